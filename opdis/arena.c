@@ -0,0 +1,243 @@
+/*!
+ * \file arena.c
+ * \brief Arena allocator for collected instructions
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <opdis/arena.h>
+#include <opdis/strpool.h>
+
+/* alignment of every allocation; opdis_insn_t contains 64-bit fields */
+#define ARENA_ALIGN 8
+#define ALIGN_UP(x) (((x) + ARENA_ALIGN - 1) & ~((size_t) ARENA_ALIGN - 1))
+
+struct opdis_arena_page {
+	struct opdis_arena_page * next;
+	size_t size;			/* bytes in data */
+	size_t used;			/* bytes of data handed out */
+	/* data follows the (aligned) header */
+};
+
+#define PAGE_HDR_SIZE ALIGN_UP(sizeof(struct opdis_arena_page))
+#define PAGE_DATA(p) ((unsigned char *) (p) + PAGE_HDR_SIZE)
+
+opdis_arena_t LIBCALL opdis_arena_init( size_t page_size ) {
+	opdis_arena_t arena = (opdis_arena_t) calloc( 1,
+						sizeof(opdis_arena_base_t) );
+	if (! arena ) {
+		return NULL;
+	}
+
+	arena->page_size = ( page_size ) ? page_size : OPDIS_ARENA_PAGE_SIZE;
+
+	return arena;
+}
+
+static struct opdis_arena_page * add_page( opdis_arena_t arena,
+					   size_t size ) {
+	struct opdis_arena_page * page;
+
+	/* calloc: arena memory is always zero-initialized */
+	page = (struct opdis_arena_page *) calloc( 1, PAGE_HDR_SIZE + size );
+	if (! page ) {
+		return NULL;
+	}
+
+	page->size = size;
+	arena->allocated += size;
+
+	if ( arena->pages && size > arena->page_size ) {
+		/* oversized page: keep filling the current page */
+		page->next = arena->pages->next;
+		arena->pages->next = page;
+	} else {
+		page->next = arena->pages;
+		arena->pages = page;
+	}
+
+	return page;
+}
+
+void * LIBCALL opdis_arena_alloc( opdis_arena_t arena, size_t size ) {
+	struct opdis_arena_page * page;
+	void * ptr;
+
+	if (! arena ) {
+		return NULL;
+	}
+
+	size = ALIGN_UP( ( size ) ? size : 1 );
+
+	page = arena->pages;
+	if (! page || page->size - page->used < size ) {
+		page = add_page( arena, ( size > arena->page_size ) ? size :
+							arena->page_size );
+		if (! page ) {
+			return NULL;
+		}
+	}
+
+	ptr = PAGE_DATA(page) + page->used;
+	page->used += size;
+	arena->used += size;
+
+	return ptr;
+}
+
+static char * arena_strdup( opdis_arena_t arena, const char * str ) {
+	size_t len = strlen( str ) + 1;
+	char * s = (char *) opdis_arena_alloc( arena, len );
+
+	if ( s ) {
+		memcpy( s, str, len );
+	}
+
+	return s;
+}
+
+/* strings shared by many insns are taken from the string pool, if any */
+static char * arena_shared_str( opdis_arena_t arena, const char * str ) {
+	if ( arena->strings ) {
+		return (char *) opdis_strpool_intern( arena->strings, str );
+	}
+
+	return arena_strdup( arena, str );
+}
+
+static opdis_op_t * arena_op_dupe( opdis_arena_t arena,
+				   const opdis_op_t * op ) {
+	opdis_op_t * new_op = (opdis_op_t *) opdis_arena_alloc( arena,
+							sizeof(opdis_op_t) );
+	if (! new_op ) {
+		return NULL;
+	}
+
+	memcpy( new_op, op, sizeof(opdis_op_t) );
+	new_op->fixed_size = new_op->ascii_sz = 0;
+	new_op->packed = new_op->ascii_shared = 1;
+	new_op->ascii = NULL;
+	if ( op->ascii ) {
+		new_op->ascii = arena_shared_str( arena, op->ascii );
+		if (! new_op->ascii ) {
+			return NULL;
+		}
+	}
+
+	return new_op;
+}
+
+/* copy a special operand pointer, e.g. target, to the new insn */
+static opdis_op_t * op_for_copy( const opdis_insn_t * insn,
+				 const opdis_insn_t * new_insn,
+				 const opdis_op_t * op ) {
+	opdis_off_t i;
+
+	if (! op ) {
+		return NULL;
+	}
+
+	for ( i = 0; i < new_insn->num_operands; i++ ) {
+		if ( insn->operands[i] == op ) {
+			return new_insn->operands[i];
+		}
+	}
+
+	return NULL;
+}
+
+opdis_insn_t * LIBCALL opdis_insn_arena_dupe( opdis_arena_t arena,
+					      const opdis_insn_t * insn ) {
+	opdis_insn_t * new_insn;
+	opdis_off_t i;
+
+	if (! arena || ! insn ) {
+		return NULL;
+	}
+
+	/* a failed copy is abandoned; the arena reclaims it when freed */
+	new_insn = (opdis_insn_t *) opdis_arena_alloc( arena,
+						       sizeof(opdis_insn_t) );
+	if (! new_insn ) {
+		return NULL;
+	}
+
+	memcpy( new_insn, insn, sizeof(opdis_insn_t) );
+	new_insn->fixed_size = new_insn->ascii_sz = new_insn->mnemonic_sz = 0;
+	/* pooled strings are shared: opdis_insn_clear must not empty them */
+	new_insn->packed = 1;
+	new_insn->bytes = NULL;
+	new_insn->ascii = new_insn->mnemonic = NULL;
+	new_insn->prefixes = new_insn->comment = NULL;
+	new_insn->operands = NULL;
+	new_insn->target = new_insn->dest = new_insn->src = NULL;
+	new_insn->num_operands = new_insn->alloc_operands = 0;
+
+	if ( insn->size && insn->bytes ) {
+		new_insn->bytes = (opdis_byte_t *) opdis_arena_alloc( arena,
+								insn->size );
+		if (! new_insn->bytes ) {
+			return NULL;
+		}
+		memcpy( new_insn->bytes, insn->bytes, insn->size );
+	}
+
+	if ( (insn->ascii &&
+	      ! (new_insn->ascii = arena_strdup( arena, insn->ascii ))) ||
+	     (insn->mnemonic &&
+	      ! (new_insn->mnemonic = arena_shared_str( arena,
+							insn->mnemonic ))) ||
+	     (insn->prefixes &&
+	      ! (new_insn->prefixes = arena_shared_str( arena,
+							insn->prefixes ))) ||
+	     (insn->comment &&
+	      ! (new_insn->comment = arena_strdup( arena, insn->comment ))) ) {
+		return NULL;
+	}
+
+	if ( insn->num_operands > OPDIS_INSN_INLINE_OPS ) {
+		new_insn->operands = (opdis_op_t **) opdis_arena_alloc( arena,
+				insn->num_operands * sizeof(opdis_op_t *) );
+		if (! new_insn->operands ) {
+			return NULL;
+		}
+	} else {
+		new_insn->operands = new_insn->inline_ops;
+	}
+	new_insn->alloc_operands = insn->num_operands;
+
+	for ( i = 0; i < insn->num_operands; i++ ) {
+		new_insn->operands[i] = arena_op_dupe( arena,
+						       insn->operands[i] );
+		if (! new_insn->operands[i] ) {
+			return NULL;
+		}
+		new_insn->num_operands++;
+	}
+
+	new_insn->target = op_for_copy( insn, new_insn, insn->target );
+	new_insn->dest = op_for_copy( insn, new_insn, insn->dest );
+	new_insn->src = op_for_copy( insn, new_insn, insn->src );
+
+	return new_insn;
+}
+
+void LIBCALL opdis_arena_free( opdis_arena_t arena ) {
+	struct opdis_arena_page * page, * next;
+
+	if (! arena ) {
+		return;
+	}
+
+	for ( page = arena->pages; page; page = next ) {
+		next = page->next;
+		free( page );
+	}
+
+	free( arena );
+}
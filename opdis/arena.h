@@ -0,0 +1,124 @@
+/*!
+ * \file arena.h
+ * \brief Arena allocator for collected instructions
+ * \details An arena allocates memory from large pages and frees all of it
+ *          at once. Instructions copied into an arena with
+ *          opdis_insn_arena_dupe need no per-object allocation or free,
+ *          which makes it suitable for collecting the output of a large
+ *          disassembly, e.g. in an opdis_insn_tree_t.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#ifndef OPDIS_ARENA_H
+#define OPDIS_ARENA_H
+
+#include <stddef.h>
+
+#include <opdis/model.h>
+
+#ifdef WIN32
+        #define LIBCALL _stdcall
+#else
+        #define LIBCALL
+#endif
+
+/*! \def OPDIS_ARENA_PAGE_SIZE
+ *  \ingroup arena
+ *  \brief Default size of an arena page.
+ */
+#define OPDIS_ARENA_PAGE_SIZE 65536
+
+/*! \struct opdis_arena_base_t
+ *  \ingroup arena
+ *  \brief An arena of memory pages.
+ *  \details Memory is allocated from the current page until it is full.
+ *           Requests larger than a page get a page of their own.
+ *  \note If \e strings is set to an opdis_strpool_t, instructions copied
+ *        into the arena share the pooled copies of their mnemonic, prefixes
+ *        and operand strings. The pool is not owned by the arena, and may
+ *        be shared by several arenas.
+ */
+typedef struct {
+	struct opdis_arena_page * pages;	/*!< Most recent page first */
+	size_t page_size;			/*!< Default page size */
+	size_t allocated;			/*!< Bytes in all pages */
+	size_t used;				/*!< Bytes handed out */
+	struct opdis_strpool_base * strings;	/*!< String pool, or NULL */
+} opdis_arena_base_t;
+
+/*! \typedef opdis_arena_base_t * opdis_arena_t
+ *  \ingroup arena
+ *  \brief Pointer to an arena.
+ */
+typedef opdis_arena_base_t * opdis_arena_t;
+
+/* ---------------------------------------------------------------------- */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*!
+ * \fn opdis_arena_t opdis_arena_init( size_t )
+ * \ingroup arena
+ * \brief Allocate an empty arena.
+ * \param page_size Size of each page; default is \ref OPDIS_ARENA_PAGE_SIZE.
+ * \return The allocated arena.
+ * \sa opdis_arena_free
+ * \note No page is allocated until the first call to opdis_arena_alloc.
+ */
+opdis_arena_t LIBCALL opdis_arena_init( size_t page_size );
+
+/*!
+ * \fn void * opdis_arena_alloc( opdis_arena_t, size_t )
+ * \ingroup arena
+ * \brief Allocate memory from an arena.
+ * \param arena The arena.
+ * \param size The number of bytes to allocate.
+ * \return Zero-initialized memory aligned for any object in opdis_insn_t,
+ *         or NULL if memory could not be allocated.
+ * \note The memory must not be passed to free(). It is released by
+ *       opdis_arena_free.
+ */
+void * LIBCALL opdis_arena_alloc( opdis_arena_t arena, size_t size );
+
+/*!
+ * \fn opdis_insn_t * opdis_insn_arena_dupe( opdis_arena_t,
+ * 					     const opdis_insn_t * )
+ * \ingroup arena
+ * \brief Copy an instruction into an arena.
+ * \details This is equivalent to opdis_insn_dupe, except that the
+ *          instruction, its operands, bytes and strings are all allocated
+ *          from \e arena. If the arena has a string pool, the mnemonic,
+ *          prefixes and operand strings are taken from the pool instead.
+ * \param arena The arena.
+ * \param insn The instruction to copy.
+ * \return The copy, or NULL if memory could not be allocated.
+ * \note The copy must not be passed to opdis_insn_free, or to any routine
+ *       that reallocates its fields (e.g. opdis_insn_set_ascii or
+ *       opdis_insn_add_operand). Store it in an opdis_insn_tree_t that
+ *       does not manage its instructions.
+ * \note The copy and its operands are \e packed, so pooled strings are
+ *       never modified through it: opdis_insn_clear and opdis_op_clear
+ *       reset its string fields to NULL instead of emptying them.
+ */
+opdis_insn_t * LIBCALL opdis_insn_arena_dupe( opdis_arena_t arena,
+					      const opdis_insn_t * insn );
+
+/*!
+ * \fn void opdis_arena_free( opdis_arena_t )
+ * \ingroup arena
+ * \brief Free an arena and everything allocated from it.
+ * \param arena The arena to free.
+ * \sa opdis_arena_init
+ */
+void LIBCALL opdis_arena_free( opdis_arena_t arena );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,249 @@
+/*!
+ * \file bitmap.c
+ * \brief Bitmap of visited addresses in a buffer
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <opdis/bitmap.h>
+
+#define BITS_PER_WORD 32
+#define WORD_COUNT(len) (((len) + BITS_PER_WORD - 1) / BITS_PER_WORD)
+#define WORD_INDEX(off) ((off) / BITS_PER_WORD)
+#define WORD_MASK(off) ((uint32_t) 1 << ((off) % BITS_PER_WORD))
+
+opdis_vma_bitmap_t LIBCALL opdis_vma_bitmap_init( opdis_vma_t vma,
+						  opdis_off_t len ) {
+	opdis_vma_bitmap_t map = (opdis_vma_bitmap_t) calloc( 1,
+					sizeof(opdis_vma_bitmap_base_t) );
+	if (! map ) {
+		return NULL;
+	}
+
+	/* always allocate at least one word so bits is never NULL */
+	map->bits = (uint32_t *) calloc( WORD_COUNT(len) + 1,
+					 sizeof(uint32_t) );
+	if (! map->bits ) {
+		free( map );
+		return NULL;
+	}
+
+	map->vma = vma;
+	map->len = len;
+
+	return map;
+}
+
+int LIBCALL opdis_vma_bitmap_covers( opdis_vma_bitmap_t map,
+				     opdis_vma_t addr ) {
+	/* unsigned subtraction also rejects addr < vma */
+	return ( map && (addr - map->vma) < map->len );
+}
+
+int LIBCALL opdis_vma_bitmap_add( opdis_vma_bitmap_t map, opdis_vma_t addr ) {
+	opdis_off_t off;
+	uint32_t * word;
+
+	if (! opdis_vma_bitmap_covers( map, addr ) ) {
+		return 0;
+	}
+
+	off = addr - map->vma;
+	word = &map->bits[WORD_INDEX(off)];
+	if ( *word & WORD_MASK(off) ) {
+		return 0;
+	}
+
+	*word |= WORD_MASK(off);
+	return 1;
+}
+
+int LIBCALL opdis_vma_bitmap_add_atomic( opdis_vma_bitmap_t map,
+					 opdis_vma_t addr ) {
+#ifdef __GNUC__
+	opdis_off_t off;
+	uint32_t old;
+
+	if (! opdis_vma_bitmap_covers( map, addr ) ) {
+		return 0;
+	}
+
+	off = addr - map->vma;
+	old = __sync_fetch_and_or( &map->bits[WORD_INDEX(off)],
+				   WORD_MASK(off) );
+	return (old & WORD_MASK(off)) ? 0 : 1;
+#else
+	return opdis_vma_bitmap_add( map, addr );
+#endif
+}
+
+int LIBCALL opdis_vma_bitmap_delete( opdis_vma_bitmap_t map,
+				     opdis_vma_t addr ) {
+	opdis_off_t off;
+	uint32_t * word;
+
+	if (! opdis_vma_bitmap_covers( map, addr ) ) {
+		return 0;
+	}
+
+	off = addr - map->vma;
+	word = &map->bits[WORD_INDEX(off)];
+	if (! (*word & WORD_MASK(off)) ) {
+		return 0;
+	}
+
+	*word &= ~WORD_MASK(off);
+	return 1;
+}
+
+int LIBCALL opdis_vma_bitmap_contains( opdis_vma_bitmap_t map,
+				       opdis_vma_t addr ) {
+	opdis_off_t off;
+
+	if (! opdis_vma_bitmap_covers( map, addr ) ) {
+		return 0;
+	}
+
+	off = addr - map->vma;
+	return (map->bits[WORD_INDEX(off)] & WORD_MASK(off)) ? 1 : 0;
+}
+
+size_t LIBCALL opdis_vma_bitmap_count( opdis_vma_bitmap_t map ) {
+	size_t i, count = 0;
+
+	if (! map ) {
+		return 0;
+	}
+
+	for ( i = 0; i < WORD_COUNT(map->len); i++ ) {
+		uint32_t word = map->bits[i];
+		while ( word ) {
+			word &= word - 1;
+			count++;
+		}
+	}
+
+	return count;
+}
+
+void LIBCALL opdis_vma_bitmap_clear( opdis_vma_bitmap_t map ) {
+	if ( map ) {
+		memset( map->bits, 0, WORD_COUNT(map->len) * sizeof(uint32_t) );
+	}
+}
+
+opdis_vma_t LIBCALL opdis_vma_bitmap_next( opdis_vma_bitmap_t map,
+					   opdis_vma_t addr ) {
+	opdis_off_t off;
+
+	if (! map ) {
+		return OPDIS_INVALID_ADDR;
+	}
+
+	off = ( addr < map->vma ) ? 0 : addr - map->vma;
+	while ( off < map->len ) {
+		uint32_t word = map->bits[WORD_INDEX(off)] >>
+				(off % BITS_PER_WORD);
+
+		if (! word ) {
+			/* skip to the next word */
+			off = (WORD_INDEX(off) + 1) * BITS_PER_WORD;
+			continue;
+		}
+
+		while (! (word & 1) ) {
+			word >>= 1;
+			off++;
+		}
+
+		return ( off < map->len ) ? map->vma + off : OPDIS_INVALID_ADDR;
+	}
+
+	return OPDIS_INVALID_ADDR;
+}
+
+void LIBCALL opdis_vma_bitmap_foreach( opdis_vma_bitmap_t map,
+				       OPDIS_VMA_BITMAP_FOREACH_FN fn,
+				       void * arg ) {
+	size_t i;
+
+	if (! map || ! fn ) {
+		return;
+	}
+
+	for ( i = 0; i < WORD_COUNT(map->len); i++ ) {
+		uint32_t word = map->bits[i];
+		opdis_off_t bit;
+
+		/* most words in a sparse map are empty */
+		for ( bit = 0; word; bit++, word >>= 1 ) {
+			if ( (word & 1) &&
+			     ! fn( map->vma + (i * BITS_PER_WORD) + bit, arg ) ) {
+				return;
+			}
+		}
+	}
+}
+
+void LIBCALL opdis_vma_bitmap_free( opdis_vma_bitmap_t map ) {
+	if (! map ) {
+		return;
+	}
+
+	if ( map->bits ) {
+		free( map->bits );
+	}
+
+	free( map );
+}
+
+/* ---------------------------------------------------------------------- */
+/* Instruction start map */
+
+opdis_insn_map_t LIBCALL opdis_insn_map_alloc( opdis_vma_t vma,
+					       opdis_off_t len ) {
+	opdis_insn_map_t map = (opdis_insn_map_t) calloc( 1,
+						sizeof(opdis_insn_map_base_t) );
+	if (! map ) {
+		return NULL;
+	}
+
+	map->starts = opdis_vma_bitmap_init( vma, len );
+	if (! map->starts ) {
+		free( map );
+		return NULL;
+	}
+
+	return map;
+}
+
+int LIBCALL opdis_insn_map_add( opdis_insn_map_t map, opdis_vma_t vma ) {
+	if (! map || ! opdis_vma_bitmap_add( map->starts, vma ) ) {
+		return 0;
+	}
+
+	map->count++;
+	return 1;
+}
+
+int LIBCALL opdis_insn_map_is_start( opdis_insn_map_t map, opdis_vma_t vma ) {
+	return ( map ) ? opdis_vma_bitmap_contains( map->starts, vma ) : 0;
+}
+
+opdis_vma_t LIBCALL opdis_insn_map_next( opdis_insn_map_t map,
+					 opdis_vma_t vma ) {
+	return ( map ) ? opdis_vma_bitmap_next( map->starts, vma ) :
+			 OPDIS_INVALID_ADDR;
+}
+
+void LIBCALL opdis_insn_map_free( opdis_insn_map_t map ) {
+	if ( map ) {
+		opdis_vma_bitmap_free( map->starts );
+		free( map );
+	}
+}
@@ -0,0 +1,282 @@
+/*!
+ * \file bitmap.h
+ * \brief Bitmap of visited addresses in a buffer
+ * \details This defines a set of addresses backed by a bitmap. The bitmap
+ *          covers a fixed address range (normally that of the buffer being
+ *          disassembled) and stores one bit per byte in that range. Unlike
+ *          an opdis_vma_tree_t, adding an address never allocates memory
+ *          and membership tests are constant-time.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#ifndef OPDIS_BITMAP_H
+#define OPDIS_BITMAP_H
+
+#include <opdis/types.h>
+
+#ifdef WIN32
+        #define LIBCALL _stdcall
+#else
+        #define LIBCALL
+#endif
+
+/*! \struct opdis_vma_bitmap_base_t
+ *  \ingroup bitmap
+ *  \brief A set of addresses in the range [vma, vma + len).
+ *  \details Bit \e n of the bitmap is set if address \e vma + \e n is
+ *           in the set.
+ */
+typedef struct {
+	opdis_vma_t	vma;	/*!< First address in the bitmap */
+	opdis_off_t	len;	/*!< Number of addresses in the bitmap */
+	uint32_t *	bits;	/*!< One bit per address */
+} opdis_vma_bitmap_base_t;
+
+/*! \typedef opdis_vma_bitmap_base_t * opdis_vma_bitmap_t
+ *  \ingroup bitmap
+ *  \brief Pointer to an address bitmap.
+ */
+typedef opdis_vma_bitmap_base_t * opdis_vma_bitmap_t;
+
+/*! \struct opdis_insn_map_base_t
+ *  \ingroup bitmap
+ *  \brief The instruction start addresses in a range of a buffer.
+ *  \details An Address Bitmap of the instruction starts, which keeps
+ *           a count of the addresses added to it.
+ *  \sa opdis_disasm_insn_map
+ */
+typedef struct {
+	opdis_vma_bitmap_t starts;	/*!< Instruction start addresses. */
+	opdis_off_t	count;		/*!< Number of instruction starts. */
+} opdis_insn_map_base_t;
+
+/*! \typedef opdis_insn_map_base_t * opdis_insn_map_t
+ *  \ingroup bitmap
+ *  \brief Pointer to an instruction start map.
+ */
+typedef opdis_insn_map_base_t * opdis_insn_map_t;
+
+/*!
+ * \typedef int (*OPDIS_VMA_BITMAP_FOREACH_FN) (opdis_vma_t, void *)
+ * \ingroup bitmap
+ * \brief Callback invoked for every address emitted by
+ *        opdis_vma_bitmap_foreach.
+ * \param addr The address.
+ * \param arg Argument provided to opdis_vma_bitmap_foreach
+ * \note A zero return value will break out of the foreach.
+ */
+
+typedef int (*OPDIS_VMA_BITMAP_FOREACH_FN) (opdis_vma_t addr, void * arg);
+
+/* ---------------------------------------------------------------------- */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*!
+ * \fn opdis_vma_bitmap_t opdis_vma_bitmap_init( opdis_vma_t, opdis_off_t )
+ * \ingroup bitmap
+ * \brief Allocate an empty Address Bitmap.
+ * \param vma The first address covered by the bitmap.
+ * \param len The number of addresses covered by the bitmap.
+ * \return The allocated bitmap.
+ * \sa opdis_vma_bitmap_free
+ * \note The bitmap requires \e len / 8 bytes of memory.
+ */
+
+opdis_vma_bitmap_t LIBCALL opdis_vma_bitmap_init( opdis_vma_t vma,
+						  opdis_off_t len );
+
+/*!
+ * \fn int opdis_vma_bitmap_covers( opdis_vma_bitmap_t, opdis_vma_t )
+ * \ingroup bitmap
+ * \brief Determine if an address is in the range covered by the bitmap.
+ * \param map The Address Bitmap.
+ * \param addr The address.
+ * \return 1 if the address can be stored in the bitmap, 0 otherwise.
+ */
+
+int LIBCALL opdis_vma_bitmap_covers( opdis_vma_bitmap_t map, opdis_vma_t addr );
+
+/*!
+ * \fn int opdis_vma_bitmap_add( opdis_vma_bitmap_t, opdis_vma_t )
+ * \ingroup bitmap
+ * \brief Insert an address into the bitmap.
+ * \param map The Address Bitmap.
+ * \param addr The address to insert.
+ * \return 1 if address was added, 0 if address exists or is not covered
+ *         by the bitmap.
+ * \sa opdis_vma_bitmap_delete
+ */
+
+int LIBCALL opdis_vma_bitmap_add( opdis_vma_bitmap_t map, opdis_vma_t addr );
+
+/*!
+ * \fn int opdis_vma_bitmap_add_atomic( opdis_vma_bitmap_t, opdis_vma_t )
+ * \ingroup bitmap
+ * \brief Insert an address into the bitmap atomically.
+ * \details This is identical to opdis_vma_bitmap_add, except that the bit
+ *          is tested and set in a single atomic operation. When several
+ *          threads add the same address, exactly one of them will see
+ *          a return value of 1.
+ * \param map The Address Bitmap.
+ * \param addr The address to insert.
+ * \return 1 if address was added, 0 if address exists or is not covered
+ *         by the bitmap.
+ * \note This requires GCC atomic builtins; other compilers get the
+ *       non-atomic opdis_vma_bitmap_add.
+ */
+
+int LIBCALL opdis_vma_bitmap_add_atomic( opdis_vma_bitmap_t map,
+					 opdis_vma_t addr );
+
+/*!
+ * \fn int opdis_vma_bitmap_delete( opdis_vma_bitmap_t, opdis_vma_t )
+ * \ingroup bitmap
+ * \brief Delete an address from the bitmap.
+ * \param map The Address Bitmap.
+ * \param addr The address to delete.
+ * \return 1 on success, 0 if the address was not in the bitmap.
+ * \sa opdis_vma_bitmap_add
+ */
+
+int LIBCALL opdis_vma_bitmap_delete( opdis_vma_bitmap_t map,
+				     opdis_vma_t addr );
+
+/*!
+ * \fn int opdis_vma_bitmap_contains( opdis_vma_bitmap_t, opdis_vma_t )
+ * \ingroup bitmap
+ * \brief Determine if an address is in the bitmap.
+ * \param map The Address Bitmap.
+ * \param addr The address to search for.
+ * \return 1 if the address is in the bitmap, 0 otherwise.
+ */
+
+int LIBCALL opdis_vma_bitmap_contains( opdis_vma_bitmap_t map,
+				       opdis_vma_t addr );
+
+/*!
+ * \fn size_t opdis_vma_bitmap_count( opdis_vma_bitmap_t )
+ * \ingroup bitmap
+ * \brief Return the number of addresses in the bitmap.
+ * \param map The Address Bitmap.
+ */
+
+size_t LIBCALL opdis_vma_bitmap_count( opdis_vma_bitmap_t map );
+
+/*!
+ * \fn void opdis_vma_bitmap_clear( opdis_vma_bitmap_t )
+ * \ingroup bitmap
+ * \brief Remove all addresses from the bitmap.
+ * \param map The Address Bitmap.
+ */
+
+void LIBCALL opdis_vma_bitmap_clear( opdis_vma_bitmap_t map );
+
+/*!
+ * \fn opdis_vma_t opdis_vma_bitmap_next( opdis_vma_bitmap_t, opdis_vma_t )
+ * \ingroup bitmap
+ * \brief Find the first address in the bitmap at or after an address.
+ * \param map The Address Bitmap.
+ * \param addr The address to search from.
+ * \return The address, or OPDIS_INVALID_ADDR if there is none.
+ */
+
+opdis_vma_t LIBCALL opdis_vma_bitmap_next( opdis_vma_bitmap_t map,
+					   opdis_vma_t addr );
+
+/*!
+ * \fn void opdis_vma_bitmap_foreach( opdis_vma_bitmap_t,
+				     OPDIS_VMA_BITMAP_FOREACH_FN, void * )
+ * \ingroup bitmap
+ * \brief Invoke a callback for every address in the bitmap.
+ * \details Addresses are emitted in ascending order.
+ * \param map The Address Bitmap.
+ * \param fn The callback to invoke for each address.
+ * \param arg An optional argument to pass to the callback function.
+ */
+
+void LIBCALL opdis_vma_bitmap_foreach( opdis_vma_bitmap_t map,
+				       OPDIS_VMA_BITMAP_FOREACH_FN fn,
+				       void * arg );
+
+/*!
+ * \fn void opdis_vma_bitmap_free( opdis_vma_bitmap_t )
+ * \ingroup bitmap
+ * \brief Free the Address Bitmap.
+ * \param map The Address Bitmap.
+ * \sa opdis_vma_bitmap_init
+ */
+
+void LIBCALL opdis_vma_bitmap_free( opdis_vma_bitmap_t map );
+
+/* ---------------------------------------------------------------------- */
+/*!
+ * \fn opdis_insn_map_t opdis_insn_map_alloc( opdis_vma_t, opdis_off_t )
+ * \ingroup bitmap
+ * \brief Allocate an empty instruction start map.
+ * \param vma The first address covered by the map.
+ * \param len The number of addresses covered by the map.
+ * \return The allocated map.
+ * \sa opdis_disasm_insn_map opdis_insn_map_free
+ */
+
+opdis_insn_map_t LIBCALL opdis_insn_map_alloc( opdis_vma_t vma,
+					       opdis_off_t len );
+
+/*!
+ * \fn int opdis_insn_map_add( opdis_insn_map_t, opdis_vma_t )
+ * \ingroup bitmap
+ * \brief Mark an address as the start of an instruction.
+ * \param map The instruction start map.
+ * \param vma The address.
+ * \return 1 if the address was added, 0 if it was already in the map or
+ *         is not covered by the map.
+ */
+
+int LIBCALL opdis_insn_map_add( opdis_insn_map_t map, opdis_vma_t vma );
+
+/*!
+ * \fn int opdis_insn_map_is_start( opdis_insn_map_t, opdis_vma_t )
+ * \ingroup bitmap
+ * \brief Determine if an instruction starts at an address.
+ * \param map The instruction start map.
+ * \param vma The address.
+ * \return 1 if \e vma is an instruction start, 0 otherwise.
+ */
+
+int LIBCALL opdis_insn_map_is_start( opdis_insn_map_t map, opdis_vma_t vma );
+
+/*!
+ * \fn opdis_vma_t opdis_insn_map_next( opdis_insn_map_t, opdis_vma_t )
+ * \ingroup bitmap
+ * \brief Find the first instruction start at or after an address.
+ * \details This can be used to split a buffer at instruction boundaries,
+ *          e.g. when distributing a linear disassembly across threads.
+ * \param map The instruction start map.
+ * \param vma The address to search from.
+ * \return The address of the instruction start, or OPDIS_INVALID_ADDR.
+ */
+
+opdis_vma_t LIBCALL opdis_insn_map_next( opdis_insn_map_t map,
+					 opdis_vma_t vma );
+
+/*!
+ * \fn void opdis_insn_map_free( opdis_insn_map_t )
+ * \ingroup bitmap
+ * \brief Free an instruction start map.
+ * \param map The instruction start map.
+ * \sa opdis_insn_map_alloc
+ */
+
+void LIBCALL opdis_insn_map_free( opdis_insn_map_t map );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
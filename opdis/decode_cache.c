@@ -0,0 +1,176 @@
+/*!
+ * \file decode_cache.c
+ * \brief Cache of decoded instructions.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <opdis/decode_cache.h>
+
+/* ---------------------------------------------------------------------- */
+/* Slots */
+
+static size_t slot_for_bytes( opdis_decode_cache_t cache,
+			      const opdis_byte_t * bytes, opdis_off_t size ) {
+	unsigned int h = 2166136261U;
+	opdis_off_t i;
+
+	for ( i = 0; i < size; i++ ) {
+		h = (h ^ bytes[i]) * 16777619U;
+	}
+
+	return h & (cache->num_slots - 1);
+}
+
+static int same_options( const char * a, const char * b ) {
+	if (! a || ! b ) {
+		return ( a == b );
+	}
+
+	return (! strcmp( a, b ));
+}
+
+/* ---------------------------------------------------------------------- */
+/* Decode cache API */
+
+opdis_decode_cache_t LIBCALL opdis_decode_cache_init( size_t num_slots ) {
+	opdis_decode_cache_t cache;
+	size_t n = 1;
+
+	if (! num_slots ) {
+		return NULL;
+	}
+
+	while ( n < num_slots ) {
+		n <<= 1;
+	}
+
+	cache = (opdis_decode_cache_t) calloc( 1,
+					sizeof(opdis_decode_cache_base_t) );
+	if (! cache ) {
+		return NULL;
+	}
+
+	cache->slots = (opdis_insn_t **) calloc( n, sizeof(opdis_insn_t *) );
+	if (! cache->slots ) {
+		free( cache );
+		return NULL;
+	}
+
+	cache->num_slots = n;
+
+	return cache;
+}
+
+void LIBCALL opdis_decode_cache_set_key( opdis_decode_cache_t cache,
+					 enum bfd_architecture arch,
+					 unsigned long mach,
+					 disassembler_ftype fn,
+					 const char * options,
+					 OPDIS_DECODER decoder,
+					 void * decoder_arg,
+					 unsigned int decode_level,
+					 int branch_ops ) {
+	if (! cache ) {
+		return;
+	}
+
+	if ( cache->arch == arch && cache->mach == mach &&
+	     cache->disassembler == fn && cache->decoder == decoder &&
+	     cache->decoder_arg == decoder_arg &&
+	     cache->decode_level == decode_level &&
+	     cache->decode_branch_ops == branch_ops &&
+	     same_options( cache->options, options ) ) {
+		return;
+	}
+
+	opdis_decode_cache_flush( cache );
+
+	cache->arch = arch;
+	cache->mach = mach;
+	cache->disassembler = fn;
+	cache->decoder = decoder;
+	cache->decoder_arg = decoder_arg;
+	cache->decode_level = decode_level;
+	cache->decode_branch_ops = branch_ops;
+
+	free( cache->options );
+	cache->options = (options) ? strdup( options ) : NULL;
+}
+
+const opdis_insn_t * LIBCALL opdis_decode_cache_find(
+				opdis_decode_cache_t cache,
+				const opdis_byte_t * bytes, opdis_off_t size ) {
+	opdis_insn_t * insn;
+
+	if (! cache || ! bytes || ! size ) {
+		return NULL;
+	}
+
+	cache->stats.lookups++;
+
+	insn = cache->slots[slot_for_bytes( cache, bytes, size )];
+	if (! insn || insn->size != size ||
+	     memcmp( insn->bytes, bytes, size ) ) {
+		return NULL;
+	}
+
+	cache->stats.hits++;
+
+	return insn;
+}
+
+int LIBCALL opdis_decode_cache_add( opdis_decode_cache_t cache,
+				    const opdis_insn_t * insn ) {
+	opdis_insn_t * copy;
+	size_t slot;
+
+	if (! cache || ! insn || ! insn->bytes || ! insn->size ) {
+		return 0;
+	}
+
+	copy = opdis_insn_dupe( insn );
+	if (! copy ) {
+		return 0;
+	}
+
+	slot = slot_for_bytes( cache, insn->bytes, insn->size );
+	if ( cache->slots[slot] ) {
+		opdis_insn_free( cache->slots[slot] );
+		cache->stats.evictions++;
+	}
+
+	cache->slots[slot] = copy;
+	cache->stats.inserts++;
+
+	return 1;
+}
+
+void LIBCALL opdis_decode_cache_flush( opdis_decode_cache_t cache ) {
+	size_t i;
+
+	if (! cache ) {
+		return;
+	}
+
+	for ( i = 0; i < cache->num_slots; i++ ) {
+		opdis_insn_free( cache->slots[i] );
+		cache->slots[i] = NULL;
+	}
+}
+
+void LIBCALL opdis_decode_cache_free( opdis_decode_cache_t cache ) {
+	if (! cache ) {
+		return;
+	}
+
+	opdis_decode_cache_flush( cache );
+	free( cache->options );
+	free( cache->slots );
+	free( cache );
+}
@@ -0,0 +1,148 @@
+/*!
+ * \file decode_cache.h
+ * \brief Cache of decoded instructions.
+ * \details This defines the cache used by the disassembly routines to
+ *          avoid invoking libopcodes and the decoder for byte sequences
+ *          which have already been decoded. The cache is direct-mapped:
+ *          each byte sequence hashes to a single slot, and a new
+ *          instruction replaces the one already in its slot.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#ifndef OPDIS_DECODE_CACHE_H
+#define OPDIS_DECODE_CACHE_H
+
+#include <opdis/opdis.h>
+
+#ifdef WIN32
+        #define LIBCALL _stdcall
+#else
+        #define LIBCALL
+#endif
+
+/*! \struct opdis_decode_cache_base_t
+ *  \ingroup internal
+ *  \brief A cache of decoded instructions.
+ *  \details The instructions in the cache are only valid for the
+ *           architecture, libopcodes routine, decoder and decoder argument
+ *           which produced them; these are recorded so the cache can be
+ *           flushed when any of them changes.
+ */
+typedef struct opdis_decode_cache {
+	opdis_insn_t ** slots;		/*!< Decoded insns, or NULL */
+	size_t num_slots;		/*!< Number of slots (power of 2) */
+	enum bfd_architecture arch;	/*!< Architecture of cached insns */
+	unsigned long mach;		/*!< Machine of cached insns */
+	disassembler_ftype disassembler;/*!< libopcodes routine */
+	char * options;			/*!< libopcodes options, or NULL */
+	OPDIS_DECODER decoder;		/*!< Decoder of cached insns */
+	void * decoder_arg;		/*!< Argument passed to decoder */
+	unsigned int decode_level;	/*!< Decode level of cached insns */
+	int decode_branch_ops;		/*!< Branch operands were decoded */
+	opdis_decode_cache_stats_t stats; /*!< Usage statistics */
+} opdis_decode_cache_base_t;
+
+/*! \typedef opdis_decode_cache_base_t * opdis_decode_cache_t
+ *  \ingroup internal
+ *  \brief Pointer to a decode cache.
+ */
+typedef opdis_decode_cache_base_t * opdis_decode_cache_t;
+
+/* ---------------------------------------------------------------------- */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*!
+ * \fn opdis_decode_cache_t opdis_decode_cache_init( size_t )
+ * \ingroup internal
+ * \brief Allocate an empty decode cache.
+ * \param num_slots The number of instructions to keep. This is rounded up
+ *                  to a power of two.
+ * \return The allocated cache.
+ * \sa opdis_decode_cache_free
+ */
+opdis_decode_cache_t LIBCALL opdis_decode_cache_init( size_t num_slots );
+
+/*!
+ * \fn void opdis_decode_cache_set_key( opdis_decode_cache_t,
+ * 			enum bfd_architecture, unsigned long,
+ * 			disassembler_ftype, const char *, OPDIS_DECODER,
+ * 			void *, unsigned int, int )
+ * \ingroup internal
+ * \brief Set the configuration which the cached instructions belong to.
+ * \details If this differs from the current configuration of the cache,
+ *          all cached instructions are discarded.
+ * \param cache The decode cache.
+ * \param arch The architecture.
+ * \param mach The machine.
+ * \param fn The libopcodes routine (which determines e.g. x86 syntax).
+ * \param options The libopcodes disassembler options, or NULL.
+ * \param decoder The decoder.
+ * \param decoder_arg The argument passed to the decoder.
+ * \param decode_level The opdis_insn_decode_t fields which are decoded.
+ * \param branch_ops Nonzero if operands of branch insns are decoded.
+ */
+void LIBCALL opdis_decode_cache_set_key( opdis_decode_cache_t cache,
+					 enum bfd_architecture arch,
+					 unsigned long mach,
+					 disassembler_ftype fn,
+					 const char * options,
+					 OPDIS_DECODER decoder,
+					 void * decoder_arg,
+					 unsigned int decode_level,
+					 int branch_ops );
+
+/*!
+ * \fn const opdis_insn_t * opdis_decode_cache_find( opdis_decode_cache_t,
+ * 					const opdis_byte_t *, opdis_off_t )
+ * \ingroup internal
+ * \brief Find the decoded instruction for a byte sequence.
+ * \param cache The decode cache.
+ * \param bytes The instruction bytes.
+ * \param size The size of the instruction.
+ * \return The cached instruction, or NULL.
+ */
+const opdis_insn_t * LIBCALL opdis_decode_cache_find(
+				opdis_decode_cache_t cache,
+				const opdis_byte_t * bytes, opdis_off_t size );
+
+/*!
+ * \fn int opdis_decode_cache_add( opdis_decode_cache_t, const opdis_insn_t * )
+ * \ingroup internal
+ * \brief Add a copy of a decoded instruction to the cache.
+ * \details The instruction is keyed on its \e bytes and \e size fields.
+ *          It must not contain any values which depend on its VMA.
+ * \param cache The decode cache.
+ * \param insn The decoded instruction.
+ * \return 1 on success, 0 on failure.
+ */
+int LIBCALL opdis_decode_cache_add( opdis_decode_cache_t cache,
+				    const opdis_insn_t * insn );
+
+/*!
+ * \fn void opdis_decode_cache_flush( opdis_decode_cache_t )
+ * \ingroup internal
+ * \brief Discard all instructions in a decode cache.
+ * \param cache The decode cache.
+ */
+void LIBCALL opdis_decode_cache_flush( opdis_decode_cache_t cache );
+
+/*!
+ * \fn void opdis_decode_cache_free( opdis_decode_cache_t )
+ * \ingroup internal
+ * \brief Free a decode cache and all instructions stored in it.
+ * \param cache The decode cache.
+ * \sa opdis_decode_cache_init
+ */
+void LIBCALL opdis_decode_cache_free( opdis_decode_cache_t cache );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -7,101 +7,289 @@
  * See http://www.gnu.org/licenses/gpl.txt for details.
  */
 
+#include <ctype.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include <opdis/insn_buf.h>
+#include <opdis/model.h>
 
 opdis_insn_buf_t LIBCALL opdis_insn_buf_alloc( unsigned int max_items, 
 					       unsigned int max_item_size,
 					       unsigned int max_insn_str ) {
-	int i;
-
-	opdis_insn_buf_t buf = (opdis_insn_buf_t) calloc( 1,
-						sizeof(opdis_insn_buffer_t) );
-	if (! buf ) {
-		return NULL;
-	}
+	opdis_insn_buf_t buf;
 
 	max_items = (max_items == 0) ? OPDIS_MAX_ITEMS : max_items;
 	max_item_size = (max_item_size == 0) ? OPDIS_MAX_ITEM_SIZE : 
 					     max_item_size;
 	max_insn_str = (max_insn_str == 0) ? OPDIS_MAX_INSN_STR : max_insn_str;
 
-	buf->items = (char **) calloc( max_items, sizeof(char *));
-	if (! buf->items ) {
-		free(buf);
+	/* the buffer, tokens, arena, and string are allocated in a
+	 * single block: [buf][tokens[]][arena][string] */
+	buf = (opdis_insn_buf_t) calloc( 1, sizeof(opdis_insn_buffer_t) +
+					 (max_items *
+					  sizeof(opdis_insn_token_t)) +
+					 (max_items * max_item_size) +
+					 max_insn_str );
+	if (! buf ) {
 		return NULL;
 	}
-	for ( i = 0; i < max_items; i++ ) {
-		buf->items[i] = calloc( 1, max_item_size );
-		if (! buf->items[i] ) {
-			buf->max_item_count = i;
-			opdis_insn_buf_free( buf );
-			return NULL;
-		}
-	}
-			
+
+	buf->tokens = (opdis_insn_token_t *) &buf[1];
 	buf->max_item_count = max_items;
 	buf->max_item_size = max_item_size;
 
-	buf->string = (char *) calloc( 1, max_insn_str );
-	if (! buf->string ) {
-		opdis_insn_buf_free(buf);
-		return NULL;
-	}
+	buf->arena = (char *) &buf->tokens[max_items];
+	buf->arena_size = max_items * max_item_size;
+
+	buf->string = &buf->arena[buf->arena_size];
 	buf->max_string_size = max_insn_str;
 
+	/* decoders called directly on the buffer fill every field */
+	buf->decode_level = OPDIS_DECODE_ALL;
+
 	return buf;
 }
 
+/* Record the item just written at the end of the arena */
+static void add_token( opdis_insn_buf_t buf, unsigned int len,
+		       enum opdis_token_style_t style ) {
+	opdis_insn_token_t * tok = &buf->tokens[buf->item_count];
+	unsigned int str_len = len;
+
+	tok->offset = buf->arena_len;
+	tok->length = len;
+	tok->style = style;
+	buf->arena_len += len + 1;
+	buf->item_count++;
+
+	if ( buf->string_len + str_len >= buf->max_string_size ) {
+		str_len = buf->max_string_size - buf->string_len - 1;
+	}
+
+	memcpy( &buf->string[buf->string_len], &buf->arena[tok->offset],
+		str_len );
+	buf->string_len += str_len;
+	buf->string[buf->string_len] = '\0';
+}
+
 int LIBCALL opdis_insn_buf_append( opdis_insn_buf_t buf, const char * item ) {
-	char *dest;
-	unsigned int len;
+	unsigned int len, avail;
 
-	if (! buf || ! buf->items || buf->item_count == buf->max_item_count ) {
+	if (! buf || ! item || buf->item_count == buf->max_item_count ||
+	     buf->arena_len == buf->arena_size ) {
 		return 0;
 	}
 
-	if ( buf->item_count < buf->max_item_count ) {
-		dest = buf->items[buf->item_count];
-		strncpy( dest, item, buf->max_item_size );
-		buf->item_count++;
+	/* items which do not fit in the arena are truncated */
+	avail = buf->arena_size - buf->arena_len - 1;
+	len = strlen( item );
+	len = ( len > avail ) ? avail : len;
+
+	memcpy( &buf->arena[buf->arena_len], item, len );
+	buf->arena[buf->arena_len + len] = '\0';
+	add_token( buf, len, opdis_token_style_none );
+
+	return 1;
+}
+
+int LIBCALL opdis_insn_buf_vappend( opdis_insn_buf_t buf,
+				    enum opdis_token_style_t style,
+				    const char * format, va_list args ) {
+	unsigned int len, avail;
+	int rv;
+
+	if (! buf || ! format || buf->item_count == buf->max_item_count ||
+	     buf->arena_len == buf->arena_size ) {
+		return -1;
 	}
 
-	len = buf->max_string_size - strlen(buf->string) - 1;
-	strncat( buf->string, item, len );
+	avail = buf->arena_size - buf->arena_len;
+	rv = vsnprintf( &buf->arena[buf->arena_len], avail, format, args );
+	if ( rv < 0 ) {
+		return rv;
+	}
+
+	/* vsnprintf truncates items which do not fit in the arena */
+	len = ( (unsigned int) rv >= avail ) ? avail - 1 : (unsigned int) rv;
+	add_token( buf, len, style );
+	if ( style != opdis_token_style_none ) {
+		buf->styled = 1;
+	}
+
+	return rv;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Styled items */
+
+static int is_mnemonic_style( enum opdis_token_style_t style ) {
+	return ( style == opdis_token_style_mnemonic ||
+		 style == opdis_token_style_sub_mnemonic ||
+		 style == opdis_token_style_directive );
+}
+
+static int is_blank( const char * str, unsigned int len ) {
+	unsigned int i;
+
+	for ( i = 0; i < len; i++ ) {
+		if (! isspace( (unsigned char) str[i] ) ) {
+			return 0;
+		}
+	}
 
 	return 1;
 }
 
-void LIBCALL opdis_insn_buf_clear( opdis_insn_buf_t buf ) {
-	if ( buf ) {
-		buf->item_count = 0;
-		buf->string[0] = '\0';
+static void add_span( opdis_insn_layout_t * layout, opdis_insn_span_t * span,
+		      unsigned int last, unsigned int end ) {
+	span->last = last;
+	span->end = end;
+
+	if ( layout->num_operands < OPDIS_MAX_LAYOUT_OPS ) {
+		layout->operands[layout->num_operands] = *span;
+		layout->num_operands++;
 	}
 }
 
-void LIBCALL opdis_insn_buf_free( opdis_insn_buf_t buf ) {
-	if (! buf ) {
-		return;
+int LIBCALL opdis_insn_buf_layout( const opdis_insn_buf_t buf,
+				   opdis_insn_layout_t * layout ) {
+	opdis_insn_span_t span;
+	unsigned int i, j;
+	int depth = 0, in_operands = 0, have_operand = 0, gap = 0;
+
+	if (! buf || ! layout || ! buf->styled ) {
+		return 0;
+	}
+
+	layout->prefix = layout->mnemonic = layout->comment = -1;
+	layout->mnemonic_end = 0;
+	layout->num_operands = 0;
+
+	for ( i = 0; i < buf->item_count; i++ ) {
+		const opdis_insn_token_t * tok = &buf->tokens[i];
+		const char * item = OPDIS_INSN_BUF_ITEM(buf, i);
+
+		if ( tok->style == opdis_token_style_comment ) {
+			layout->comment = i;
+			break;
+		}
+
+		if (! in_operands ) {
+			if ( is_mnemonic_style( tok->style ) ) {
+				if ( layout->mnemonic == -1 ) {
+					layout->mnemonic = i;
+				} else if ( gap ) {
+					/* an earlier mnemonic was a prefix */
+					if ( layout->prefix == -1 ) {
+						layout->prefix =
+							layout->mnemonic;
+					}
+					layout->mnemonic = i;
+				}
+				layout->mnemonic_end = i + 1;
+				gap = ( tok->length &&
+					isspace( (unsigned char)
+						 item[tok->length - 1] ) );
+				continue;
+			}
+
+			if ( is_blank( item, tok->length ) ) {
+				gap = 1;
+				continue;
+			}
+
+			in_operands = 1;
+			span.first = i;
+			span.start = 0;
+		}
+
+		if ( tok->style != opdis_token_style_text &&
+		     tok->style != opdis_token_style_none ) {
+			have_operand = 1;
+			continue;
+		}
+
+		for ( j = 0; j < tok->length; j++ ) {
+			switch ( item[j] ) {
+				case '(': case '[': case '{':
+					depth++; break;
+				case ')': case ']': case '}':
+					depth--; break;
+				case ',':
+					if ( depth ) {
+						break;
+					}
+					if ( have_operand ) {
+						add_span( layout, &span, i, j );
+					}
+					have_operand = 0;
+					span.first = i;
+					span.start = j + 1;
+					break;
+				default:
+					if (! isspace( (unsigned char) item[j] ) ) {
+						have_operand = 1;
+					}
+			}
+		}
+	}
+
+	if ( have_operand ) {
+		i = ( layout->comment > -1 ) ? layout->comment : buf->item_count;
+		add_span( layout, &span, i - 1, buf->tokens[i - 1].length );
 	}
 
-	if ( buf->items ) {
-		int i;
-		for ( i = 0; i < buf->max_item_count; i++ ) {
-			if ( buf->items[i] ) {
-				free( buf->items[i] );
-				buf->items[i] = NULL;
+	return 1;
+}
+
+unsigned int LIBCALL opdis_insn_buf_span_str( const opdis_insn_buf_t buf,
+					      const opdis_insn_span_t * span,
+					      char * dest, unsigned int size ) {
+	unsigned int i, len = 0;
+
+	if (! buf || ! span || ! dest || ! size ) {
+		return 0;
+	}
+
+	for ( i = span->first; i <= span->last && i < buf->item_count; i++ ) {
+		const char * item = OPDIS_INSN_BUF_ITEM(buf, i);
+		unsigned int start = ( i == span->first ) ? span->start : 0;
+		unsigned int end = ( i == span->last ) ? span->end :
+						      buf->tokens[i].length;
+
+		for ( ; start < end && len < size - 1; start++ ) {
+			/* skip leading whitespace */
+			if ( len || ! isspace( (unsigned char) item[start] ) ) {
+				dest[len++] = item[start];
 			}
 		}
+	}
 
-		free(buf->items);
+	while ( len && isspace( (unsigned char) dest[len - 1] ) ) {
+		len--;
 	}
+	dest[len] = '\0';
+
+	return len;
+}
 
-	if ( buf->string ) {
-		free(buf->string);
+/* ---------------------------------------------------------------------- */
+
+void LIBCALL opdis_insn_buf_clear( opdis_insn_buf_t buf ) {
+	if ( buf ) {
+		buf->item_count = 0;
+		buf->arena_len = 0;
+		buf->string_len = 0;
+		buf->styled = 0;
+		buf->string[0] = '\0';
 	}
+}
 
-	free(buf);
+void LIBCALL opdis_insn_buf_free( opdis_insn_buf_t buf ) {
+	/* tokens, arena, and string are part of the same allocation as buf */
+	if ( buf ) {
+		free(buf);
+	}
 }
@@ -18,6 +18,8 @@
         #define LIBCALL
 #endif
 
+#include <stdarg.h>
+
 #include <bfd.h>
 #include <dis-asm.h>
 
@@ -33,7 +35,8 @@
 #define OPDIS_MAX_ITEMS 64		
 
 /*! \def OPDIS_MAX_ITEM_SIZE
- *  Max size of a single item.
+ *  Average size of an item. The item arena holds OPDIS_MAX_ITEMS items
+ *  of this size; a single item may be larger.
  *  \ingroup internal
  *  \sa opdis_insn_buffer_t
  */
@@ -46,22 +49,73 @@
  */
 #define OPDIS_MAX_INSN_STR 128		
 
+/*! \def OPDIS_INSN_BUF_ITEM
+ *  The nul-terminated string for item \e i of instruction buffer \e buf.
+ *  \ingroup internal
+ *  \sa opdis_insn_buffer_t
+ */
+#define OPDIS_INSN_BUF_ITEM(buf, i) (&(buf)->arena[(buf)->tokens[(i)].offset])
+
 /* ---------------------------------------------------------------------- */
+/*! \enum opdis_token_style_t
+ *  \ingroup internal
+ *  \brief The style of an item emitted by libopcodes.
+ *  \details libopcodes versions which provide \e fprintf_styled_func in
+ *           disassemble_info emit each item with a style describing what
+ *           it is. Items emitted through \e fprintf_func have no style.
+ *  \note These correspond to enum disassembler_style in dis-asm.h.
+ */
+enum opdis_token_style_t {
+	opdis_token_style_none,		/*!< No style (plain fprintf) */
+	opdis_token_style_text,		/*!< Punctuation, whitespace */
+	opdis_token_style_mnemonic,	/*!< Mnemonic or prefix */
+	opdis_token_style_sub_mnemonic,	/*!< Part of a mnemonic, e.g. cond */
+	opdis_token_style_directive,	/*!< Assembler directive */
+	opdis_token_style_register,	/*!< Register name */
+	opdis_token_style_immediate,	/*!< Immediate value */
+	opdis_token_style_address,	/*!< Absolute address */
+	opdis_token_style_address_offset, /*!< Offset from an address */
+	opdis_token_style_symbol,	/*!< Symbol name */
+	opdis_token_style_comment	/*!< Start of a comment */
+};
+
+/*! \struct opdis_insn_token_t
+ *  \ingroup internal
+ *  \brief The location of an item in the item arena.
+ *  \sa opdis_insn_buffer_t
+ */
+typedef struct {
+	unsigned int offset;			/*!< Offset of item in arena */
+	unsigned int length;			/*!< Length of item */
+	enum opdis_token_style_t style;		/*!< Style of item */
+} opdis_insn_token_t;
+
 /*! \struct opdis_insn_buffer_t
  *  \ingroup internal
  *  \ingroup types
  *  \brief A buffer that stores the output of libopcodes before processing.
  *  \details This collects the strings emitted by libopcodes during 
  *           disassembly. A 'raw' string representation of the instruction 
- *           is also constructed.
+ *           is also constructed. Items are written once, nul-terminated,
+ *           to the end of an append-only arena; \e tokens records the
+ *           offset and length of each. Use OPDIS_INSN_BUF_ITEM to get the
+ *           string for an item.
  */
 typedef struct {
 	unsigned int item_count;		/*!< Number of items */
 	unsigned int max_item_count;		/*!< Max number of items */
-	unsigned int max_item_size;		/*!< Max size of items */
-	char **items;				/*!< Array of stored items */
+	unsigned int max_item_size;		/*!< Average size of items */
+	opdis_insn_token_t *tokens;		/*!< Location of each item */
+	char *arena;				/*!< Storage for items */
+	unsigned int arena_len;			/*!< Bytes used in arena */
+	unsigned int arena_size;		/*!< Size of arena */
 	char *string;				/*!< Raw instruction string */
+	unsigned int string_len;		/*!< Length of \e string */
 	unsigned int max_string_size;		/*!< Max insn string length */
+	int styled;				/*!< Nonzero if items have styles */
+	/* requested by the disassembler for the current instruction */
+	unsigned int decode_level;		/*!< opdis_insn_decode_t to fill */
+	int decode_branch_ops;			/*!< Decode operands of branches */
 	/* instruction info from libopcodes disassemble_info struct */
 	char insn_info_valid;			/*!< Nonzero if info is set */
 	char branch_delay_insns;		/*!< Branch delay insn count */
@@ -77,6 +131,43 @@ typedef struct {
  */
 typedef opdis_insn_buffer_t * opdis_insn_buf_t;
 
+/*! \def OPDIS_MAX_LAYOUT_OPS
+ *  Max number of operands in an opdis_insn_layout_t.
+ *  \ingroup internal
+ */
+#define OPDIS_MAX_LAYOUT_OPS 8
+
+/*! \struct opdis_insn_span_t
+ *  \ingroup internal
+ *  \brief A range of text in the items of an instruction buffer.
+ *  \details The span starts at offset \e start in item \e first, and ends
+ *           before offset \e end in item \e last. An operand may start or
+ *           end inside an item, e.g. the text item ",(" which ends one
+ *           operand and starts another.
+ */
+typedef struct {
+	unsigned int first;			/*!< First item in span */
+	unsigned int start;			/*!< Offset of span in \e first */
+	unsigned int last;			/*!< Last item in span */
+	unsigned int end;			/*!< End of span in \e last */
+} opdis_insn_span_t;
+
+/*! \struct opdis_insn_layout_t
+ *  \ingroup internal
+ *  \brief The parts of an instruction in a styled instruction buffer.
+ *  \details This is determined from the styles of the items, without
+ *           examining their text beyond whitespace and punctuation.
+ *  \sa opdis_insn_buf_layout
+ */
+typedef struct {
+	int prefix;				/*!< First prefix item, or -1 */
+	int mnemonic;				/*!< First mnemonic item, or -1 */
+	int mnemonic_end;			/*!< Item after mnemonic */
+	unsigned int num_operands;		/*!< Number of operands */
+	opdis_insn_span_t operands[OPDIS_MAX_LAYOUT_OPS]; /*!< Operands */
+	int comment;				/*!< First comment item, or -1 */
+} opdis_insn_layout_t;
+
 /* ---------------------------------------------------------------------- */
 #ifdef __cplusplus
 extern "C"
@@ -89,9 +180,12 @@ extern "C"
  * \ingroup internal
  * \brief Allocate an instruction buffer
  * \details Allocates an opdis_insn_buffer_t based on the specified parameters.
- *          The buffer contents are initialized to zero.
+ *          The buffer contents are initialized to zero, except for
+ *          \e decode_level, which is OPDIS_DECODE_ALL. The buffer, its
+ *          tokens, item arena, and string are allocated in a single block.
  * \param max_items Default is \ref OPDIS_MAX_ITEMS.
- * \param max_item_size Default is \ref OPDIS_MAX_ITEM_SIZE.
+ * \param max_item_size Default is \ref OPDIS_MAX_ITEM_SIZE. The item arena
+ *        is \e max_items * \e max_item_size bytes.
  * \param max_insn_str Default is \ref OPDIS_MAX_INSN_STR.
  * \return The allocated opdis_insn_buffer_t.
  * \sa opdis_insn_buf_free
@@ -123,6 +217,60 @@ void LIBCALL opdis_insn_buf_free( opdis_insn_buf_t buf );
  */
 int LIBCALL opdis_insn_buf_append( opdis_insn_buf_t buf, const char * item );
 
+/*!
+ * \fn int opdis_insn_buf_vappend( opdis_insn_buf_t, enum opdis_token_style_t,
+ * 				     const char *, va_list )
+ * \ingroup internal
+ * \brief Format a string directly into an opdis_insn_buffer_t.
+ * \details This behaves like opdis_insn_buf_append, but the item is
+ *          formatted with vsnprintf directly into the item arena. If
+ *          \e style is not opdis_token_style_none, the buffer is marked as
+ *          \e styled.
+ * \param buf The instruction buffer to append to.
+ * \param style The style of the item.
+ * \param format The printf-style format string.
+ * \param args The arguments for \e format.
+ * \return The length of the formatted string (as returned by vsnprintf),
+ *         or -1 on failure.
+ * \sa opdis_insn_buf_append
+ */
+int LIBCALL opdis_insn_buf_vappend( opdis_insn_buf_t buf,
+				    enum opdis_token_style_t style,
+				    const char * format, va_list args );
+
+/*!
+ * \fn int opdis_insn_buf_layout( const opdis_insn_buf_t,
+ * 				  opdis_insn_layout_t * )
+ * \ingroup internal
+ * \brief Locate the prefixes, mnemonic, operands and comment of an insn.
+ * \details Items styled as mnemonics which precede the first operand are
+ *          the mnemonic; all but the last group of these, separated by
+ *          whitespace, are prefixes. Operands are separated by commas
+ *          which are not enclosed in (), [] or {}. The comment starts at
+ *          the first item styled as a comment.
+ * \param buf The instruction buffer.
+ * \param layout The layout to fill.
+ * \return 1 on success, 0 if the buffer is not \e styled.
+ */
+int LIBCALL opdis_insn_buf_layout( const opdis_insn_buf_t buf,
+				   opdis_insn_layout_t * layout );
+
+/*!
+ * \fn unsigned int opdis_insn_buf_span_str( const opdis_insn_buf_t,
+ * 				const opdis_insn_span_t *, char *, unsigned int )
+ * \ingroup internal
+ * \brief Copy the text in a span to a string.
+ * \details Leading and trailing whitespace is removed.
+ * \param buf The instruction buffer.
+ * \param span The span to copy.
+ * \param dest The string to fill.
+ * \param size The size of \e dest.
+ * \return The length of the string in \e dest.
+ */
+unsigned int LIBCALL opdis_insn_buf_span_str( const opdis_insn_buf_t buf,
+					      const opdis_insn_span_t * span,
+					      char * dest, unsigned int size );
+
 /*!
  * \fn void opdis_insn_buf_clear( opdis_insn_buf_t )
  * \ingroup internal
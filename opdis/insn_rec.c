@@ -0,0 +1,227 @@
+/*!
+ * \file insn_rec.c
+ * \brief Compact instruction records
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <opdis/insn_rec.h>
+
+#define DEFAULT_NUM_RECS 1024
+#define MAX_MNEM_ID 0xFFFF
+
+/* ---------------------------------------------------------------------- */
+/* RECORDS */
+
+static uint8_t op_index( const opdis_insn_t * insn, const opdis_op_t * op ) {
+	opdis_off_t i;
+
+	for ( i = 0; op && i < insn->num_operands && i < OPDIS_REC_MAX_OPS;
+	      i++ ) {
+		if ( insn->operands[i] == op ) {
+			return (uint8_t) i;
+		}
+	}
+
+	return OPDIS_REC_NO_OP;
+}
+
+static void fill_op_rec( opdis_op_rec_t * rec, const opdis_op_t * op ) {
+	const opdis_addr_expr_t * expr = &op->value.expr;
+
+	memset( rec, 0, sizeof(opdis_op_rec_t) );
+	rec->category = (uint8_t) op->category;
+	rec->flags = (uint8_t) op->flags;
+	rec->data_size = op->data_size;
+
+	switch ( op->category ) {
+		case opdis_op_cat_register:
+			rec->reg = op->value.reg.id;
+			break;
+		case opdis_op_cat_immediate:
+			rec->value = op->value.immediate.u;
+			break;
+		case opdis_op_cat_absolute:
+			rec->segment = op->value.abs.segment.id;
+			rec->value = op->value.abs.offset;
+			break;
+		case opdis_op_cat_expr:
+			rec->elements = (uint8_t) expr->elements;
+			rec->reg = expr->base.id;
+			rec->index = expr->index.id;
+			rec->scale = (uint8_t) expr->scale;
+			if ( expr->elements & opdis_addr_expr_disp_abs ) {
+				rec->segment = expr->displacement.a.segment.id;
+				rec->value = expr->displacement.a.offset;
+			} else {
+				rec->value = expr->displacement.u;
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+int LIBCALL opdis_insn_rec_fill( opdis_insn_rec_t * rec,
+				 const opdis_insn_t * insn,
+				 unsigned int mnemonic ) {
+	opdis_off_t i;
+
+	if (! rec || ! insn ) {
+		return 0;
+	}
+
+	memset( rec, 0, sizeof(opdis_insn_rec_t) );
+	rec->vma = insn->vma;
+	rec->offset = (uint32_t) insn->offset;
+	rec->mnemonic = (uint16_t) mnemonic;
+	rec->flags = (uint16_t) insn->flags.cflow;
+	rec->size = (uint8_t) insn->size;
+	rec->status = (uint8_t) insn->status;
+	rec->category = (uint8_t) insn->category;
+	rec->isa = (uint8_t) insn->isa;
+	rec->num_operands = (uint8_t) insn->num_operands;
+	rec->roles = op_index( insn, insn->target ) |
+		     (op_index( insn, insn->dest ) << 2) |
+		     (op_index( insn, insn->src ) << 4);
+
+	for ( i = 0; i < insn->num_operands && i < OPDIS_REC_MAX_OPS; i++ ) {
+		fill_op_rec( &rec->ops[i], insn->operands[i] );
+	}
+
+	return ( insn->num_operands <= OPDIS_REC_MAX_OPS );
+}
+
+/* ---------------------------------------------------------------------- */
+/* MNEMONIC TABLE */
+
+/* Return the id of a mnemonic, adding it if necessary. 0 means none. */
+static unsigned int mnemonic_id( opdis_insn_rec_list_t list,
+				 const char * mnem ) {
+	unsigned int id;
+
+	if (! mnem || ! mnem[0] ) {
+		return OPDIS_STRPOOL_NO_ID;
+	}
+
+	/* ids must fit in the 16-bit mnemonic field */
+	id = opdis_strpool_id( list->mnemonics, mnem );
+	if (! id && list->mnemonics->count < MAX_MNEM_ID ) {
+		id = opdis_strpool_add( list->mnemonics, mnem );
+	}
+
+	return id;
+}
+
+/* ---------------------------------------------------------------------- */
+/* RECORD LIST */
+
+opdis_insn_rec_list_t LIBCALL opdis_insn_rec_list_init( size_t num_recs ) {
+	opdis_insn_rec_list_t list = (opdis_insn_rec_list_t) calloc( 1,
+					sizeof(opdis_insn_rec_list_base_t) );
+	if (! list ) {
+		return NULL;
+	}
+
+	list->alloc = ( num_recs ) ? num_recs : DEFAULT_NUM_RECS;
+	list->recs = (opdis_insn_rec_t *) malloc( list->alloc *
+						  sizeof(opdis_insn_rec_t) );
+	list->mnemonics = opdis_strpool_init();
+	if (! list->recs || ! list->mnemonics ) {
+		opdis_insn_rec_list_free( list );
+		return NULL;
+	}
+
+	list->sorted = 1;
+
+	return list;
+}
+
+opdis_insn_rec_t * LIBCALL opdis_insn_rec_list_add( opdis_insn_rec_list_t list,
+						    const opdis_insn_t * insn ) {
+	opdis_insn_rec_t * rec;
+
+	if (! list || ! insn ) {
+		return NULL;
+	}
+
+	if ( list->count == list->alloc ) {
+		size_t alloc = list->alloc * 2;
+		rec = (opdis_insn_rec_t *) realloc( list->recs,
+					alloc * sizeof(opdis_insn_rec_t) );
+		if (! rec ) {
+			return NULL;
+		}
+		list->recs = rec;
+		list->alloc = alloc;
+	}
+
+	rec = &list->recs[list->count];
+	opdis_insn_rec_fill( rec, insn, mnemonic_id( list, insn->mnemonic ) );
+
+	if ( list->count && list->recs[list->count - 1].vma > rec->vma ) {
+		list->sorted = 0;
+	}
+	list->count++;
+
+	return rec;
+}
+
+const char * LIBCALL opdis_insn_rec_list_mnemonic( opdis_insn_rec_list_t list,
+					    const opdis_insn_rec_t * rec ) {
+	const char * mnem;
+
+	if (! list || ! rec ) {
+		return "";
+	}
+
+	mnem = opdis_strpool_str( list->mnemonics, rec->mnemonic );
+	return ( mnem ) ? mnem : "";
+}
+
+static int cmp_rec( const void * a, const void * b ) {
+	opdis_vma_t vma_a = ((const opdis_insn_rec_t *) a)->vma;
+	opdis_vma_t vma_b = ((const opdis_insn_rec_t *) b)->vma;
+
+	return ( vma_a > vma_b ) - ( vma_a < vma_b );
+}
+
+void LIBCALL opdis_insn_rec_list_sort( opdis_insn_rec_list_t list ) {
+	if (! list || list->sorted ) {
+		return;
+	}
+
+	qsort( list->recs, list->count, sizeof(opdis_insn_rec_t), cmp_rec );
+	list->sorted = 1;
+}
+
+opdis_insn_rec_t * LIBCALL opdis_insn_rec_list_find( opdis_insn_rec_list_t list,
+						     opdis_vma_t vma ) {
+	opdis_insn_rec_t key;
+
+	if (! list ) {
+		return NULL;
+	}
+
+	opdis_insn_rec_list_sort( list );
+
+	key.vma = vma;
+	return (opdis_insn_rec_t *) bsearch( &key, list->recs, list->count,
+					     sizeof(opdis_insn_rec_t),
+					     cmp_rec );
+}
+
+void LIBCALL opdis_insn_rec_list_free( opdis_insn_rec_list_t list ) {
+	if (! list ) {
+		return;
+	}
+
+	opdis_strpool_free( list->mnemonics );
+	free( list->recs );
+	free( list );
+}
@@ -0,0 +1,211 @@
+/*!
+ * \file insn_rec.h
+ * \brief Compact instruction records
+ * \details An opdis_insn_rec_t is a fixed-size, pointer-free summary of an
+ *          opdis_insn_t: addresses, size, category and flags, and up to
+ *          \ref OPDIS_REC_MAX_OPS operand descriptors. Mnemonics are stored
+ *          once per record list, in an opdis_strpool_t, and referred to by
+ *          their id in the pool. Records are kept
+ *          contiguously in an opdis_insn_rec_list_t, so that the result of
+ *          disassembling an entire binary can be held and scanned without
+ *          following pointers.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#ifndef OPDIS_INSN_REC_H
+#define OPDIS_INSN_REC_H
+
+#include <stddef.h>
+
+#include <opdis/model.h>
+#include <opdis/strpool.h>
+
+#ifdef WIN32
+        #define LIBCALL _stdcall
+#else
+        #define LIBCALL
+#endif
+
+/*! \def OPDIS_REC_MAX_OPS
+ *  \ingroup model
+ *  \brief Number of operand descriptors stored in a record.
+ */
+#define OPDIS_REC_MAX_OPS 3
+
+/*! \def OPDIS_REC_NO_OP
+ *  \ingroup model
+ *  \brief Operand index used in \e roles for an absent target, dest or src.
+ */
+#define OPDIS_REC_NO_OP 3
+
+/*! \def OPDIS_REC_TARGET
+ *  \ingroup model
+ *  \brief Index of the branch target operand of a record.
+ */
+#define OPDIS_REC_TARGET(r) ((r)->roles & 3)
+
+/*! \def OPDIS_REC_DEST
+ *  \ingroup model
+ *  \brief Index of the destination operand of a record.
+ */
+#define OPDIS_REC_DEST(r) (((r)->roles >> 2) & 3)
+
+/*! \def OPDIS_REC_SRC
+ *  \ingroup model
+ *  \brief Index of the source operand of a record.
+ */
+#define OPDIS_REC_SRC(r) (((r)->roles >> 4) & 3)
+
+/*! \struct opdis_op_rec_t
+ *  \ingroup model
+ *  \brief Operand descriptor in an instruction record.
+ *  \details Registers are stored by their opdis_reg_t \e id.
+ */
+typedef struct {
+	uint64_t value;		/*!< Immediate, displacement, or offset */
+	uint8_t category;	/*!< opdis_op_cat_t */
+	uint8_t flags;		/*!< opdis_op_flag_t */
+	uint8_t data_size;	/*!< Size of operand datatype */
+	uint8_t reg;		/*!< Register, or base register of expr */
+	uint8_t index;		/*!< Index register of expr */
+	uint8_t scale;		/*!< Scale of expr */
+	uint8_t segment;	/*!< Segment register of expr or abs addr */
+	uint8_t elements;	/*!< opdis_addr_expr_elem_t of expr */
+} opdis_op_rec_t;
+
+/*! \struct opdis_insn_rec_t
+ *  \ingroup model
+ *  \brief Compact instruction record.
+ *  \note \e num_operands is the number of operands in the instruction; only
+ *        the first \ref OPDIS_REC_MAX_OPS are stored in \e ops.
+ *  \note \e offset is the offset of the instruction in its buffer,
+ *        truncated to 32 bits.
+ */
+typedef struct {
+	opdis_vma_t vma;	/*!< Virtual memory address of insn */
+	uint32_t offset;	/*!< Offset of instruction in buffer */
+	uint16_t mnemonic;	/*!< Mnemonic id in the record list */
+	uint16_t flags;		/*!< Instruction-specific flags */
+	uint8_t size;		/*!< Size (# bytes) of insn */
+	uint8_t status;		/*!< opdis_insn_decode_t */
+	uint8_t category;	/*!< opdis_insn_cat_t */
+	uint8_t isa;		/*!< opdis_insn_subset_t */
+	uint8_t num_operands;	/*!< Number of operands in insn */
+	uint8_t roles;		/*!< Indexes of target, dest and src ops */
+	opdis_op_rec_t ops[OPDIS_REC_MAX_OPS];	/*!< Operand descriptors */
+} opdis_insn_rec_t;
+
+/*! \struct opdis_insn_rec_list_base_t
+ *  \ingroup model
+ *  \brief A contiguous array of instruction records.
+ *  \details \e recs may be read directly; it is reallocated as records
+ *           are added.
+ */
+typedef struct {
+	opdis_insn_rec_t * recs;	/*!< Records */
+	size_t count;			/*!< Number of records */
+	size_t alloc;			/*!< Number of allocated records */
+	int sorted;			/*!< Records are sorted by vma */
+	opdis_strpool_t mnemonics;	/*!< Mnemonics by id */
+} opdis_insn_rec_list_base_t;
+
+/*! \typedef opdis_insn_rec_list_base_t * opdis_insn_rec_list_t
+ *  \ingroup model
+ *  \brief Pointer to an instruction record list.
+ */
+typedef opdis_insn_rec_list_base_t * opdis_insn_rec_list_t;
+
+/* ---------------------------------------------------------------------- */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*!
+ * \fn int opdis_insn_rec_fill( opdis_insn_rec_t *, const opdis_insn_t *,
+ * 			       unsigned int )
+ * \ingroup model
+ * \brief Fill an instruction record from an instruction.
+ * \param rec The record to fill.
+ * \param insn The instruction.
+ * \param mnemonic The mnemonic id to store in the record.
+ * \return 1 if all operands were stored, 0 if the instruction has more
+ *         than \ref OPDIS_REC_MAX_OPS operands.
+ */
+int LIBCALL opdis_insn_rec_fill( opdis_insn_rec_t * rec,
+				 const opdis_insn_t * insn,
+				 unsigned int mnemonic );
+
+/*!
+ * \fn opdis_insn_rec_list_t opdis_insn_rec_list_init( size_t )
+ * \ingroup model
+ * \brief Allocate an empty instruction record list.
+ * \param num_recs The number of records to allocate space for, or 0.
+ * \return The allocated list.
+ * \sa opdis_insn_rec_list_free
+ */
+opdis_insn_rec_list_t LIBCALL opdis_insn_rec_list_init( size_t num_recs );
+
+/*!
+ * \fn opdis_insn_rec_t * opdis_insn_rec_list_add( opdis_insn_rec_list_t,
+ * 						   const opdis_insn_t * )
+ * \ingroup model
+ * \brief Append a record for an instruction to the list.
+ * \param list The record list.
+ * \param insn The instruction.
+ * \return The record, or NULL if memory could not be allocated.
+ * \note The returned pointer is only valid until the next record is added.
+ */
+opdis_insn_rec_t * LIBCALL opdis_insn_rec_list_add( opdis_insn_rec_list_t list,
+						    const opdis_insn_t * insn );
+
+/*!
+ * \fn const char * opdis_insn_rec_list_mnemonic( opdis_insn_rec_list_t,
+ * 						  const opdis_insn_rec_t * )
+ * \ingroup model
+ * \brief Return the mnemonic of a record.
+ * \param list The record list containing \e rec.
+ * \param rec The record.
+ * \return The mnemonic, or an empty string if the instruction had none.
+ */
+const char * LIBCALL opdis_insn_rec_list_mnemonic( opdis_insn_rec_list_t list,
+					    const opdis_insn_rec_t * rec );
+
+/*!
+ * \fn void opdis_insn_rec_list_sort( opdis_insn_rec_list_t )
+ * \ingroup model
+ * \brief Sort the records in a list by address.
+ * \param list The record list.
+ */
+void LIBCALL opdis_insn_rec_list_sort( opdis_insn_rec_list_t list );
+
+/*!
+ * \fn opdis_insn_rec_t * opdis_insn_rec_list_find( opdis_insn_rec_list_t,
+ * 						    opdis_vma_t )
+ * \ingroup model
+ * \brief Find the record for an address.
+ * \param list The record list.
+ * \param vma The address of the instruction.
+ * \return The record, or NULL if there is no record for \e vma.
+ * \note The list is sorted first if necessary.
+ */
+opdis_insn_rec_t * LIBCALL opdis_insn_rec_list_find( opdis_insn_rec_list_t list,
+						     opdis_vma_t vma );
+
+/*!
+ * \fn void opdis_insn_rec_list_free( opdis_insn_rec_list_t )
+ * \ingroup model
+ * \brief Free an instruction record list.
+ * \param list The record list to free.
+ * \sa opdis_insn_rec_list_init
+ */
+void LIBCALL opdis_insn_rec_list_free( opdis_insn_rec_list_t list );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -12,6 +12,19 @@
 
 #include <opdis/model.h>
 
+#define OPS_ARE_INLINE(insn) ((insn)->operands == (insn)->inline_ops)
+
+/* return zeroed storage for num operand pointers: inline if it fits */
+static opdis_op_t ** alloc_op_array( opdis_insn_t * insn,
+				     opdis_off_t num ) {
+	if ( num <= OPDIS_INSN_INLINE_OPS ) {
+		memset( insn->inline_ops, 0, sizeof(insn->inline_ops) );
+		return insn->inline_ops;
+	}
+
+	return (opdis_op_t **) calloc( num, sizeof(opdis_op_t *) );
+}
+
 opdis_insn_t * LIBCALL opdis_insn_alloc( opdis_off_t num_operands ) {
 	opdis_insn_t * i = (opdis_insn_t *) calloc( 1, sizeof(opdis_insn_t) );
 	if (! i ) {
@@ -23,8 +36,7 @@ opdis_insn_t * LIBCALL opdis_insn_alloc( opdis_off_t num_operands ) {
 	}
 
 	/* operands is an array of opdis_t pointers */
-	i->operands = (opdis_op_t **) calloc( num_operands, 
-					     sizeof(opdis_op_t *) );
+	i->operands = alloc_op_array( i, num_operands );
 	if (! i->operands ) {
 		free(i);
 		return NULL;
@@ -37,14 +49,60 @@ opdis_insn_t * LIBCALL opdis_insn_alloc( opdis_off_t num_operands ) {
 
 #define PREFIX_SIZE(mnem_size) (4 * mnem_size)
 
-opdis_insn_t * LIBCALL opdis_insn_alloc_fixed( size_t ascii_sz, 
-				size_t mnemonic_sz, size_t num_operands,
-				size_t op_ascii_sz ) {
+/* release everything owned by insn, but not insn itself */
+static void insn_fini( opdis_insn_t * insn ) {
+	int i; 
+
+	/* packed operands only own strings set after they were packed */
+	for ( i = 0; i < insn->alloc_operands; i++ ) {
+		opdis_op_t * op = insn->operands[i];
+		if ( op ) {
+			opdis_op_free( op );
+		}
+	}
+
+	if ( insn->packed ) {
+		/* every other field is part of the insn allocation */
+		return;
+	}
+
+	if ( insn->bytes ) {
+		free( (void *) insn->bytes);
+	}
+
+	if ( insn->ascii ) {
+		free( (void *) insn->ascii);
+	}
+
+	if ( insn->mnemonic ) {
+		free( (void *) insn->mnemonic);
+	}
+
+	if ( insn->prefixes ) {
+		free( (void *) insn->prefixes);
+	}
+
+	if ( insn->comment ) {
+		free( (void *) insn->comment);
+	}
+
+	if ( insn->operands && ! OPS_ARE_INLINE(insn) ) {
+		free( (void *) insn->operands);
+	}
+}
+
+/* fill a zeroed insn with fixed-size fields and operands */
+static int insn_init_fixed( opdis_insn_t * insn, size_t ascii_sz, 
+			    size_t mnemonic_sz, size_t num_operands,
+			    size_t op_ascii_sz ) {
 	int i;
 
-	opdis_insn_t * insn = opdis_insn_alloc( num_operands );
-	if (! insn ) {
-		return NULL;
+	if ( num_operands ) {
+		insn->operands = alloc_op_array( insn, num_operands );
+		if (! insn->operands ) {
+			return 0;
+		}
+		insn->alloc_operands = num_operands;
 	}
 
 	insn->bytes = calloc( 1, 128 );	/* plenty */
@@ -55,8 +113,7 @@ opdis_insn_t * LIBCALL opdis_insn_alloc_fixed( size_t ascii_sz,
 
 	if (! insn->ascii || ! insn->prefixes || ! insn->mnemonic ||
 	    ! insn->prefixes || ! insn->comment || ! insn->bytes ) {
-		opdis_insn_free( insn );
-		return NULL;
+		return 0;
 	}
 
 	for ( i = 0; i < num_operands; i++ ) {
@@ -64,8 +121,7 @@ opdis_insn_t * LIBCALL opdis_insn_alloc_fixed( size_t ascii_sz,
 		if ( op ) {
 			insn->operands[i] = op;
 		} else {
-			opdis_insn_free( insn );
-			return NULL;
+			return 0;
 		}
 	}
 
@@ -73,9 +129,68 @@ opdis_insn_t * LIBCALL opdis_insn_alloc_fixed( size_t ascii_sz,
 	insn->ascii_sz = ascii_sz;
 	insn->mnemonic_sz = mnemonic_sz;
 
+	return 1;
+}
+
+opdis_insn_t * LIBCALL opdis_insn_alloc_fixed( size_t ascii_sz, 
+				size_t mnemonic_sz, size_t num_operands,
+				size_t op_ascii_sz ) {
+	opdis_insn_t * insn = (opdis_insn_t *) calloc( 1, 
+						       sizeof(opdis_insn_t) );
+	if (! insn ) {
+		return NULL;
+	}
+
+	if (! insn_init_fixed( insn, ascii_sz, mnemonic_sz, num_operands,
+			       op_ascii_sz ) ) {
+		opdis_insn_free( insn );
+		return NULL;
+	}
+
 	return insn;
 }
 
+opdis_insn_t * LIBCALL opdis_insn_array_alloc_fixed( size_t count,
+				size_t ascii_sz, size_t mnemonic_sz,
+				size_t num_operands, size_t op_ascii_sz ) {
+	size_t i;
+	opdis_insn_t * insns;
+
+	if (! count ) {
+		return NULL;
+	}
+
+	insns = (opdis_insn_t *) calloc( count, sizeof(opdis_insn_t) );
+	if (! insns ) {
+		return NULL;
+	}
+
+	for ( i = 0; i < count; i++ ) {
+		if (! insn_init_fixed( &insns[i], ascii_sz, mnemonic_sz,
+				       num_operands, op_ascii_sz ) ) {
+			/* insns[i] is partially initialized */
+			opdis_insn_array_free( insns, i + 1 );
+			return NULL;
+		}
+	}
+
+	return insns;
+}
+
+void LIBCALL opdis_insn_array_free( opdis_insn_t * insns, size_t count ) {
+	size_t i;
+
+	if (! insns ) {
+		return;
+	}
+
+	for ( i = 0; i < count; i++ ) {
+		insn_fini( &insns[i] );
+	}
+
+	free( insns );
+}
+
 static unsigned int idx_for_op( const opdis_insn_t * insn, 
 				const opdis_op_t * op ) {
 	int i;
@@ -88,7 +203,8 @@ static unsigned int idx_for_op( const opdis_insn_t * insn,
 	return 0;
 }
 
-opdis_insn_t * LIBCALL opdis_insn_dupe( const opdis_insn_t * insn ) {
+/* duplicate insn with a separate allocation for every field */
+static opdis_insn_t * insn_heap_dupe( const opdis_insn_t * insn ) {
 	int i;
 	opdis_op_t ** new_operands = NULL;
 
@@ -99,13 +215,17 @@ opdis_insn_t * LIBCALL opdis_insn_dupe( const opdis_insn_t * insn ) {
 
 	new_operands = new_insn->operands;
 	memcpy( new_insn, insn, sizeof(opdis_insn_t) );
+	memset( new_insn->inline_ops, 0, sizeof(new_insn->inline_ops) );
 
 	new_insn->bytes = NULL;
 	new_insn->ascii = NULL;
 	new_insn->mnemonic = NULL;
 	new_insn->prefixes = NULL;
+	new_insn->comment = NULL;
 	new_insn->operands = new_operands;
+	new_insn->alloc_operands = insn->num_operands;
 	new_insn->fixed_size = new_insn->ascii_sz = new_insn->mnemonic_sz = 0;
+	new_insn->packed = 0;
 
 	new_insn->bytes = calloc( 1, insn->size );
 	if (! new_insn->bytes ) {
@@ -176,67 +296,296 @@ opdis_insn_t * LIBCALL opdis_insn_dupe( const opdis_insn_t * insn ) {
 	return new_insn;
 }
 
-void LIBCALL opdis_insn_clear( opdis_insn_t * insn ) {
-	int i;
-	if ( insn ) {
-		insn->status = opdis_decode_invalid;
-		insn->category = opdis_insn_cat_unknown;
-		insn->flags.cflow = 0;
-		if (insn->ascii) insn->ascii[0] = '\0';
-		insn->num_prefixes = 0;
-		if (insn->prefixes) insn->prefixes[0] = '\0';
-		if (insn->mnemonic) insn->mnemonic[0] = '\0';
-		if (insn->comment) insn->comment[0] = '\0';
-		for ( i = 0; i < insn->num_operands; i++ ) {
-			opdis_op_clear( insn->operands[i] );
-		}
-		insn->num_operands = 0;
-		insn->target = insn->dest = insn->src = NULL;
+/* move the fields of a packed insn to separate allocations */
+static int insn_unpack( opdis_insn_t * insn ) {
+	opdis_insn_t * heap;
+
+	if (! insn->packed ) {
+		return 1;
+	}
+
+	heap = insn_heap_dupe( insn );
+	if (! heap ) {
+		return 0;
 	}
+
+	/* insn is still the start of its block; the rest goes unused */
+	insn_fini( insn );
+	memcpy( insn, heap, sizeof(opdis_insn_t) );
+	if ( OPS_ARE_INLINE(heap) ) {
+		insn->operands = insn->inline_ops;
+	}
+	free( heap );
+
+	return 1;
 }
 
-void LIBCALL opdis_insn_free( opdis_insn_t * insn ) {
-	int i; 
-	if (! insn ) {
-		return;
+#define PACKED_STR_SIZE(str) ( (str) ? strlen(str) + 1 : 0 )
+
+/* copy a string to the next free byte of a packed insn */
+static char * pack_str( unsigned char ** pos, const char * str ) {
+	char * s = (char *) *pos;
+	size_t len = strlen( str ) + 1;
+
+	memcpy( s, str, len );
+	*pos += len;
+
+	return s;
+}
+
+opdis_insn_t * LIBCALL opdis_insn_dupe( const opdis_insn_t * insn ) {
+	opdis_insn_t * new_insn;
+	opdis_op_t * new_ops;
+	unsigned char * pos;
+	opdis_off_t i, array_ops;
+	size_t size;
+
+	/* layout: insn, operand array (if not inline), operands, bytes,
+	 * strings */
+	array_ops = ( insn->num_operands > OPDIS_INSN_INLINE_OPS ) ?
+		    insn->num_operands : 0;
+	size = sizeof(opdis_insn_t) + array_ops * sizeof(opdis_op_t *) +
+	       insn->num_operands * sizeof(opdis_op_t) +
+	       insn->size + PACKED_STR_SIZE(insn->ascii) +
+	       PACKED_STR_SIZE(insn->prefixes) +
+	       PACKED_STR_SIZE(insn->mnemonic) +
+	       PACKED_STR_SIZE(insn->comment);
+	for ( i = 0; i < insn->num_operands; i++ ) {
+		size += PACKED_STR_SIZE(insn->operands[i]->ascii);
 	}
 
+	new_insn = (opdis_insn_t *) calloc( 1, size );
+	if (! new_insn ) {
+		return NULL;
+	}
+
+	memcpy( new_insn, insn, sizeof(opdis_insn_t) );
+	memset( new_insn->inline_ops, 0, sizeof(new_insn->inline_ops) );
+	new_insn->fixed_size = new_insn->ascii_sz = new_insn->mnemonic_sz = 0;
+	new_insn->packed = 1;
+	new_insn->ascii = new_insn->prefixes = NULL;
+	new_insn->mnemonic = new_insn->comment = NULL;
+	new_insn->target = new_insn->dest = new_insn->src = NULL;
+	new_insn->alloc_operands = insn->num_operands;
+
+	new_insn->operands = NULL;
+	if ( array_ops ) {
+		new_insn->operands = (opdis_op_t **) (new_insn + 1);
+	} else if ( insn->num_operands ) {
+		new_insn->operands = new_insn->inline_ops;
+	}
+	new_ops = (opdis_op_t *) ((opdis_op_t **) (new_insn + 1) + array_ops);
+	pos = (unsigned char *) (new_ops + insn->num_operands);
+
+	new_insn->bytes = pos;
 	if ( insn->bytes ) {
-		free( (void *) insn->bytes);
+		memcpy( new_insn->bytes, insn->bytes, insn->size );
 	}
+	pos += insn->size;
 
 	if ( insn->ascii ) {
-		free( (void *) insn->ascii);
+		new_insn->ascii = pack_str( &pos, insn->ascii );
+	}
+	if ( insn->prefixes ) {
+		new_insn->prefixes = pack_str( &pos, insn->prefixes );
 	}
-
 	if ( insn->mnemonic ) {
-		free( (void *) insn->mnemonic);
+		new_insn->mnemonic = pack_str( &pos, insn->mnemonic );
+	}
+	if ( insn->comment ) {
+		new_insn->comment = pack_str( &pos, insn->comment );
 	}
 
-	if ( insn->prefixes ) {
-		free( (void *) insn->prefixes);
+	for ( i = 0; i < insn->num_operands; i++ ) {
+		const opdis_op_t * op = insn->operands[i];
+		opdis_op_t * new_op = &new_ops[i];
+
+		memcpy( new_op, op, sizeof(opdis_op_t) );
+		new_op->fixed_size = new_op->ascii_sz = 0;
+		new_op->packed = new_op->ascii_shared = 1;
+		new_op->ascii = NULL;
+		if ( op->ascii ) {
+			new_op->ascii = pack_str( &pos, op->ascii );
+		}
+
+		new_insn->operands[i] = new_op;
 	}
 
-	if ( insn->comment ) {
-		free( (void *) insn->comment);
+	if ( insn->target ) {
+		new_insn->target = new_insn->operands[idx_for_op(insn, 
+						      insn->target)    ];
+	}
+	if ( insn->dest ) {
+		new_insn->dest = new_insn->operands[idx_for_op(insn, 
+						    insn->dest)    ];
+	}
+	if ( insn->src ) {
+		new_insn->src = new_insn->operands[idx_for_op(insn, 
+						   insn->src)      ];
 	}
 
-	for ( i = 0; i < insn->alloc_operands; i++ ) {
-		opdis_op_t * op = insn->operands[i];
-		if ( op ) {
+	return new_insn;
+}
+
+/* copy a string into a fixed-size or dynamically-allocated field */
+static int copy_field( char ** dest, const char * src, int fixed_size,
+		       size_t size ) {
+	if ( fixed_size ) {
+		if ( size ) {
+			strncpy( *dest, src, size - 1 );
+			(*dest)[size - 1] = '\0';
+		}
+		return 1;
+	}
+
+	if ( *dest ) {
+		free( *dest );
+	}
+
+	*dest = strdup( src );
+	return (*dest != NULL);
+}
+
+static int op_copy( opdis_op_t * dest, const opdis_op_t * src ) {
+	dest->category = src->category;
+	dest->flags = src->flags;
+	memcpy( &dest->value, &src->value, sizeof(dest->value) );
+	dest->data_size = src->data_size;
+
+	if (! src->ascii ) {
+		if ( dest->ascii ) dest->ascii[0] = '\0';
+		return 1;
+	}
+
+	return copy_field( &dest->ascii, src->ascii, dest->fixed_size,
+			   dest->ascii_sz );
+}
+
+int LIBCALL opdis_insn_copy( opdis_insn_t * dest, const opdis_insn_t * src ) {
+	int i;
+
+	if (! dest || ! src ) {
+		return 0;
+	}
+
+	if (! insn_unpack( dest ) ) {
+		return 0;
+	}
+
+	opdis_insn_clear( dest );
+
+	dest->status = src->status;
+	dest->offset = src->offset;
+	dest->vma = src->vma;
+	dest->category = src->category;
+	dest->isa = src->isa;
+	dest->flags = src->flags;
+
+	if ( dest->fixed_size ) {
+		/* fixed-size insns have a 128-byte bytes field */
+		memcpy( dest->bytes, src->bytes,
+			(src->size < 128) ? src->size : 128 );
+	} else {
+		void * ptr = realloc( dest->bytes, src->size );
+		if ( src->size && ! ptr ) {
+			return 0;
+		}
+		dest->bytes = ptr;
+		memcpy( dest->bytes, src->bytes, src->size );
+	}
+	dest->size = src->size;
+
+	if ( src->ascii && ! copy_field( &dest->ascii, src->ascii,
+					 dest->fixed_size, dest->ascii_sz ) ) {
+		return 0;
+	}
+
+	if ( src->mnemonic && ! copy_field( &dest->mnemonic, src->mnemonic,
+				dest->fixed_size, dest->mnemonic_sz ) ) {
+		return 0;
+	}
+
+	if ( src->prefixes && ! copy_field( &dest->prefixes, src->prefixes,
+				dest->fixed_size,
+				PREFIX_SIZE(dest->mnemonic_sz) ) ) {
+		return 0;
+	}
+	dest->num_prefixes = src->num_prefixes;
+
+	if ( src->comment && ! copy_field( &dest->comment, src->comment,
+				dest->fixed_size, dest->ascii_sz ) ) {
+		return 0;
+	}
+
+	for ( i = 0; i < src->num_operands; i++ ) {
+		opdis_op_t * op;
+
+		/* reuse operands allocated by a previous decode */
+		if ( dest->num_operands < dest->alloc_operands &&
+		     dest->operands[dest->num_operands] ) {
+			op = opdis_insn_next_avail_op( dest );
+			if (! op_copy( op, src->operands[i] ) ) {
+				return 0;
+			}
+			continue;
+		}
+
+		op = opdis_op_dupe( src->operands[i] );
+		if (! op || ! opdis_insn_add_operand( dest, op ) ) {
 			opdis_op_free( op );
+			return 0;
 		}
 	}
 
-	if ( insn->operands ) {
-		free( (void *) insn->operands);
+	if ( src->target ) {
+		dest->target = dest->operands[idx_for_op(src, src->target)];
+	}
+	if ( src->dest ) {
+		dest->dest = dest->operands[idx_for_op(src, src->dest)];
+	}
+	if ( src->src ) {
+		dest->src = dest->operands[idx_for_op(src, src->src)];
+	}
+
+	return 1;
+}
+
+void LIBCALL opdis_insn_clear( opdis_insn_t * insn ) {
+	int i;
+	if ( insn ) {
+		insn->status = opdis_decode_invalid;
+		insn->category = opdis_insn_cat_unknown;
+		insn->flags.cflow = 0;
+		insn->num_prefixes = 0;
+		if ( insn->packed ) {
+			/* packed strings may be shared: do not modify them */
+			insn->ascii = insn->prefixes = NULL;
+			insn->mnemonic = insn->comment = NULL;
+		} else {
+			if (insn->ascii) insn->ascii[0] = '\0';
+			if (insn->prefixes) insn->prefixes[0] = '\0';
+			if (insn->mnemonic) insn->mnemonic[0] = '\0';
+			if (insn->comment) insn->comment[0] = '\0';
+		}
+		for ( i = 0; i < insn->num_operands; i++ ) {
+			opdis_op_clear( insn->operands[i] );
+		}
+		insn->num_operands = 0;
+		insn->target = insn->dest = insn->src = NULL;
+	}
+}
+
+void LIBCALL opdis_insn_free( opdis_insn_t * insn ) {
+	if (! insn ) {
+		return;
 	}
 
+	insn_fini( insn );
 	free(insn);
 }
 
 void LIBCALL opdis_insn_set_ascii( opdis_insn_t * i, const char * ascii ) {
-	if (! i || ! ascii ) {
+	if (! i || ! ascii || ! insn_unpack( i ) ) {
 		return;
 	}
 
@@ -253,7 +602,7 @@ void LIBCALL opdis_insn_set_ascii( opdis_insn_t * i, const char * ascii ) {
 }
 
 void LIBCALL opdis_insn_set_mnemonic( opdis_insn_t * i, const char * mnemonic ){
-	if (! i || ! mnemonic ) {
+	if (! i || ! mnemonic || ! insn_unpack( i ) ) {
 		return;
 	}
 
@@ -270,7 +619,7 @@ void LIBCALL opdis_insn_set_mnemonic( opdis_insn_t * i, const char * mnemonic ){
 }
 
 void LIBCALL opdis_insn_add_prefix( opdis_insn_t * i, const char * prefix ){
-	if (! i || ! prefix ) {
+	if (! i || ! prefix || ! insn_unpack( i ) ) {
 		return;
 	}
 
@@ -306,13 +655,15 @@ void LIBCALL opdis_insn_add_prefix( opdis_insn_t * i, const char * prefix ){
 }
 
 void LIBCALL opdis_insn_add_comment( opdis_insn_t * i, const char * cmt ){
-	if (! i || ! cmt ) {
+	if (! i || ! cmt || ! insn_unpack( i ) ) {
 		return;
 	}
 
 	if ( i->fixed_size ) {
 		unsigned int size = i->ascii_sz - strlen(i->comment);
-		strncat( i->comment, " ", size - 1 );
+		if ( i->comment[0] ) {
+			strncat( i->comment, " ", size - 1 );
+		}
 		strncat( i->comment, cmt, size - 2 );
 		return;
 	}
@@ -339,7 +690,7 @@ void LIBCALL opdis_insn_add_comment( opdis_insn_t * i, const char * cmt ){
 int LIBCALL opdis_insn_add_operand( opdis_insn_t * i, opdis_op_t * op ) {
 	void * p;
 
-	if (! i || ! op ) {
+	if (! i || ! op || ! insn_unpack( i ) ) {
 		return 0;
 	}
 
@@ -350,7 +701,19 @@ int LIBCALL opdis_insn_add_operand( opdis_insn_t * i, opdis_op_t * op ) {
 	}
 
 	i->alloc_operands++;
-	p = realloc( i->operands, sizeof(opdis_op_t *) * i->alloc_operands ); 
+	if ( i->alloc_operands <= OPDIS_INSN_INLINE_OPS &&
+	     (! i->operands || OPS_ARE_INLINE(i)) ) {
+		p = i->inline_ops;
+	} else if ( OPS_ARE_INLINE(i) ) {
+		/* spill inline operands to the heap */
+		p = malloc( sizeof(opdis_op_t *) * i->alloc_operands );
+		if ( p ) {
+			memcpy( p, i->inline_ops, sizeof(i->inline_ops) );
+		}
+	} else {
+		p = realloc( i->operands,
+			     sizeof(opdis_op_t *) * i->alloc_operands ); 
+	}
 	if (! p ) {
 		i->alloc_operands--;
 		return 0;
@@ -433,6 +796,7 @@ opdis_op_t * LIBCALL opdis_op_dupe(  opdis_op_t * op ) {
 
 	memcpy( new_op, op, sizeof(opdis_op_t) );
 	new_op->fixed_size = new_op->ascii_sz = 0;
+	new_op->packed = new_op->ascii_shared = 0;
 	new_op->ascii = NULL;
 
 	if ( op->ascii ) {
@@ -448,7 +812,11 @@ opdis_op_t * LIBCALL opdis_op_dupe(  opdis_op_t * op ) {
 
 void LIBCALL opdis_op_clear( opdis_op_t * op ) {
 	if ( op ) {
-		if (op->ascii) op->ascii[0] = '\0';
+		if ( op->ascii_shared ) {
+			op->ascii = NULL;
+		} else if (op->ascii) {
+			op->ascii[0] = '\0';
+		}
 		op->category = opdis_op_cat_unknown;
 		op->flags = opdis_op_flag_none;
 		memset( &op->value, 0, sizeof(op->value) );
@@ -460,11 +828,13 @@ void LIBCALL opdis_op_free( opdis_op_t * op ) {
 		return;
 	}
 
-	if ( op->ascii ) {
+	if ( op->ascii && ! op->ascii_shared ) {
 		free((void *) op->ascii);
 	}
 
-	free ((void *)op);
+	if (! op->packed ) {
+		free ((void *)op);
+	}
 }
 
 void LIBCALL opdis_op_set_ascii( opdis_op_t * op, const char * ascii ) {
@@ -477,11 +847,12 @@ void LIBCALL opdis_op_set_ascii( opdis_op_t * op, const char * ascii ) {
 		return;
 	}
 
-	if ( op->ascii ) {
+	if ( op->ascii && ! op->ascii_shared ) {
 		free((void *) op->ascii);
 	}
 
 	op->ascii = strdup(ascii);
+	op->ascii_shared = 0;
 }
 
 int LIBCALL opdis_insn_isa_str( const opdis_insn_t * insn, char * buf, 
@@ -34,6 +34,14 @@ enum opdis_insn_decode_t {
 	opdis_decode_op_flags = 16	/*!< operand category, flags decoded */
 };
 
+/*! \def OPDIS_DECODE_ALL
+ *  \ingroup model
+ *  \brief Decode level which fills every field of an instruction.
+ */
+#define OPDIS_DECODE_ALL (opdis_decode_basic | opdis_decode_mnem | \
+			  opdis_decode_ops | opdis_decode_mnem_flags | \
+			  opdis_decode_op_flags)
+
 /* ---------------------------------------------------------------------- */
 /* OPERAND */
 
@@ -138,6 +146,10 @@ typedef struct {
  * \ingroup model
  * \brief Operand object
  * \details  An instruction operand (i.e. an argument to a CPU opcode).
+ * \note Operands of an instruction created by opdis_insn_dupe are
+ *       \e packed into the instruction allocation, and their \e ascii is
+ *       shared with it. opdis_op_set_ascii gives such an operand its own
+ *       copy of the string; opdis_op_free releases only that copy.
  * \sa opdis_insn_t
  */
 
@@ -160,11 +172,21 @@ typedef struct {
 	/* fixed-size operand fields */
 	unsigned char fixed_size;	/*!< Is op of a fixed size? 0 or 1 */
 	unsigned char ascii_sz;		/*!< Size of fixed ascii field */
+
+	/* packed operand fields */
+	unsigned char packed;		/*!< Is op part of an insn allocation? */
+	unsigned char ascii_shared;	/*!< Is ascii owned by another object? */
 } opdis_op_t;
 
 /* ---------------------------------------------------------------------- */
 /* INSTRUCTION */
 
+/*! \def OPDIS_INSN_INLINE_OPS
+ *  \ingroup model
+ *  \brief Number of operand pointers stored inside an opdis_insn_t.
+ */
+#define OPDIS_INSN_INLINE_OPS 3
+
 /*!
  * \struct opdis_insn_t 
  * \ingroup model
@@ -183,6 +205,15 @@ typedef struct {
  *       opdis_insn_alloc_fixed, \e num_operands will contain the number of
  *       operands in the instruction, and \e alloc_operands will contain the
  *       number of fixed_size operands that have been allocated.
+ * \note Instructions created by opdis_insn_dupe are \e packed: the
+ *       instruction, its operands, bytes and strings share one allocation.
+ *       Routines that change a packed instruction first move its fields to
+ *       separate allocations. opdis_insn_clear resets the string fields of
+ *       a packed instruction to NULL rather than emptying them.
+ * \note While \e alloc_operands is at most \ref OPDIS_INSN_INLINE_OPS,
+ *       \e operands points to \e inline_ops inside the instruction. An
+ *       opdis_insn_t must therefore be copied with opdis_insn_copy or
+ *       opdis_insn_dupe, not with memcpy or assignment.
  * \sa opdis_op_t
  */
 typedef struct {
@@ -215,6 +246,8 @@ typedef struct {
 	opdis_off_t num_operands;	/*!< Number of operands in insn */
 	opdis_off_t alloc_operands;	/*!< Number of allocated operands */
 	opdis_op_t ** operands;		/*!< Array of operand objects */
+	/*! Storage for \e operands when there are few operands */
+	opdis_op_t * inline_ops[OPDIS_INSN_INLINE_OPS];
 
 	/* accessors for special operands */
 	opdis_op_t * target;		/*!< Branch target */
@@ -225,6 +258,7 @@ typedef struct {
 	unsigned char fixed_size;	/*!< Is insn of a fixed size? 0 or 1 */
 	unsigned char ascii_sz;		/*!< Size of fixed ascii field */
 	unsigned char mnemonic_sz;	/*!< Size of fixed mnemonic field */
+	unsigned char packed;		/*!< Is insn a single allocation? */
 
 } opdis_insn_t;
 
@@ -271,6 +305,38 @@ opdis_insn_t * LIBCALL opdis_insn_alloc_fixed( size_t ascii_sz,
 				size_t mnemonic_sz, size_t num_operands,
 				size_t op_ascii_sz );
 
+/*!
+ * \fn opdis_insn_t * opdis_insn_array_alloc_fixed( size_t, size_t, size_t,
+ * 						   size_t, size_t )
+ * \ingroup model
+ * \brief Allocate a contiguous array of fixed-size instruction objects.
+ * \details This allocates an array of \e count instruction objects, each
+ *          of which is initialized as if by opdis_insn_alloc_fixed. The
+ *          array is intended for use with opdis_disasm_batch.
+ * \param count Number of instructions in the array.
+ * \param ascii_sz
+ * \param mnemonic_sz
+ * \param num_operands
+ * \param op_ascii_sz
+ * \return The allocated array.
+ * \sa opdis_insn_alloc_fixed
+ * \sa opdis_insn_array_free
+ * \note The elements of the array must not be passed to opdis_insn_free.
+ */
+opdis_insn_t * LIBCALL opdis_insn_array_alloc_fixed( size_t count,
+				size_t ascii_sz, size_t mnemonic_sz,
+				size_t num_operands, size_t op_ascii_sz );
+
+/*!
+ * \fn void opdis_insn_array_free( opdis_insn_t *, size_t )
+ * \ingroup model
+ * \brief Free an array of instruction objects.
+ * \param insns The array to free.
+ * \param count The number of instructions in the array.
+ * \sa opdis_insn_array_alloc_fixed
+ */
+void LIBCALL opdis_insn_array_free( opdis_insn_t * insns, size_t count );
+
 /*!
  * \fn opdis_insn_t * opdis_insn_dupe( const opdis_insn_t * )
  * \ingroup model
@@ -280,12 +346,34 @@ opdis_insn_t * LIBCALL opdis_insn_alloc_fixed( size_t ascii_sz,
  *          from a fixed-size opdis_insn_t. The \e ascii, \e mnemonic, and
  *          \e operands fields are only as large as they need to be (i.e.
  *          the length of the string and the number of valid operands).
+ *          The duplicate is made with a single allocation which holds the
+ *          instruction, operand array, operands, bytes and strings.
  * \param i The instruction to duplicate.
  * \return The duplicate instruction.
  * \sa opdis_insn_alloc
+ * \note The instruction setters (e.g. opdis_insn_set_ascii) move the
+ *       fields of a duplicate to separate allocations before modifying it.
+ *       The operands of a duplicate are \e packed: opdis_op_set_ascii
+ *       gives an operand its own copy of the new string.
  */
 opdis_insn_t * LIBCALL opdis_insn_dupe( const opdis_insn_t * i );
 
+/*!
+ * \fn int opdis_insn_copy( opdis_insn_t *, const opdis_insn_t * )
+ * \ingroup model
+ * \brief Copy the contents of an instruction object into another.
+ * \details Unlike opdis_insn_dupe, this fills an existing instruction
+ *          object, e.g. one allocated with opdis_insn_alloc_fixed. Strings
+ *          are truncated to the fixed sizes of \e dest, and operands are
+ *          copied into the operands already allocated in \e dest before
+ *          new operands are allocated.
+ * \param dest The instruction to fill.
+ * \param src The instruction to copy.
+ * \return 1 on success, 0 on failure.
+ * \sa opdis_insn_dupe
+ */
+int LIBCALL opdis_insn_copy( opdis_insn_t * dest, const opdis_insn_t * src );
+
 /*!
  * \fn void opdis_insn_clear( opdis_insn_t * )
  * \ingroup model
@@ -491,6 +579,8 @@ opdis_op_t * LIBCALL opdis_op_dupe(  opdis_op_t * op );
  * \ingroup model
  * \brief Clear the contents of an operand object.
  * \param o The operand to clear.
+ * \note If the \e ascii field is shared, it is reset to NULL rather
+ *       than emptied.
  */
 void LIBCALL opdis_op_clear( opdis_op_t * o );
 
@@ -500,6 +590,8 @@ void LIBCALL opdis_op_clear( opdis_op_t * o );
  * \brief Free an allocated operand object.
  * \param op The operand to free.
  * \sa opdis_op_alloc
+ * \note A \e packed operand is released with its instruction: only an
+ *       \e ascii string set after it was packed is freed.
  */
 void LIBCALL opdis_op_free( opdis_op_t * op );
 
@@ -508,8 +600,8 @@ void LIBCALL opdis_op_free( opdis_op_t * op );
  * \ingroup model
  * \brief Set the \e ascii field of an operand.
  * \details This duplicates the string \e ascii and sets the \e ascii field
- *          of \e op to the new string. If the \e ascii field is non-NULL, it
- *          is freed before the assignment.
+ *          of \e op to the new string. If the \e ascii field is non-NULL
+ *          and is not shared, it is freed before the assignment.
  * \param op The operand to modify
  * \param ascii The new value for the \e ascii field.
  */
@@ -7,11 +7,27 @@
  * See http://www.gnu.org/licenses/gpl.txt for details.
  */
 
+#include <ctype.h>
 #include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+#ifdef HAVE_SYS_MMAN_H
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include <opdis/opdis.h>
+#include <opdis/decode_cache.h>
+#include <opdis/section_cache.h>
+#include <opdis/section_index.h>
+#include <opdis/worklist.h>
 #include <opdis/x86_decoder.h>
 
 void opdis_debug( opdis_t o, int min_level, const char * format, ... ) {
@@ -38,13 +54,21 @@ int opdis_default_handler( const opdis_insn_t * insn, void * arg ) {
 		return 0;
 	}
 
-	if (! o || ! o->visited_addr ) {
+	if (! o ) {
 		/* visited addresses not being tracked */
 		return 1;
 	}
 
-	/* returns 0 if address already exists in tree */
-	return opdis_vma_tree_add( o->visited_addr, insn->vma );
+	/* returns 0 if address already exists in bitmap or tree */
+	if ( opdis_vma_bitmap_covers( o->visited_map, insn->vma ) ) {
+		return opdis_vma_bitmap_add( o->visited_map, insn->vma );
+	}
+
+	if ( o->visited_addr ) {
+		return opdis_vma_tree_add( o->visited_addr, insn->vma );
+	}
+
+	return 1;
 }
 
 void opdis_default_display( const opdis_insn_t * i, void * arg ) {
@@ -89,6 +113,29 @@ void opdis_default_error_reporter( enum opdis_error_t error, const char * msg,
 /* ---------------------------------------------------------------------- */
 /* Built-in decoders */
 
+/* Classify a branch from the insn info libopcodes fills for some ISAs */
+static void classify_insn_info( const opdis_insn_buf_t in,
+				opdis_insn_t * out ) {
+	enum opdis_cflow_flag_t flag;
+
+	if (! in->insn_info_valid ||
+	     ! (in->decode_level & opdis_decode_mnem_flags) ) {
+		return;
+	}
+
+	switch ( in->insn_type ) {
+		case dis_branch: flag = opdis_cflow_flag_jmp; break;
+		case dis_condbranch: flag = opdis_cflow_flag_jmpcc; break;
+		case dis_jsr: flag = opdis_cflow_flag_call; break;
+		case dis_condjsr: flag = opdis_cflow_flag_callcc; break;
+		default: return;
+	}
+
+	out->category = opdis_insn_cat_cflow;
+	out->flags.cflow = flag;
+	out->status |= opdis_decode_mnem_flags;
+}
+
 int opdis_default_decoder( const opdis_insn_buf_t in, opdis_insn_t * out,
 		           const opdis_byte_t * buf, opdis_off_t offset,
 			   opdis_vma_t vma, opdis_off_t length, void * arg ) {
@@ -108,33 +155,222 @@ int opdis_default_decoder( const opdis_insn_buf_t in, opdis_insn_t * out,
 	out->vma = vma;
 
 	out->status |= opdis_decode_basic;
+	classify_insn_info( in, out );
 	return 1;
 }
 
+/* set operand category and value from the styles of its items */
+static void fill_styled_operand( const opdis_insn_buf_t in, opdis_op_t * op,
+				 const opdis_insn_span_t * span ) {
+	const char * value = NULL;
+	enum opdis_token_style_t value_style = opdis_token_style_none;
+	unsigned int i, num_regs = 0, num_values = 0, reg = 0;
+
+	op->category = opdis_op_cat_unknown;
+	op->flags = opdis_op_flag_none;
+
+	for ( i = span->first; i <= span->last; i++ ) {
+		const opdis_insn_token_t * tok = &in->tokens[i];
+		const char * item = OPDIS_INSN_BUF_ITEM(in, i);
+		unsigned int start = ( i == span->first ) ? span->start : 0;
+		unsigned int end = ( i == span->last ) ? span->end : tok->length;
+
+		switch ( tok->style ) {
+			case opdis_token_style_register:
+				num_regs++;
+				reg = i;
+				break;
+			case opdis_token_style_immediate:
+			case opdis_token_style_address:
+			case opdis_token_style_address_offset:
+				num_values++;
+				value = item;
+				value_style = tok->style;
+				break;
+			case opdis_token_style_text:
+				for ( ; start < end; start++ ) {
+					if ( item[start] == '[' ||
+					     item[start] == '(' ) {
+						/* memory reference */
+						op->category = opdis_op_cat_expr;
+						op->flags |=
+							opdis_op_flag_address;
+						return;
+					}
+				}
+				break;
+			default:
+				break;
+		}
+	}
+
+	if ( num_regs == 1 && ! num_values ) {
+		op->category = opdis_op_cat_register;
+		strncpy( op->value.reg.ascii, OPDIS_INSN_BUF_ITEM(in, reg),
+			 OPDIS_REG_NAME_SZ - 1 );
+	} else if ( num_values == 1 && ! num_regs ) {
+		op->category = opdis_op_cat_immediate;
+		/* skip immediate markers such as # and $ */
+		while ( *value && ! isdigit( (unsigned char) *value ) &&
+			*value != '-' ) {
+			value++;
+		}
+		if ( *value == '-' ) {
+			op->value.immediate.s = strtoll( value, NULL, 0 );
+			op->flags |= opdis_op_flag_signed;
+		} else {
+			op->value.immediate.u = strtoull( value, NULL, 0 );
+		}
+		if ( value_style != opdis_token_style_immediate ) {
+			op->flags |= opdis_op_flag_address;
+		}
+	}
+}
+
+int opdis_styled_decoder( const opdis_insn_buf_t in, opdis_insn_t * out,
+		          const opdis_byte_t * buf, opdis_off_t offset,
+			  opdis_vma_t vma, opdis_off_t length, void * arg ) {
+	char str[OPDIS_MAX_INSN_STR];
+	opdis_insn_layout_t layout;
+	opdis_insn_span_t span;
+	unsigned int i;
+	int rv;
+
+	rv = opdis_default_decoder( in, out, buf, offset, vma, length, NULL );
+	if (! rv || ! (in->decode_level & ~opdis_decode_basic) ||
+	     ! opdis_insn_buf_layout( in, &layout ) ) {
+		return rv;
+	}
+
+	if (! (in->decode_level & opdis_decode_mnem) ) {
+		layout.prefix = layout.mnemonic = -1;
+	}
+
+	for ( i = layout.prefix; layout.prefix > -1 &&
+			i < (unsigned int) layout.mnemonic; i++ ) {
+		span.first = span.last = i;
+		span.start = 0;
+		span.end = in->tokens[i].length;
+		if ( opdis_insn_buf_span_str( in, &span, str, sizeof(str) ) ) {
+			opdis_insn_add_prefix( out, str );
+		}
+	}
+
+	if ( layout.mnemonic > -1 ) {
+		span.first = layout.mnemonic;
+		span.start = 0;
+		span.last = layout.mnemonic_end - 1;
+		span.end = in->tokens[span.last].length;
+		opdis_insn_buf_span_str( in, &span, str, sizeof(str) );
+		opdis_insn_set_mnemonic( out, str );
+		out->status |= opdis_decode_mnem;
+	}
+
+	if (! (in->decode_level & (opdis_decode_ops | opdis_decode_op_flags)) ){
+		return rv;
+	}
+
+	for ( i = 0; i < layout.num_operands; i++ ) {
+		opdis_op_t * op = opdis_insn_next_avail_op( out );
+		if (! op ) {
+			break;
+		}
+
+		opdis_insn_buf_span_str( in, &layout.operands[i], str,
+					 sizeof(str) );
+		opdis_op_set_ascii( op, str );
+		fill_styled_operand( in, op, &layout.operands[i] );
+	}
+	out->status |= opdis_decode_ops;
+
+	if ( layout.comment > -1 &&
+	     (unsigned int) layout.comment + 1 < in->item_count ) {
+		span.first = layout.comment + 1;
+		span.start = 0;
+		span.last = in->item_count - 1;
+		span.end = in->tokens[span.last].length;
+		if ( opdis_insn_buf_span_str( in, &span, str, sizeof(str) ) ) {
+			opdis_insn_add_comment( out, str );
+		}
+	}
+
+	return rv;
+}
+
 /* ---------------------------------------------------------------------- */
 /* libopcodes callbacks */
 
 static int build_insn_fprintf( void * stream, const char * format, ... ) {
-	char str[OPDIS_MAX_ITEM_SIZE];
 	int rv;
 	/* hack to get around libopcodes' fprintf-only output */
-	opdis_t o = (opdis_t) stream;
+	opdis_ctx_t ctx = (opdis_ctx_t) stream;
 
 	va_list args;
 	va_start (args, format);
-	rv = vsnprintf( str, OPDIS_MAX_ITEM_SIZE - 1, format, args );
+	rv = opdis_insn_buf_vappend( ctx->buf, opdis_token_style_none,
+				     format, args );
 	va_end (args);
 
-	opdis_insn_buf_append( o->buf, str );
+	return rv;
+}
+
+#ifdef HAVE_STRUCT_DISASSEMBLE_INFO_FPRINTF_STYLED_FUNC
+static enum opdis_token_style_t token_style( enum disassembler_style style ) {
+	switch ( style ) {
+		case dis_style_mnemonic:
+			return opdis_token_style_mnemonic;
+#if HAVE_DECL_DIS_STYLE_SUB_MNEMONIC
+		case dis_style_sub_mnemonic:
+			return opdis_token_style_sub_mnemonic;
+#endif
+		case dis_style_assembler_directive:
+			return opdis_token_style_directive;
+		case dis_style_register:
+			return opdis_token_style_register;
+		case dis_style_immediate:
+			return opdis_token_style_immediate;
+		case dis_style_address:
+			return opdis_token_style_address;
+		case dis_style_address_offset:
+			return opdis_token_style_address_offset;
+		case dis_style_symbol:
+			return opdis_token_style_symbol;
+		case dis_style_comment_start:
+			return opdis_token_style_comment;
+		case dis_style_text:
+		default:
+			return opdis_token_style_text;
+	}
+}
+
+static int build_insn_styled_fprintf( void * stream,
+				      enum disassembler_style style,
+				      const char * format, ... ) {
+	int rv;
+	opdis_ctx_t ctx = (opdis_ctx_t) stream;
+
+	va_list args;
+	va_start (args, format);
+	rv = opdis_insn_buf_vappend( ctx->buf, token_style(style), format,
+				     args );
+	va_end (args);
 
 	return rv;
 }
+#endif
 
 /* this is used only to get the size of an insn: it discards all insn details */
 static int null_fprintf( void * f, const char * str, ... ) {
 	return 0;
 }
 
+#ifdef HAVE_STRUCT_DISASSEMBLE_INFO_FPRINTF_STYLED_FUNC
+static int null_styled_fprintf( void * f, enum disassembler_style style,
+				const char * str, ... ) {
+	return 0;
+}
+#endif
+
 static void report_memory_error( int status, bfd_vma vma, 
 				 struct disassemble_info * info ) {
 	char msg[48];
@@ -153,7 +389,11 @@ static void report_memory_error( int status, bfd_vma vma,
 
 
 static void invoke_opcodes_init( opdis_t o, OPCODES_INIT fn ) {
+#ifdef HAVE_STRUCT_DISASSEMBLE_INFO_FPRINTF_STYLED_FUNC
+	fn( &o->config, o, build_insn_fprintf, build_insn_styled_fprintf );
+#else
 	fn( &o->config, o, build_insn_fprintf );
+#endif
 	o->config.application_data = (void *) o;
 	o->config.memory_error_func = report_memory_error;
 }
@@ -194,11 +434,26 @@ opdis_t LIBCALL opdis_dupe( opdis_t src ) {
 		o->resolver_arg = src->resolver_arg;
 		o->decoder = src->decoder;
 		o->decoder_arg = src->decoder_arg;
+		o->decode_level = src->decode_level;
+		o->x86_native = src->x86_native;
+		o->cflow_order = src->cflow_order;
+		o->cflow_call_seeds = src->cflow_call_seeds;
+		o->mmap_sections = src->mmap_sections;
+		if ( src->section_cache ) {
+			/* cached sections are not shared */
+			opdis_set_section_cache( o,
+						src->section_cache->budget );
+		}
+		if ( src->decode_cache ) {
+			opdis_set_decode_cache( o,
+						src->decode_cache->num_slots );
+		}
 		o->debug = src->debug;
 
 		/* NOTE: this is not threadsafe, but we don't really care;
 		 *       it just means an insn might be disassembled twice */
 		o->visited_addr = src->visited_addr;
+		o->visited_map = src->visited_map;
 	}
 
 	return o;
@@ -206,6 +461,9 @@ opdis_t LIBCALL opdis_dupe( opdis_t src ) {
 
 void LIBCALL opdis_term( opdis_t o ) {
 	if ( o ) {
+		opdis_section_cache_free(o->section_cache);
+		opdis_section_index_free(o->section_index);
+		opdis_decode_cache_free(o->decode_cache);
 		opdis_insn_buf_free(o->buf);
 		free( o );
 	}
@@ -237,6 +495,8 @@ void LIBCALL opdis_set_defaults( opdis_t o ) {
 	opdis_set_display( o, opdis_default_display, NULL );
 	opdis_set_resolver( o, opdis_default_resolver, NULL );
 	opdis_set_error_reporter( o, opdis_default_error_reporter, NULL );
+	opdis_set_cflow_order( o, opdis_cflow_order_dfs );
+	opdis_set_decode_level( o, OPDIS_DECODE_ALL );
 	opdis_set_arch( o, bfd_arch_i386, bfd_mach_i386_i386, NULL );
 	/* note: this sets the decoder */
 	opdis_set_x86_syntax( o, opdis_x86_syntax_intel );
@@ -282,9 +542,15 @@ void LIBCALL opdis_set_x86_syntax( opdis_t o, enum opdis_x86_syntax_t syntax ) {
 	opdis_set_decoder( o, d_fn, o );
 }
 
+void LIBCALL opdis_set_x86_native( opdis_t o, int enabled ) {
+	if ( o ) {
+		o->x86_native = enabled;
+	}
+}
+
 void LIBCALL opdis_set_arch( opdis_t o, enum bfd_architecture arch, 
 			     unsigned long mach, disassembler_ftype fn ) {
-	OPDIS_DECODER d_fn = opdis_default_decoder;
+	OPDIS_DECODER d_fn = opdis_styled_decoder;
 
 	if (! o ) {
 		return;
@@ -326,6 +592,19 @@ void LIBCALL opdis_set_decoder( opdis_t o, OPDIS_DECODER fn, void * arg ) {
 	}
 }
 
+void LIBCALL opdis_set_decode_level( opdis_t o, unsigned int level ) {
+	if (! o ) {
+		return;
+	}
+
+	/* the basic fields are always filled; operand flags need operands */
+	level |= opdis_decode_basic;
+	if ( level & opdis_decode_op_flags ) {
+		level |= opdis_decode_ops;
+	}
+	o->decode_level = level;
+}
+
 void LIBCALL opdis_set_resolver( opdis_t o, OPDIS_RESOLVER fn, void * arg ) {
 	if ( o && fn ) {
 		o->resolver = fn;
@@ -333,6 +612,71 @@ void LIBCALL opdis_set_resolver( opdis_t o, OPDIS_RESOLVER fn, void * arg ) {
 	}
 }
 
+void LIBCALL opdis_set_cflow_order( opdis_t o, enum opdis_cflow_order_t order ){
+	if ( o ) {
+		o->cflow_order = order;
+	}
+}
+
+void LIBCALL opdis_set_cflow_call_seeds( opdis_t o, int enabled ) {
+	if ( o ) {
+		o->cflow_call_seeds = enabled;
+	}
+}
+
+void LIBCALL opdis_set_mmap_sections( opdis_t o, int enabled ) {
+	if ( o ) {
+		o->mmap_sections = enabled;
+	}
+}
+
+void LIBCALL opdis_set_section_cache( opdis_t o, size_t budget ) {
+	if (! o ) {
+		return;
+	}
+
+	opdis_section_cache_free( o->section_cache );
+	o->section_cache = NULL;
+
+	if ( budget ) {
+		o->section_cache = opdis_section_cache_init( budget );
+	}
+}
+
+void LIBCALL opdis_set_decode_cache( opdis_t o, size_t num_slots ) {
+	if (! o ) {
+		return;
+	}
+
+	opdis_decode_cache_free( o->decode_cache );
+	o->decode_cache = NULL;
+
+	if ( num_slots ) {
+		o->decode_cache = opdis_decode_cache_init( num_slots );
+	}
+}
+
+static int fill_decode_cache_stats( opdis_decode_cache_t cache,
+				    opdis_decode_cache_stats_t * stats ) {
+	if (! cache || ! stats ) {
+		return 0;
+	}
+
+	memcpy( stats, &cache->stats, sizeof(opdis_decode_cache_stats_t) );
+	return 1;
+}
+
+int LIBCALL opdis_decode_cache_stats( opdis_t o,
+				      opdis_decode_cache_stats_t * stats ) {
+	return ( o ) ? fill_decode_cache_stats( o->decode_cache, stats ) : 0;
+}
+
+int LIBCALL opdis_ctx_decode_cache_stats( opdis_ctx_t ctx,
+					  opdis_decode_cache_stats_t * stats ) {
+	return ( ctx ) ? fill_decode_cache_stats( ctx->decode_cache, stats )
+		       : 0;
+}
+
 void LIBCALL opdis_set_error_reporter( opdis_t o, OPDIS_ERROR fn, void * arg ) {
 	if ( o && fn ) {
 		o->error_reporter = fn;
@@ -340,102 +684,447 @@ void LIBCALL opdis_set_error_reporter( opdis_t o, OPDIS_ERROR fn, void * arg ) {
 	}
 }
 
+/* ---------------------------------------------------------------------- */
+/* Disassembly contexts */
+
+/* Wrap the libopcodes config and insn buffer of an opdis_t in a context.
+ * This is used by the opdis_t disassembly routines, which therefore modify
+ * the opdis_t exactly as they always have. */
+static void default_ctx( opdis_t o, opdis_context_t * ctx ) {
+	ctx->opdis = o;
+	ctx->config = &o->config;
+	ctx->buf = o->buf;
+	ctx->map_addr = NULL;
+	ctx->map_len = 0;
+	ctx->buffer_cached = 0;
+	ctx->decode_cache = o->decode_cache;
+	ctx->cflow = 0;
+}
+
+opdis_ctx_t LIBCALL opdis_ctx_init( opdis_t o ) {
+	opdis_ctx_t ctx;
+
+	if (! o ) {
+		return NULL;
+	}
+
+	ctx = (opdis_ctx_t) calloc( 1, sizeof(opdis_context_t) );
+	if (! ctx ) {
+		return NULL;
+	}
+
+	ctx->buf = opdis_insn_buf_alloc( o->buf->max_item_count,
+					 o->buf->max_item_size,
+					 o->buf->max_string_size );
+	if (! ctx->buf ) {
+		free( ctx );
+		return NULL;
+	}
+
+	/* libopcodes writes to its disassemble_info during every call, so
+	 * each context needs a private copy */
+	memcpy( &ctx->config_data, &o->config, sizeof(disassemble_info) );
+	ctx->config = &ctx->config_data;
+	ctx->opdis = o;
+
+	if ( o->decode_cache ) {
+		/* cached instructions are not shared between threads */
+		ctx->decode_cache = opdis_decode_cache_init(
+						o->decode_cache->num_slots );
+	}
+
+	return ctx;
+}
+
+void LIBCALL opdis_ctx_term( opdis_ctx_t ctx ) {
+	if ( ctx ) {
+		opdis_decode_cache_free( ctx->decode_cache );
+		opdis_insn_buf_free( ctx->buf );
+		free( ctx );
+	}
+}
+
+/* libopcodes i386 options which only change the text of an instruction */
+static const char * x86_print_options[] = {
+	"att", "intel", "att-mnemonic", "intel-mnemonic", "suffix", NULL
+};
+
+static int is_x86_print_option( const char * opt, size_t len ) {
+	int i;
+
+	for ( i = 0; x86_print_options[i]; i++ ) {
+		if ( strlen( x86_print_options[i] ) == len &&
+		     ! strncmp( opt, x86_print_options[i], len ) ) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/* Get the x86 processor mode from the mach and the disassembler options,
+ * as libopcodes does. Returns 0 if an option changes how libopcodes decodes
+ * (e.g. addr16, data16) or, unless print_opts is set, how it prints the
+ * instruction: these are not supported by the native x86 code. */
+static int x86_mode( const disassemble_info * config, int print_opts,
+		     enum opdis_x86_mode_t * mode ) {
+	const char * opt = config->disassembler_options;
+
+	*mode = opdis_x86_mode_32;
+	if ( config->mach & bfd_mach_x86_64 ) {
+		*mode = opdis_x86_mode_64;
+#ifdef bfd_mach_x64_32
+	} else if ( config->mach & bfd_mach_x64_32 ) {
+		*mode = opdis_x86_mode_64;
+#endif
+	} else if ( config->mach & bfd_mach_i386_i8086 ) {
+		*mode = opdis_x86_mode_16;
+	}
+
+	while ( opt && *opt ) {
+		size_t len = strcspn( opt, "," );
+
+		if ( len == 6 && ! strncmp( opt, "x86-64", len ) ) {
+			*mode = opdis_x86_mode_64;
+		} else if ( len == 4 && ! strncmp( opt, "i386", len ) ) {
+			*mode = opdis_x86_mode_32;
+		} else if ( len == 5 && ! strncmp( opt, "i8086", len ) ) {
+			*mode = opdis_x86_mode_16;
+		} else if ( len && ! ( print_opts &&
+				       is_x86_print_option( opt, len ) ) ) {
+			return 0;
+		}
+
+		opt += ( opt[len] ) ? len + 1 : len;
+	}
+
+	return 1;
+}
+
+/* Size an instruction without libopcodes; returns 0 if unsupported */
+// NOTE: This requires that set_ctx_buffer() have been called
+static unsigned int native_insn_size( opdis_ctx_t ctx, opdis_vma_t vma ) {
+	disassemble_info * config = ctx->config;
+	opdis_off_t offset = vma - config->buffer_vma;
+	enum opdis_x86_mode_t mode;
+
+	if ( config->arch != bfd_arch_i386 || vma < config->buffer_vma ||
+	     offset >= config->buffer_length || ! x86_mode( config, 1, &mode ) ) {
+		return 0;
+	}
+
+	return opdis_x86_insn_size( &config->buffer[offset],
+				    config->buffer_length - offset, mode );
+}
+
+/* Decode an instruction without libopcodes; returns 0 if unsupported */
+// NOTE: This requires that set_ctx_buffer() have been called
+static unsigned int native_insn( opdis_ctx_t ctx, opdis_vma_t vma,
+				 opdis_insn_t * insn ) {
+	disassemble_info * config = ctx->config;
+	opdis_off_t offset = vma - config->buffer_vma;
+	enum opdis_x86_syntax_t syntax = opdis_x86_syntax_att;
+	enum opdis_x86_mode_t mode;
+	int size;
+
+	if ( config->arch != bfd_arch_i386 || vma < config->buffer_vma ||
+	     offset >= config->buffer_length || ! x86_mode( config, 0, &mode ) ) {
+		return 0;
+	}
+
+	/* addresses are printed as generic_print_address() would print them */
+	if ( config->print_address_func != generic_print_address ) {
+		return 0;
+	}
+
+	if ( ctx->opdis->disassembler == print_insn_i386_intel ) {
+		syntax = opdis_x86_syntax_intel;
+	}
+
+	size = opdis_x86_native_decode( &config->buffer[offset],
+					config->buffer_length - offset, vma,
+					mode, syntax, insn );
+	if ( size > 0 ) {
+		insn->offset = offset;
+		/* there is no libopcodes insn info for this insn */
+		ctx->buf->insn_info_valid = 0;
+		opdis_debug( ctx->opdis, 4, "%p : %s (native)", (void *) vma,
+			     insn->ascii );
+	}
+
+	return (unsigned int) size;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Decode cache */
+
+/* libopcodes prints every address it computes (branch targets, PC-relative
+ * operands) through print_address_func: such insns depend on their VMA */
+static void note_print_address( bfd_vma addr, struct disassemble_info * info ){
+	opdis_ctx_t ctx = (opdis_ctx_t) info->stream;
+
+	ctx->printed_address = 1;
+	ctx->print_address( addr, info );
+}
+
+/* Fill insn from the decode cache, given the native size of the insn;
+ * returns the insn size, or 0 on a miss */
+static unsigned int cached_insn( opdis_ctx_t ctx, opdis_vma_t vma,
+				 unsigned int size, opdis_insn_t * insn ) {
+	opdis_t o = ctx->opdis;
+	disassemble_info * config = ctx->config;
+	const opdis_insn_t * cached;
+
+	opdis_decode_cache_set_key( ctx->decode_cache, config->arch,
+				    config->mach, o->disassembler,
+				    config->disassembler_options,
+				    o->decoder, o->decoder_arg,
+				    ctx->buf->decode_level,
+				    ctx->buf->decode_branch_ops );
+
+	cached = opdis_decode_cache_find( ctx->decode_cache,
+				&config->buffer[vma - config->buffer_vma],
+				size );
+	if (! cached || ! opdis_insn_copy( insn, cached ) ) {
+		return 0;
+	}
+
+	/* fix up the only fields which depend on the VMA */
+	insn->offset = vma - config->buffer_vma;
+	insn->vma = vma;
+
+	opdis_debug( o, 4, "%p : %s (cached)", (void *) vma, insn->ascii );
+
+	return size;
+}
+
+static void cache_insn( opdis_ctx_t ctx, const opdis_insn_t * insn,
+			unsigned int size ) {
+	opdis_insn_buf_t buf = ctx->buf;
+
+	if ( ctx->printed_address || ( buf->insn_info_valid &&
+	     ( buf->target || buf->target2 ) ) ) {
+		ctx->decode_cache->stats.uncacheable++;
+		return;
+	}
+
+	if ( insn->size == size && insn->bytes ) {
+		opdis_decode_cache_add( ctx->decode_cache, insn );
+	}
+}
+
 /* ---------------------------------------------------------------------- */
 /* Disassemble instruction */
 
 /* Internal wrapper for libopcodes disassembler used by the three main
  * disasm functions: disasm_insn, disasm_linear, disasm_cflow. */
-// NOTE: This requires that opdis_set_buffer() have been called
-static unsigned int disasm_single_insn( opdis_t o, opdis_vma_t vma, 
+// NOTE: This requires that set_ctx_buffer() have been called
+static unsigned int disasm_single_insn( opdis_ctx_t ctx, opdis_vma_t vma,
 					opdis_insn_t * insn ) {
-	int size;
+	int size, decoded;
+	unsigned int cache_size = 0;
+	opdis_t o = ctx->opdis;
+	disassemble_info * config = ctx->config;
+	opdis_insn_buf_t buf = ctx->buf;
+
+	/* control flow needs insn flags and branch targets to proceed */
+	buf->decode_level = o->decode_level;
+	buf->decode_branch_ops = ctx->cflow;
+	if ( ctx->cflow ) {
+		buf->decode_level |= opdis_decode_mnem_flags;
+	}
+
+	if ( o->x86_native ) {
+		size = native_insn( ctx, vma, insn );
+		if ( size ) {
+			return (unsigned int) size;
+		}
+	}
+
+	/* insns can only be looked up if they can be sized without
+	 * libopcodes: otherwise, disassemble as if there were no cache */
+	if ( ctx->decode_cache ) {
+		cache_size = native_insn_size( ctx, vma );
+	}
+
+	if ( cache_size ) {
+		size = cached_insn( ctx, vma, cache_size, insn );
+		if ( size ) {
+			/* cached insns never have a libopcodes target */
+			buf->insn_info_valid = 0;
+			return (unsigned int) size;
+		}
+
+		ctx->printed_address = 0;
+		ctx->print_address = config->print_address_func;
+		config->print_address_func = note_print_address;
+	}
 
-	o->config.insn_info_valid = 0;
-	o->buf->item_count = 0;
-	o->buf->string[0] = '\0';
+	config->insn_info_valid = 0;
+	opdis_insn_buf_clear( buf );
 	opdis_insn_clear( insn );
 
-	o->config.stream = o;
-	size = o->disassembler( (bfd_vma) vma, &o->config );
+	config->stream = ctx;
+	size = o->disassembler( (bfd_vma) vma, config );
+
+	if ( cache_size ) {
+		config->print_address_func = ctx->print_address;
+	}
+
 	if ( size < 1 ) {
 		char msg[32];
-		snprintf( msg, 31, "VMA %p: %02X\n", (void *) vma, 
-			  o->config.buffer[(vma - o->config.buffer_vma)] );
+		snprintf( msg, 31, "VMA %p: %02X\n", (void *) vma,
+			  config->buffer[(vma - config->buffer_vma)] );
 		opdis_error( o, opdis_error_invalid_insn, msg );
 		return 0;
 	}
 
 	opdis_debug( o, 3, "Disassembled %d bytes at %p", size, (void *) vma );
 
-	opdis_debug( o, 4, "%p : %s", (void *) vma, o->buf->string );
+	opdis_debug( o, 4, "%p : %s", (void *) vma, buf->string );
 
 
 	/* fill insn_buf with libopcodes meta-info */
-	o->buf->insn_info_valid = o->config.insn_info_valid;
-	o->buf->branch_delay_insns = o->config.branch_delay_insns;
-	o->buf->data_size = o->config.data_size;
-	o->buf->insn_type = o->config.insn_type;
-	o->buf->target = o->config.target;
-	o->buf->target2 = o->config.target2;
-
-	if (! o->decoder( o->buf, insn, o->config.buffer, 
-			  vma - o->config.buffer_vma, vma, size,
-			  o->decoder_arg ) ) {
+	buf->insn_info_valid = config->insn_info_valid;
+	buf->branch_delay_insns = config->branch_delay_insns;
+	buf->data_size = config->data_size;
+	buf->insn_type = config->insn_type;
+	buf->target = config->target;
+	buf->target2 = config->target2;
+
+	decoded = o->decoder( buf, insn, config->buffer,
+			      vma - config->buffer_vma, vma, size,
+			      o->decoder_arg );
+	if ( decoded && cache_size ) {
+		cache_insn( ctx, insn, cache_size );
+	}
+
+	if (! decoded ) {
 		char msg[64];
 		snprintf( msg, 63, "VMA %p: '%s'\n", (void *) vma,
-			  o->buf->string );
+			  buf->string );
 		opdis_error( o, opdis_error_decode_insn, msg );
 		// Note: this is a warning, not an error
 	}
 
 	/* clear insn buffer now that decoding has taken place */
-	opdis_insn_buf_clear( o->buf );
+	opdis_insn_buf_clear( buf );
 
 	return (unsigned int) size;
 }
 
-// size of single insn at address
-unsigned int LIBCALL opdis_disasm_insn_size( opdis_t o, opdis_buf_t buf, 
-					     opdis_vma_t vma ){
-	size_t size;
-	fprintf_ftype fn = o->config.fprintf_func;
-	o->config.fprintf_func = null_fprintf;
+/* Get the target of a branch insn. libopcodes computes this itself for
+ * many ISAs, in which case the default resolver does not have to examine
+ * the operands. A custom resolver is always called, as it may remap or
+ * filter targets. */
+// NOTE: This must be called right after disasm_single_insn()
+static opdis_vma_t branch_target( opdis_ctx_t ctx, const opdis_insn_t * insn ){
+	opdis_insn_buf_t buf = ctx->buf;
+	opdis_t o = ctx->opdis;
+
+	if ( o->resolver == opdis_default_resolver &&
+	     buf->insn_info_valid && buf->target &&
+	     ( buf->insn_type == dis_branch ||
+	       buf->insn_type == dis_condbranch ||
+	       buf->insn_type == dis_jsr || buf->insn_type == dis_condjsr ) ) {
+		return (opdis_vma_t) buf->target;
+	}
+
+	return o->resolver( insn, o->resolver_arg );
+}
 
-	if (! o || ! buf  ) {
+static void set_ctx_buffer( opdis_ctx_t ctx, opdis_buf_t buf ) {
+	opdis_debug( ctx->opdis, 2, "Buffer VMA %p size %d\n",
+		     (void *) buf->vma, buf->len );
+	ctx->config->buffer_vma = buf->vma;
+	ctx->config->buffer = (bfd_byte *) buf->data;
+	ctx->config->buffer_length = buf->len;
+}
+
+/* Size of a single insn at address, without decoding it */
+// NOTE: This requires that set_ctx_buffer() have been called
+static unsigned int disasm_insn_size( opdis_ctx_t ctx, opdis_vma_t vma ) {
+	int size;
+	fprintf_ftype fn;
+#ifdef HAVE_STRUCT_DISASSEMBLE_INFO_FPRINTF_STYLED_FUNC
+	fprintf_styled_ftype styled_fn;
+#endif
+
+	size = native_insn_size( ctx, vma );
+	if ( size ) {
+		return size;
+	}
+
+	fn = ctx->config->fprintf_func;
+	ctx->config->fprintf_func = null_fprintf;
+#ifdef HAVE_STRUCT_DISASSEMBLE_INFO_FPRINTF_STYLED_FUNC
+	styled_fn = ctx->config->fprintf_styled_func;
+	ctx->config->fprintf_styled_func = null_styled_fprintf;
+#endif
+	ctx->config->stream = ctx;
+	size = ctx->opdis->disassembler( vma, ctx->config );
+	ctx->config->fprintf_func = fn;
+#ifdef HAVE_STRUCT_DISASSEMBLE_INFO_FPRINTF_STYLED_FUNC
+	ctx->config->fprintf_styled_func = styled_fn;
+#endif
+
+	/* libopcodes returns -1 on error */
+	return ( size < 1 ) ? 0 : (unsigned int) size;
+}
+
+// size of single insn at address
+unsigned int LIBCALL opdis_ctx_disasm_insn_size( opdis_ctx_t ctx,
+						 opdis_buf_t buf,
+						 opdis_vma_t vma ){
+	if (! ctx || ! buf  ) {
 		return 0;
 	}
 
-	o->config.stream = o;
-	size = o->disassembler( vma, &o->config );
-	
-	o->config.fprintf_func = fn;
-	return size;
+	set_ctx_buffer( ctx, buf );
+	return disasm_insn_size( ctx, vma );
 }
 
-static void set_opdis_buffer( opdis_t o, opdis_buf_t buf ) {
-	opdis_debug( o, 2, "Buffer VMA %p size %d\n", (void *) buf->vma,
-		     buf->len );
-	o->config.buffer_vma = buf->vma;
-	o->config.buffer = (bfd_byte *) buf->data;
-	o->config.buffer_length = buf->len;
+unsigned int LIBCALL opdis_disasm_insn_size( opdis_t o, opdis_buf_t buf,
+					     opdis_vma_t vma ){
+	opdis_context_t ctx;
+
+	if (! o ) {
+		return 0;
+	}
+
+	default_ctx( o, &ctx );
+	return opdis_ctx_disasm_insn_size( &ctx, buf, vma );
 }
 
-unsigned int LIBCALL opdis_disasm_insn( opdis_t o, opdis_buf_t buf, 
-					opdis_vma_t vma, 
-					opdis_insn_t * insn ) {
+unsigned int LIBCALL opdis_ctx_disasm_insn( opdis_ctx_t ctx, opdis_buf_t buf,
+					    opdis_vma_t vma,
+					    opdis_insn_t * insn ) {
 	size_t size;
 
-	if (! o || ! buf  ) {
+	if (! ctx || ! buf  ) {
 		return 0;
 	}
 
-	set_opdis_buffer( o, buf );
-	size = disasm_single_insn( o, vma, insn );
-	o->display( insn, o->display_arg );
+	set_ctx_buffer( ctx, buf );
+	size = disasm_single_insn( ctx, vma, insn );
+	ctx->opdis->display( insn, ctx->opdis->display_arg );
 
 	return size;
 }
 
+unsigned int LIBCALL opdis_disasm_insn( opdis_t o, opdis_buf_t buf,
+					opdis_vma_t vma,
+					opdis_insn_t * insn ) {
+	opdis_context_t ctx;
+
+	if (! o ) {
+		return 0;
+	}
+
+	default_ctx( o, &ctx );
+	return opdis_ctx_disasm_insn( &ctx, buf, vma, insn );
+}
+
 /* ---------------------------------------------------------------------- */
 /* Disassembler algorithms */
 
@@ -445,13 +1134,15 @@ static inline opdis_insn_t * alloc_fixed_insn() {
 	return opdis_insn_alloc_fixed( 128, 32, 16, 32 );
 }
 
-static int disasm_linear( opdis_t o, opdis_vma_t vma, opdis_off_t length ) {
+static int disasm_linear( opdis_ctx_t ctx, opdis_vma_t vma,
+			  opdis_off_t length ) {
 	opdis_insn_t * insn;
 	int cont = 1;
 	unsigned int count = 0;
 	opdis_off_t pos = vma;
-	length = (length == 0) ? o->config.buffer_length : length;
-	opdis_off_t max_pos = o->config.buffer_vma + length;
+	opdis_t o = ctx->opdis;
+	length = (length == 0) ? ctx->config->buffer_length : length;
+	opdis_off_t max_pos = ctx->config->buffer_vma + length;
 
 	insn = alloc_fixed_insn();
 	if (! insn ) {
@@ -463,10 +1154,10 @@ static int disasm_linear( opdis_t o, opdis_vma_t vma, opdis_off_t length ) {
 		     (void *) max_pos );
 
 	while ( cont && pos < max_pos ) {
-		unsigned int size = disasm_single_insn( o, pos, insn );
+		unsigned int size = disasm_single_insn( ctx, pos, insn );
 		pos += size;
 		if ( pos - vma > length ) {
-			opdis_debug( o, 1, "Instruction at %p exceeds buffer", 
+			opdis_debug( o, 1, "Instruction at %p exceeds buffer",
 				    (void *) vma );
 			break;
 		}
@@ -482,42 +1173,196 @@ static int disasm_linear( opdis_t o, opdis_vma_t vma, opdis_off_t length ) {
 	return count;
 }
 
-int LIBCALL opdis_disasm_linear( opdis_t o, opdis_buf_t buf, opdis_vma_t vma,
-				 opdis_off_t length ) {
-	set_opdis_buffer( o, buf );
+int LIBCALL opdis_ctx_disasm_linear( opdis_ctx_t ctx, opdis_buf_t buf,
+				     opdis_vma_t vma, opdis_off_t length ) {
+	if (! ctx || ! buf ) {
+		return 0;
+	}
+
+	set_ctx_buffer( ctx, buf );
 
-	return disasm_linear( o, vma, length );
+	return disasm_linear( ctx, vma, length );
 }
 
-static int disasm_cflow(opdis_t o, opdis_vma_tree_t tree, opdis_vma_t vma) {
-	int cont = 1;
-	unsigned int count = 0;
-	opdis_off_t pos = vma;
-	opdis_off_t max_pos = o->config.buffer_vma + o->config.buffer_length;
-	opdis_insn_t * insn = alloc_fixed_insn();
+int LIBCALL opdis_disasm_linear( opdis_t o, opdis_buf_t buf, opdis_vma_t vma,
+				 opdis_off_t length ) {
+	opdis_context_t ctx;
 
-	if (! insn ) {
-		fprintf( stderr, "Unable to alloc insn\n" );
+	if (! o ) {
 		return 0;
 	}
 
-	if ( pos < o->config.buffer_vma ) {
+	default_ctx( o, &ctx );
+	return opdis_ctx_disasm_linear( &ctx, buf, vma, length );
+}
+
+/* Record the instruction starts of a linear disassembly of
+ * [vma, vma + length) without decoding or printing instructions. Bytes
+ * which do not start a valid instruction are skipped one at a time. */
+static opdis_insn_map_t disasm_insn_map( opdis_ctx_t ctx, opdis_buf_t buf,
+					 opdis_vma_t vma, opdis_off_t length ) {
+	opdis_insn_map_t map;
+	opdis_vma_t pos = vma;
+	opdis_vma_t max_pos = buf->vma + buf->len;
+
+	if ( vma < buf->vma || vma >= max_pos ) {
+		return NULL;
+	}
+
+	if ( length && length < max_pos - vma ) {
+		max_pos = vma + length;
+	}
+
+	map = opdis_insn_map_alloc( vma, max_pos - vma );
+	if (! map ) {
+		return NULL;
+	}
+
+	set_ctx_buffer( ctx, buf );
+
+	while ( pos < max_pos ) {
+		unsigned int size = disasm_insn_size( ctx, pos );
+		if (! size ) {
+			pos++;
+			continue;
+		}
+
+		if ( size > max_pos - pos ) {
+			opdis_debug( ctx->opdis, 1,
+				     "Instruction at %p exceeds buffer",
+				     (void *) pos );
+			break;
+		}
+
+		opdis_insn_map_add( map, pos );
+		pos += size;
+	}
+
+	opdis_debug( ctx->opdis, 1, "Insn map %p: %d insns", (void *) vma,
+		     (int) map->count );
+
+	return map;
+}
+
+opdis_insn_map_t LIBCALL opdis_ctx_disasm_insn_map( opdis_ctx_t ctx,
+						    opdis_buf_t buf,
+						    opdis_vma_t vma,
+						    opdis_off_t length ) {
+	if (! ctx || ! buf ) {
+		return NULL;
+	}
+
+	return disasm_insn_map( ctx, buf, vma, length );
+}
+
+opdis_insn_map_t LIBCALL opdis_disasm_insn_map( opdis_t o, opdis_buf_t buf,
+						opdis_vma_t vma,
+						opdis_off_t length ) {
+	opdis_context_t ctx;
+
+	if (! o ) {
+		return NULL;
+	}
+
+	default_ctx( o, &ctx );
+	return opdis_ctx_disasm_insn_map( &ctx, buf, vma, length );
+}
+
+/* Fill an array of instructions without invoking the display or handler
+ * callbacks. Disassembly stops at the first invalid instruction, or at the
+ * first instruction which does not fit in [vma, vma + length). */
+static unsigned int disasm_batch( opdis_ctx_t ctx, opdis_vma_t vma,
+				  opdis_off_t length, opdis_insn_t * insns,
+				  unsigned int count ) {
+	unsigned int i;
+	opdis_vma_t pos = vma;
+	opdis_off_t min_pos = ctx->config->buffer_vma;
+	opdis_off_t max_pos = min_pos + ctx->config->buffer_length;
+
+	if ( vma < min_pos || vma >= max_pos ) {
 		return 0;
 	}
 
-	opdis_debug( o, 1, "Start cflow from %p max %p", (void *) vma,
-		     (void *) max_pos );
+	if ( length && length < max_pos - vma ) {
+		max_pos = vma + length;
+	}
+
+	for ( i = 0; i < count && pos < max_pos; i++ ) {
+		unsigned int size = disasm_single_insn( ctx, pos, &insns[i] );
+		if (! size || pos + size > max_pos ) {
+			break;
+		}
+		pos += size;
+	}
+
+	opdis_debug( ctx->opdis, 1, "Batch %p: %d insns", (void *) vma, i );
+
+	return i;
+}
+
+unsigned int LIBCALL opdis_ctx_disasm_batch( opdis_ctx_t ctx,
+					     opdis_buf_t buf, opdis_vma_t vma,
+					     opdis_off_t length,
+					     opdis_insn_t * insns,
+					     unsigned int count ) {
+	if (! ctx || ! buf || ! insns ) {
+		return 0;
+	}
+
+	set_ctx_buffer( ctx, buf );
+
+	return disasm_batch( ctx, vma, length, insns, count );
+}
+
+unsigned int LIBCALL opdis_disasm_batch( opdis_t o, opdis_buf_t buf,
+					 opdis_vma_t vma, opdis_off_t length,
+					 opdis_insn_t * insns,
+					 unsigned int count ) {
+	opdis_context_t ctx;
+
+	if (! o ) {
+		return 0;
+	}
+
+	default_ctx( o, &ctx );
+	return opdis_ctx_disasm_batch( &ctx, buf, vma, length, insns, count );
+}
+
+/* Disassemble a single path of execution starting at vma. Branch targets
+ * which have not been seen before are added to the worklist. If visited
+ * is non-NULL, the path ends at the first address which is already in it;
+ * otherwise the handler is relied upon to detect visited addresses. */
+static unsigned int disasm_cflow_path( opdis_ctx_t ctx,
+				       opdis_vma_bitmap_t visited,
+				       opdis_vma_bitmap_t targets,
+				       opdis_worklist_t work,
+				       opdis_insn_t * insn, opdis_vma_t vma ) {
+	int cont = 1;
+	unsigned int count = 0;
+	opdis_off_t pos = vma;
+	opdis_t o = ctx->opdis;
+	opdis_off_t min_pos = ctx->config->buffer_vma;
+	opdis_off_t max_pos = min_pos + ctx->config->buffer_length;
 
 	while ( cont && pos < max_pos ) {
-		unsigned int size = disasm_single_insn( o, pos, insn );
+		opdis_vma_t target;
+		unsigned int size;
+
+		if ( visited && ! opdis_vma_bitmap_add( visited, pos ) ) {
+			opdis_debug( o, 2, "VMA %p already visited",
+				     (void *) pos );
+			break;
+		}
+
+		size = disasm_single_insn( ctx, pos, insn );
 		pos += size;
 		count++;
 
-		/* NOTE : handler determines if an address has already been
-		 *        visited, and if not it adds the insn to the addr
-		 *        list. this means that the first insn of a branch could
-		 *        be disassembled, but will not be added. a bit
-		 *        inefficient, but not too troubling. */
+		/* NOTE : if the caller supplied a visited_addr tree or
+		 *        visited_map bitmap, the handler determines if an
+		 *        address has already been visited. this means that
+		 *        the first insn of a branch could be disassembled,
+		 *        but will not be added. */
 		cont = o->handler( insn, o->handler_arg );
 
 		if ( cont ) {
@@ -538,96 +1383,576 @@ static int disasm_cflow(opdis_t o, opdis_vma_tree_t tree, opdis_vma_t vma) {
 			continue;
 		}
 
-		opdis_vma_t vma = o->resolver( insn, o->resolver_arg );
-		/* recurse on branch target */
-		if ( vma == OPDIS_INVALID_ADDR ) {
+		target = branch_target( ctx, insn );
+		/* queue branch target */
+		if ( target == OPDIS_INVALID_ADDR ) {
 			opdis_debug( o, 2, "Cannot Resolve: %s", insn->ascii );
-		} else if ( vma < o->config.buffer_vma || vma >= max_pos ) {
-			opdis_debug( o, 2, "Branch target %p not in buffer %p", 
-				(void *) vma, (void *) o->config.buffer_vma );
-		} else if ( opdis_vma_tree_add( tree, vma ) ) {
-			opdis_debug( o, 2, "CFLOW BRANCH START: %p", 
-				     (void *) vma );
-			count +=  disasm_cflow( o, tree, vma );
+		} else if ( target < min_pos || target >= max_pos ) {
+			opdis_debug( o, 2, "Branch target %p not in buffer %p",
+				(void *) target, (void *) min_pos );
+		} else if ( opdis_vma_bitmap_add( targets, target ) ) {
+			opdis_debug( o, 2, "CFLOW BRANCH START: %p",
+				     (void *) target );
+			if (! opdis_worklist_push( work, target ) ) {
+				opdis_error( o, opdis_error_unknown,
+					     "Unable to add branch target" );
+			}
 		} else {
 			opdis_debug( o, 3, "VMA %p already visited\n",
-				     (void *) vma );
+				     (void *) target );
 		}
 	}
 
+	return count;
+}
+
+struct CALL_SEEDS {
+	opdis_t opdis;
+	opdis_vma_bitmap_t targets;
+	opdis_worklist_t work;
+	unsigned int count;
+};
+
+static void queue_call_seed( opdis_vma_t target, void * arg ) {
+	struct CALL_SEEDS * seeds = (struct CALL_SEEDS *) arg;
+
+	/* the targets bitmap removes duplicate targets */
+	if (! opdis_vma_bitmap_add( seeds->targets, target ) ) {
+		return;
+	}
+
+	if ( opdis_worklist_push( seeds->work, target ) ) {
+		seeds->count++;
+	} else {
+		opdis_error( seeds->opdis, opdis_error_unknown,
+			     "Unable to add call target" );
+	}
+}
+
+/* Queue the targets of direct calls in the buffer, if enabled */
+static void seed_call_targets( opdis_ctx_t ctx, opdis_vma_bitmap_t targets,
+			       opdis_worklist_t work ) {
+	disassemble_info * config = ctx->config;
+	struct CALL_SEEDS seeds = { ctx->opdis, targets, work, 0 };
+	enum opdis_x86_mode_t mode;
+
+	if (! ctx->opdis->cflow_call_seeds || config->arch != bfd_arch_i386 ||
+	     ! x86_mode( config, 1, &mode ) ) {
+		return;
+	}
+
+	opdis_x86_call_targets( config->buffer, config->buffer_length,
+				config->buffer_vma, mode,
+				queue_call_seed, &seeds );
+
+	opdis_debug( ctx->opdis, 1, "Seeded cflow with %d call targets",
+		     seeds.count );
+}
+
+/* Control-flow disassembly engine. Branch targets are kept in a worklist
+ * rather than being disassembled recursively, so stack usage is constant
+ * and a single instruction object is used for the entire job. Both the
+ * set of queued targets and (if the caller has not supplied one) the set
+ * of visited addresses are bitmaps covering the buffer. */
+static int disasm_cflow( opdis_ctx_t ctx, opdis_vma_t vma ) {
+	unsigned int count = 0;
+	opdis_t o = ctx->opdis;
+	opdis_off_t min_pos = ctx->config->buffer_vma;
+	opdis_off_t max_pos = min_pos + ctx->config->buffer_length;
+	opdis_vma_bitmap_t targets, visited = NULL;
+	opdis_worklist_t work;
+	opdis_insn_t * insn;
+
+	if ( vma < min_pos || vma >= max_pos ) {
+		return 0;
+	}
+
+	insn = alloc_fixed_insn();
+	if (! insn ) {
+		fprintf( stderr, "Unable to alloc insn\n" );
+		return 0;
+	}
+
+	work = opdis_worklist_init( o->cflow_order );
+	targets = opdis_vma_bitmap_init( min_pos, ctx->config->buffer_length );
+	if (! o->visited_map && ! o->visited_addr ) {
+		/* track visited addresses for the duration of the job */
+		visited = opdis_vma_bitmap_init( min_pos,
+						 ctx->config->buffer_length );
+	}
+
+	if (! work || ! targets ||
+	     (! visited && ! o->visited_map && ! o->visited_addr) ) {
+		fprintf( stderr, "Unable to alloc worklist\n" );
+		opdis_worklist_free( work );
+		opdis_vma_bitmap_free( targets );
+		opdis_insn_free( insn );
+		return 0;
+	}
+
+	opdis_debug( o, 1, "Start cflow from %p max %p", (void *) vma,
+		     (void *) max_pos );
+
+	opdis_vma_bitmap_add( targets, vma );
+	opdis_worklist_push( work, vma );
+	seed_call_targets( ctx, targets, work );
+
+	ctx->cflow = 1;
+	while ( opdis_worklist_count( work ) ) {
+		opdis_vma_t pos = opdis_worklist_pop( work );
+		count += disasm_cflow_path( ctx, visited, targets, work, insn,
+					    pos );
+	}
+	ctx->cflow = 0;
+
 	opdis_debug( o, 1, "End cflow %p (count %d)", (void *) vma, count );
 
+	opdis_vma_bitmap_free( visited );
+	opdis_vma_bitmap_free( targets );
+	opdis_worklist_free( work );
+	opdis_insn_free( insn );
+
 	return count;
 }
 
+int LIBCALL opdis_ctx_disasm_cflow( opdis_ctx_t ctx, opdis_buf_t buf,
+				    opdis_vma_t vma ) {
+	if (! ctx || ! buf ) {
+		return 0;
+	}
+
+	set_ctx_buffer( ctx, buf );
+
+	return disasm_cflow( ctx, vma );
+}
+
 int LIBCALL opdis_disasm_cflow( opdis_t o, opdis_buf_t buf, opdis_vma_t vma ) {
+	opdis_context_t ctx;
+
+	if (! o ) {
+		return 0;
+	}
+
+	default_ctx( o, &ctx );
+	return opdis_ctx_disasm_cflow( &ctx, buf, vma );
+}
+
+/* ---------------------------------------------------------------------- */
+/* Multi-threaded control-flow disassembler */
+
+#ifdef HAVE_PTHREAD_H
+
+struct CFLOW_MT_JOB {
+	opdis_ctx_t ctx;		/* context of caller */
+	pthread_mutex_t lock;		/* guards work, targets, busy, count */
+	pthread_cond_t cond;		/* signalled when work is available */
+	opdis_worklist_t work;		/* pending branch targets */
+	opdis_vma_bitmap_t targets;	/* all targets added to worklist */
+	unsigned int busy;		/* number of workers on a path */
+	unsigned int count;		/* total insns disassembled */
+	pthread_mutex_t output_lock;	/* serializes handler and display */
+	opdis_vma_bitmap_t visited;	/* claimed addresses; lock-free */
+};
+
+static void queue_mt_target( struct CFLOW_MT_JOB * job, opdis_t o,
+			     opdis_vma_t target ) {
+	pthread_mutex_lock( &job->lock );
+	if ( opdis_vma_bitmap_add( job->targets, target ) ) {
+		opdis_debug( o, 2, "CFLOW BRANCH START: %p", (void *) target );
+		if ( opdis_worklist_push( job->work, target ) ) {
+			pthread_cond_signal( &job->cond );
+		} else {
+			opdis_error( o, opdis_error_unknown,
+				     "Unable to add branch target" );
+		}
+	}
+	pthread_mutex_unlock( &job->lock );
+}
+
+/* Identical to disasm_cflow_path, except that an address is claimed in the
+ * shared visited set *before* it is disassembled, so that no instruction is
+ * decoded by more than one worker. */
+static unsigned int disasm_cflow_mt_path( struct CFLOW_MT_JOB * job,
+					  opdis_ctx_t ctx, opdis_insn_t * insn,
+					  opdis_vma_t vma ) {
+	int cont = 1;
+	unsigned int count = 0;
+	opdis_off_t pos = vma;
+	opdis_t o = ctx->opdis;
+	opdis_off_t min_pos = ctx->config->buffer_vma;
+	opdis_off_t max_pos = min_pos + ctx->config->buffer_length;
+
+	while ( cont && pos < max_pos ) {
+		opdis_vma_t target;
+		unsigned int size;
+
+		if (! opdis_vma_bitmap_add_atomic( job->visited, pos ) ) {
+			opdis_debug( o, 2, "VMA %p already visited",
+				     (void *) pos );
+			break;
+		}
+
+		size = disasm_single_insn( ctx, pos, insn );
+		pos += size;
+		count++;
+
+		pthread_mutex_lock( &job->output_lock );
+		cont = o->handler( insn, o->handler_arg );
+		if ( cont ) {
+			o->display( insn, o->display_arg );
+		}
+		pthread_mutex_unlock( &job->output_lock );
+
+		if (! opdis_insn_fallthrough( insn ) ) {
+			cont = 0;
+		}
+
+		if (! opdis_insn_is_branch( insn ) ) {
+			continue;
+		}
+
+		target = branch_target( ctx, insn );
+		if ( target != OPDIS_INVALID_ADDR &&
+		     target >= min_pos && target < max_pos ) {
+			queue_mt_target( job, o, target );
+		}
+	}
+
+	return count;
+}
+
+static void * cflow_mt_worker( void * arg ) {
+	struct CFLOW_MT_JOB * job = (struct CFLOW_MT_JOB *) arg;
+	unsigned int count = 0;
+	opdis_insn_t * insn;
+	opdis_ctx_t ctx;
+
+	ctx = opdis_ctx_init( job->ctx->opdis );
+	insn = alloc_fixed_insn();
+	if (! ctx || ! insn ) {
+		opdis_ctx_term( ctx );
+		opdis_insn_free( insn );
+		return NULL;
+	}
+
+	ctx->config->section = job->ctx->config->section;
+	ctx->config->buffer = job->ctx->config->buffer;
+	ctx->config->buffer_vma = job->ctx->config->buffer_vma;
+	ctx->config->buffer_length = job->ctx->config->buffer_length;
+	ctx->cflow = 1;
+
+	pthread_mutex_lock( &job->lock );
+	for (;;) {
+		opdis_vma_t pos;
+
+		while (! opdis_worklist_count( job->work ) && job->busy ) {
+			pthread_cond_wait( &job->cond, &job->lock );
+		}
+
+		if (! opdis_worklist_count( job->work ) ) {
+			/* no work pending and no worker can add more */
+			pthread_cond_broadcast( &job->cond );
+			break;
+		}
+
+		pos = opdis_worklist_pop( job->work );
+		job->busy++;
+		pthread_mutex_unlock( &job->lock );
+
+		count += disasm_cflow_mt_path( job, ctx, insn, pos );
+
+		pthread_mutex_lock( &job->lock );
+		job->busy--;
+		if (! job->busy ) {
+			pthread_cond_broadcast( &job->cond );
+		}
+	}
+	job->count += count;
+	pthread_mutex_unlock( &job->lock );
+
+	opdis_insn_free( insn );
+	opdis_ctx_term( ctx );
+
+	return NULL;
+}
+
+static void cflow_mt_job_free( struct CFLOW_MT_JOB * job ) {
+	opdis_vma_bitmap_free( job->visited );
+	opdis_worklist_free( job->work );
+	opdis_vma_bitmap_free( job->targets );
+	pthread_mutex_destroy( &job->output_lock );
+	pthread_cond_destroy( &job->cond );
+	pthread_mutex_destroy( &job->lock );
+	free( job );
+}
+
+static struct CFLOW_MT_JOB * cflow_mt_job_alloc( opdis_ctx_t ctx ) {
+	struct CFLOW_MT_JOB * job = (struct CFLOW_MT_JOB *) calloc( 1,
+						sizeof(struct CFLOW_MT_JOB) );
+	if (! job ) {
+		return NULL;
+	}
+
+	job->ctx = ctx;
+	pthread_mutex_init( &job->lock, NULL );
+	pthread_cond_init( &job->cond, NULL );
+	pthread_mutex_init( &job->output_lock, NULL );
+
+	job->work = opdis_worklist_init( ctx->opdis->cflow_order );
+	job->targets = opdis_vma_bitmap_init( ctx->config->buffer_vma,
+					      ctx->config->buffer_length );
+	job->visited = opdis_vma_bitmap_init( ctx->config->buffer_vma,
+					      ctx->config->buffer_length );
+
+	if (! job->work || ! job->targets || ! job->visited ) {
+		cflow_mt_job_free( job );
+		return NULL;
+	}
+
+	return job;
+}
+
+static int disasm_cflow_mt( opdis_ctx_t ctx, opdis_vma_t vma,
+			    unsigned int num_threads ) {
+	unsigned int i, num_started = 0;
+	pthread_t * threads;
+	struct CFLOW_MT_JOB * job;
+	opdis_t o = ctx->opdis;
+	opdis_off_t min_pos = ctx->config->buffer_vma;
+	opdis_off_t max_pos = min_pos + ctx->config->buffer_length;
 	int count;
-	opdis_vma_tree_t tree = opdis_vma_tree_init();
 
-	set_opdis_buffer( o, buf );
+	if ( vma < min_pos || vma >= max_pos ) {
+		return 0;
+	}
+
+	job = cflow_mt_job_alloc( ctx );
+	threads = (pthread_t *) calloc( num_threads, sizeof(pthread_t) );
+	if (! job || ! threads ) {
+		fprintf( stderr, "Unable to alloc cflow job\n" );
+		if ( job ) cflow_mt_job_free( job );
+		if ( threads ) free( threads );
+		return 0;
+	}
+
+	opdis_debug( o, 1, "Start cflow from %p max %p (%d threads)",
+		     (void *) vma, (void *) max_pos, num_threads );
+
+	opdis_vma_bitmap_add( job->targets, vma );
+	opdis_worklist_push( job->work, vma );
+	/* no locking needed: the workers have not been started */
+	seed_call_targets( ctx, job->targets, job->work );
 
-	count = disasm_cflow( o, tree, vma );
+	/* the calling thread is one of the workers */
+	for ( i = 1; i < num_threads; i++ ) {
+		if ( pthread_create( &threads[num_started], NULL,
+				     cflow_mt_worker, job ) == 0 ) {
+			num_started++;
+		}
+	}
 
-	opdis_vma_tree_free( tree );
+	cflow_mt_worker( job );
+
+	for ( i = 0; i < num_started; i++ ) {
+		pthread_join( threads[i], NULL );
+	}
+
+	count = job->count;
+
+	opdis_debug( o, 1, "End cflow %p (count %d)", (void *) vma, count );
+
+	free( threads );
+	cflow_mt_job_free( job );
 
 	return count;
 }
 
+#endif
+
+int LIBCALL opdis_disasm_cflow_mt( opdis_t o, opdis_buf_t buf,
+				   opdis_vma_t vma, unsigned int num_threads ) {
+#ifdef HAVE_PTHREAD_H
+	if ( o && buf && num_threads > 1 ) {
+		opdis_context_t ctx;
+		default_ctx( o, &ctx );
+		set_ctx_buffer( &ctx, buf );
+		return disasm_cflow_mt( &ctx, vma, num_threads );
+	}
+#endif
+	return opdis_disasm_cflow( o, buf, vma );
+}
+
 /* ---------------------------------------------------------------------- */
 /* BFD interface */
 
-struct BFD_VMA_SECTION {
-	bfd_vma vma;
-	asection * sec;
-};
+#ifdef HAVE_SYS_MMAN_H
+/* Map the file contents of a section. This is only possible if the file
+ * contents are exactly what bfd_get_section_contents would return. */
+static unsigned char * map_section( opdis_ctx_t ctx, asection * s,
+				    opdis_off_t size ) {
+	bfd * abfd = s->owner;
+	struct stat st, bfd_st;
+	long page = sysconf( _SC_PAGESIZE );
+	off_t offset;
+	size_t delta;
+	void * addr;
+	int fd;
+
+	if (! abfd || ! abfd->filename || abfd->my_archive ||
+	    (abfd->flags & BFD_IN_MEMORY) || ! (s->flags & SEC_HAS_CONTENTS) ||
+	    (s->flags & SEC_IN_MEMORY) || s->filepos < 0 || page <= 0 ) {
+		return NULL;
+	}
+#if HAVE_DECL_BFD_IS_SECTION_COMPRESSED
+	if ( bfd_is_section_compressed( abfd, s ) ) {
+		return NULL;
+	}
+#endif
+
+	if ( bfd_stat( abfd, &bfd_st ) != 0 ) {
+		return NULL;
+	}
+
+	fd = open( abfd->filename, O_RDONLY );
+	if ( fd == -1 ) {
+		return NULL;
+	}
 
-static int load_section( opdis_t o, asection * s ) {
+	/* filename may be relative, replaced, or not the file BFD read */
+	if ( fstat( fd, &st ) == -1 || ! S_ISREG(st.st_mode) ||
+	     st.st_dev != bfd_st.st_dev || st.st_ino != bfd_st.st_ino ||
+	     s->filepos + (off_t) size > st.st_size ) {
+		close( fd );
+		return NULL;
+	}
+
+	/* mmap offset must be page-aligned */
+	offset = s->filepos & ~((off_t) page - 1);
+	delta = s->filepos - offset;
+	addr = mmap( NULL, size + delta, PROT_READ, MAP_PRIVATE, fd, offset );
+	close( fd );
+
+	if ( addr == MAP_FAILED ) {
+		return NULL;
+	}
+
+	ctx->map_addr = addr;
+	ctx->map_len = size + delta;
+
+	return (unsigned char *) addr + delta;
+}
+#endif
+
+static void set_ctx_section( opdis_ctx_t ctx, asection * s,
+			     unsigned char * buf, opdis_off_t size ) {
+	ctx->config->section = s;
+	ctx->config->buffer = buf;
+	ctx->config->buffer_length = size;
+	ctx->config->buffer_vma = bfd_section_vma( s->owner, s );
+}
+
+/* Transfer a loaded section to the section cache, if there is one */
+static void cache_section( opdis_ctx_t ctx ) {
+	opdis_section_cache_t cache = ctx->opdis->section_cache;
+
+	if ( cache && opdis_section_cache_add( cache, ctx->config->section,
+					       ctx->config->buffer,
+					       ctx->config->buffer_length,
+					       ctx->map_addr, ctx->map_len ) ) {
+		ctx->map_addr = NULL;
+		ctx->map_len = 0;
+		ctx->buffer_cached = 1;
+	}
+}
+
+static int load_section( opdis_ctx_t ctx, asection * s ) {
 	int size;
-	unsigned char *buf;
+	unsigned char *buf = NULL;
 	opdis_vma_t vma;
+	opdis_section_cache_entry_t * entry;
+
+	entry = opdis_section_cache_find( ctx->opdis->section_cache, s );
+	if ( entry ) {
+		set_ctx_section( ctx, s, entry->buffer, entry->length );
+		ctx->buffer_cached = 1;
+		return 1;
+	}
 
 	size = bfd_section_size( s->owner, s );
 	vma = bfd_section_vma( s->owner, s );
+
+#ifdef HAVE_SYS_MMAN_H
+	if ( ctx->opdis->mmap_sections && size > 0 ) {
+		buf = map_section( ctx, s, size );
+		if ( buf ) {
+			opdis_debug( ctx->opdis, 2, "Mapped section %s\n",
+				     s->name );
+			set_ctx_section( ctx, s, buf, size );
+			cache_section( ctx );
+			return 1;
+		}
+	}
+#endif
+
 	buf = calloc( size, 1 );
 	if (! buf || ! bfd_get_section_contents( s->owner, s, buf, 0, size ) ) {
 		char msg[32];
 		snprintf( msg, 31, "Unable to get section %s\n", s->name );
-		opdis_error( o, opdis_error_bfd, msg );
+		opdis_error( ctx->opdis, opdis_error_bfd, msg );
+		if ( buf ) free( buf );
 		return 0;
 	}
 
-	opdis_debug( o, 2, "Loaded section of %d bytes [%p-%p]\n", size,
-		     (void *) vma, (void *) (vma + size - 1) );
-	o->config.section = s;
-	o->config.buffer = buf;
-	o->config.buffer_length = size;
-	o->config.buffer_vma = vma;
+	opdis_debug( ctx->opdis, 2, "Loaded section of %d bytes [%p-%p]\n",
+		     size, (void *) vma, (void *) (vma + size - 1) );
+	set_ctx_section( ctx, s, buf, size );
+	cache_section( ctx );
 
 	return 1;
 }
 
-static void vma_in_section( bfd * abfd, asection *s, PTR data ){
-	struct BFD_VMA_SECTION * req = (struct BFD_VMA_SECTION *) data;
-	if ( req && req->vma >= s->vma && req->vma < 
-	     (s->vma + bfd_section_size(abfd, s)) ) {
-		req->sec = s;
+static void unload_section( opdis_ctx_t ctx ) {
+	if ( ctx->buffer_cached ) {
+		/* owned by the section cache */
+		ctx->buffer_cached = 0;
+		ctx->config->buffer = NULL;
+		return;
 	}
+
+#ifdef HAVE_SYS_MMAN_H
+	if ( ctx->map_addr ) {
+		munmap( ctx->map_addr, ctx->map_len );
+		ctx->map_addr = NULL;
+		ctx->map_len = 0;
+		ctx->config->buffer = NULL;
+		return;
+	}
+#endif
+	free( ctx->config->buffer );
+	ctx->config->buffer = NULL;
 }
 
-static int load_section_for_vma( opdis_t o, bfd * abfd, bfd_vma vma ){
-	int size;
-	unsigned char * buf;
-	struct BFD_VMA_SECTION req = { vma, NULL };
+static asection * section_for_vma( opdis_t o, bfd * abfd, bfd_vma vma ) {
+	if (! opdis_section_index_is_for( o->section_index, abfd ) ) {
+		/* index is rebuilt only when a different BFD is used */
+		opdis_section_index_free( o->section_index );
+		o->section_index = opdis_section_index_init( abfd );
+	}
 
-	bfd_map_over_sections( abfd, vma_in_section, & req );
-	if (! req.sec ) {
+	return opdis_section_index_find( o->section_index, vma );
+}
+
+static int load_section_for_vma( opdis_ctx_t ctx, bfd * abfd, bfd_vma vma ){
+	asection * sec = section_for_vma( ctx->opdis, abfd, vma );
+
+	if (! sec ) {
 		char msg[32];
 		snprintf( msg, 31, "No section for VMA %p\n", (void *) vma );
-		opdis_error( o, opdis_error_bfd, msg );
+		opdis_error( ctx->opdis, opdis_error_bfd, msg );
 		return 0;
 	}
 
-	if (! load_section( o, req.sec ) ) {
+	if (! load_section( ctx, sec ) ) {
 		return 0;
 	}
 
@@ -638,20 +1963,21 @@ unsigned int LIBCALL opdis_disasm_bfd_insn( opdis_t o, bfd * abfd,
 					    opdis_vma_t vma, 
 					    opdis_insn_t * insn ) {
 	size_t size;
+	opdis_context_t ctx;
 
 	if (! o || ! abfd ) {
 		return 0;
 	}
 
-	if (! load_section_for_vma(o, abfd, vma) ) {
+	default_ctx( o, &ctx );
+	if (! load_section_for_vma(&ctx, abfd, vma) ) {
 		return 0;
 	}
 
-	size = disasm_single_insn( o, vma, insn );
+	size = disasm_single_insn( &ctx, vma, insn );
 	o->display( insn, o->display_arg );
 
-	free( o->config.buffer );
-	o->config.buffer = NULL;
+	unload_section( &ctx );
 
 	return size;
 }
@@ -659,80 +1985,111 @@ unsigned int LIBCALL opdis_disasm_bfd_insn( opdis_t o, bfd * abfd,
 int LIBCALL opdis_disasm_bfd_linear( opdis_t o, bfd * abfd, opdis_vma_t vma,
 				     opdis_off_t length ) {
 	int count;
+	opdis_context_t ctx;
+
 	if (! o || ! abfd ) {
 		return 0;
 	}
 
-	if (! load_section_for_vma(o, abfd, vma) ) {
+	default_ctx( o, &ctx );
+	if (! load_section_for_vma(&ctx, abfd, vma) ) {
 		return 0;
 	}
 
-	count = disasm_linear( o, vma, length );
+	count = disasm_linear( &ctx, vma, length );
 
-	free( o->config.buffer );
-	o->config.buffer = NULL;
+	unload_section( &ctx );
 
 	return count;
 }
 
 int LIBCALL opdis_disasm_bfd_cflow( opdis_t o, bfd * abfd, opdis_vma_t vma ) {
 	int count;
-	opdis_vma_tree_t tree;
+	opdis_context_t ctx;
 
 	if (! o || ! abfd ) {
 		return 0;
 	}
 
-	if (! load_section_for_vma(o, abfd, vma) ) {
+	default_ctx( o, &ctx );
+	if (! load_section_for_vma(&ctx, abfd, vma) ) {
 		return 0;
 	}
 
-	tree = opdis_vma_tree_init();
+	count = disasm_cflow( &ctx, vma );
+
+	unload_section( &ctx );
 
-	count = disasm_cflow( o, tree, vma );
+	return count;
+}
 
-	opdis_vma_tree_free( tree );
 
-	free( o->config.buffer );
-	o->config.buffer = NULL;
+int LIBCALL opdis_disasm_bfd_cflow_mt( opdis_t o, bfd * abfd, opdis_vma_t vma,
+				       unsigned int num_threads ) {
+#ifdef HAVE_PTHREAD_H
+	int count;
+	opdis_context_t ctx;
+
+	if (! o || ! abfd ) {
+		return 0;
+	}
+
+	if ( num_threads < 2 ) {
+		return opdis_disasm_bfd_cflow( o, abfd, vma );
+	}
+
+	default_ctx( o, &ctx );
+	if (! load_section_for_vma(&ctx, abfd, vma) ) {
+		return 0;
+	}
+
+	count = disasm_cflow_mt( &ctx, vma, num_threads );
+
+	unload_section( &ctx );
 
 	return count;
+#else
+	return opdis_disasm_bfd_cflow( o, abfd, vma );
+#endif
 }
 
 
 int LIBCALL opdis_disasm_bfd_section( opdis_t o, asection * sec ) {
 	int count = 0;
+	opdis_context_t ctx;
+
 	if (! o || ! sec ) {
 		return 0;
 	}
 
-	if ( load_section( o, sec ) ) {
-		count = disasm_linear( o, bfd_section_vma(sec->owner, sec), 0 );
-		free( o->config.buffer );
-		o->config.buffer = NULL;
+	default_ctx( o, &ctx );
+	if ( load_section( &ctx, sec ) ) {
+		count = disasm_linear( &ctx, bfd_section_vma(sec->owner, sec),
+				       0 );
+		unload_section( &ctx );
 	}
 	return count;
 }
 
 
 int LIBCALL opdis_disasm_bfd_symbol( opdis_t o, asymbol * sym ) {
-	int count;
-	opdis_vma_tree_t tree;
-	asection * sec = sym->section;
-	if (! o || ! sym || ! sec ) {
+	int count = 0;
+	asection * sec;
+	opdis_context_t ctx;
+
+	if (! o || ! sym || ! sym->section ) {
 		return 0;
 	}
 
-	if ( load_section( o, sec ) ) {
+	sec = sym->section;
+	default_ctx( o, &ctx );
+	if ( load_section( &ctx, sec ) ) {
 		symbol_info info;
 		bfd_symbol_info( sym, &info );
 
-		tree = opdis_vma_tree_init();
-		count = disasm_cflow( o, tree, info.value );
-		opdis_vma_tree_free( tree );
+		count = disasm_cflow( &ctx, info.value );
 
-		free( o->config.buffer );
-		o->config.buffer = NULL;
+		unload_section( &ctx );
 	}
 	return count;
 }
@@ -745,7 +2102,6 @@ int LIBCALL opdis_disasm_bfd_entry( opdis_t o, bfd * abfd ) {
 	return opdis_disasm_bfd_cflow( o, abfd, bfd_get_start_address(abfd) );
 }
 
-
 /* ---------------------------------------------------------------------- */
 void LIBCALL opdis_error( opdis_t o, enum opdis_error_t error, 
 			  const char * msg ) {
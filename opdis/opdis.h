@@ -13,10 +13,12 @@
 
 #include <dis-asm.h>		/* libopcodes (provided by binutils-dev) */
 
+#include <opdis/opdis_config.h>
 #include <opdis/types.h>
 #include <opdis/insn_buf.h>
 #include <opdis/model.h>
 #include <opdis/tree.h>
+#include <opdis/bitmap.h>
 
 #ifdef WIN32
         #define LIBCALL _stdcall
@@ -54,9 +56,9 @@ typedef int (*OPDIS_HANDLER) ( const opdis_insn_t * i, void * arg );
  * The default handler returns true unless the instruction is invalid or
  * if the address has already been visited.
  * \note The default handler callback takes an opdis_t as the \e arg
- *       parameter. If this parameter is NULL, or if the \e visited_addr
- *       field of the opdis_t is NULL, the handler will not check
- *       check if an address has already been visited.
+ *       parameter. If this parameter is NULL, or if both the \e visited_map
+ *       and \e visited_addr fields of the opdis_t are NULL, the handler
+ *       will not check if an address has already been visited.
  */
 int opdis_default_handler( const opdis_insn_t * i, void * arg );
 
@@ -133,6 +135,9 @@ typedef int (*OPDIS_DECODER) ( const opdis_insn_buf_t in,
  * This callback fills the \e ascii, \e offset, \e vma, \e bytes,
  * and \e size fields of the output instruction object. It is recommended 
  * that all other decoders invoke this callback directly to fill these fields.
+ * If libopcodes reported the type of the instruction (the \e insn_info_valid
+ * field of the buffer), branches are also given a control-flow category
+ * and flags.
  * \note The default decoder callback takes a NULL \e arg parameter.
  */
 int opdis_default_decoder( const opdis_insn_buf_t in, opdis_insn_t * out,
@@ -140,6 +145,27 @@ int opdis_default_decoder( const opdis_insn_buf_t in, opdis_insn_t * out,
 			   opdis_vma_t vma, opdis_off_t length,
 			   void * arg );
 
+/*!
+ * \fn int opdis_styled_decoder( const opdis_insn_buf_t, opdis_insn_t *,
+			         const opdis_byte_t *, opdis_off_t, 
+				 opdis_vma_t, opdis_off_t, void * )
+ * \ingroup configuration
+ * \brief A decoder for any architecture, using the styles of libopcodes items.
+ * \details This invokes opdis_default_decoder, then uses the style of each
+ *          item emitted by libopcodes (see opdis_token_style_t) to fill the
+ *          prefixes, mnemonic, operands and comment of the instruction.
+ *          Operands are classified as registers, immediates or address
+ *          expressions from their styles alone; register details, such as
+ *          the register id, are not filled.
+ * \note If libopcodes does not emit styled items, this is equivalent to
+ *       opdis_default_decoder.
+ * \note This is the default decoder for architectures other than x86.
+ */
+int opdis_styled_decoder( const opdis_insn_buf_t in, opdis_insn_t * out,
+			  const opdis_byte_t * buf, opdis_off_t,
+			  opdis_vma_t vma, opdis_off_t length,
+			  void * arg );
+
 /*!
  * \typedef opdis_vma_t (*OPDIS_RESOLVER) ( const opdis_insn_t * i, 
  * 					     void * arg )
@@ -207,17 +233,45 @@ typedef void (*OPDIS_ERROR) ( enum opdis_error_t error, const char * msg,
 void opdis_default_error_reporter( enum opdis_error_t error, const char * msg,
 			      void * arg );
 
+/*!
+ * \enum opdis_cflow_order_t
+ * \ingroup configuration
+ * \brief Order in which control-flow disassembly follows branch targets.
+ * \details Branch targets discovered during control-flow disassembly are
+ *          stored in a worklist until they are disassembled. The order
+ *          determines which pending target is disassembled next.
+ */
+enum opdis_cflow_order_t {
+	opdis_cflow_order_dfs,	/*!< Most recently found target first */
+	opdis_cflow_order_bfs,	/*!< Least recently found target first */
+	opdis_cflow_order_addr	/*!< Lowest target address first */
+};
+
+/*!
+ * \struct opdis_decode_cache_stats_t
+ * \ingroup configuration
+ * \brief Usage statistics for a decode cache.
+ * \sa opdis_set_decode_cache opdis_decode_cache_stats
+ */
+typedef struct {
+	unsigned long lookups;		/*!< Instructions looked up */
+	unsigned long hits;		/*!< Lookups that found an instruction */
+	unsigned long inserts;		/*!< Instructions added */
+	unsigned long evictions;	/*!< Instructions replaced by inserts */
+	unsigned long uncacheable;	/*!< Instructions which depend on VMA */
+} opdis_decode_cache_stats_t;
+
 /* ---------------------------------------------------------------------- */
 
 /*!
  * \struct opdis_info_t
  * \ingroup configuration
  * \brief An opdis disassembler
- * \note The \e visited_addr tree is NULL by default. Both 
- *       opdis_disasm_cflow and opdis_disasm_bfd_cflow create this tree
- *       if \e visited_addr is NULL. This means that linear disassembly
- *       will not check if an address exists before invoking the display
- *       callback.
+ * \note The \e visited_map bitmap and \e visited_addr tree are NULL by
+ *       default. The control-flow disassemblers create a bitmap covering
+ *       the buffer for the duration of the job if both are NULL. This
+ *       means that linear disassembly will not check if an address exists
+ *       before invoking the display callback.
  */
 typedef struct {
 	/*! \var config
@@ -282,6 +336,65 @@ typedef struct {
 	 */
 	opdis_vma_tree_t visited_addr;
 
+	/*! \var visited_map
+	 *  \brief Bitmap of all VMAs that have been disassembled and displayed.
+	 *  \details A bitmap covering a fixed address range, normally that of
+	 *   the buffer being disassembled. The default handler checks this
+	 *   before \e visited_addr for any address in its range. Membership
+	 *   tests are constant-time and adding an address never allocates
+	 *   memory, so this is much faster than \e visited_addr.
+	 *  \sa opdis_vma_bitmap_init
+	 */
+	opdis_vma_bitmap_t visited_map;
+
+	/*! \var cflow_order
+	 *  \brief Order in which control-flow disassembly visits targets.
+	 */
+	enum opdis_cflow_order_t cflow_order;
+
+	/*! \var cflow_call_seeds
+	 *  \brief Seed control-flow disassembly with scanned call targets.
+	 *  \sa opdis_set_cflow_call_seeds
+	 */
+	int cflow_call_seeds;
+
+	/*! \var mmap_sections
+	 *  \brief Map BFD sections from their file instead of copying them.
+	 *  \sa opdis_set_mmap_sections
+	 */
+	int mmap_sections;
+
+	/*! \var section_cache
+	 *  \brief Cache of loaded BFD sections, or NULL.
+	 *  \sa opdis_set_section_cache
+	 */
+	struct opdis_section_cache * section_cache;
+
+	/*! \var section_index
+	 *  \brief Index of sections in the most recently used BFD.
+	 *  \details This is built on demand by the BFD disassembly routines
+	 *           to find the section containing a VMA.
+	 */
+	struct opdis_section_index * section_index;
+
+	/*! \var decode_cache
+	 *  \brief Cache of decoded instructions, or NULL.
+	 *  \sa opdis_set_decode_cache
+	 */
+	struct opdis_decode_cache * decode_cache;
+
+	/*! \var decode_level
+	 *  \brief opdis_insn_decode_t fields which the decoder fills.
+	 *  \sa opdis_set_decode_level
+	 */
+	unsigned int decode_level;
+
+	/*! \var x86_native
+	 *  \brief Decode x86 instructions from their bytes when possible.
+	 *  \sa opdis_set_x86_native
+	 */
+	int x86_native;
+
 	/*! \var debug
 	 *  \brief Print debug info to STDERR
 	 */
@@ -296,6 +409,55 @@ typedef struct {
 
 typedef opdis_info_t * opdis_t;
 
+/*!
+ * \struct opdis_context_t
+ * \ingroup configuration
+ * \brief Per-thread state for an opdis disassembler.
+ * \details An opdis_t contains both configuration (the architecture,
+ *          libopcodes routine, and callbacks) and the scratch state that
+ *          is modified while an instruction is disassembled: the
+ *          libopcodes \e config buffer and output fields, and the
+ *          instruction buffer. A context holds a private copy of that
+ *          scratch state, so several threads can disassemble with one
+ *          opdis_t, each through its own context.
+ * \note The libopcodes configuration is copied when the context is
+ *       created; a context will not see changes to the opdis_t made
+ *       after it was created.
+ * \note Not all state is private to a context:
+ *       - The handler and resolver callbacks are shared. The default
+ *         handler is passed the opdis_t as its argument and records
+ *         visited addresses in its \e visited_map or \e visited_addr,
+ *         so it must not be used by more than one thread at a time.
+ *       - The copied libopcodes configuration shares \e private_data
+ *         with the opdis_t. The x86 backend keeps its state on the
+ *         stack for each instruction, but other libopcodes backends
+ *         modify the shared \e private_data; contexts for non-x86
+ *         architectures must not be used concurrently.
+ * \sa opdis_ctx_init
+ */
+typedef struct {
+	opdis_t opdis;			/*!< Shared configuration */
+	disassemble_info * config;	/*!< libopcodes state for this context */
+	opdis_insn_buf_t buf;		/*!< libopcodes output for this context */
+	disassemble_info config_data;	/*!< Storage for \e config */
+	void * map_addr;		/*!< Mapping backing config->buffer */
+	size_t map_len;			/*!< Size of \e map_addr mapping */
+	int buffer_cached;		/*!< config->buffer is in section cache */
+	struct opdis_decode_cache * decode_cache; /*!< Decode cache, or NULL */
+	/*! libopcodes print_address_func wrapped while decode cache is used */
+	void (*print_address) (bfd_vma, struct disassemble_info *);
+	int printed_address;		/*!< libopcodes printed an address */
+	int cflow;			/*!< Control-flow disassembly running */
+} opdis_context_t;
+
+/*!
+ * \typedef opdis_context_t * opdis_ctx_t
+ * \ingroup configuration
+ * \brief Disassembler context handle (pointer to opdis_context_t).
+ */
+
+typedef opdis_context_t * opdis_ctx_t;
+
 /* ---------------------------------------------------------------------- */
 
 /*!
@@ -349,7 +511,9 @@ void LIBCALL opdis_config_from_bfd( opdis_t o, bfd * target );
  * \details Allocates an opdis_t and fills it based on the provided opdis_t. 
  * This is used when running multiple threads in a single target, as one 
  * opdis_t must be used per-thread..
- * \sa opdis_init opdis_term
+ * \sa opdis_init opdis_term opdis_ctx_init opdis_disasm_cflow_mt
+ * \note Threads which only need to disassemble with the same configuration
+ *       should share one opdis_t and use an opdis_ctx_t each.
  * \return An opdis disassembler object
  */
 
@@ -366,6 +530,33 @@ opdis_t LIBCALL opdis_dupe( opdis_t );
 
 void LIBCALL opdis_term( opdis_t o );
 
+/*!
+ * \fn opdis_ctx_init( opdis_t )
+ * \ingroup disassembly
+ * \brief Create a disassembly context for an opdis disassembler
+ * \details Allocates an opdis_ctx_t which disassembles using the
+ *          configuration and callbacks of \e o. The opdis_t is not copied,
+ *          and must not be freed until all of its contexts have been freed.
+ * \param o The opdis disassembler to use.
+ * \sa opdis_ctx_term opdis_ctx_disasm_insn opdis_ctx_disasm_linear
+ * \sa opdis_ctx_disasm_cflow
+ * \return An opdis disassembler context.
+ * \note The callbacks of \e o are invoked by every context, and must be
+ *       threadsafe if contexts are used in more than one thread.
+ */
+
+opdis_ctx_t LIBCALL opdis_ctx_init( opdis_t o );
+
+/*!
+ * \fn opdis_ctx_term( opdis_ctx_t )
+ * \ingroup disassembly
+ * \brief Free a disassembly context
+ * \param ctx The context to free
+ * \sa opdis_ctx_init
+ */
+
+void LIBCALL opdis_ctx_term( opdis_ctx_t ctx );
+
 
 /*!
  * \fn opdis_set_defaults( opdis_t )
@@ -380,7 +571,12 @@ void LIBCALL opdis_term( opdis_t o );
  */
 void LIBCALL opdis_set_defaults( opdis_t o );
 
+#if OPDIS_HAVE_STYLED_INIT
+typedef void (*OPCODES_INIT) (struct disassemble_info *, void *, fprintf_ftype,
+			      fprintf_styled_ftype);
+#else
 typedef void (*OPCODES_INIT) (struct disassemble_info *, void *, fprintf_ftype);
+#endif
 
 /*!
  * \fn opdis_override_opcodes_init( opdis_t o, OPCODES_INIT fn );
@@ -421,6 +617,27 @@ enum opdis_x86_syntax_t {
  */
 void LIBCALL opdis_set_x86_syntax( opdis_t o, enum opdis_x86_syntax_t syntax );
 
+/*!
+ * \fn opdis_set_x86_native( opdis_t, int )
+ * \ingroup configuration
+ * \brief Decode x86 instructions without libopcodes where possible.
+ * \details When enabled, each x86 instruction is first passed to
+ *          opdis_x86_native_decode, which builds the opdis_insn_t directly
+ *          from the instruction bytes, instead of having libopcodes print
+ *          the instruction and then parsing the output. Instructions
+ *          which it does not support are disassembled by libopcodes and
+ *          the decoder as usual.
+ * \param o opdis disassembler to configure.
+ * \param enabled Nonzero to use the native decoder.
+ * \note The decoder callback is not invoked for natively decoded
+ *       instructions. Enable this only with the built-in x86 decoders.
+ * \note Addresses are printed as by the default libopcodes
+ *       print_address_func; if the disassemble_info print_address_func
+ *       has been replaced, every instruction is disassembled by libopcodes.
+ * \note The native decoder is disabled by default.
+ */
+void LIBCALL opdis_set_x86_native( opdis_t o, int enabled );
+
 /*!
  * \fn opdis_set_arch( opdis_t, enum bfd_architecture, unsigned long mach,
  * 		       disassembler_ftype )
@@ -521,6 +738,29 @@ void LIBCALL opdis_set_handler( opdis_t o, OPDIS_HANDLER fn, void * arg );
  */
 void LIBCALL opdis_set_decoder( opdis_t o, OPDIS_DECODER fn, void * arg );
 
+/*!
+ * \fn opdis_set_decode_level( opdis_t, unsigned int )
+ * \ingroup configuration
+ * \brief Set how much of each instruction the decoder fills.
+ * \details Most of the time spent decoding an instruction goes to parsing
+ *          the mnemonic and operands out of the libopcodes strings. An
+ *          application which only needs the ASCII representation, size
+ *          and bytes of each instruction (e.g. a listing) can skip this
+ *          by setting the level to opdis_decode_basic. The level is a
+ *          mask of opdis_insn_decode_t values; the default is
+ *          OPDIS_DECODE_ALL. The \e status field of each opdis_insn_t
+ *          reports what was actually decoded.
+ * \param o opdis disassembler to configure.
+ * \param level A mask of opdis_insn_decode_t values.
+ * \note opdis_decode_op_flags implies opdis_decode_ops. Control-flow
+ *       disassembly always decodes the mnemonic flags of each instruction
+ *       and the operands of branch instructions, as it needs them to
+ *       find branch targets.
+ * \note The x86 decoders and opdis_styled_decoder honor the decode level;
+ *       custom decoders may ignore it.
+ */
+void LIBCALL opdis_set_decode_level( opdis_t o, unsigned int level );
+
 /*!
  * \fn opdis_set_resolver( opdis_t, OPDIS_RESOLVER, void * )
  * \ingroup configuration
@@ -536,9 +776,147 @@ void LIBCALL opdis_set_decoder( opdis_t o, OPDIS_DECODER fn, void * arg );
  *       a valid offset or -1 if no address can be determined. The
  *       resolver can be a subsystem that manages the stack and registers
  *       in order to provide more complete branch resolution.
+ * \note The default resolver is not called for branches whose target was
+ *       computed by libopcodes itself (see opdis_insn_buffer_t). A custom
+ *       resolver is called for every branch.
  */
 void LIBCALL opdis_set_resolver( opdis_t o, OPDIS_RESOLVER fn, void * arg );
 
+/*!
+ * \fn opdis_set_cflow_order( opdis_t, enum opdis_cflow_order_t )
+ * \ingroup configuration
+ * \brief Set the order in which control-flow disassembly follows branches.
+ * \details Control-flow disassembly keeps a worklist of branch targets that
+ *          have not yet been disassembled. Depth-first order (the default)
+ *          follows the most recently discovered target, which keeps the
+ *          disassembly of a routine close together in memory. Breadth-first
+ *          order follows targets in the order they were discovered, and
+ *          address order always disassembles the lowest pending target.
+ * \param o opdis disassembler to configure.
+ * \param order The order to use.
+ * \note The worklist uses a constant amount of stack regardless of the
+ *       order, so deeply-nested call graphs will not exhaust the stack.
+ */
+void LIBCALL opdis_set_cflow_order( opdis_t o, enum opdis_cflow_order_t order );
+
+/*!
+ * \fn opdis_set_cflow_call_seeds( opdis_t, int )
+ * \ingroup configuration
+ * \brief Add the targets of direct calls as control-flow starting points.
+ * \details Control-flow disassembly only reaches code which is branched to
+ *          from its starting address, so in a stripped binary every routine
+ *          called only through a function pointer is missed. When this is
+ *          enabled, the buffer is first scanned with opdis_x86_call_targets
+ *          and every target found is queued along with the starting
+ *          address. This is much cheaper than a linear disassembly of the
+ *          buffer, and the targets are still disassembled by following
+ *          control flow.
+ * \param o opdis disassembler to configure.
+ * \param enabled Nonzero to seed control-flow disassembly with call targets.
+ * \note The scan is only performed for x86 code. Because the bytes are not
+ *       disassembled first, a small number of targets may be found in
+ *       data or in the middle of other instructions.
+ * \note This is disabled by default.
+ */
+void LIBCALL opdis_set_cflow_call_seeds( opdis_t o, int enabled );
+
+/*!
+ * \fn opdis_set_mmap_sections( opdis_t, int )
+ * \ingroup bfd
+ * \brief Map BFD sections into memory instead of copying them.
+ * \details By default, the BFD disassembly routines allocate a buffer the
+ *          size of the section and copy the section contents into it with
+ *          bfd_get_section_contents. When this is enabled, the section is
+ *          instead mapped read-only from the file with mmap(), so no copy
+ *          is made and pages are only read as they are disassembled.
+ * \param o opdis disassembler to configure.
+ * \param enabled Nonzero to map sections, 0 to copy them.
+ * \note Only sections of BFDs opened from a regular file are mapped. Sections
+ *       in archive members, in-memory BFDs, compressed sections, and
+ *       sections whose contents have been modified in memory are copied
+ *       as usual. The file is reopened by the BFD's filename, and is only
+ *       mapped if it is the same file (device and inode) that BFD opened.
+ *       On systems without mmap(), sections are always copied.
+ */
+void LIBCALL opdis_set_mmap_sections( opdis_t o, int enabled );
+
+/*!
+ * \fn opdis_set_section_cache( opdis_t, size_t )
+ * \ingroup bfd
+ * \brief Keep loaded BFD sections in memory between calls.
+ * \details By default, every BFD disassembly routine loads the section it
+ *          disassembles and releases it before returning. This means that
+ *          disassembling each symbol or instruction in a section with
+ *          opdis_disasm_bfd_symbol or opdis_disasm_bfd_insn loads the
+ *          entire section once per call. When a section cache is set,
+ *          loaded sections are kept until the total size of all cached
+ *          sections exceeds \e budget, at which point the least recently
+ *          used sections are released.
+ * \param o opdis disassembler to configure.
+ * \param budget The maximum number of bytes of section contents to keep,
+ *        or 0 to disable the cache.
+ * \note Calling this releases all sections in the existing cache. Sections
+ *       are identified by their asection pointer and the unique ID of
+ *       their BFD, so a section of a closed BFD is never returned for a
+ *       section of a new BFD at the same address. Its contents are
+ *       released when it is found to be stale or is evicted.
+ * \note A section larger than \e budget is never cached.
+ */
+void LIBCALL opdis_set_section_cache( opdis_t o, size_t budget );
+
+/*!
+ * \fn opdis_set_decode_cache( opdis_t, size_t )
+ * \ingroup configuration
+ * \brief Reuse decoded instructions for repeated byte sequences.
+ * \details When a decode cache is set, each decoded instruction is stored
+ *          in the cache keyed on its bytes. When the same bytes are found
+ *          at another address, the stored instruction is copied and its
+ *          \e vma and \e offset fields are updated; neither libopcodes nor
+ *          the decoder is invoked. The cache is flushed whenever the
+ *          architecture, libopcodes routine, disassembler options,
+ *          decoder or decoder argument change.
+ * \param o opdis disassembler to configure.
+ * \param num_slots The number of instructions to keep, or 0 to disable
+ *        the cache. This is rounded up to a power of two.
+ * \note Instructions for which libopcodes printed an address (e.g.
+ *       relative branches, or x86 RIP-relative operands) depend on their
+ *       VMA and are never cached.
+ * \note The decoder must not derive any field from the \e vma or
+ *       \e offset it is passed, other than the fields of the same name.
+ * \note Instructions can only be looked up if their size can be
+ *       determined without libopcodes; at present this means x86.
+ *       Other architectures are disassembled as if there were no cache.
+ * \note Each context created by opdis_ctx_init has a private cache of the
+ *       same size.
+ * \sa opdis_decode_cache_stats
+ */
+void LIBCALL opdis_set_decode_cache( opdis_t o, size_t num_slots );
+
+/*!
+ * \fn opdis_decode_cache_stats( opdis_t, opdis_decode_cache_stats_t * )
+ * \ingroup configuration
+ * \brief Get the usage statistics of the decode cache of an opdis_t.
+ * \param o opdis disassembler.
+ * \param stats The statistics to fill.
+ * \return 1 if \e o has a decode cache, 0 otherwise.
+ * \sa opdis_set_decode_cache opdis_ctx_decode_cache_stats
+ */
+int LIBCALL opdis_decode_cache_stats( opdis_t o,
+				      opdis_decode_cache_stats_t * stats );
+
+/*!
+ * \fn opdis_ctx_decode_cache_stats( opdis_ctx_t,
+ * 				    opdis_decode_cache_stats_t * )
+ * \ingroup configuration
+ * \brief Get the usage statistics of the decode cache of a context.
+ * \param ctx opdis disassembler context.
+ * \param stats The statistics to fill.
+ * \return 1 if \e ctx has a decode cache, 0 otherwise.
+ * \sa opdis_set_decode_cache opdis_decode_cache_stats
+ */
+int LIBCALL opdis_ctx_decode_cache_stats( opdis_ctx_t ctx,
+					  opdis_decode_cache_stats_t * stats );
+
 /*!
  * \fn opdis_set_error_reporter( opdis_t, OPDIS_ERROR, void * )
  * \ingroup configuration
@@ -559,10 +937,27 @@ void LIBCALL opdis_set_error_reporter( opdis_t o, OPDIS_ERROR fn, void * arg );
  * \param buf The buffer to disassemble
  * \param vma The address (VMA) in the buffer to disassemble.
  * \note If the vma of \e buf is 0, then \e vma is the offset into the buffer.
+ * \note For x86 targets, the size is determined by opdis_x86_insn_size
+ *       where possible; libopcodes is only invoked for instructions that
+ *       it cannot size, or when the disassembler options include one
+ *       (such as addr16 or data16) which it does not support.
  */
 unsigned int LIBCALL opdis_disasm_insn_size( opdis_t o, opdis_buf_t buf, 
 					     opdis_vma_t vma );
 
+/*!
+ * \fn opdis_ctx_disasm_insn_size( opdis_ctx_t, opdis_buf_t, opdis_vma_t )
+ * \ingroup disassembly
+ * \brief Return the size of the instruction at an offset in the buffer.
+ * \details Identical to opdis_disasm_insn_size(), but uses a context.
+ * \param ctx opdis disassembler context
+ * \param buf The buffer to disassemble
+ * \param vma The address (VMA) in the buffer to disassemble.
+ */
+unsigned int LIBCALL opdis_ctx_disasm_insn_size( opdis_ctx_t ctx,
+						 opdis_buf_t buf,
+						 opdis_vma_t vma );
+
 // TODO: opdis_disam_invariant
 //       * wraps decoder
 //       * after decode, find addr arguments in insns bytes (search backwards
@@ -581,6 +976,21 @@ unsigned int LIBCALL opdis_disasm_insn( opdis_t o, opdis_buf_t buf,
 					opdis_vma_t vma, 
 					opdis_insn_t * insn );
 
+/*!
+ * \fn opdis_ctx_disasm_insn( opdis_ctx_t, opdis_buf_t, opdis_vma_t,
+ * 			      opdis_insn_t * )
+ * \ingroup disassembly
+ * \brief Disassemble a single instruction in the buffer
+ * \details Identical to opdis_disasm_insn(), but uses a context.
+ * \param ctx opdis disassembler context
+ * \param buf The buffer to disassemble
+ * \param vma The address (VMA) in the buffer to disassemble.
+ * \param insn The op_insn_t to fill with the disassembled instruction
+ */
+unsigned int LIBCALL opdis_ctx_disasm_insn( opdis_ctx_t ctx, opdis_buf_t buf,
+					    opdis_vma_t vma,
+					    opdis_insn_t * insn );
+
 /*!
  * \fn opdis_disasm_linear( opdis_t, opdis_buf_t, opdis_vma_t, opdis_off_t )
  * \ingroup disassembly
@@ -595,6 +1005,112 @@ unsigned int LIBCALL opdis_disasm_insn( opdis_t o, opdis_buf_t buf,
  */
 int LIBCALL opdis_disasm_linear( opdis_t o, opdis_buf_t buf, opdis_vma_t vma,
 				 opdis_off_t length );
+
+/*!
+ * \fn opdis_ctx_disasm_linear( opdis_ctx_t, opdis_buf_t, opdis_vma_t,
+ * 				opdis_off_t )
+ * \ingroup disassembly
+ * \brief Disassemble a sequence of instructions in order.
+ * \details Identical to opdis_disasm_linear(), but uses a context.
+ * \param ctx opdis disassembler context
+ * \param buf The buffer to disassemble
+ * \param vma The address (VMA) in the buffer to start disassembly at.
+ * \param length The number of bytes to disassemble.
+ */
+int LIBCALL opdis_ctx_disasm_linear( opdis_ctx_t ctx, opdis_buf_t buf,
+				     opdis_vma_t vma, opdis_off_t length );
+
+/*!
+ * \fn opdis_disasm_insn_map( opdis_t, opdis_buf_t, opdis_vma_t, opdis_off_t )
+ * \ingroup disassembly
+ * \brief Map the instruction starts of a linear disassembly of a buffer.
+ * \details This determines the address of every instruction that
+ *          opdis_disasm_linear would disassemble in the range, without
+ *          decoding or printing the instructions and without invoking any
+ *          callbacks. Bytes that do not begin a valid instruction are
+ *          skipped one at a time. The resulting map can be used to split
+ *          a buffer at instruction boundaries or to test whether an
+ *          address is an instruction start.
+ * \param o opdis disassembler
+ * \param buf The buffer to disassemble
+ * \param vma The address (VMA) in the buffer to start at.
+ * \param length The number of bytes to map, or 0 for the rest of the buffer.
+ * \return The instruction start map, or NULL. The caller must free the map
+ *         with opdis_insn_map_free.
+ * \note On x86, instruction sizes are determined by opdis_x86_insn_size
+ *       where possible.
+ */
+opdis_insn_map_t LIBCALL opdis_disasm_insn_map( opdis_t o, opdis_buf_t buf,
+						opdis_vma_t vma,
+						opdis_off_t length );
+
+/*!
+ * \fn opdis_ctx_disasm_insn_map( opdis_ctx_t, opdis_buf_t, opdis_vma_t,
+ *				  opdis_off_t )
+ * \ingroup disassembly
+ * \brief Map the instruction starts of a linear disassembly of a buffer.
+ * \details Identical to opdis_disasm_insn_map(), but uses a context.
+ * \param ctx opdis disassembler context
+ * \param buf The buffer to disassemble
+ * \param vma The address (VMA) in the buffer to start at.
+ * \param length The number of bytes to map, or 0 for the rest of the buffer.
+ */
+opdis_insn_map_t LIBCALL opdis_ctx_disasm_insn_map( opdis_ctx_t ctx,
+						    opdis_buf_t buf,
+						    opdis_vma_t vma,
+						    opdis_off_t length );
+
+/*!
+ * \fn opdis_disasm_batch( opdis_t, opdis_buf_t, opdis_vma_t, opdis_off_t,
+ * 			   opdis_insn_t *, unsigned int )
+ * \ingroup disassembly
+ * \brief Disassemble a sequence of instructions into an array.
+ * \details This disassembles up to \e count instructions in order,
+ *          starting at \e vma, and stores them in consecutive elements of
+ *          \e insns. Unlike opdis_disasm_linear, the display and handler
+ *          callbacks are not invoked. Disassembly stops when an
+ *          instruction cannot be read, i.e. libopcodes returns a size of
+ *          0, or when an instruction extends past \e length. Invalid
+ *          instructions that libopcodes can size (e.g. x86 "(bad)") do
+ *          not stop disassembly: they are stored like any other
+ *          instruction, with the \e status set by the decoder, which is
+ *          not necessarily \ref opdis_decode_invalid.
+ * \param o opdis disassembler
+ * \param buf The buffer to disassemble
+ * \param vma The address (VMA) in the buffer to start disassembly at.
+ * \param length The maximum number of bytes to disassemble, or 0 for
+ *        all bytes from \e vma to the end of the buffer.
+ * \param insns Array of at least \e count instructions to fill.
+ * \param count The maximum number of instructions to disassemble.
+ * \return The number of instructions stored in \e insns.
+ * \sa opdis_insn_array_alloc_fixed
+ * \note Use the \e vma and \e size of the last instruction returned to
+ *       continue disassembly with a subsequent call.
+ */
+unsigned int LIBCALL opdis_disasm_batch( opdis_t o, opdis_buf_t buf,
+					 opdis_vma_t vma, opdis_off_t length,
+					 opdis_insn_t * insns,
+					 unsigned int count );
+
+/*!
+ * \fn opdis_ctx_disasm_batch( opdis_ctx_t, opdis_buf_t, opdis_vma_t,
+ * 			       opdis_off_t, opdis_insn_t *, unsigned int )
+ * \ingroup disassembly
+ * \brief Disassemble a sequence of instructions into an array.
+ * \details Identical to opdis_disasm_batch(), but uses a context.
+ * \param ctx opdis disassembler context
+ * \param buf The buffer to disassemble
+ * \param vma The address (VMA) in the buffer to start disassembly at.
+ * \param length The maximum number of bytes to disassemble, or 0.
+ * \param insns Array of at least \e count instructions to fill.
+ * \param count The maximum number of instructions to disassemble.
+ * \return The number of instructions stored in \e insns.
+ */
+unsigned int LIBCALL opdis_ctx_disasm_batch( opdis_ctx_t ctx,
+					     opdis_buf_t buf, opdis_vma_t vma,
+					     opdis_off_t length,
+					     opdis_insn_t * insns,
+					     unsigned int count );
 /*!
  * \fn opdis_disasm_cflow( opdis_t, opdis_buf_t, opdis_vma_t )
  * \ingroup disassembly
@@ -606,6 +1122,43 @@ int LIBCALL opdis_disasm_linear( opdis_t o, opdis_buf_t buf, opdis_vma_t vma,
  */
 int LIBCALL opdis_disasm_cflow( opdis_t o, opdis_buf_t buf, 
 				opdis_vma_t vma );
+
+/*!
+ * \fn opdis_ctx_disasm_cflow( opdis_ctx_t, opdis_buf_t, opdis_vma_t )
+ * \ingroup disassembly
+ * \brief Disassemble a buffer following flow of control.
+ * \details Identical to opdis_disasm_cflow(), but uses a context.
+ * \param ctx opdis disassembler context
+ * \param buf The buffer to disassemble
+ * \param vma The address (VMA) of the entry point in the buffer
+ */
+int LIBCALL opdis_ctx_disasm_cflow( opdis_ctx_t ctx, opdis_buf_t buf,
+				    opdis_vma_t vma );
+/*!
+ * \fn opdis_disasm_cflow_mt( opdis_t, opdis_buf_t, opdis_vma_t, unsigned int )
+ * \ingroup disassembly
+ * \brief Disassemble a buffer following flow of control using multiple threads.
+ * \details Branch targets are shared between \e num_threads workers, each of
+ *          which disassembles with its own context (see opdis_ctx_init())
+ *          for \e o.
+ *          The workers share a set of visited addresses, and an address is
+ *          claimed in this set before it is disassembled, so no instruction
+ *          is decoded more than once.
+ * \param o opdis disassembler
+ * \param buf The buffer to disassemble
+ * \param vma The address (VMA) of the entry point in the buffer
+ * \param num_threads The number of worker threads, including the caller.
+ * \note The handler and display callbacks are invoked while holding a lock
+ *       shared by all workers, so they never run concurrently. The resolver,
+ *       decoder, and error reporter callbacks are not serialized, and must
+ *       be threadsafe.
+ * \note Instructions are displayed in a nondeterministic order; the display
+ *       callback should store them in an opdis_insn_tree_t.
+ * \note If \e num_threads is less than 2, or if libopdis was built without
+ *       POSIX threads, this is equivalent to opdis_disasm_cflow().
+ */
+int LIBCALL opdis_disasm_cflow_mt( opdis_t o, opdis_buf_t buf, 
+				   opdis_vma_t vma, unsigned int num_threads );
 /*!
  * \fn opdis_disasm_insn( opdis_t, bfd *, opdis_vma_t, opdis_insn_t * )
  * \ingroup bfd
@@ -642,6 +1195,19 @@ int LIBCALL opdis_disasm_bfd_linear( opdis_t o, bfd * abfd, opdis_vma_t vma,
  */
 int LIBCALL opdis_disasm_bfd_cflow( opdis_t o, bfd * abfd, opdis_vma_t vma );
 
+/*!
+ * \fn opdis_disasm_bfd_cflow_mt( opdis_t, bfd *, opdis_vma_t, unsigned int )
+ * \ingroup bfd
+ * \brief Disassemble a BFD following flow of control using multiple threads.
+ * \param o opdis disassembler
+ * \param abfd The BFD to disassemble
+ * \param vma The address (VMA) of the entry point in the BFD
+ * \param num_threads The number of worker threads, including the caller.
+ * \sa opdis_disasm_cflow_mt
+ */
+int LIBCALL opdis_disasm_bfd_cflow_mt( opdis_t o, bfd * abfd, opdis_vma_t vma,
+				       unsigned int num_threads );
+
 /*!
  * \fn opdis_disasm_bfd_section( opdis_t, asection * )
  * \ingroup bfd
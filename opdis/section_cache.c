@@ -0,0 +1,179 @@
+/*!
+ * \file section_cache.c
+ * \brief Cache of loaded BFD section contents.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
+#include <opdis/section_cache.h>
+
+/* ---------------------------------------------------------------------- */
+/* Entries */
+
+static void entry_free( opdis_section_cache_entry_t * entry ) {
+#ifdef HAVE_SYS_MMAN_H
+	if ( entry->map_addr ) {
+		munmap( entry->map_addr, entry->map_len );
+		free( entry );
+		return;
+	}
+#endif
+	free( entry->buffer );
+	free( entry );
+}
+
+static unsigned int section_bfd_id( asection * s ) {
+	return ( s->owner ) ? s->owner->id : 0;
+}
+
+static void evict( opdis_section_cache_t cache,
+		   opdis_section_cache_entry_t * entry );
+
+static opdis_section_cache_entry_t * entry_find( opdis_section_cache_t cache,
+						 asection * s ) {
+	opdis_section_cache_entry_t * entry;
+
+	/* a BFD has few sections: a linear scan in MRU order is sufficient */
+	for ( entry = cache->mru; entry; entry = entry->next ) {
+		if ( entry->section != s ) {
+			continue;
+		}
+
+		if ( entry->bfd_id != section_bfd_id( s ) ) {
+			/* stale: the BFD was closed and s reused */
+			evict( cache, entry );
+			return NULL;
+		}
+
+		return entry;
+	}
+
+	return NULL;
+}
+
+/* ---------------------------------------------------------------------- */
+/* LRU list */
+
+static void lru_unlink( opdis_section_cache_t cache,
+			opdis_section_cache_entry_t * entry ) {
+	if ( entry->prev ) {
+		entry->prev->next = entry->next;
+	} else {
+		cache->mru = entry->next;
+	}
+
+	if ( entry->next ) {
+		entry->next->prev = entry->prev;
+	} else {
+		cache->lru = entry->prev;
+	}
+
+	entry->prev = entry->next = NULL;
+}
+
+static void lru_push( opdis_section_cache_t cache,
+		      opdis_section_cache_entry_t * entry ) {
+	entry->prev = NULL;
+	entry->next = cache->mru;
+	if ( cache->mru ) {
+		cache->mru->prev = entry;
+	}
+	cache->mru = entry;
+	if (! cache->lru ) {
+		cache->lru = entry;
+	}
+}
+
+static void evict( opdis_section_cache_t cache,
+		   opdis_section_cache_entry_t * entry ) {
+	lru_unlink( cache, entry );
+	cache->size -= entry->length;
+	entry_free( entry );
+}
+
+/* ---------------------------------------------------------------------- */
+/* Section cache API */
+
+opdis_section_cache_t LIBCALL opdis_section_cache_init( size_t budget ) {
+	opdis_section_cache_t cache = (opdis_section_cache_t) calloc( 1,
+					sizeof(opdis_section_cache_base_t) );
+	if (! cache ) {
+		return NULL;
+	}
+
+	cache->budget = budget;
+
+	return cache;
+}
+
+opdis_section_cache_entry_t * LIBCALL opdis_section_cache_find(
+				opdis_section_cache_t cache, asection * s ) {
+	opdis_section_cache_entry_t * entry;
+
+	if (! cache || ! s ) {
+		return NULL;
+	}
+
+	entry = entry_find( cache, s );
+	if ( entry && entry != cache->mru ) {
+		lru_unlink( cache, entry );
+		lru_push( cache, entry );
+	}
+
+	return entry;
+}
+
+opdis_section_cache_entry_t * LIBCALL opdis_section_cache_add(
+				opdis_section_cache_t cache, asection * s,
+				opdis_byte_t * buffer, opdis_off_t length,
+				void * map_addr, size_t map_len ) {
+	opdis_section_cache_entry_t * entry;
+
+	if (! cache || ! s || ! buffer || length > cache->budget ||
+	     entry_find( cache, s ) ) {
+		return NULL;
+	}
+
+	entry = (opdis_section_cache_entry_t *) calloc( 1,
+					sizeof(opdis_section_cache_entry_t) );
+	if (! entry ) {
+		return NULL;
+	}
+
+	entry->section = s;
+	entry->bfd_id = section_bfd_id( s );
+	entry->buffer = buffer;
+	entry->length = length;
+	entry->map_addr = map_addr;
+	entry->map_len = map_len;
+
+	while ( cache->lru && cache->size + length > cache->budget ) {
+		evict( cache, cache->lru );
+	}
+
+	lru_push( cache, entry );
+	cache->size += length;
+
+	return entry;
+}
+
+void LIBCALL opdis_section_cache_free( opdis_section_cache_t cache ) {
+	if (! cache ) {
+		return;
+	}
+
+	while ( cache->mru ) {
+		evict( cache, cache->mru );
+	}
+
+	free( cache );
+}
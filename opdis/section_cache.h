@@ -0,0 +1,129 @@
+/*!
+ * \file section_cache.h
+ * \brief Cache of loaded BFD section contents.
+ * \details This defines the cache used by the BFD disassembly routines to
+ *          avoid loading the contents of a section on every call. Entries
+ *          are keyed by asection and the unique ID of its BFD, and kept in
+ *          most-recently used order; the
+ *          least-recently used entries are evicted when the total size of
+ *          the cache exceeds its budget.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#ifndef OPDIS_SECTION_CACHE_H
+#define OPDIS_SECTION_CACHE_H
+
+#include <opdis/types.h>
+
+#ifdef WIN32
+        #define LIBCALL _stdcall
+#else
+        #define LIBCALL
+#endif
+
+/*! \struct opdis_section_cache_entry_t
+ *  \ingroup internal
+ *  \brief The loaded contents of a single section.
+ *  \details The contents are either a heap buffer or a region mapped
+ *           with mmap(); \e map_addr is non-NULL in the latter case.
+ */
+typedef struct opdis_section_cache_entry {
+	asection * section;		/*!< Section (key) */
+	unsigned int bfd_id;		/*!< Unique ID of section BFD (key) */
+	opdis_byte_t * buffer;		/*!< Section contents */
+	opdis_off_t length;		/*!< Size of section contents */
+	void * map_addr;		/*!< Mapped region or NULL */
+	size_t map_len;			/*!< Size of mapped region */
+	struct opdis_section_cache_entry * prev;  /*!< More recently used */
+	struct opdis_section_cache_entry * next;  /*!< Less recently used */
+} opdis_section_cache_entry_t;
+
+/*! \struct opdis_section_cache_base_t
+ *  \ingroup internal
+ *  \brief A cache of loaded sections.
+ */
+typedef struct opdis_section_cache {
+	opdis_section_cache_entry_t * mru;	/*!< Most recently used */
+	opdis_section_cache_entry_t * lru;	/*!< Least recently used */
+	size_t budget;				/*!< Max total size in bytes */
+	size_t size;				/*!< Total size in bytes */
+} opdis_section_cache_base_t;
+
+/*! \typedef opdis_section_cache_base_t * opdis_section_cache_t
+ *  \ingroup internal
+ *  \brief Pointer to a section cache.
+ */
+typedef opdis_section_cache_base_t * opdis_section_cache_t;
+
+/* ---------------------------------------------------------------------- */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*!
+ * \fn opdis_section_cache_t opdis_section_cache_init( size_t )
+ * \ingroup internal
+ * \brief Allocate an empty section cache.
+ * \param budget The maximum number of bytes of section contents to keep.
+ * \return The allocated cache.
+ * \sa opdis_section_cache_free
+ */
+opdis_section_cache_t LIBCALL opdis_section_cache_init( size_t budget );
+
+/*!
+ * \fn opdis_section_cache_entry_t * opdis_section_cache_find(
+ * 					opdis_section_cache_t, asection * )
+ * \ingroup internal
+ * \brief Find the cached contents of a section.
+ * \details The entry, if found, becomes the most recently used. An entry
+ *          for the same asection pointer in a different BFD (e.g. one
+ *          that was closed, after which its memory was reused) is evicted.
+ * \param cache The section cache.
+ * \param s The section.
+ * \return The cache entry for \e s, or NULL.
+ */
+opdis_section_cache_entry_t * LIBCALL opdis_section_cache_find(
+				opdis_section_cache_t cache, asection * s );
+
+/*!
+ * \fn opdis_section_cache_entry_t * opdis_section_cache_add(
+ * 			opdis_section_cache_t, asection *, opdis_byte_t *,
+ * 			opdis_off_t, void *, size_t )
+ * \ingroup internal
+ * \brief Add the loaded contents of a section to the cache.
+ * \details On success, the cache takes ownership of the contents. Least
+ *          recently used entries are evicted until the cache is within
+ *          its budget; the new entry is never evicted by this call.
+ * \param cache The section cache.
+ * \param s The section.
+ * \param buffer The section contents.
+ * \param length The size of the section contents.
+ * \param map_addr The mapped region containing \e buffer, or NULL if
+ *        \e buffer was allocated with malloc().
+ * \param map_len The size of the mapped region.
+ * \return The new cache entry, or NULL if the contents were not cached
+ *         (e.g. because they are larger than the budget).
+ */
+opdis_section_cache_entry_t * LIBCALL opdis_section_cache_add(
+				opdis_section_cache_t cache, asection * s,
+				opdis_byte_t * buffer, opdis_off_t length,
+				void * map_addr, size_t map_len );
+
+/*!
+ * \fn void opdis_section_cache_free( opdis_section_cache_t )
+ * \ingroup internal
+ * \brief Free a section cache and all contents stored in it.
+ * \param cache The section cache.
+ * \sa opdis_section_cache_init
+ */
+void LIBCALL opdis_section_cache_free( opdis_section_cache_t cache );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,243 @@
+/*!
+ * \file section_index.c
+ * \brief Index of BFD sections by address.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <opdis/section_index.h>
+
+struct INDEX_BUILD {
+	opdis_section_index_t idx;
+	unsigned int order;
+	unsigned int max;
+};
+
+static void count_section( bfd * abfd, asection * s, PTR data ) {
+	unsigned int * count = (unsigned int *) data;
+	(*count)++;
+}
+
+static void add_section( bfd * abfd, asection * s, PTR data ) {
+	struct INDEX_BUILD * b = (struct INDEX_BUILD *) data;
+	opdis_section_range_t * r;
+	opdis_off_t size = bfd_section_size( abfd, s );
+	unsigned int order = b->order++;
+
+	/* empty sections can never contain an address */
+	if (! size || b->idx->num >= b->max ) {
+		return;
+	}
+
+	r = &b->idx->ranges[b->idx->num++];
+	r->vma = bfd_section_vma( abfd, s );
+	r->end = r->vma + size;
+	r->order = order;
+	r->section = s;
+}
+
+static int cmp_range( const void * a, const void * b ) {
+	const opdis_section_range_t * ra = (const opdis_section_range_t *) a;
+	const opdis_section_range_t * rb = (const opdis_section_range_t *) b;
+
+	if ( ra->vma != rb->vma ) {
+		return ( ra->vma < rb->vma ) ? -1 : 1;
+	}
+
+	return ( ra->order < rb->order ) ? -1 : ( ra->order > rb->order );
+}
+
+static int cmp_vma( const void * a, const void * b ) {
+	opdis_vma_t va = *(const opdis_vma_t *) a;
+	opdis_vma_t vb = *(const opdis_vma_t *) b;
+
+	return ( va > vb ) - ( va < vb );
+}
+
+/* ---------------------------------------------------------------------- */
+/* Heap of active ranges, ordered by position in the BFD section list */
+
+static void heap_push( opdis_section_range_t ** heap, unsigned int * n,
+		       opdis_section_range_t * r ) {
+	unsigned int i = (*n)++;
+
+	while ( i > 0 && heap[(i - 1) / 2]->order < r->order ) {
+		heap[i] = heap[(i - 1) / 2];
+		i = (i - 1) / 2;
+	}
+	heap[i] = r;
+}
+
+static void heap_pop( opdis_section_range_t ** heap, unsigned int * n ) {
+	opdis_section_range_t * last = heap[--(*n)];
+	unsigned int i = 0;
+
+	for ( ;; ) {
+		unsigned int c = 2 * i + 1;
+		if ( c >= *n ) {
+			break;
+		}
+		if ( c + 1 < *n && heap[c + 1]->order > heap[c]->order ) {
+			c++;
+		}
+		if ( heap[c]->order <= last->order ) {
+			break;
+		}
+		heap[i] = heap[c];
+		i = c;
+	}
+
+	if ( *n ) {
+		heap[i] = last;
+	}
+}
+
+/* Sweep the sorted bounds, keeping the ranges that contain the current
+ * interval in a heap; the top of the heap owns the interval. */
+static int build_intervals( opdis_section_index_t idx ) {
+	opdis_section_range_t ** heap;
+	unsigned int i, j, n = 0, num_heap = 0;
+
+	idx->bounds = (opdis_vma_t *) calloc( 2 * idx->num + 1,
+					      sizeof(opdis_vma_t) );
+	idx->owners = (asection **) calloc( 2 * idx->num + 1,
+					    sizeof(asection *) );
+	heap = (opdis_section_range_t **) calloc( idx->num + 1,
+					sizeof(opdis_section_range_t *) );
+	if (! idx->bounds || ! idx->owners || ! heap ) {
+		free( heap );
+		return 0;
+	}
+
+	for ( i = 0; i < idx->num; i++ ) {
+		idx->bounds[n++] = idx->ranges[i].vma;
+		idx->bounds[n++] = idx->ranges[i].end;
+	}
+	qsort( idx->bounds, n, sizeof(opdis_vma_t), cmp_vma );
+
+	/* remove duplicate bounds */
+	for ( i = 0, j = 0; i < n; i++ ) {
+		if (! j || idx->bounds[j - 1] != idx->bounds[i] ) {
+			idx->bounds[j++] = idx->bounds[i];
+		}
+	}
+	idx->num_bounds = j;
+
+	for ( i = 0, j = 0; i < idx->num_bounds; i++ ) {
+		opdis_vma_t vma = idx->bounds[i];
+
+		while ( j < idx->num && idx->ranges[j].vma == vma ) {
+			heap_push( heap, &num_heap, &idx->ranges[j++] );
+		}
+
+		/* discard ranges that ended at or before this bound */
+		while ( num_heap && heap[0]->end <= vma ) {
+			heap_pop( heap, &num_heap );
+		}
+
+		idx->owners[i] = ( num_heap ) ? heap[0]->section : NULL;
+	}
+
+	free( heap );
+	return 1;
+}
+
+opdis_section_index_t LIBCALL opdis_section_index_init( bfd * abfd ) {
+	struct INDEX_BUILD b;
+	unsigned int count = 0;
+	opdis_section_index_t idx;
+
+	if (! abfd ) {
+		return NULL;
+	}
+
+	idx = (opdis_section_index_t) calloc( 1,
+					sizeof(opdis_section_index_base_t) );
+	if (! idx ) {
+		return NULL;
+	}
+
+	idx->abfd = abfd;
+	idx->bfd_id = abfd->id;
+
+	bfd_map_over_sections( abfd, count_section, &count );
+
+	/* always allocate at least one range so the arrays are never NULL */
+	idx->ranges = (opdis_section_range_t *) calloc( count + 1,
+					sizeof(opdis_section_range_t) );
+	if (! idx->ranges ) {
+		opdis_section_index_free( idx );
+		return NULL;
+	}
+
+	b.idx = idx;
+	b.order = 0;
+	b.max = count;
+	bfd_map_over_sections( abfd, add_section, &b );
+
+	qsort( idx->ranges, idx->num, sizeof(opdis_section_range_t),
+	       cmp_range );
+
+	if (! build_intervals( idx ) ) {
+		opdis_section_index_free( idx );
+		return NULL;
+	}
+
+	return idx;
+}
+
+int LIBCALL opdis_section_index_is_for( opdis_section_index_t idx,
+					bfd * abfd ) {
+	/* the ID distinguishes a new BFD allocated at the address of a
+	 * closed one */
+	return ( idx && abfd && idx->abfd == abfd &&
+		 idx->bfd_id == abfd->id );
+}
+
+asection * LIBCALL opdis_section_index_find( opdis_section_index_t idx,
+					     opdis_vma_t vma ) {
+	unsigned int lo = 0, hi;
+
+	if (! idx ) {
+		return NULL;
+	}
+
+	/* find the first bound after vma */
+	hi = idx->num_bounds;
+	while ( lo < hi ) {
+		unsigned int mid = lo + (hi - lo) / 2;
+		if ( idx->bounds[mid] <= vma ) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	/* vma is in the interval starting at the preceding bound */
+	return ( lo ) ? idx->owners[lo - 1] : NULL;
+}
+
+void LIBCALL opdis_section_index_free( opdis_section_index_t idx ) {
+	if (! idx ) {
+		return;
+	}
+
+	if ( idx->ranges ) {
+		free( idx->ranges );
+	}
+
+	if ( idx->bounds ) {
+		free( idx->bounds );
+	}
+
+	if ( idx->owners ) {
+		free( idx->owners );
+	}
+
+	free( idx );
+}
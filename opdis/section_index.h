@@ -0,0 +1,119 @@
+/*!
+ * \file section_index.h
+ * \brief Index of BFD sections by address.
+ * \details This defines the index used by the BFD disassembly routines to
+ *          find the section containing a VMA. The index is a sorted array
+ *          of section address ranges that is built once per BFD and
+ *          searched with a binary search, instead of walking every
+ *          section in the BFD on every lookup.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#ifndef OPDIS_SECTION_INDEX_H
+#define OPDIS_SECTION_INDEX_H
+
+#include <opdis/types.h>
+
+#ifdef WIN32
+        #define LIBCALL _stdcall
+#else
+        #define LIBCALL
+#endif
+
+/*! \struct opdis_section_range_t
+ *  \ingroup internal
+ *  \brief The address range [vma, end) of a section.
+ */
+typedef struct {
+	opdis_vma_t vma;		/*!< First address in section */
+	opdis_vma_t end;		/*!< Address following section */
+	unsigned int order;		/*!< Position in BFD section list */
+	asection * section;		/*!< The section */
+} opdis_section_range_t;
+
+/*! \struct opdis_section_index_base_t
+ *  \ingroup internal
+ *  \brief Section ranges of a BFD, sorted by start address.
+ *  \details The start and end addresses of all ranges, sorted, divide the
+ *           address space into intervals [bounds[n], bounds[n + 1]) in
+ *           which the same sections are present. \e owners[n] is the
+ *           section that is found for interval n: the one that appears
+ *           last in the BFD section list, or NULL. Overlapping sections
+ *           (e.g. in relocatable objects, where most sections start at 0)
+ *           are resolved when the index is built, so a lookup is a single
+ *           binary search.
+ */
+typedef struct opdis_section_index {
+	bfd * abfd;			/*!< Indexed BFD */
+	unsigned int bfd_id;		/*!< Unique ID of indexed BFD */
+	unsigned int num;		/*!< Number of ranges */
+	opdis_section_range_t * ranges;	/*!< Ranges sorted by vma */
+	unsigned int num_bounds;	/*!< Number of interval bounds */
+	opdis_vma_t * bounds;		/*!< Sorted, unique range endpoints */
+	asection ** owners;		/*!< Section for each interval */
+} opdis_section_index_base_t;
+
+/*! \typedef opdis_section_index_base_t * opdis_section_index_t
+ *  \ingroup internal
+ *  \brief Pointer to a section index.
+ */
+typedef opdis_section_index_base_t * opdis_section_index_t;
+
+/* ---------------------------------------------------------------------- */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*!
+ * \fn opdis_section_index_t opdis_section_index_init( bfd * )
+ * \ingroup internal
+ * \brief Build an index of the sections in a BFD.
+ * \param abfd The BFD.
+ * \return The allocated index.
+ * \sa opdis_section_index_free
+ */
+opdis_section_index_t LIBCALL opdis_section_index_init( bfd * abfd );
+
+/*!
+ * \fn int opdis_section_index_is_for( opdis_section_index_t, bfd * )
+ * \ingroup internal
+ * \brief Determine if an index was built for a BFD.
+ * \param idx The section index.
+ * \param abfd The BFD.
+ * \return 1 if \e idx indexes \e abfd, 0 otherwise.
+ */
+int LIBCALL opdis_section_index_is_for( opdis_section_index_t idx,
+					bfd * abfd );
+
+/*!
+ * \fn asection * opdis_section_index_find( opdis_section_index_t,
+ * 					   opdis_vma_t )
+ * \ingroup internal
+ * \brief Find the section containing an address.
+ * \details If more than one section contains \e vma, the one that appears
+ *          last in the BFD section list is returned.
+ * \param idx The section index.
+ * \param vma The address.
+ * \return The section containing \e vma, or NULL.
+ */
+asection * LIBCALL opdis_section_index_find( opdis_section_index_t idx,
+					     opdis_vma_t vma );
+
+/*!
+ * \fn void opdis_section_index_free( opdis_section_index_t )
+ * \ingroup internal
+ * \brief Free a section index.
+ * \param idx The section index.
+ * \sa opdis_section_index_init
+ */
+void LIBCALL opdis_section_index_free( opdis_section_index_t idx );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
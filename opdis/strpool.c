@@ -0,0 +1,158 @@
+/*!
+ * \file strpool.c
+ * \brief String interning pool
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <opdis/strpool.h>
+
+#define STRPOOL_PAGE_SIZE 4096
+#define MIN_SLOTS 256
+
+opdis_strpool_t LIBCALL opdis_strpool_init( void ) {
+	opdis_strpool_t pool = (opdis_strpool_t) calloc( 1,
+						sizeof(opdis_strpool_base_t) );
+	if (! pool ) {
+		return NULL;
+	}
+
+	pool->arena = opdis_arena_init( STRPOOL_PAGE_SIZE );
+	if (! pool->arena ) {
+		free( pool );
+		return NULL;
+	}
+
+	return pool;
+}
+
+static unsigned int str_hash( const char * str ) {
+	unsigned int h = 2166136261U;
+
+	for ( ; *str; str++ ) {
+		h = (h ^ (unsigned char) *str) * 16777619U;
+	}
+
+	return h;
+}
+
+/* Return the hash slot for str: either its id or an empty slot. */
+static unsigned int find_slot( opdis_strpool_t pool, const char * str ) {
+	unsigned int s = str_hash( str ) & (pool->slots - 1);
+
+	/* slots is a power of 2 and is never full; probe linearly */
+	while ( pool->hash[s] &&
+		strcmp( pool->strs[pool->hash[s] - 1], str ) ) {
+		s = (s + 1) & (pool->slots - 1);
+	}
+
+	return s;
+}
+
+static int grow( opdis_strpool_t pool ) {
+	unsigned int i, slots = pool->slots * 2;
+	unsigned int * hash;
+	const char ** strs;
+
+	if ( slots < MIN_SLOTS ) {
+		slots = MIN_SLOTS;
+	}
+
+	/* the pool is only changed once both arrays have been allocated */
+	hash = (unsigned int *) calloc( slots, sizeof(unsigned int) );
+	if (! hash ) {
+		return 0;
+	}
+
+	/* strs grows with the hash table, which is kept at most half full */
+	strs = (const char **) realloc( pool->strs,
+					(slots / 2) * sizeof(const char *) );
+	if (! strs ) {
+		free( hash );
+		return 0;
+	}
+
+	pool->strs = strs;
+	pool->alloc = slots / 2;
+	free( pool->hash );
+	pool->hash = hash;
+	pool->slots = slots;
+
+	for ( i = 0; i < pool->count; i++ ) {
+		pool->hash[find_slot( pool, pool->strs[i] )] = i + 1;
+	}
+
+	return 1;
+}
+
+unsigned int LIBCALL opdis_strpool_id( opdis_strpool_t pool,
+				       const char * str ) {
+	if (! pool || ! str || ! pool->slots ) {
+		return OPDIS_STRPOOL_NO_ID;
+	}
+
+	return pool->hash[find_slot( pool, str )];
+}
+
+unsigned int LIBCALL opdis_strpool_add( opdis_strpool_t pool,
+					const char * str ) {
+	unsigned int id;
+	size_t len;
+	char * s;
+
+	if (! pool || ! str ) {
+		return OPDIS_STRPOOL_NO_ID;
+	}
+
+	id = opdis_strpool_id( pool, str );
+	if ( id ) {
+		return id;
+	}
+
+	if ( pool->count == pool->alloc && ! grow( pool ) ) {
+		return OPDIS_STRPOOL_NO_ID;
+	}
+
+	len = strlen( str ) + 1;
+	s = (char *) opdis_arena_alloc( pool->arena, len );
+	if (! s ) {
+		return OPDIS_STRPOOL_NO_ID;
+	}
+	memcpy( s, str, len );
+
+	pool->strs[pool->count] = s;
+	pool->count++;
+	pool->hash[find_slot( pool, s )] = pool->count;
+
+	return pool->count;
+}
+
+const char * LIBCALL opdis_strpool_intern( opdis_strpool_t pool,
+					   const char * str ) {
+	return opdis_strpool_str( pool, opdis_strpool_add( pool, str ) );
+}
+
+const char * LIBCALL opdis_strpool_str( opdis_strpool_t pool,
+					unsigned int id ) {
+	if (! pool || ! id || id > pool->count ) {
+		return NULL;
+	}
+
+	return pool->strs[id - 1];
+}
+
+void LIBCALL opdis_strpool_free( opdis_strpool_t pool ) {
+	if (! pool ) {
+		return;
+	}
+
+	opdis_arena_free( pool->arena );
+	free( pool->strs );
+	free( pool->hash );
+	free( pool );
+}
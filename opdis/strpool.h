@@ -0,0 +1,131 @@
+/*!
+ * \file strpool.h
+ * \brief String interning pool
+ * \details A string pool stores one canonical copy of each string added to
+ *          it, and assigns each string a numeric id. Instructions that
+ *          reference pooled strings share them, so equal mnemonics,
+ *          prefixes or operands can be compared by pointer or by id
+ *          instead of with strcmp.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#ifndef OPDIS_STRPOOL_H
+#define OPDIS_STRPOOL_H
+
+#include <opdis/arena.h>
+
+#ifdef WIN32
+        #define LIBCALL _stdcall
+#else
+        #define LIBCALL
+#endif
+
+/*! \def OPDIS_STRPOOL_NO_ID
+ *  \ingroup arena
+ *  \brief The id returned for a string that is not in a pool.
+ */
+#define OPDIS_STRPOOL_NO_ID 0
+
+/*! \struct opdis_strpool_base_t
+ *  \ingroup arena
+ *  \brief A pool of interned strings.
+ *  \details Strings are allocated from \e arena, and are numbered from 1
+ *           in the order they were added: \e strs[id - 1] is the string
+ *           with the given id.
+ */
+typedef struct opdis_strpool_base {
+	opdis_arena_t arena;		/*!< Storage for the strings */
+	const char ** strs;		/*!< Strings by id - 1 */
+	unsigned int count;		/*!< Number of strings */
+	unsigned int alloc;		/*!< Number of allocated entries in strs */
+	unsigned int * hash;		/*!< String id by hash slot, or 0 */
+	unsigned int slots;		/*!< Number of hash slots */
+} opdis_strpool_base_t;
+
+/*! \typedef opdis_strpool_base_t * opdis_strpool_t
+ *  \ingroup arena
+ *  \brief Pointer to a string pool.
+ */
+typedef opdis_strpool_base_t * opdis_strpool_t;
+
+/* ---------------------------------------------------------------------- */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*!
+ * \fn opdis_strpool_t opdis_strpool_init( void )
+ * \ingroup arena
+ * \brief Allocate an empty string pool.
+ * \return The allocated pool.
+ * \sa opdis_strpool_free
+ */
+opdis_strpool_t LIBCALL opdis_strpool_init( void );
+
+/*!
+ * \fn unsigned int opdis_strpool_add( opdis_strpool_t, const char * )
+ * \ingroup arena
+ * \brief Add a string to a pool.
+ * \param pool The string pool.
+ * \param str The string to add.
+ * \return The id of the string, or \ref OPDIS_STRPOOL_NO_ID if \e str is
+ *         NULL or memory could not be allocated. A string that is already
+ *         in the pool keeps its id.
+ */
+unsigned int LIBCALL opdis_strpool_add( opdis_strpool_t pool,
+					const char * str );
+
+/*!
+ * \fn const char * opdis_strpool_intern( opdis_strpool_t, const char * )
+ * \ingroup arena
+ * \brief Return the canonical copy of a string, adding it if necessary.
+ * \param pool The string pool.
+ * \param str The string to intern.
+ * \return The pooled string, or NULL if \e str could not be added.
+ * \note Pooled strings must not be modified or freed. They remain valid
+ *       until the pool is freed.
+ */
+const char * LIBCALL opdis_strpool_intern( opdis_strpool_t pool,
+					   const char * str );
+
+/*!
+ * \fn unsigned int opdis_strpool_id( opdis_strpool_t, const char * )
+ * \ingroup arena
+ * \brief Return the id of a string without adding it.
+ * \param pool The string pool.
+ * \param str The string.
+ * \return The id of the string, or \ref OPDIS_STRPOOL_NO_ID if it is not
+ *         in the pool.
+ */
+unsigned int LIBCALL opdis_strpool_id( opdis_strpool_t pool,
+				       const char * str );
+
+/*!
+ * \fn const char * opdis_strpool_str( opdis_strpool_t, unsigned int )
+ * \ingroup arena
+ * \brief Return the string with a given id.
+ * \param pool The string pool.
+ * \param id The id of the string.
+ * \return The pooled string, or NULL if \e id is not valid.
+ */
+const char * LIBCALL opdis_strpool_str( opdis_strpool_t pool,
+					unsigned int id );
+
+/*!
+ * \fn void opdis_strpool_free( opdis_strpool_t )
+ * \ingroup arena
+ * \brief Free a string pool and all of its strings.
+ * \param pool The string pool to free.
+ * \sa opdis_strpool_init
+ */
+void LIBCALL opdis_strpool_free( opdis_strpool_t pool );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,191 @@
+/*!
+ * \file worklist.c
+ * \brief Worklist of pending branch targets for control-flow disassembly.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <opdis/worklist.h>
+
+/* initial number of items allocated; the array doubles as needed */
+#define WORKLIST_DEFAULT_SIZE 64
+
+/* ---------------------------------------------------------------------- */
+/* Storage */
+
+static int grow_items( opdis_worklist_t work ) {
+	size_t alloc = work->alloc * 2;
+	opdis_vma_t * items;
+
+	items = (opdis_vma_t *) calloc( alloc, sizeof(opdis_vma_t) );
+	if (! items ) {
+		return 0;
+	}
+
+	if ( work->order == opdis_cflow_order_bfs ) {
+		/* unwrap the ring buffer so that head is at index 0 */
+		size_t first = work->alloc - work->head;
+		if ( first > work->count ) {
+			first = work->count;
+		}
+		memcpy( items, &work->items[work->head],
+			first * sizeof(opdis_vma_t) );
+		memcpy( &items[first], work->items,
+			(work->count - first) * sizeof(opdis_vma_t) );
+		work->head = 0;
+	} else {
+		memcpy( items, work->items, work->count * sizeof(opdis_vma_t) );
+	}
+
+	free( work->items );
+	work->items = items;
+	work->alloc = alloc;
+
+	return 1;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Binary min-heap (lowest address first) */
+
+static void heap_push( opdis_worklist_t work, opdis_vma_t vma ) {
+	size_t i = work->count;
+
+	while ( i > 0 ) {
+		size_t parent = (i - 1) / 2;
+		if ( work->items[parent] <= vma ) {
+			break;
+		}
+		work->items[i] = work->items[parent];
+		i = parent;
+	}
+
+	work->items[i] = vma;
+}
+
+static opdis_vma_t heap_pop( opdis_worklist_t work ) {
+	opdis_vma_t min = work->items[0];
+	opdis_vma_t last = work->items[work->count - 1];
+	size_t i = 0, count = work->count - 1;
+
+	for (;;) {
+		size_t child = (i * 2) + 1;
+		if ( child >= count ) {
+			break;
+		}
+		if ( child + 1 < count &&
+		     work->items[child + 1] < work->items[child] ) {
+			child++;
+		}
+		if ( last <= work->items[child] ) {
+			break;
+		}
+		work->items[i] = work->items[child];
+		i = child;
+	}
+
+	work->items[i] = last;
+
+	return min;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Worklist API */
+
+opdis_worklist_t LIBCALL opdis_worklist_init( enum opdis_cflow_order_t order ) {
+	opdis_worklist_t work = (opdis_worklist_t) calloc( 1,
+						sizeof(opdis_worklist_base_t) );
+	if (! work ) {
+		return NULL;
+	}
+
+	work->items = (opdis_vma_t *) calloc( WORKLIST_DEFAULT_SIZE,
+					      sizeof(opdis_vma_t) );
+	if (! work->items ) {
+		free( work );
+		return NULL;
+	}
+
+	work->alloc = WORKLIST_DEFAULT_SIZE;
+	work->order = order;
+
+	return work;
+}
+
+int LIBCALL opdis_worklist_push( opdis_worklist_t work, opdis_vma_t vma ) {
+	if (! work ) {
+		return 0;
+	}
+
+	if ( work->count == work->alloc && ! grow_items( work ) ) {
+		return 0;
+	}
+
+	switch ( work->order ) {
+		case opdis_cflow_order_bfs:
+			work->items[(work->head + work->count) % work->alloc] =
+				vma;
+			break;
+		case opdis_cflow_order_addr:
+			heap_push( work, vma );
+			break;
+		case opdis_cflow_order_dfs:
+		default:
+			work->items[work->count] = vma;
+			break;
+	}
+
+	work->count++;
+
+	return 1;
+}
+
+opdis_vma_t LIBCALL opdis_worklist_pop( opdis_worklist_t work ) {
+	opdis_vma_t vma;
+
+	if (! work || ! work->count ) {
+		return OPDIS_INVALID_ADDR;
+	}
+
+	switch ( work->order ) {
+		case opdis_cflow_order_bfs:
+			vma = work->items[work->head];
+			work->head = (work->head + 1) % work->alloc;
+			break;
+		case opdis_cflow_order_addr:
+			vma = heap_pop( work );
+			break;
+		case opdis_cflow_order_dfs:
+		default:
+			vma = work->items[work->count - 1];
+			break;
+	}
+
+	work->count--;
+
+	return vma;
+}
+
+size_t LIBCALL opdis_worklist_count( opdis_worklist_t work ) {
+	if (! work ) {
+		return 0;
+	}
+
+	return work->count;
+}
+
+void LIBCALL opdis_worklist_free( opdis_worklist_t work ) {
+	if (! work ) {
+		return;
+	}
+
+	if ( work->items ) {
+		free( work->items );
+	}
+
+	free( work );
+}
@@ -0,0 +1,105 @@
+/*!
+ * \file worklist.h
+ * \brief Worklist of pending branch targets for control-flow disassembly.
+ * \details This defines the worklist used by the control-flow disassembler
+ *          to track branch targets which have been discovered but not yet
+ *          disassembled. The order in which targets are removed from the
+ *          worklist is determined by an \ref opdis_cflow_order_t.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#ifndef OPDIS_WORKLIST_H
+#define OPDIS_WORKLIST_H
+
+#include <opdis/opdis.h>
+
+#ifdef WIN32
+        #define LIBCALL _stdcall
+#else
+        #define LIBCALL
+#endif
+
+/*! \struct opdis_worklist_base_t
+ *  \ingroup internal
+ *  \brief A worklist of addresses.
+ *  \details The storage for a worklist is a single array of addresses.
+ *           Depth-first worklists use it as a stack, breadth-first
+ *           worklists use it as a ring buffer starting at \e head, and
+ *           address-ordered worklists use it as a binary min-heap.
+ */
+typedef struct {
+	enum opdis_cflow_order_t order;	/*!< Order items are removed in */
+	opdis_vma_t * items;		/*!< Array of pending addresses */
+	size_t head;			/*!< Index of first item (BFS only) */
+	size_t count;			/*!< Number of pending addresses */
+	size_t alloc;			/*!< Number of allocated items */
+} opdis_worklist_base_t;
+
+/*! \typedef opdis_worklist_base_t * opdis_worklist_t
+ *  \ingroup internal
+ *  \brief Pointer to a worklist.
+ */
+typedef opdis_worklist_base_t * opdis_worklist_t;
+
+/* ---------------------------------------------------------------------- */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*!
+ * \fn opdis_worklist_t opdis_worklist_init( enum opdis_cflow_order_t )
+ * \ingroup internal
+ * \brief Allocate an empty worklist.
+ * \param order The order in which addresses will be removed.
+ * \return The allocated worklist.
+ * \sa opdis_worklist_free
+ */
+opdis_worklist_t LIBCALL opdis_worklist_init( enum opdis_cflow_order_t order );
+
+/*!
+ * \fn int opdis_worklist_push( opdis_worklist_t, opdis_vma_t )
+ * \ingroup internal
+ * \brief Add an address to the worklist.
+ * \param work The worklist.
+ * \param vma The address to add.
+ * \return 1 on success, 0 on failure.
+ * \note The worklist does not check for duplicate addresses; the caller
+ *       is expected to track which addresses have been added.
+ */
+int LIBCALL opdis_worklist_push( opdis_worklist_t work, opdis_vma_t vma );
+
+/*!
+ * \fn opdis_vma_t opdis_worklist_pop( opdis_worklist_t )
+ * \ingroup internal
+ * \brief Remove the next address from the worklist.
+ * \param work The worklist.
+ * \return The next address, or OPDIS_INVALID_ADDR if the worklist is empty.
+ */
+opdis_vma_t LIBCALL opdis_worklist_pop( opdis_worklist_t work );
+
+/*!
+ * \fn size_t opdis_worklist_count( opdis_worklist_t )
+ * \ingroup internal
+ * \brief Return the number of addresses in the worklist.
+ * \param work The worklist.
+ */
+size_t LIBCALL opdis_worklist_count( opdis_worklist_t work );
+
+/*!
+ * \fn void opdis_worklist_free( opdis_worklist_t )
+ * \ingroup internal
+ * \brief Free a worklist.
+ * \param work The worklist to free.
+ * \sa opdis_worklist_init
+ */
+void LIBCALL opdis_worklist_free( opdis_worklist_t work );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
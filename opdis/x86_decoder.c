@@ -13,6 +13,7 @@
 #include <ctype.h>
 
 #include <opdis/opdis.h>
+#include <opdis/x86_mnemonic.h>
 
 
 /* ---------------------------------------------------------------------- */
@@ -42,9 +43,8 @@ static void set_isa( opdis_insn_t * out, const char * item ) {
 	out->isa = opdis_insn_subset_gen;
 }
 
-static void decode_intel_mnemonic( opdis_insn_t * out, const char * item ) {
-	int i, num;
-
+/* Classify a mnemonic which is not in the mnemonic table */
+static void classify_mnemonic( opdis_insn_t * out, const char * item ) {
 	set_isa( out, item );
 
 	/* detect NOP */
@@ -241,9 +241,15 @@ static void decode_intel_mnemonic( opdis_insn_t * out, const char * item ) {
 	}
 }
 
+static void decode_intel_mnemonic( opdis_insn_t * out, const char * item ) {
+	if (! opdis_x86_mnemonic_classify( out, item ) ) {
+		classify_mnemonic( out, item );
+	}
+}
+
 typedef void (*MNEMONIC_DECODE_FN) ( opdis_insn_t *, const char * );
 static void decode_mnemonic( opdis_insn_t * insn, MNEMONIC_DECODE_FN decode_fn, 
-			    const char * item ) {
+			    const char * item, unsigned int level ) {
 	int i;
 	char buf[64];
 	for ( i=0; item[i] && ! isspace(item[i]); i++ ) {
@@ -251,9 +257,33 @@ static void decode_mnemonic( opdis_insn_t * insn, MNEMONIC_DECODE_FN decode_fn,
 	}
 	buf[i] = '\0';
 
-	opdis_insn_set_mnemonic( insn, buf );
+	if ( level & opdis_decode_mnem ) {
+		opdis_insn_set_mnemonic( insn, buf );
+		insn->status |= opdis_decode_mnem;
+	}
+
+	if ( level & opdis_decode_mnem_flags ) {
+		/* classify the mnemonic alone: item may be followed by ops */
+		decode_fn( insn, buf );
+		insn->status |= opdis_decode_mnem_flags;
+	}
+}
+
+/* mnemonic decoder for a syntax: handles syntax-specific suffixes */
+typedef void (*MNEMONIC_ITEM_FN) ( opdis_insn_t *, const char *,
+				   unsigned int );
+
+/* Operand decoding is requested, or needed to find a branch target */
+static int want_operands( const opdis_insn_buf_t in,
+			  const opdis_insn_t * out ) {
+	if ( in->decode_level & (opdis_decode_ops | opdis_decode_op_flags) ) {
+		return 1;
+	}
 
-	decode_fn( insn, item );
+	/* no need to parse the target if libopcodes supplied it */
+	return ( in->decode_branch_ops &&
+		 out->category == opdis_insn_cat_cflow &&
+		 ! (in->insn_info_valid && in->target) );
 }
 
 static const char * intel_prefixes[] = {
@@ -287,139 +317,191 @@ static int is_prefix_byte( opdis_byte_t b ) {
 /* ---------------------------------------------------------------------- */
 /* CPU REGISTERS */
 
-static char intel_reg_id[] = {
-	1, 2, 3, 4, 1, 2, 3, 4, 	// al, cl, dl, bl, ah, ch, dh, bh
-	1, 2, 3, 4, 5, 6, 7, 8, 	// ax, cx, dx, bx, sp, bp, si, di
-	1, 2, 3, 4, 5, 6, 7, 8, 	// eax,ecx,edx,ebx,esp,ebp,esi,edi
-	1, 2, 3, 4, 5, 6, 7, 8, 	// rax,rcx,rdx,rbx,rsp,rbp,rsi,rdi
-	9, 10, 11, 12, 13, 14, 15, 16, 	// r8 - r15
-	9, 10, 11, 12, 13, 14, 15, 16, 	// r8l - r15l
-	9, 10, 11, 12, 13, 14, 15, 16, 	// r8w - r15w
-	9, 10, 11, 12, 13, 14, 15, 16, 	// r8d - r15d
-	17, 18, 19, 20, 21, 22, 23, 24, // mm0 - mm7
-	25, 26, 27, 28, 29, 30, 31, 32,	// xmm0 - xmm7
-	17, 18, 19, 20, 21, 22, 23, 24, // st(0) - st(7)
-	33, 34, 35, 36, 37, 38, 39, 40, // cr0 - cr7
-	41, 42, 43, 44, 45, 46, 47, 48, // dr0 - dr7
-	49, 50, 51, 52, 53, 54, 	// cs, ds, ss, es, fs, gs 
-	55, 55, 56, 56, 		// eip, rip, eflags, rflags
-	5, 6, 7, 8, 			// spl, bpl, sil, dil
-	57, 58, 59, 60, 61 		// gdtr, ldtr, idtr, tr, mxcsr
+/* Register descriptors. The id identifies the underlying register, so that
+ * e.g. al, ax, eax and rax share an id. */
+struct X86_REGISTER {
+	const char * name;
+	unsigned char id;
+	unsigned char size;
+	enum opdis_reg_flag_t flags;
 };
 
-static enum opdis_reg_flag_t lookup_register_type( unsigned int id ) {
-	enum opdis_reg_flag_t type = opdis_reg_flag_unknown;
-
-	if ( id == 5 ) {
-		type = opdis_reg_flag_gen | opdis_reg_flag_stack;
-	} else if ( id == 6 ) {
-		type = opdis_reg_flag_gen | opdis_reg_flag_frame;
-	} else if ( id <= 16 ) {
-		type = opdis_reg_flag_gen;
-	} else if ( id >= 17 && id <= 24 ) {
-		type = opdis_reg_flag_fpu | opdis_reg_flag_simd;
-	} else if (( id >= 25 && id <= 32 ) || id == 61 ) {
-		type = opdis_reg_flag_simd;
-	} else if ( id >= 33 && id <= 40 ) {
-		type = opdis_reg_flag_task;
-	} else if ( id >= 41 && id <= 48 ) {
-		type = opdis_reg_flag_debug;
-	} else if ( id >= 49 && id <= 54 ) {
-		type = opdis_reg_flag_gen | opdis_reg_flag_seg;
-	} else if ( id == 55 ) {
-		type = opdis_reg_flag_pc;
-	} else if ( id == 56 ) {
-		type = opdis_reg_flag_flags;
-	} else if ( id >= 57 && id <= 60 ) {
-		type = opdis_reg_flag_mem;
-	}
-
-	return type;
-}
-
-static char intel_reg_size[] = {
-	1, 1, 1, 1, 1, 1, 1, 1, 	// al, cl, dl, bl, ah, ch, dh, bh
-	2, 2, 2, 2, 2, 2, 2, 2, 	// ax, cx, dx, bx, sp, bp, si, di
-	4, 4, 4, 4, 4, 4, 4, 4, 	// eax,ecx,edx,ebx,esp,ebp,esi,edi
-	8, 8, 8, 8, 8, 8, 8, 8, 	// rax,rcx,rdx,rbx,rsp,rbp,rsi,rdi
-	8, 8, 8, 8, 8, 8, 8, 8, 	// r8 - r15
-	1, 1, 1, 1, 1, 1, 1, 1, 	// r8l - r15l
-	2, 2, 2, 2, 2, 2, 2, 2, 	// r8w - r15w
-	4, 4, 4, 4, 4, 4, 4, 4, 	// r8d - r15d
-	8, 8, 8, 8, 8, 8, 8, 8, 	// mm0 - mm7
-	16, 16, 16, 16, 16, 16, 16, 16,	// xmm0 - xmm7
-	10, 10, 10, 10, 10, 10, 10, 10,	// st(0) - st(7)
-	4, 4, 4, 4, 4, 4, 4, 4, 	// cr0 - cr7
-	4, 4, 4, 4, 4, 4, 4, 4, 	// dr0 - dr7
-	2, 2, 2, 2, 2, 2, 		// cs, ds, ss, es, fs, gs 
-	4, 8, 4, 8, 			// eip, rip, eflags, rflags
-	1, 1, 1, 1, 			// spl, bpl, sil, dil
-	6, 6, 6, 6, 4 			// gdtr, ldtr, idtr, tr, mxcsr
+#define UNK	opdis_reg_flag_unknown
+#define GEN	opdis_reg_flag_gen
+#define FPU	opdis_reg_flag_fpu
+#define SIMD	opdis_reg_flag_simd
+#define TASK	opdis_reg_flag_task
+#define MEM	opdis_reg_flag_mem
+#define DEBUG	opdis_reg_flag_debug
+#define PC	opdis_reg_flag_pc
+#define FLAGS	opdis_reg_flag_flags
+#define STACK	opdis_reg_flag_stack
+#define FRAME	opdis_reg_flag_frame
+#define SEG	opdis_reg_flag_seg
+
+static const struct X86_REGISTER intel_registers[] = {
+	/* al, cl, dl, bl, ah, ch, dh, bh */
+	{ "al", 1, 1, GEN }, { "cl", 2, 1, GEN }, { "dl", 3, 1, GEN },
+	{ "bl", 4, 1, GEN }, { "ah", 1, 1, GEN }, { "ch", 2, 1, GEN },
+	{ "dh", 3, 1, GEN }, { "bh", 4, 1, GEN },
+	/* ax, cx, dx, bx, sp, bp, si, di */
+	{ "ax", 1, 2, GEN }, { "cx", 2, 2, GEN }, { "dx", 3, 2, GEN },
+	{ "bx", 4, 2, GEN }, { "sp", 5, 2, GEN | STACK },
+	{ "bp", 6, 2, GEN | FRAME }, { "si", 7, 2, GEN },
+	{ "di", 8, 2, GEN },
+	/* eax,ecx,edx,ebx,esp,ebp,esi,edi */
+	{ "eax", 1, 4, GEN }, { "ecx", 2, 4, GEN }, { "edx", 3, 4, GEN },
+	{ "ebx", 4, 4, GEN }, { "esp", 5, 4, GEN | STACK },
+	{ "ebp", 6, 4, GEN | FRAME }, { "esi", 7, 4, GEN },
+	{ "edi", 8, 4, GEN },
+	/* rax,rcx,rdx,rbx,rsp,rbp,rsi,rdi */
+	{ "rax", 1, 8, GEN }, { "rcx", 2, 8, GEN }, { "rdx", 3, 8, GEN },
+	{ "rbx", 4, 8, GEN }, { "rsp", 5, 8, GEN | STACK },
+	{ "rbp", 6, 8, GEN | FRAME }, { "rsi", 7, 8, GEN },
+	{ "rdi", 8, 8, GEN },
+	/* r8 - r15 */
+	{ "r8", 9, 8, GEN }, { "r9", 10, 8, GEN }, { "r10", 11, 8, GEN },
+	{ "r11", 12, 8, GEN }, { "r12", 13, 8, GEN }, { "r13", 14, 8, GEN },
+	{ "r14", 15, 8, GEN }, { "r15", 16, 8, GEN },
+	/* r8l - r15l */
+	{ "r8l", 9, 1, GEN }, { "r9l", 10, 1, GEN }, { "r10l", 11, 1, GEN },
+	{ "r11l", 12, 1, GEN }, { "r12l", 13, 1, GEN },
+	{ "r13l", 14, 1, GEN }, { "r14l", 15, 1, GEN },
+	{ "r15l", 16, 1, GEN },
+	/* r8w - r15w */
+	{ "r8w", 9, 2, GEN }, { "r9w", 10, 2, GEN }, { "r10w", 11, 2, GEN },
+	{ "r11w", 12, 2, GEN }, { "r12w", 13, 2, GEN },
+	{ "r13w", 14, 2, GEN }, { "r14w", 15, 2, GEN },
+	{ "r15w", 16, 2, GEN },
+	/* r8d - r15d */
+	{ "r8d", 9, 4, GEN }, { "r9d", 10, 4, GEN }, { "r10d", 11, 4, GEN },
+	{ "r11d", 12, 4, GEN }, { "r12d", 13, 4, GEN },
+	{ "r13d", 14, 4, GEN }, { "r14d", 15, 4, GEN },
+	{ "r15d", 16, 4, GEN },
+	/* mm0 - mm7 */
+	{ "mm0", 17, 8, FPU | SIMD }, { "mm1", 18, 8, FPU | SIMD },
+	{ "mm2", 19, 8, FPU | SIMD }, { "mm3", 20, 8, FPU | SIMD },
+	{ "mm4", 21, 8, FPU | SIMD }, { "mm5", 22, 8, FPU | SIMD },
+	{ "mm6", 23, 8, FPU | SIMD }, { "mm7", 24, 8, FPU | SIMD },
+	/* xmm0 - xmm7 */
+	{ "xmm0", 25, 16, SIMD }, { "xmm1", 26, 16, SIMD },
+	{ "xmm2", 27, 16, SIMD }, { "xmm3", 28, 16, SIMD },
+	{ "xmm4", 29, 16, SIMD }, { "xmm5", 30, 16, SIMD },
+	{ "xmm6", 31, 16, SIMD }, { "xmm7", 32, 16, SIMD },
+	/* st(0) - st(7) */
+	{ "st(0)", 17, 10, FPU | SIMD }, { "st(1)", 18, 10, FPU | SIMD },
+	{ "st(2)", 19, 10, FPU | SIMD }, { "st(3)", 20, 10, FPU | SIMD },
+	{ "st(4)", 21, 10, FPU | SIMD }, { "st(5)", 22, 10, FPU | SIMD },
+	{ "st(6)", 23, 10, FPU | SIMD }, { "st(7)", 24, 10, FPU | SIMD },
+	/* cr0 - cr7 */
+	{ "cr0", 33, 4, TASK }, { "cr1", 34, 4, TASK },
+	{ "cr2", 35, 4, TASK }, { "cr3", 36, 4, TASK },
+	{ "cr4", 37, 4, TASK }, { "cr5", 38, 4, TASK },
+	{ "cr6", 39, 4, TASK }, { "cr7", 40, 4, TASK },
+	/* dr0 - dr7 */
+	{ "dr0", 41, 4, DEBUG }, { "dr1", 42, 4, DEBUG },
+	{ "dr2", 43, 4, DEBUG }, { "dr3", 44, 4, DEBUG },
+	{ "dr4", 45, 4, DEBUG }, { "dr5", 46, 4, DEBUG },
+	{ "dr6", 47, 4, DEBUG }, { "dr7", 48, 4, DEBUG },
+	/* cs, ds, ss, es, fs, gs */
+	{ "cs", 49, 2, GEN | SEG }, { "ds", 50, 2, GEN | SEG },
+	{ "ss", 51, 2, GEN | SEG }, { "es", 52, 2, GEN | SEG },
+	{ "fs", 53, 2, GEN | SEG }, { "gs", 54, 2, GEN | SEG },
+	/* eip, rip, eflags, rflags */
+	{ "eip", 55, 4, PC }, { "rip", 55, 8, PC },
+	{ "eflags", 56, 4, FLAGS }, { "rflags", 56, 8, FLAGS },
+	/* spl, bpl, sil, dil */
+	{ "spl", 5, 1, GEN | STACK }, { "bpl", 6, 1, GEN | FRAME },
+	{ "sil", 7, 1, GEN }, { "dil", 8, 1, GEN },
+	/* gdtr, ldtr, idtr, tr, mxcsr */
+	{ "gdtr", 57, 6, MEM }, { "ldtr", 58, 6, MEM },
+	{ "idtr", 59, 6, MEM }, { "tr", 60, 6, MEM },
+	{ "mxcsr", 61, 4, SIMD }
 };
 
-static const char * intel_registers[] = {
-	"al", "cl", "dl", "bl", "ah", "ch", "dh", "bh",
-	"ax", "cx", "dx", "bx", "sp", "bp", "si", "di",
-	"eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi",
-	"rax", "rcx", "rdx", "rbx", "rsp", "rbp", "rsi", "rdi",
-	"r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15",
-	"r8l", "r9l", "r10l", "r11l", "r12l", "r13l", "r14l", "r15l",
-	"r8w", "r9w", "r10w", "r11w", "r12w", "r13w", "r14w", "r15w",
-	"r8d", "r9d", "r10d", "r11d", "r12d", "r13d", "r14d", "r15d",
-	"mm0", "mm1", "mm2", "mm3", "mm4", "mm5", "mm6", "mm7",
-	"xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7",
-	"st(0)", "st(1)", "st(2)", "st(3)", "st(4)", "st(5)", "st(6)", "st(7)",
-	"cr0", "cr1", "cr2", "cr3", "cr4", "cr5", "cr6", "cr7",
-	"dr0", "dr1", "dr2", "dr3", "dr4", "dr5", "dr6", "dr7",
-	"cs", "ds", "ss", "es", "fs", "gs", 
-	"eip", "rip", "eflags", "rflags",
-	"spl", "bpl", "sil", "dil", 
-	"gdtr", "ldtr", "idtr", "tr", "mxcsr"
+#undef UNK
+#undef GEN
+#undef FPU
+#undef SIMD
+#undef TASK
+#undef MEM
+#undef DEBUG
+#undef PC
+#undef FLAGS
+#undef STACK
+#undef FRAME
+#undef SEG
+
+/* The register names are indexed by a perfect hash; see
+ * opdis_x86_name_hash() in x86_mnemonic.c. The tables below are generated
+ * by util/x86_hash.py: run "util/x86_hash.py register" when a register is
+ * added or removed. */
+#define NUM_REG_BUCKETS 48
+#define NUM_REG_SLOTS 256
+
+/* displacement for each bucket */
+static const unsigned char reg_bucket_disp[48] = {
+	1, 0, 0, 2, 1, 3, 2, 1, 0, 1, 5, 0, 0, 0, 1, 0,
+	0, 13, 3, 0, 1, 1, 2, 0, 0, 1, 0, 0, 4, 0, 0, 1,
+	2, 0, 0, 0, 0, 0, 0, 2, 0, 0, 1, 10, 3, 1, 0, 0
 };
 
-static int intel_register_lookup( const char * item ) {
-	int i;
-	int num_regs = (int) sizeof(intel_registers) / sizeof(char *);
-	for ( i = 0; i < num_regs; i++ ) {
-		if (! strcmp(intel_registers[i], item) ) {
-			return i;
-		}
-	}
+/* index + 1 of the register in each slot; 0 if the slot is empty */
+static const unsigned char reg_slot[256] = {
+	0, 27, 0, 122, 75, 0, 12, 67, 86, 0, 0, 35, 24, 0, 76, 0,
+	94, 44, 1, 0, 0, 36, 0, 0, 0, 77, 0, 0, 108, 10, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 72, 0, 0, 95, 0, 55, 0, 119,
+	29, 113, 52, 0, 116, 89, 0, 0, 0, 21, 101, 0, 9, 73, 32, 30,
+	0, 0, 0, 0, 63, 0, 0, 0, 39, 47, 0, 84, 0, 38, 6, 61,
+	0, 11, 48, 18, 0, 82, 0, 0, 0, 40, 80, 120, 97, 78, 109, 0,
+	0, 41, 0, 107, 64, 0, 33, 0, 43, 56, 31, 0, 85, 0, 115, 0,
+	118, 17, 0, 99, 68, 0, 59, 0, 0, 0, 20, 104, 0, 0, 0, 0,
+	0, 7, 50, 90, 103, 2, 0, 0, 0, 0, 121, 0, 98, 117, 0, 14,
+	0, 0, 0, 106, 0, 0, 0, 0, 0, 0, 51, 0, 0, 0, 0, 0,
+	110, 100, 65, 0, 91, 0, 0, 102, 83, 0, 0, 4, 60, 45, 0, 0,
+	0, 54, 0, 0, 0, 0, 58, 123, 0, 0, 37, 71, 0, 53, 96, 70,
+	5, 111, 0, 87, 13, 0, 88, 0, 112, 57, 0, 0, 81, 3, 0, 0,
+	19, 0, 0, 34, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 69, 22, 66, 28, 46, 0, 0, 74, 0, 0, 0, 25, 79, 16, 0,
+	92, 15, 0, 105, 0, 62, 23, 8, 42, 49, 0, 26, 114, 0, 0, 93
+};
 
-	return -1;
-}
+static const struct X86_REGISTER * intel_register_lookup_len( const char * item,
+							     size_t len ) {
+	const struct X86_REGISTER * reg;
+	unsigned int h1, h2, slot, idx;
 
-static void fill_register_by_id(opdis_reg_t * reg, int id) {
-	if ( id > -1 ) {
-		reg->id = intel_reg_id[id];
-		reg->flags = lookup_register_type(reg->id);
-		reg->size = intel_reg_size[id];
-		strncpy( reg->ascii, intel_registers[id], 
-			 OPDIS_REG_NAME_SZ - 1 );
-	} else {
-		reg->flags = opdis_reg_flag_unknown;
-		reg->id = reg->size = 0;
+	opdis_x86_name_hash( item, len, &h1, &h2 );
+	slot = (h1 + reg_bucket_disp[h1 % NUM_REG_BUCKETS] * h2) %
+		NUM_REG_SLOTS;
+	idx = reg_slot[slot];
+	if (! idx ) {
+		return NULL;
+	}
+
+	reg = &intel_registers[idx - 1];
+	if ( strncmp( reg->name, item, len ) || reg->name[len] ) {
+		return NULL;
 	}
-}
 
-static void fill_register( opdis_reg_t * reg, const char * name ) {
-	int id = intel_register_lookup(name);
-	return fill_register_by_id(reg, id);
+	return reg;
 }
 
-static int register_for_token( const char * tok ) {
-	char buf[OPDIS_REG_NAME_SZ];
-	int i;
-	if (! tok ) {
-		return -1;
-	}
+static const struct X86_REGISTER * intel_register_lookup( const char * item ) {
+	return intel_register_lookup_len( item, strlen(item) );
+}
 
-	for ( i=0; tok[i] && isalnum(tok[i]); i++ ) {
-		buf[i] = tok[i];
+static void fill_register_desc( opdis_reg_t * reg,
+				const struct X86_REGISTER * desc ) {
+	if ( desc ) {
+		reg->id = desc->id;
+		reg->flags = desc->flags;
+		reg->size = desc->size;
+		strncpy( reg->ascii, desc->name, OPDIS_REG_NAME_SZ - 1 );
+	} else {
+		reg->flags = opdis_reg_flag_unknown;
+		reg->id = reg->size = 0;
 	}
-	buf[i] = '\0';
-
-	return intel_register_lookup( buf );
 }
 
 /* ---------------------------------------------------------------------- */
@@ -465,7 +547,9 @@ static void parse_insn_buf( const opdis_insn_buf_t in, IS_OPERAND_FN is_operand,
 		     parse->cmt = parse->cmt_char = -1;
 
 	for ( i=0; i < in->item_count; i++ ) {
-		if ( is_operand(in->items[i]) && parse->cmt_char == -1 ) {
+		const char * item = OPDIS_INSN_BUF_ITEM(in, i);
+
+		if ( is_operand(item) && parse->cmt_char == -1 ) {
 			/* all operands-looking tokens before # are operands */
 			if ( parse->first_op == -1 ) {
 				parse->first_op = i;
@@ -474,7 +558,7 @@ static void parse_insn_buf( const opdis_insn_buf_t in, IS_OPERAND_FN is_operand,
 			parse->last_op = i;
 		}
 
-		if ( strchr(in->items[i], '#') != NULL ) {
+		if ( memchr(item, '#', in->tokens[i].length) != NULL ) {
 			parse->cmt_char = i;
 			if ( i + 1 < in->item_count ) {
 				parse->cmt = i + 1;
@@ -495,7 +579,8 @@ static void parse_insn_buf( const opdis_insn_buf_t in, IS_OPERAND_FN is_operand,
 
 	if ( parse->mnem > 0 ) {
 		parse->pfx = 0;
-	} else if (parse->mnem == 0 && intel_prefix_lookup(in->items[0]) > -1) {
+	} else if (parse->mnem == 0 &&
+		   intel_prefix_lookup(OPDIS_INSN_BUF_ITEM(in, 0)) > -1) {
 		/* verify that this is not a prefix */
 		parse->pfx = parse->mnem;
 		parse->mnem = 0;
@@ -509,7 +594,7 @@ static void add_prefixes( const opdis_insn_buf_t in, opdis_insn_t * out,
 	/* fill prefixes */
 	max_i = (parse->mnem > -1) ? parse->mnem : in->item_count;
 	for ( i = parse->pfx; i > -1 && i < max_i; i++ ) {
-		opdis_insn_add_prefix( out, in->items[i] );
+		opdis_insn_add_prefix( out, OPDIS_INSN_BUF_ITEM(in, i) );
 	}
 }
 
@@ -518,7 +603,7 @@ static void add_comments( const opdis_insn_buf_t in, opdis_insn_t * out,
 	int i;
 
 	for ( i = parse->cmt; i > -1 && i < in->item_count; i++ ) {
-		char * c = in->items[i];
+		char * c = OPDIS_INSN_BUF_ITEM(in, i);
 		while ( *c && isspace(*c) )
 			c++;
 		opdis_insn_add_comment( out, c );
@@ -527,204 +612,492 @@ static void add_comments( const opdis_insn_buf_t in, opdis_insn_t * out,
 	if ( parse->pfx > -1 && parse->mnem == -1 ) {
 		// TODO: set insn status to invalid?
 		opdis_insn_add_comment( out, "Warning: prefix w/o insn" );
-	} else if ( parse->mnem > -1 && in->items[parse->mnem][0] == '.' ) {
+	} else if ( parse->mnem > -1 &&
+		    OPDIS_INSN_BUF_ITEM(in, parse->mnem)[0] == '.' ) {
 		// TODO: set insn status to invalid?
 		opdis_insn_add_comment( out, "Warning: directive (data)" );
 	}
 }
 
-/* ---------------------------------------------------------------------- */
-/* AT&T DECODING */
+/* decode the unstyled items emitted by libopcodes */
+static void decode_insn_items( const opdis_insn_buf_t in, opdis_insn_t * out,
+			       IS_OPERAND_FN is_operand,
+			       MNEMONIC_ITEM_FN mnemonic_fn,
+			       OPERAND_DECODE_FN operand_fn ) {
+	struct INSN_BUF_PARSE parse = { 0 };
+	int i;
 
-static int is_att_operand( const char * item ) {
-	int rv = 0;
-	switch ( item[0] ) {
-		case '0': case '%': case '$': case '*': case '-': case '(':
-			rv = 1; break;
-		default:
-			break;
+	parse_insn_buf( in, is_operand, & parse );
+
+	if ( in->decode_level & opdis_decode_mnem ) {
+		add_prefixes( in, out, & parse );
 	}
-	return rv;
-}
 
-static void decode_att_mnemonic( opdis_insn_t * out, const char * item ) {
-	// TODO: handle mem operand size: b w l q ?
-	return decode_intel_mnemonic( out, item );
+	/* fill instruction info */
+	if ( parse.mnem > -1 ) {
+		mnemonic_fn( out, OPDIS_INSN_BUF_ITEM(in, parse.mnem),
+			     in->decode_level );
+	}
+
+	if (! want_operands( in, out ) ) {
+		return;
+	}
+	out->status |= opdis_decode_ops | opdis_decode_op_flags;
+
+	/* fill operands */
+	for ( i = parse.first_op; i > -1 && i <= parse.last_op; i++ ) {
+		if ( OPDIS_INSN_BUF_ITEM(in, i)[0] != ',' ) {
+			decode_operand( opdis_insn_next_avail_op(out),
+					operand_fn,
+					OPDIS_INSN_BUF_ITEM(in, i) );
+		}
+	}
+
+	add_comments( in, out, & parse );
 }
 
+/* ---------------------------------------------------------------------- */
+/* STYLED DECODING */
 
+/* libopcodes versions with fprintf_styled_func emit typed items, e.g.
+ * "0x8" (address offset) "(" (text) "%ebp" (register) ")" (text). Operands
+ * are built from the item styles instead of being parsed from strings. */
 
-static void fill_att_expression( opdis_addr_expr_t *expr, const char * item,
-			     const char * first_paren ) {
-	/* format : section:disp(base,index.scale) */
-	int seg = -1, base = -1, index = -1, scale = 1, tok_count = 0;
-	enum opdis_addr_expr_elem_t flags = 0;
-	const char * base_tok = NULL, * index_tok = NULL, * scale_tok = NULL;
-	const char * ptr, * tok, * end_paren = strchr( item, ')' );
-	end_paren = (end_paren == NULL) ? item + strlen(item) -1 : end_paren;
+struct STYLED_OPERAND {
+	const struct X86_REGISTER * reg, * seg, * base, * index;
+	const char * value, * disp, * scale;
+	enum opdis_token_style_t value_style;
+	int mem, in_mem, commas, star, neg, disp_neg, indirect, ptr;
+};
 
-	if ( first_paren != item ) {
-		/* displacement always precedes SIB */
-		const char * col = strchr( item, ':' );
-		flags |= opdis_addr_expr_disp;
-		if ( col != NULL ) {
-			/* segment register followed by optional displacement */
-			fill_register_by_id( &expr->displacement.a.segment, 
-					     register_for_token(&item[1]) );
-			if ( col + 1 < first_paren ) {
-				fill_immediate( &expr->displacement.a.offset, 
-						col + 1 );
-			}
-			flags |= opdis_addr_expr_disp_abs;
+static const char * styled_value( const char * item ) {
+	/* AT&T immediates are prefixed with $ */
+	return ( *item == '$' ) ? item + 1 : item;
+}
+
+static void styled_register( struct STYLED_OPERAND * op, const char * item,
+			     unsigned int len, int att ) {
+	const struct X86_REGISTER * reg;
+
+	if ( *item == '%' ) {
+		item++;
+		len--;
+	}
+
+	reg = intel_register_lookup_len( item, len );
+	if (! op->in_mem ) {
+		op->reg = reg;
+	} else if ( att ) {
+		/* disp(base,index,scale) */
+		if ( op->commas == 0 ) {
+			op->base = reg;
 		} else {
-			/* displacement */
-			fill_immediate( &expr->displacement.u, item );
-			if ( item[0] == '-' ) {
-				flags |= opdis_addr_expr_disp_s;
-			} else {
-				flags |= opdis_addr_expr_disp_u;
-			}
+			op->index = reg;
 		}
+	} else if (! op->base ) {
+		/* [base+index*scale+disp] */
+		op->base = reg;
+	} else {
+		op->index = reg;
 	}
+}
 
-	for ( ptr = tok = first_paren + 1; ptr < end_paren; ptr++ ) {
-		if ( *ptr == ',' ) {
-			if (! tok_count ) {
-				base_tok = tok;
-			} else {
-				index_tok = tok;
-			}
-			tok_count++;
-			tok = ptr + 1;
+static void styled_value_item( struct STYLED_OPERAND * op, const char * item,
+			       enum opdis_token_style_t style, int att ) {
+	if ( op->in_mem ) {
+		if ( (att && op->commas >= 2) || (! att && op->star) ) {
+			op->scale = item;
+			op->star = 0;
+		} else {
+			op->disp = item;
+			op->disp_neg = op->neg;
 		}
+	} else if (! op->mem ) {
+		/* for AT&T, this becomes the displacement if ( follows */
+		op->value = styled_value( item );
+		op->value_style = style;
 	}
+	op->neg = 0;
+}
 
-	if (! base_tok ) {
-		base_tok = tok;
-	} else if (! index_tok && *tok != '1' ) {	/* handle disp(,1) */
-		index_tok = tok;
-	} else {
-		scale_tok = tok;
+static void styled_text( struct STYLED_OPERAND * op, const char * item,
+			 unsigned int start, unsigned int end, int att ) {
+	for ( ; start < end; start++ ) {
+		switch ( item[start] ) {
+			case '(': case '[':
+				op->in_mem = op->mem = 1;
+				break;
+			case ')': case ']':
+				op->in_mem = 0;
+				break;
+			case ',':
+				op->commas += op->in_mem;
+				break;
+			case '*':
+				if (! op->in_mem ) {
+					op->indirect = 1;
+				} else if (! att ) {
+					/* the register before * is index */
+					if (! op->index ) {
+						op->index = op->base;
+						op->base = NULL;
+					}
+					op->star = 1;
+				}
+				break;
+			case ':':
+				if ( op->reg ) {
+					op->seg = op->reg;
+					op->reg = NULL;
+				}
+				break;
+			case '-':
+				op->neg = 1;
+				break;
+			case '+':
+				op->neg = 0;
+				break;
+			case 'P':
+				if ( end - start >= 3 &&
+				     ! strncmp( &item[start], "PTR", 3 ) ) {
+					op->ptr = 1;
+				}
+				break;
+		}
 	}
+}
 
-	if ( base_tok ) {
-		base = register_for_token( &base_tok[1] );
-	}
-	if ( index_tok ) {
-		index = register_for_token( &index_tok[1] );
+static void fill_styled_expression( opdis_addr_expr_t * expr,
+				    struct STYLED_OPERAND * op ) {
+	enum opdis_addr_expr_elem_t flags = 0;
+
+	if ( op->seg ) {
+		fill_register_desc( &expr->displacement.a.segment, op->seg );
+		flags |= opdis_addr_expr_disp_abs;
 	}
-	if ( scale_tok ) {
-		scale = strtol( scale_tok, NULL, 0 );
+
+	if ( op->disp ) {
+		uint64_t * disp = ( op->seg ) ? &expr->displacement.a.offset :
+						&expr->displacement.u;
+		flags |= opdis_addr_expr_disp;
+		fill_immediate( disp, op->disp );
+		if ( op->disp_neg ) {
+			*disp = (uint64_t) -((int64_t) *disp);
+		}
+		if ( op->disp_neg || op->disp[0] == '-' ) {
+			flags |= opdis_addr_expr_disp_s;
+		} else {
+			flags |= opdis_addr_expr_disp_u;
+		}
 	}
 
-	if ( base != -1 ) {
-		fill_register_by_id( &expr->base, base );
+	if ( op->base ) {
+		fill_register_desc( &expr->base, op->base );
 		flags |= opdis_addr_expr_base;
 	}
-	if ( index != -1 ) {
-		fill_register_by_id( &expr->index, index );
+	if ( op->index ) {
+		fill_register_desc( &expr->index, op->index );
 		flags |= opdis_addr_expr_index;
 	}
-	expr->scale = scale;
+
+	expr->scale = ( op->scale ) ? strtol( op->scale, NULL, 0 ) : 1;
 	expr->shift = opdis_addr_expr_asl;
 	expr->elements = flags;
 }
 
-static void decode_att_operand( opdis_op_t * out, const char * item ) {
-	const char * start;
-	out->flags = 0;
-
-	switch ( item[0] ) {
-		case '$':			/* immediate value */
-			out->category = opdis_op_cat_immediate;
-			fill_immediate( &out->value.immediate.u, &item[1] );
+static void fill_styled_operand( opdis_op_t * out,
+				 struct STYLED_OPERAND * op, int att ) {
+	if ( op->mem ) {
+		if ( att && ! op->disp && op->value ) {
+			op->disp = op->value;
+		}
+		out->category = opdis_op_cat_expr;
+		out->flags |= opdis_op_flag_address;
+		fill_styled_expression( &out->value.expr, op );
+	} else if ( op->seg && op->value ) {
+		out->category = opdis_op_cat_absolute;
+		out->flags |= opdis_op_flag_address;
+		fill_register_desc( &out->value.abs.segment, op->seg );
+		fill_immediate( &out->value.abs.offset, op->value );
+	} else if ( op->reg ) {
+		out->category = opdis_op_cat_register;
+		fill_register_desc( &out->value.reg, op->reg );
+	} else if ( op->value ) {
+		out->category = opdis_op_cat_immediate;
+		fill_immediate( &out->value.immediate.u, op->value );
+		if ( op->value[0] == '-' ) {
+			out->flags |= opdis_op_flag_signed;
+		}
+		if ( op->value_style == opdis_token_style_immediate ) {
 			out->flags |= opdis_op_flag_r;
-			if ( item[1] == '-' ) {
-				out->flags |= opdis_op_flag_signed;
-			}
-			return;
-		case '%':			/* CPU register */
-			out->category = opdis_op_cat_register;
-			fill_register( &out->value.reg, &item[1] );
-			return;
-		case '*':			/* indirect jump/call addr */
-			out->flags |= opdis_op_flag_indirect;
-			/* * is followed by either a reg or expr; recurse */
-			decode_att_operand( out, &item[1] );
-			return;
-		default:
-			/* All other values are assumed to be addresses */
+		} else {
 			out->flags |= opdis_op_flag_address;
-			start = strchr( item, '(' );
-			if ( start ) {
-				out->category = opdis_op_cat_expr;
-				fill_att_expression(&out->value.expr, item, 
-						    start);
-			} else {
-				start = strchr( item, ',' );
-				if ( start ) {
-					out->category = opdis_op_cat_absolute;
-					fill_register_by_id( 
-						&out->value.abs.segment, 
-						register_for_token(item) );
-					fill_immediate( &out->value.abs.offset, 
-							start );
-				} else {
-					out->category = opdis_op_cat_immediate;
-					fill_immediate( &out->value.immediate.u,
-							item );
-				}
-			}
+		}
+	}
+
+	if ( op->indirect ) {
+		out->flags |= opdis_op_flag_indirect;
+	}
+	if ( op->ptr ) {
+		out->flags |= opdis_op_flag_indirect | opdis_op_flag_address;
 	}
 }
 
-int opdis_x86_att_decoder( const opdis_insn_buf_t in, opdis_insn_t * out,
-		           const opdis_byte_t * buf, opdis_off_t offset,
-			   opdis_vma_t vma, opdis_off_t length, void * arg ) {
+static void decode_styled_operand( const opdis_insn_buf_t in, opdis_op_t * out,
+				   const opdis_insn_span_t * span, int att ) {
+	struct STYLED_OPERAND op = { 0 };
+	unsigned int i;
+
+	out->category = opdis_op_cat_unknown;
+	out->flags = opdis_op_flag_none;
+
+	for ( i = span->first; i <= span->last; i++ ) {
+		const opdis_insn_token_t * tok = &in->tokens[i];
+		const char * item = OPDIS_INSN_BUF_ITEM(in, i);
+
+		switch ( tok->style ) {
+			case opdis_token_style_register:
+				styled_register( &op, item, tok->length, att );
+				break;
+			case opdis_token_style_immediate:
+			case opdis_token_style_address:
+			case opdis_token_style_address_offset:
+				styled_value_item( &op, item, tok->style, att );
+				break;
+			case opdis_token_style_text:
+			case opdis_token_style_none:
+				styled_text( &op, item,
+				     ( i == span->first ) ? span->start : 0,
+				     ( i == span->last ) ? span->end :
+							   tok->length, att );
+				break;
+			default:
+				/* symbols are informational */
+				break;
+		}
+	}
 
-	int i, max_i, rv;
-	struct INSN_BUF_PARSE parse = { 0 };
+	fill_styled_operand( out, &op, att );
+}
 
-	rv = opdis_default_decoder( in, out, buf, offset, vma, length, NULL );
+static void decode_styled_insn( const opdis_insn_buf_t in, opdis_insn_t * out,
+				const opdis_insn_layout_t * layout,
+				MNEMONIC_ITEM_FN mnemonic_fn, int att ) {
+	char str[OPDIS_MAX_INSN_STR];
+	opdis_insn_span_t span;
+	unsigned int i;
+
+	for ( i = layout->prefix; layout->prefix > -1 &&
+			(in->decode_level & opdis_decode_mnem) &&
+			i < (unsigned int) layout->mnemonic; i++ ) {
+		span.first = span.last = i;
+		span.start = 0;
+		span.end = in->tokens[i].length;
+		if ( opdis_insn_buf_span_str( in, &span, str, sizeof(str) ) ) {
+			opdis_insn_add_prefix( out, str );
+		}
+	}
 
-	parse_insn_buf( in, is_att_operand, & parse );
+	if ( layout->mnemonic > -1 ) {
+		span.first = layout->mnemonic;
+		span.start = 0;
+		span.last = layout->mnemonic_end - 1;
+		span.end = in->tokens[span.last].length;
+		opdis_insn_buf_span_str( in, &span, str, sizeof(str) );
+		mnemonic_fn( out, str, in->decode_level );
+	}
 
-	add_prefixes( in, out, &parse );
+	if (! want_operands( in, out ) ) {
+		return;
+	}
+	out->status |= opdis_decode_ops | opdis_decode_op_flags;
 
-	/* fill instruction info */
-	if ( parse.mnem > -1 ) {
-		char *c, mnem[32];
-		int i;
+	for ( i = 0; i < layout->num_operands; i++ ) {
+		opdis_op_t * op = opdis_insn_next_avail_op( out );
+		if (! op ) {
+			break;
+		}
 
-		/* check for branch hint */
-		for ( i = 0, c = in->items[parse.mnem]; 
-		      i < 32 && *c && *c != ','; i++, c++ ) {
-			mnem[i] = *c;
+		opdis_insn_buf_span_str( in, &layout->operands[i], str,
+					 sizeof(str) );
+		opdis_op_set_ascii( op, str );
+		decode_styled_operand( in, op, &layout->operands[i], att );
+	}
+
+	if ( layout->comment > -1 &&
+	     (unsigned int) layout->comment + 1 < in->item_count ) {
+		span.first = layout->comment + 1;
+		span.start = 0;
+		span.last = in->item_count - 1;
+		span.end = in->tokens[span.last].length;
+		if ( opdis_insn_buf_span_str( in, &span, str, sizeof(str) ) ) {
+			opdis_insn_add_comment( out, str );
 		}
-		mnem[i] = '\0';
-		if ( *c == ',' ) {
-			char buf[16];
+	}
+
+	if ( out->mnemonic && out->mnemonic[0] == '.' ) {
+		// TODO: set insn status to invalid?
+		opdis_insn_add_comment( out, "Warning: directive (data)" );
+	}
+}
+
+/* ---------------------------------------------------------------------- */
+/* OPERAND LEXER */
+
+/* Unstyled operands (e.g. "-0x8(%ebp,%eax,4)" or "DWORD PTR fs:[eax*4-0x8]")
+ * are split into register, value and text tokens in a single forward scan.
+ * The tokens are fed to the styled decoding routines, so that both paths
+ * build operands the same way. */
+
+static unsigned int lex_ident_len( const char * item ) {
+	unsigned int len;
+
+	for ( len = 0; isalnum((unsigned char) item[len]) || item[len] == '_';
+	      len++ )
+		;
+
+	/* FPU stack registers: st(0) ... st(7) */
+	if ( len == 2 && item[0] == 's' && item[1] == 't' && item[2] == '(' &&
+	     isdigit((unsigned char) item[3]) && item[4] == ')' ) {
+		len += 3;
+	}
+
+	return len;
+}
+
+static unsigned int lex_value_len( const char * item ) {
+	unsigned int len = ( *item == '-' ) ? 1 : 0;
 
-			for ( i = 0, c++; i < 16 && *c && ! isspace(*c); 
-			      i++, c++ ) {
-				buf[i] = *c;
+	while ( isalnum((unsigned char) item[len]) ) {
+		len++;
+	}
+
+	return len;
+}
+
+static void lex_operand( struct STYLED_OPERAND * op, const char * item,
+			 int att ) {
+	enum opdis_token_style_t value_style = ( att ) ?
+						opdis_token_style_address :
+						opdis_token_style_immediate;
+	const char * c = item;
+	unsigned int len;
+
+	while ( *c ) {
+		if ( *c == '%' || isalpha((unsigned char) *c) ) {
+			const char * name = ( *c == '%' ) ? c + 1 : c;
+			len = lex_ident_len( name );
+			if ( intel_register_lookup_len( name, len ) ) {
+				styled_register( op, name, len, att );
+			} else {
+				/* size keywords, PTR */
+				styled_text( op, name, 0, len, att );
 			}
-			buf[i] = '\0';
-			opdis_insn_add_prefix( out, buf );
+			c = name + len;
+		} else if ( isdigit((unsigned char) *c) ||
+			    (*c == '-' && isdigit((unsigned char) c[1])) ) {
+			len = lex_value_len( c );
+			styled_value_item( op, c, value_style, att );
+			c += len;
+		} else if ( *c == '$' ) {
+			value_style = opdis_token_style_immediate;
+			c++;
+		} else if ( *c == '<' ) {
+			/* symbol names are informational */
+			while ( *c && *c != '>' ) {
+				c++;
+			}
+		} else {
+			styled_text( op, c, 0, 1, att );
+			c++;
 		}
+	}
+}
+
+static void decode_lexed_operand( opdis_op_t * out, const char * item,
+				  int att ) {
+	struct STYLED_OPERAND op = { 0 };
+
+	lex_operand( &op, item, att );
+	fill_styled_operand( out, &op, att );
+}
+
+/* ---------------------------------------------------------------------- */
+/* AT&T DECODING */
 
-		decode_mnemonic( out, decode_att_mnemonic, mnem );
+static int is_att_operand( const char * item ) {
+	int rv = 0;
+	switch ( item[0] ) {
+		case '0': case '%': case '$': case '*': case '-': case '(':
+			rv = 1; break;
+		default:
+			break;
 	}
+	return rv;
+}
 
-	/* fill operands */
-	for ( i = parse.first_op; i > -1 && i <= parse.last_op; i++ ) {
-		if ( in->items[i][0] != ',' ) {
-			decode_operand( opdis_insn_next_avail_op(out),
-					decode_att_operand, in->items[i] );
+static void decode_att_mnemonic( opdis_insn_t * out, const char * item ) {
+	// TODO: handle mem operand size: b w l q ?
+	return decode_intel_mnemonic( out, item );
+}
+
+
+
+static void decode_att_operand( opdis_op_t * out, const char * item ) {
+	/* format : section:disp(base,index,scale) */
+	decode_lexed_operand( out, item, 1 );
+}
+
+static void decode_att_mnemonic_hint( opdis_insn_t * out,
+				      const char * item, unsigned int level ) {
+	char mnem[32];
+	const char *c;
+	int i;
+
+	/* check for branch hint */
+	for ( i = 0, c = item; i < 31 && *c && *c != ','; i++, c++ ) {
+		mnem[i] = *c;
+	}
+	mnem[i] = '\0';
+	if ( *c == ',' && (level & opdis_decode_mnem) ) {
+		char buf[16];
+
+		for ( i = 0, c++; i < 15 && *c && ! isspace(*c); 
+		      i++, c++ ) {
+			buf[i] = *c;
 		}
+		buf[i] = '\0';
+		opdis_insn_add_prefix( out, buf );
 	}
 
-	add_comments( in, out, & parse );
+	decode_mnemonic( out, decode_att_mnemonic, mnem, level );
+}
+
+int opdis_x86_att_decoder( const opdis_insn_buf_t in, opdis_insn_t * out,
+		           const opdis_byte_t * buf, opdis_off_t offset,
+			   opdis_vma_t vma, opdis_off_t length, void * arg ) {
+
+	int rv;
+	opdis_insn_layout_t layout;
+
+	rv = opdis_default_decoder( in, out, buf, offset, vma, length, NULL );
+
+	if (! (in->decode_level & ~opdis_decode_basic) ) {
+		return rv;
+	}
+
+	if ( opdis_insn_buf_layout( in, &layout ) ) {
+		decode_styled_insn( in, out, &layout, decode_att_mnemonic_hint,
+				    1 );
+	} else {
+		decode_insn_items( in, out, is_att_operand,
+				   decode_att_mnemonic_hint,
+				   decode_att_operand );
+	}
+
+	if (! (out->status & opdis_decode_ops) ) {
+		return rv;
+	}
 
 	/* set operand pointers */
 	if ( out->category == opdis_insn_cat_cflow ) {
@@ -746,12 +1119,6 @@ int opdis_x86_att_decoder( const opdis_insn_buf_t in, opdis_insn_t * out,
 		}
 	}
 
-	// NOTE: it might be better to set the *_flags status(es) only
-	//       when insn and operands have been successfully parsed
-	out->status |= (opdis_decode_basic | opdis_decode_mnem | 
-			opdis_decode_ops | opdis_decode_mnem_flags |
-			opdis_decode_op_flags);
-
 	return rv;
 }
 
@@ -759,7 +1126,7 @@ int opdis_x86_att_decoder( const opdis_insn_buf_t in, opdis_insn_t * out,
 /* INTEL DECODING */
 
 static int is_intel_operand( const char * item ) {
-	if ( intel_register_lookup(item) > -1 ) {
+	if ( intel_register_lookup(item) ) {
 		return 1;
 	}
 
@@ -777,157 +1144,41 @@ static int is_intel_operand( const char * item ) {
 	return 0;
 }
 
-static void fill_intel_expression( opdis_addr_expr_t *expr, const char * item,
-				   const char * first_paren ) {
+static void decode_intel_operand( opdis_op_t * op, const char * item ) {
 	/* format: segment:[base + index * scale + disp] */
-	int seg = -1, base = -1, index = -1, scale = 1, tok_count = 0;
-	enum opdis_addr_expr_elem_t flags = 0;
-	const char * base_tok = NULL, * index_tok = NULL, * scale_tok = NULL,
-	      	   * disp_tok = NULL;
-	const char * ptr, * tok, * end_paren = strchr( item, ']' );
-	end_paren = (end_paren == NULL) ? item + strlen(item) -1 : end_paren;
-
-	if ( first_paren != item ) {
-		/* segment always precedes SIP */
-		const char * col = strchr( item, ':' );
-		if ( col != NULL ) {
-			fill_register_by_id( &expr->displacement.a.segment,
-					register_for_token( base_tok ) );
-			flags |= opdis_addr_expr_disp_abs;
-		}
-	}
-
-	for ( ptr = tok = first_paren + 1; ptr < end_paren; ptr++ ) {
-		if ( *ptr == '+' ) {
-			if (! tok_count ) {
-				base_tok = tok;
-			} else {
-				scale_tok = tok;
-			}
-			tok_count++;
-			tok = ptr + 1;
-		} else if ( *ptr == '*' ) {
-			index_tok = tok;
-			tok_count++;
-			tok = ptr + 1;
-		}
-	}
-
-	/* only a single token means either base register or disp */
-	if (! base_tok ) {
-		if ( isalpha(tok[0]) ) {
-			base_tok = tok;
-		} else {
-			disp_tok = tok;
-		}
-	} else if ( *(tok-1) == '*' ) {
-		/* remaining token is scale if previous byte was '*' */
-		scale_tok = tok;
-	} else {
-		/* remaining token is displacement */
-		disp_tok = tok;
-	}
-
-	base = register_for_token( base_tok );
-	index = register_for_token( index_tok );
-	if ( scale_tok ) {
-		scale = strtol( scale_tok, NULL, 0 );
-	}
-
-	if ( disp_tok ) {
-		flags |= opdis_addr_expr_disp_abs;
-		fill_immediate( &expr->displacement.u, item );
-		if ( item[0] == '-' ) {
-			flags |= opdis_addr_expr_disp_s;
-		} else {
-			flags |= opdis_addr_expr_disp_u;
-		}
-	}
-
-	if ( base != -1 ) {
-		fill_register_by_id( &expr->base, base );
-		flags |= opdis_addr_expr_base;
-	}
-	if ( index != -1 ) {
-		fill_register_by_id( &expr->index, index );
-		flags |= opdis_addr_expr_index;
-	}
-
-	expr->scale = scale;
-	expr->shift = opdis_addr_expr_asl;
-	expr->elements = flags;
+	decode_lexed_operand( op, item, 0 );
 }
 
-static void decode_intel_operand( opdis_op_t * op, const char * item ) {
-	const char * start;
-	int reg = intel_register_lookup( item );
-
-	op->flags = 0;
-	if ( reg != -1 ) {
-		op->category = opdis_op_cat_register;
-		fill_register_by_id( &op->value.reg, reg );
-		return;
-	}
-
-	/* default category will be immediate */
-	op->category = opdis_op_cat_immediate;
-
-	// NOTE: the byte/word/dword before 'ptr' should be used for op size */
-	start = strstr( item, "PTR" );
-	if ( start != NULL ) {
-		op->flags |= opdis_op_flag_indirect | opdis_op_flag_address;
-	}
-
-	start = strchr( item, '[' );
-	if ( start != NULL ) {
-		op->category = opdis_op_cat_expr;
-		fill_intel_expression( &op->value.expr, item, start);
-		return;
-	}
-
-	start = strchr( item, ':' );
-	if ( start != NULL ) {
-		op->category = opdis_op_cat_absolute;
-		fill_register_by_id( &op->value.abs.segment, 
-				     register_for_token(item) );
-		fill_immediate( &op->value.immediate.u, start + 1 );
-		return;
-	}
-
-	fill_immediate( &op->value.immediate.u, item );
-	if ( item[0] == '-' ) {
-		op->flags |= opdis_op_flag_signed;
-	}
+static void decode_intel_mnemonic_item( opdis_insn_t * out,
+					const char * item, unsigned int level ) {
+	decode_mnemonic( out, decode_intel_mnemonic, item, level );
 }
 
 int opdis_x86_intel_decoder( const opdis_insn_buf_t in, opdis_insn_t * out,
 		             const opdis_byte_t * buf, opdis_off_t offset,
 			     opdis_vma_t vma, opdis_off_t length, void * arg ) {
 
-	int i, max_i, rv;
-	struct INSN_BUF_PARSE parse = { 0 };
+	int rv;
+	opdis_insn_layout_t layout;
 
 	rv = opdis_default_decoder( in, out, buf, offset, vma, length, NULL );
 
-	parse_insn_buf( in, is_intel_operand, & parse );
-
-	add_prefixes( in, out, & parse );
-
-	/* fill instruction info */
-	if ( parse.mnem > -1 ) {
-		decode_mnemonic( out, decode_intel_mnemonic, 
-				 in->items[parse.mnem] );
+	if (! (in->decode_level & ~opdis_decode_basic) ) {
+		return rv;
 	}
 
-	/* fill operands */
-	for ( i = parse.first_op; i > -1 && i <= parse.last_op; i++ ) {
- 		if ( in->items[i][0] != ',' ) {
-			decode_operand( opdis_insn_next_avail_op(out),
-					decode_intel_operand, in->items[i] );
-		}
+	if ( opdis_insn_buf_layout( in, &layout ) ) {
+		decode_styled_insn( in, out, &layout,
+				    decode_intel_mnemonic_item, 0 );
+	} else {
+		decode_insn_items( in, out, is_intel_operand,
+				   decode_intel_mnemonic_item,
+				   decode_intel_operand );
 	}
 
-	add_comments( in, out, & parse );
+	if (! (out->status & opdis_decode_ops) ) {
+		return rv;
+	}
 
 	/* set operand pointers */
 	if ( out->category == opdis_insn_cat_cflow ) {
@@ -946,10 +1197,6 @@ int opdis_x86_intel_decoder( const opdis_insn_buf_t in, opdis_insn_t * out,
 			out->src->flags |= opdis_op_flag_r;
 		}
 	}
-	
-	out->status |= (opdis_decode_basic | opdis_decode_mnem | 
-			opdis_decode_ops | opdis_decode_mnem_flags |
-			opdis_decode_op_flags);
 
 	return rv;
 }
@@ -12,6 +12,22 @@
 
 #include <opdis/opdis.h>
 
+#ifdef WIN32
+        #define LIBCALL _stdcall
+#else
+        #define LIBCALL
+#endif
+
+/*! \enum opdis_x86_mode_t
+ *  \ingroup x86
+ *  \brief Processor mode used to determine default operand and address size.
+ */
+enum opdis_x86_mode_t {
+	opdis_x86_mode_16 = 16,		/*!< 16-bit (real mode) */
+	opdis_x86_mode_32 = 32,		/*!< 32-bit (protected mode) */
+	opdis_x86_mode_64 = 64		/*!< 64-bit (long mode) */
+};
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -41,6 +57,88 @@ int opdis_x86_att_decoder( const opdis_insn_buf_t in, opdis_insn_t * out,
 			   const opdis_byte_t * buf, opdis_off_t,
 			   opdis_vma_t vma, opdis_off_t length, void * arg );
 
+/*!
+ * \fn int opdis_x86_insn_size( const opdis_byte_t *, opdis_off_t,
+				enum opdis_x86_mode_t )
+ * \ingroup x86
+ * \brief Determine the size of an x86 instruction without libopcodes.
+ * \details This decodes only the prefixes, opcode, ModRM/SIB, displacement
+ *          and immediate fields of the instruction. It is used by
+ *          opdis_disasm_insn_size for x86 targets.
+ * \param buf The instruction bytes.
+ * \param len The number of bytes available in \e buf.
+ * \param mode The processor mode.
+ * \return The size of the instruction, or 0 if the instruction is
+ *         truncated, undefined, or cannot be sized without libopcodes.
+ */
+int LIBCALL opdis_x86_insn_size( const opdis_byte_t * buf, opdis_off_t len,
+				 enum opdis_x86_mode_t mode );
+
+/*!
+ * \fn int opdis_x86_native_decode( const opdis_byte_t *, opdis_off_t,
+				    opdis_vma_t, enum opdis_x86_mode_t,
+				    enum opdis_x86_syntax_t, opdis_insn_t * )
+ * \ingroup x86
+ * \brief Decode an x86 instruction from its bytes, without libopcodes.
+ * \details This fills every field of \e insn directly from the instruction
+ *          bytes, and renders its ASCII form in the format libopcodes uses.
+ *          Only the common general-purpose instructions are supported.
+ *          It is used by the disassembler when opdis_set_x86_native is
+ *          enabled.
+ * \param buf The instruction bytes.
+ * \param len The number of bytes available in \e buf.
+ * \param vma The virtual memory address of the instruction.
+ * \param mode The processor mode. 16-bit mode is not supported.
+ * \param syntax The syntax used for the mnemonic and operands.
+ * \param insn The instruction to fill. It is not modified if the
+ *             instruction is not supported.
+ * \return The size of the instruction, or 0 if it is truncated or is not
+ *         supported.
+ * \note Branch targets and RIP-relative addresses are printed as by
+ *       generic_print_address, the default libopcodes print_address_func.
+ */
+int LIBCALL opdis_x86_native_decode( const opdis_byte_t * buf, opdis_off_t len,
+				     opdis_vma_t vma,
+				     enum opdis_x86_mode_t mode,
+				     enum opdis_x86_syntax_t syntax,
+				     opdis_insn_t * insn );
+
+/*!
+ * \typedef void (*OPDIS_X86_TARGET) ( opdis_vma_t, void * )
+ * \ingroup x86
+ * \brief Callback invoked for each target found by opdis_x86_call_targets.
+ * \param target The address of the target.
+ * \param arg The argument passed to opdis_x86_call_targets.
+ */
+typedef void (*OPDIS_X86_TARGET) ( opdis_vma_t target, void * arg );
+
+/*!
+ * \fn unsigned int opdis_x86_call_targets( const opdis_byte_t *, opdis_off_t,
+					    opdis_vma_t, enum opdis_x86_mode_t,
+					    OPDIS_X86_TARGET, void * )
+ * \ingroup x86
+ * \brief Scan x86 code for the targets of direct calls.
+ * \details This searches \e buf for E8 rel32 calls and, in 64-bit mode,
+ *          for RIP-relative LEA instructions (which load function pointers
+ *          in position-independent code). The buffer is not disassembled:
+ *          every occurrence of these byte patterns is a candidate, and
+ *          \e fn is invoked for each candidate whose target lies within
+ *          \e buf and starts with a valid instruction. Targets are not
+ *          deduplicated.
+ * \param buf The code to scan.
+ * \param len The number of bytes in \e buf.
+ * \param vma The virtual memory address of \e buf.
+ * \param mode The processor mode. 16-bit mode is not supported.
+ * \param fn The callback to invoke for each target.
+ * \param arg The argument to pass to \e fn.
+ * \return The number of targets reported.
+ * \sa opdis_set_cflow_call_seeds
+ */
+unsigned int LIBCALL opdis_x86_call_targets( const opdis_byte_t * buf,
+					     opdis_off_t len, opdis_vma_t vma,
+					     enum opdis_x86_mode_t mode,
+					     OPDIS_X86_TARGET fn, void * arg );
+
 #ifdef __cplusplus
 }
 #endif
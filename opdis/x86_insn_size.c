@@ -0,0 +1,957 @@
+/*!
+ * \file x86_insn_size.c
+ * \brief Table-driven x86 and x86-64 instruction length decoder
+ * \details This determines the size of an x86 instruction from its bytes
+ *          without invoking libopcodes. Only the information needed to
+ *          find the end of the instruction is decoded: prefixes, the
+ *          opcode map, ModRM/SIB/displacement, and immediates.
+ *          Anything the decoder is unsure about (undefined opcodes,
+ *          prefix combinations that libopcodes prints as separate
+ *          instructions) yields 0 so that the caller can fall back to
+ *          libopcodes.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#include <string.h>
+
+#include <opdis/x86_decoder.h>
+
+#define MAX_INSN_LEN	15
+
+/* opcode table flags */
+#define X	0x0000		/* undefined: let libopcodes decide */
+#define O	0x0001		/* opcode only */
+#define M	0x0002		/* ModRM (+ SIB + displacement) */
+#define I8	0x0004		/* 8-bit immediate or relative offset */
+#define I16	0x0008		/* 16-bit immediate */
+#define IZ	0x0010		/* 16- or 32-bit immediate, by operand size */
+#define IV	0x0020		/* 16-, 32- or 64-bit immediate (mov r, imm) */
+#define MO	0x0040		/* memory offset, by address size */
+#define JZ	0x0080		/* 16- or 32-bit relative offset */
+#define FP	0x0100		/* far pointer: IZ + 16-bit selector */
+#define N64	0x0200		/* invalid in 64-bit mode */
+#define S	0x0400		/* special: handled in code */
+
+/* one-byte opcode map */
+static const unsigned short map_1byte[256] = {
+/* 00 */ M, M, M, M, O|I8, O|IZ, O|N64, O|N64,
+/* 08 */ M, M, M, M, O|I8, O|IZ, O|N64, S,
+/* 10 */ M, M, M, M, O|I8, O|IZ, O|N64, O|N64,
+/* 18 */ M, M, M, M, O|I8, O|IZ, O|N64, O|N64,
+/* 20 */ M, M, M, M, O|I8, O|IZ, S, O|N64,
+/* 28 */ M, M, M, M, O|I8, O|IZ, S, O|N64,
+/* 30 */ M, M, M, M, O|I8, O|IZ, S, O|N64,
+/* 38 */ M, M, M, M, O|I8, O|IZ, S, O|N64,
+/* 40 */ S, S, S, S, S, S, S, S,
+/* 48 */ S, S, S, S, S, S, S, S,
+/* 50 */ O, O, O, O, O, O, O, O,
+/* 58 */ O, O, O, O, O, O, O, O,
+/* 60 */ O|N64, O|N64, S, M, S, S, S, S,
+/* 68 */ O|IZ, M|IZ, O|I8, M|I8, O, O, O, O,
+/* 70 */ O|I8, O|I8, O|I8, O|I8, O|I8, O|I8, O|I8, O|I8,
+/* 78 */ O|I8, O|I8, O|I8, O|I8, O|I8, O|I8, O|I8, O|I8,
+/* 80 */ M|I8, M|IZ, M|I8|N64, M|I8, M, M, M, M,
+/* 88 */ M, M, M, M, M, M, M, S,
+/* 90 */ O, O, O, O, O, O, O, O,
+/* 98 */ O, O, FP|N64, S, O, O, O, O,
+/* A0 */ MO, MO, MO, MO, O, O, O, O,
+/* A8 */ O|I8, O|IZ, O, O, O, O, O, O,
+/* B0 */ O|I8, O|I8, O|I8, O|I8, O|I8, O|I8, O|I8, O|I8,
+/* B8 */ IV, IV, IV, IV, IV, IV, IV, IV,
+/* C0 */ M|I8, M|I8, O|I16, O, S, S, S, S,
+/* C8 */ O|I16|I8, O, O|I16, O, O, O|I8, O|N64, O,
+/* D0 */ M, M, M, M, O|I8|N64, O|I8|N64, O|N64, O,
+/* D8 */ M, M, M, M, M, M, M, M,
+/* E0 */ O|I8, O|I8, O|I8, O|I8, O|I8, O|I8, O|I8, O|I8,
+/* E8 */ JZ, JZ, FP|N64, O|I8, O, O, O, O,
+/* F0 */ S, O, S, S, O, O, S, S,
+/* F8 */ O, O, O, O, O, O, S, S
+};
+
+/* two-byte opcode map (0F xx) */
+static const unsigned short map_0f[256] = {
+/* 00 */ M, M, M, M, X, O, O, O,
+/* 08 */ O, O, X, O, X, M, O, S,
+/* 10 */ M, M, M, M, M, M, M, M,
+/* 18 */ M, M, M, M, M, M, M, M,
+/* 20 */ S, S, S, S, X, X, X, X,
+/* 28 */ M, M, M, M, M, M, M, M,
+/* 30 */ O, O, O, O, O, O, X, O,
+/* 38 */ S, X, S, X, X, X, X, X,
+/* 40 */ M, M, M, M, M, M, M, M,
+/* 48 */ M, M, M, M, M, M, M, M,
+/* 50 */ M, M, M, M, M, M, M, M,
+/* 58 */ M, M, M, M, M, M, M, M,
+/* 60 */ M, M, M, M, M, M, M, M,
+/* 68 */ M, M, M, M, M, M, M, M,
+/* 70 */ M|I8, M|I8, M|I8, M|I8, M, M, M, O,
+/* 78 */ S, S, X, X, M, M, M, M,
+/* 80 */ JZ, JZ, JZ, JZ, JZ, JZ, JZ, JZ,
+/* 88 */ JZ, JZ, JZ, JZ, JZ, JZ, JZ, JZ,
+/* 90 */ M, M, M, M, M, M, M, M,
+/* 98 */ M, M, M, M, M, M, M, M,
+/* A0 */ O, O, O, M, M|I8, M, X, X,
+/* A8 */ O, O, O, M, M|I8, M, M, M,
+/* B0 */ M, M, M, M, M, M, M, M,
+/* B8 */ S, M, M|I8, M, M, M, M, M,
+/* C0 */ M, M, M|I8, M, M|I8, M|I8, M|I8, M,
+/* C8 */ O, O, O, O, O, O, O, O,
+/* D0 */ M, M, M, M, M, M, M, M,
+/* D8 */ M, M, M, M, M, M, M, M,
+/* E0 */ M, M, M, M, M, M, M, M,
+/* E8 */ M, M, M, M, M, M, M, M,
+/* F0 */ M, M, M, M, M, M, M, M,
+/* F8 */ M, M, M, M, M, M, M, X
+};
+
+/* opcode maps with a validity table */
+enum X86_OP_MAP {
+	map_legacy_0f, map_legacy_0f38, map_legacy_0f3a,
+	map_vex_0f, map_vex_0f38, map_vex_0f3a,
+	map_evex_0f, map_evex_0f38, map_evex_0f3a,
+	num_op_maps
+};
+
+/* Encodings accepted by libopcodes, by map and opcode. These tables were
+ * produced by decoding every opcode of each map with libopcodes from
+ * binutils 2.40; encodings added to libopcodes later are left to it.
+ * Bits 0-3 are set
+ * if the opcode is valid with a memory operand and no mandatory prefix,
+ * 66, F3 or F2 (VEX.pp 0-3), respectively; bits 4-7 are the same for a
+ * register operand (ModRM.mod 11). */
+static const unsigned char valid_ops[num_op_maps][256] = {
+/* legacy 0F */
+{
+/* 00 */ 0x00, 0xd4, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff,
+	 0xff, 0x55, 0x00, 0xff, 0x00, 0x0f, 0xff, 0x00,
+/* 10 */ 0xff, 0xff, 0xdf, 0x03, 0x33, 0x33, 0x57, 0x03,
+	 0xff, 0xff, 0x10, 0x50, 0xff, 0xff, 0xff, 0xff,
+/* 20 */ 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+	 0x33, 0x33, 0xff, 0x0f, 0xff, 0xff, 0x33, 0x33,
+/* 30 */ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0xff,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 40 */ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+/* 50 */ 0x30, 0xff, 0x55, 0x55, 0x33, 0x33, 0x33, 0x33,
+	 0xff, 0xff, 0xff, 0x77, 0xff, 0xff, 0xff, 0xff,
+/* 60 */ 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+	 0x33, 0x33, 0x33, 0x33, 0x22, 0x22, 0x33, 0x77,
+/* 70 */ 0xff, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x11,
+	 0x00, 0x00, 0x00, 0x00, 0xaa, 0xaa, 0x77, 0x77,
+/* 80 */ 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+	 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+/* 90 */ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+/* A0 */ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00,
+	 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x41, 0xff,
+/* B0 */ 0xff, 0xff, 0x0f, 0xff, 0x0f, 0x0f, 0xff, 0xff,
+	 0x00, 0xff, 0x00, 0xff, 0x77, 0x77, 0xff, 0xff,
+/* C0 */ 0xff, 0xff, 0xff, 0x01, 0x33, 0x30, 0x33, 0x00,
+	 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+/* D0 */ 0xaa, 0x33, 0x33, 0x33, 0x33, 0x33, 0xe2, 0xf0,
+	 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+/* E0 */ 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0xee, 0x03,
+	 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+/* F0 */ 0x08, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x30,
+	 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x00
+},
+/* legacy 0F 38 */
+{
+/* 00 */ 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+	 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00,
+/* 10 */ 0x22, 0x00, 0x00, 0x00, 0x22, 0x22, 0x00, 0x22,
+	 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x00,
+/* 20 */ 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x00, 0x00,
+	 0x22, 0x22, 0x02, 0x22, 0x00, 0x00, 0x00, 0x00,
+/* 30 */ 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x00, 0x22,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* 40 */ 0x22, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 50 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 60 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 70 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 80 */ 0x02, 0x02, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 90 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* A0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* B0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* C0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x00, 0x22,
+/* D0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x22, 0x66, 0x26, 0x26, 0x26,
+/* E0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* F0 */ 0x8b, 0x8b, 0x00, 0x00, 0x00, 0x02, 0x67, 0x00,
+	 0x0e, 0x01, 0x40, 0x40, 0x0f, 0x00, 0x00, 0x00
+},
+/* legacy 0F 3A */
+{
+/* 00 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x33,
+/* 10 */ 0x00, 0x00, 0x00, 0x00, 0x22, 0x22, 0x22, 0x22,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 20 */ 0x22, 0x22, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 30 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 40 */ 0x22, 0x22, 0x22, 0x00, 0x22, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 50 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 60 */ 0x22, 0x22, 0x22, 0x22, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 70 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 80 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 90 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* A0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* B0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* C0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x22, 0x22,
+/* D0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22,
+/* E0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* F0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+},
+/* VEX 0F */
+{
+/* 00 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 10 */ 0xff, 0xff, 0xdf, 0x03, 0x33, 0x33, 0x57, 0x03,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 20 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x33, 0x33, 0xcc, 0x03, 0xcc, 0xcc, 0x33, 0x33,
+/* 30 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 40 */ 0x00, 0x30, 0x30, 0x00, 0x30, 0x30, 0x30, 0x30,
+	 0x00, 0x00, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00,
+/* 50 */ 0x30, 0xff, 0x55, 0x55, 0x33, 0x33, 0x33, 0x33,
+	 0xff, 0xff, 0xff, 0x77, 0xff, 0xff, 0xff, 0xff,
+/* 60 */ 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x66,
+/* 70 */ 0xee, 0x00, 0x00, 0x00, 0x22, 0x22, 0x22, 0xff,
+	 0x00, 0x00, 0x00, 0x00, 0xaa, 0xaa, 0x66, 0x66,
+/* 80 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 90 */ 0x33, 0x03, 0xb0, 0xb0, 0x00, 0x00, 0x00, 0x00,
+	 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* A0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* B0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* C0 */ 0x00, 0x00, 0xff, 0x00, 0x22, 0x20, 0x33, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* D0 */ 0xaa, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x20,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* E0 */ 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0xee, 0x02,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* F0 */ 0x08, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x20,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x00
+},
+/* VEX 0F 38 */
+{
+/* 00 */ 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* 10 */ 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x22, 0x22,
+	 0x22, 0x22, 0x02, 0x00, 0x22, 0x22, 0x22, 0x00,
+/* 20 */ 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x00, 0x00,
+	 0x22, 0x22, 0x02, 0x22, 0x02, 0x02, 0x02, 0x02,
+/* 30 */ 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* 40 */ 0x22, 0x22, 0x00, 0x00, 0x00, 0x22, 0x22, 0x22,
+	 0x00, 0x83, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 50 */ 0xff, 0xff, 0x22, 0x22, 0x00, 0x00, 0x00, 0x00,
+	 0x22, 0x22, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 60 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 70 */ 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x22, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 80 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x02, 0x00,
+/* 90 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x22,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* A0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x22,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* B0 */ 0x0f, 0x06, 0x00, 0x00, 0x22, 0x22, 0x22, 0x22,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* C0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22,
+/* D0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* E0 */ 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+	 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+/* F0 */ 0x00, 0x00, 0x11, 0x00, 0x00, 0xdd, 0x88, 0xff,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+},
+/* VEX 0F 3A */
+{
+/* 00 */ 0x22, 0x22, 0x22, 0x00, 0x22, 0x22, 0x22, 0x00,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* 10 */ 0x00, 0x00, 0x00, 0x00, 0x22, 0x22, 0x22, 0x22,
+	 0x22, 0x22, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00,
+/* 20 */ 0x22, 0x22, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 30 */ 0x20, 0x20, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00,
+	 0x22, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 40 */ 0x22, 0x22, 0x22, 0x00, 0x22, 0x00, 0x22, 0x00,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x00, 0x00, 0x00,
+/* 50 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x22, 0x22, 0x22, 0x22,
+/* 60 */ 0x22, 0x22, 0x22, 0x22, 0x00, 0x00, 0x00, 0x00,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* 70 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* 80 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 90 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* A0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* B0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* C0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x22,
+/* D0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22,
+/* E0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* F0 */ 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+},
+/* EVEX 0F */
+{
+/* 00 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 10 */ 0xff, 0xff, 0xdf, 0x03, 0x33, 0x33, 0x57, 0x03,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 20 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x33, 0x33, 0xcc, 0x03, 0xcc, 0xcc, 0x33, 0x33,
+/* 30 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 40 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 50 */ 0x00, 0xff, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+	 0xff, 0xff, 0xff, 0x77, 0xff, 0xff, 0xff, 0xff,
+/* 60 */ 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0xee,
+/* 70 */ 0xee, 0x00, 0x00, 0x00, 0x22, 0x22, 0x22, 0x00,
+	 0xff, 0xff, 0xee, 0xee, 0x00, 0x00, 0x66, 0xee,
+/* 80 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 90 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* A0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* B0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* C0 */ 0x00, 0x00, 0xff, 0x00, 0x22, 0x20, 0x33, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* D0 */ 0x00, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x00,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* E0 */ 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0xee, 0x22,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* F0 */ 0x00, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x00,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x00
+},
+/* EVEX 0F 38 */
+{
+/* 00 */ 0x22, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x22, 0x22, 0x22, 0x00, 0x00,
+/* 10 */ 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x22, 0x00,
+	 0x22, 0x22, 0x02, 0x02, 0x22, 0x22, 0x22, 0x22,
+/* 20 */ 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+	 0x62, 0x66, 0x62, 0x22, 0x22, 0x22, 0x00, 0x00,
+/* 30 */ 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x22, 0x22,
+	 0x62, 0x66, 0x62, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* 40 */ 0x22, 0x00, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+	 0x00, 0x00, 0x00, 0x00, 0x22, 0x22, 0xff, 0x22,
+/* 50 */ 0xff, 0xff, 0x6e, 0x2a, 0x22, 0x22, 0x00, 0x00,
+	 0x22, 0x22, 0x02, 0x02, 0x00, 0x00, 0x00, 0x00,
+/* 60 */ 0x00, 0x00, 0x22, 0x22, 0x22, 0x22, 0x22, 0x00,
+	 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 70 */ 0x22, 0x22, 0xee, 0x22, 0x00, 0x22, 0x22, 0x22,
+	 0x22, 0x22, 0x20, 0x20, 0x20, 0x22, 0x22, 0x22,
+/* 80 */ 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0x00,
+	 0x22, 0x22, 0x22, 0x22, 0x00, 0x22, 0x00, 0x22,
+/* 90 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x22,
+	 0x22, 0x22, 0x2a, 0x2a, 0x22, 0x22, 0x22, 0x22,
+/* A0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x22,
+	 0x22, 0x22, 0x2a, 0x2a, 0x22, 0x22, 0x22, 0x22,
+/* B0 */ 0x00, 0x00, 0x00, 0x00, 0x22, 0x22, 0x22, 0x22,
+	 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+/* C0 */ 0x00, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00,
+	 0x22, 0x00, 0x22, 0x22, 0x22, 0x22, 0x00, 0x22,
+/* D0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x22, 0x22, 0x22, 0x22,
+/* E0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* F0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+},
+/* EVEX 0F 3A */
+{
+/* 00 */ 0x22, 0x22, 0x00, 0x22, 0x22, 0x22, 0x00, 0x00,
+	 0x33, 0x22, 0x33, 0x22, 0x00, 0x00, 0x00, 0x22,
+/* 10 */ 0x00, 0x00, 0x00, 0x00, 0x22, 0x22, 0x22, 0x22,
+	 0x22, 0x22, 0x22, 0x22, 0x00, 0x22, 0x22, 0x22,
+/* 20 */ 0x22, 0x22, 0x22, 0x22, 0x00, 0x22, 0x33, 0x33,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 30 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x22, 0x22, 0x22, 0x22, 0x00, 0x00, 0x22, 0x22,
+/* 40 */ 0x00, 0x00, 0xff, 0x22, 0x22, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 50 */ 0x22, 0x22, 0x00, 0x00, 0x22, 0x22, 0x33, 0x33,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 60 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 70 */ 0xff, 0x22, 0xff, 0x22, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 80 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* 90 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* A0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* B0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* C0 */ 0x00, 0x00, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x22,
+/* D0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* E0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* F0 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+}
+};
+
+/* Opcodes whose validity depends on ModRM.reg: a mask of the valid reg
+ * values for each bit position of valid_ops. */
+struct X86_OP_GROUP {
+	unsigned char map;
+	unsigned char op;
+	unsigned char reg_mask[8];
+};
+
+static const struct X86_OP_GROUP valid_groups[] = {
+	{ map_legacy_0f, 0x00, { 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f } },
+	{ map_legacy_0f, 0x01, { 0xdf, 0xdf, 0x00, 0xdf, 0x00, 0xdf, 0x00, 0x00 } },
+	{ map_legacy_0f, 0x1A, { 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x0f, 0x0f, 0x0f } },
+	{ map_legacy_0f, 0x1B, { 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x0f, 0x00, 0x0f } },
+	{ map_legacy_0f, 0x71, { 0x00, 0x00, 0x00, 0x00, 0x54, 0x54, 0x00, 0x00 } },
+	{ map_legacy_0f, 0x72, { 0x00, 0x00, 0x00, 0x00, 0x54, 0x54, 0x00, 0x00 } },
+	{ map_legacy_0f, 0x73, { 0x00, 0x00, 0x00, 0x00, 0x44, 0xcc, 0x00, 0x00 } },
+	{ map_legacy_0f, 0xAE, { 0x00, 0xcf, 0x5f, 0x0f, 0xe0, 0xc0, 0x00, 0xc0 } },
+	{ map_legacy_0f, 0xBA, { 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0 } },
+	{ map_legacy_0f, 0xC7, { 0xfa, 0xfa, 0xfa, 0xba, 0xc0, 0xc0, 0xc0, 0x00 } },
+	{ map_legacy_0f38, 0xD8, { 0x00, 0x00, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+	{ map_legacy_0f3a, 0xF0, { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00 } },
+	{ map_vex_0f, 0x71, { 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x00, 0x00 } },
+	{ map_vex_0f, 0x72, { 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x00, 0x00 } },
+	{ map_vex_0f, 0x73, { 0x00, 0x00, 0x00, 0x00, 0x00, 0xcc, 0x00, 0x00 } },
+	{ map_vex_0f, 0xAE, { 0x0c, 0x0c, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00 } },
+	{ map_vex_0f38, 0x49, { 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00 } },
+	{ map_vex_0f38, 0xF3, { 0x0e, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00 } },
+	{ map_evex_0f, 0x71, { 0x00, 0x54, 0x00, 0x00, 0x00, 0x54, 0x00, 0x00 } },
+	{ map_evex_0f, 0x72, { 0x00, 0x57, 0x00, 0x00, 0x00, 0x57, 0x00, 0x00 } },
+	{ map_evex_0f, 0x73, { 0x00, 0xcc, 0x00, 0x00, 0x00, 0xcc, 0x00, 0x00 } }
+};
+
+/* 3DNow! opcodes (the final byte of 0F 0F instructions) */
+static const unsigned char valid_3dnow[256] = {
+/* 00 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0,
+/* 10 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0,
+/* 20 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+/* 30 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+/* 40 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+/* 50 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+/* 60 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+/* 70 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+/* 80 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0,
+/* 90 */ 1, 0, 0, 0, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1, 0,
+/* A0 */ 1, 0, 0, 0, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1, 0,
+/* B0 */ 1, 0, 0, 0, 1, 0, 1, 1, 0, 0, 0, 1, 0, 0, 0, 1,
+/* C0 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+/* D0 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+/* E0 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+/* F0 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/* decoder state for a single instruction */
+struct X86_LEN_STATE {
+	const opdis_byte_t * buf;
+	opdis_off_t len;		/* bytes available */
+	opdis_off_t pos;		/* current position */
+	enum opdis_x86_mode_t mode;
+	int opsize_prefix;		/* 66 */
+	int addrsize_prefix;		/* 67 */
+	int rep_prefix;			/* F2 or F3 */
+	int has_rex;
+	int rex_w;
+	int num_prefixes;
+};
+
+static unsigned int operand_size( struct X86_LEN_STATE * s ) {
+	if ( s->mode == opdis_x86_mode_64 ) {
+		return ( s->rex_w ) ? 8 : ( s->opsize_prefix ) ? 2 : 4;
+	}
+	if ( s->mode == opdis_x86_mode_16 ) {
+		return ( s->opsize_prefix ) ? 4 : 2;
+	}
+	return ( s->opsize_prefix ) ? 2 : 4;
+}
+
+static unsigned int address_size( struct X86_LEN_STATE * s ) {
+	if ( s->mode == opdis_x86_mode_64 ) {
+		return ( s->addrsize_prefix ) ? 4 : 8;
+	}
+	if ( s->mode == opdis_x86_mode_16 ) {
+		return ( s->addrsize_prefix ) ? 4 : 2;
+	}
+	return ( s->addrsize_prefix ) ? 2 : 4;
+}
+
+/* Skip ModRM, SIB and displacement at s->pos. If reg_only is set, the
+ * mod field is ignored (MOV to/from control and debug registers). */
+static int skip_modrm( struct X86_LEN_STATE * s, int reg_only ) {
+	opdis_byte_t modrm, mod, rm;
+
+	if ( s->pos >= s->len ) {
+		return 0;
+	}
+
+	modrm = s->buf[s->pos++];
+	mod = modrm >> 6;
+	rm = modrm & 7;
+
+	if ( reg_only || mod == 3 ) {
+		return 1;
+	}
+
+	if ( address_size( s ) == 2 ) {
+		/* 16-bit addressing: no SIB */
+		if ( mod == 1 ) {
+			s->pos += 1;
+		} else if ( mod == 2 || (mod == 0 && rm == 6) ) {
+			s->pos += 2;
+		}
+		return 1;
+	}
+
+	if ( rm == 4 ) {
+		opdis_byte_t sib;
+		if ( s->pos >= s->len ) {
+			return 0;
+		}
+		sib = s->buf[s->pos++];
+		if ( mod == 0 && (sib & 7) == 5 ) {
+			s->pos += 4;
+		}
+	}
+
+	if ( mod == 1 ) {
+		s->pos += 1;
+	} else if ( mod == 2 || (mod == 0 && rm == 5) ) {
+		s->pos += 4;
+	}
+
+	return 1;
+}
+
+/* Return the ModRM reg field of the byte at s->pos, or -1 */
+static int peek_reg( struct X86_LEN_STATE * s ) {
+	if ( s->pos >= s->len ) {
+		return -1;
+	}
+	return (s->buf[s->pos] >> 3) & 7;
+}
+
+static int finish( struct X86_LEN_STATE * s ) {
+	if ( s->pos > s->len || s->pos > MAX_INSN_LEN ) {
+		return 0;
+	}
+	return (int) s->pos;
+}
+
+/* Apply the operand flags of an opcode whose opcode bytes have been
+ * consumed. */
+static int decode_operands( struct X86_LEN_STATE * s, unsigned short f ) {
+	if ( f == X ) {
+		return 0;
+	}
+
+	if ( (f & N64) && s->mode == opdis_x86_mode_64 ) {
+		return 0;
+	}
+
+	if ( (f & M) && ! skip_modrm( s, 0 ) ) {
+		return 0;
+	}
+
+	if ( f & I16 ) {
+		s->pos += 2;
+	}
+
+	if ( f & I8 ) {
+		s->pos += 1;
+	}
+
+	if ( f & IZ ) {
+		s->pos += ( operand_size( s ) == 2 ) ? 2 : 4;
+	}
+
+	if ( f & IV ) {
+		s->pos += operand_size( s );
+	}
+
+	if ( f & MO ) {
+		s->pos += address_size( s );
+	}
+
+	if ( f & JZ ) {
+		/* AMD and Intel disagree about 66 on 64-bit branches */
+		if ( s->mode == opdis_x86_mode_64 && s->opsize_prefix ) {
+			return 0;
+		}
+		s->pos += ( operand_size( s ) == 2 ) ? 2 : 4;
+	}
+
+	if ( f & FP ) {
+		s->pos += (( operand_size( s ) == 2 ) ? 2 : 4) + 2;
+	}
+
+	return finish( s );
+}
+
+/* Mandatory prefix index: none, 66, F3, F2. As in libopcodes, F2 and F3
+ * take precedence over 66. */
+static unsigned int legacy_pp( struct X86_LEN_STATE * s ) {
+	if ( s->rep_prefix ) {
+		return ( s->rep_prefix == 0xF3 ) ? 2 : 3;
+	}
+	return ( s->opsize_prefix ) ? 1 : 0;
+}
+
+/* Determine if the opcode just consumed is valid. s->pos is at ModRM. */
+static int is_valid( struct X86_LEN_STATE * s, enum X86_OP_MAP map,
+		     opdis_byte_t op, unsigned int pp ) {
+	unsigned int bit = pp;
+	size_t i;
+
+	if ( map == map_legacy_0f && ! (map_0f[op] & M) ) {
+		/* no ModRM: the opcode may be the last byte in the buffer */
+		return ( valid_ops[map][op] >> bit ) & 1;
+	}
+
+	if ( s->pos >= s->len ) {
+		return 0;
+	}
+
+	if ( (s->buf[s->pos] >> 6) == 3 ) {
+		bit += 4;
+	}
+
+	if ( (valid_ops[map][op] >> bit) & 1 ) {
+		return 1;
+	}
+
+	for ( i = 0; i < sizeof(valid_groups) / sizeof(valid_groups[0]); i++ ) {
+		if ( valid_groups[i].map == map && valid_groups[i].op == op ) {
+			unsigned int reg = (s->buf[s->pos] >> 3) & 7;
+			return ( valid_groups[i].reg_mask[bit] >> reg ) & 1;
+		}
+	}
+
+	return 0;
+}
+
+static int decode_0f( struct X86_LEN_STATE * s ) {
+	opdis_byte_t op;
+
+	if ( s->pos >= s->len ) {
+		return 0;
+	}
+
+	op = s->buf[s->pos++];
+	switch ( op ) {
+		case 0x20: case 0x21: case 0x22: case 0x23:
+			/* MOV CRn/DRn: mod is ignored */
+			if (! skip_modrm( s, 1 ) ) {
+				return 0;
+			}
+			return finish( s );
+		case 0x0F:
+			/* 3DNow!: the opcode follows the operands */
+			if (! decode_operands( s, M|I8 ) ||
+			    ! valid_3dnow[s->buf[s->pos - 1]] ) {
+				return 0;
+			}
+			return finish( s );
+		case 0x38:
+			if ( s->pos >= s->len ) {
+				return 0;
+			}
+			op = s->buf[s->pos++];
+			if (! is_valid( s, map_legacy_0f38, op, legacy_pp(s) ) ) {
+				return 0;
+			}
+			return decode_operands( s, M );
+		case 0x3A:
+			if ( s->pos >= s->len ) {
+				return 0;
+			}
+			op = s->buf[s->pos++];
+			if (! is_valid( s, map_legacy_0f3a, op, legacy_pp(s) ) ) {
+				return 0;
+			}
+			return decode_operands( s, M|I8 );
+	}
+
+	if (! is_valid( s, map_legacy_0f, op, legacy_pp(s) ) ) {
+		return 0;
+	}
+
+	return decode_operands( s, map_0f[op] );
+}
+
+/* VEX (C4, C5) and EVEX (62). s->pos is at the escape byte. */
+static int decode_vex( struct X86_LEN_STATE * s, opdis_byte_t esc ) {
+	unsigned int map, pp;
+	unsigned int hdr = ( esc == 0xC5 ) ? 2 : ( esc == 0x62 ) ? 4 : 3;
+	enum X86_OP_MAP first = ( esc == 0x62 ) ? map_evex_0f : map_vex_0f;
+	opdis_byte_t op;
+
+	/* legacy SIMD prefixes and REX are not allowed before VEX, and
+	 * libopcodes does not decode VEX in 16-bit mode */
+	if ( s->mode == opdis_x86_mode_16 ||
+	     s->opsize_prefix || s->rep_prefix || s->has_rex ||
+	     s->pos + hdr + 1 > s->len ) {
+		return 0;
+	}
+
+	if ( esc == 0xC5 ) {
+		map = 1;
+		pp = s->buf[s->pos + 1] & 0x03;
+	} else if ( esc == 0x62 ) {
+		/* P0 bit 3 is always clear, P1 bit 2 is always set */
+		if ( (s->buf[s->pos + 1] & 0x08) ||
+		     ! (s->buf[s->pos + 2] & 0x04) ) {
+			return 0;
+		}
+		map = s->buf[s->pos + 1] & 0x07;
+		pp = s->buf[s->pos + 2] & 0x03;
+	} else {
+		map = s->buf[s->pos + 1] & 0x1F;
+		pp = s->buf[s->pos + 2] & 0x03;
+	}
+
+	/* only the 0F, 0F38 and 0F3A maps are decoded */
+	if ( map < 1 || map > 3 ) {
+		return 0;
+	}
+
+	s->pos += hdr;
+	op = s->buf[s->pos++];
+
+	if ( map == 1 && op == 0x77 && esc != 0x62 ) {
+		/* VZEROUPPER, VZEROALL */
+		return finish( s );
+	}
+
+	if (! is_valid( s, (enum X86_OP_MAP) (first + map - 1), op, pp ) ) {
+		return 0;
+	}
+
+	if ( map == 1 ) {
+		switch ( op ) {
+			case 0x70: case 0x71: case 0x72: case 0x73:
+			case 0xC2: case 0xC4: case 0xC5: case 0xC6:
+				return decode_operands( s, M|I8 );
+		}
+		return decode_operands( s, M );
+	}
+
+	return decode_operands( s, ( map == 3 ) ? M|I8 : M );
+}
+
+int LIBCALL opdis_x86_insn_size( const opdis_byte_t * buf, opdis_off_t len,
+				 enum opdis_x86_mode_t mode ) {
+	struct X86_LEN_STATE s;
+	int rex_pos = -1;
+
+	if (! buf || ! len ) {
+		return 0;
+	}
+
+	memset( &s, 0, sizeof(s) );
+	s.buf = buf;
+	s.len = len;
+	s.mode = mode;
+
+	/* prefixes */
+	for ( ; s.pos < s.len; s.pos++ ) {
+		opdis_byte_t b = buf[s.pos];
+
+		if ( s.pos >= MAX_INSN_LEN ) {
+			return 0;
+		}
+
+		if ( mode == opdis_x86_mode_64 && (b & 0xF0) == 0x40 ) {
+			if ( rex_pos >= 0 ) {
+				/* first REX is emitted on its own */
+				return 0;
+			}
+			rex_pos = (int) s.pos;
+			s.has_rex = 1;
+			s.rex_w = (b & 0x08) ? 1 : 0;
+			continue;
+		}
+
+		switch ( b ) {
+			case 0x66: s.opsize_prefix = 1; break;
+			case 0x67: s.addrsize_prefix = 1; break;
+			case 0xF2: case 0xF3: s.rep_prefix = b; break;
+			case 0xF0: case 0x26: case 0x2E: case 0x36:
+			case 0x3E: case 0x64: case 0x65:
+				break;
+			default:
+				goto opcode;
+		}
+
+		/* libopcodes emits a REX followed by a prefix on its own */
+		if ( rex_pos >= 0 ) {
+			return 0;
+		}
+		s.num_prefixes++;
+	}
+
+opcode:
+	if ( s.pos >= s.len ) {
+		return 0;
+	}
+
+	/* REX must immediately precede the opcode */
+	if ( rex_pos >= 0 && rex_pos != (int) s.pos - 1 ) {
+		return 0;
+	}
+
+	switch ( buf[s.pos] ) {
+		case 0x0F:
+			s.pos++;
+			return decode_0f( &s );
+
+		case 0x62: case 0xC4: case 0xC5:
+			/* outside 64-bit mode these are BOUND, LES and LDS
+			 * unless ModRM.mod is 11 */
+			if ( mode == opdis_x86_mode_64 ||
+			     (s.pos + 1 < s.len && (buf[s.pos + 1] >> 6) == 3) ) {
+				return decode_vex( &s, buf[s.pos] );
+			}
+			s.pos++;
+			return decode_operands( &s, M );
+
+		case 0x8F:
+			/* AMD XOP is not decoded; otherwise only POP (/0) is defined */
+			s.pos++;
+			if ( peek_reg( &s ) != 0 ) {
+				return 0;
+			}
+			return decode_operands( &s, M );
+
+		case 0x9B:
+			/* FWAIT is merged with a following x87 instruction */
+			if ( s.num_prefixes || rex_pos >= 0 ) {
+				return 0;
+			}
+			s.pos++;
+			if ( s.pos < s.len && buf[s.pos] >= 0xD8 &&
+			     buf[s.pos] <= 0xDF ) {
+				s.pos++;
+				return decode_operands( &s, M );
+			}
+			if ( s.pos < s.len && map_1byte[buf[s.pos]] == S ) {
+				/* a prefix or escape follows */
+				return 0;
+			}
+			return finish( &s );
+
+		case 0xC6: case 0xC7:
+			s.pos++;
+			if ( peek_reg( &s ) != 0 &&
+			     ! (s.pos < s.len && buf[s.pos] == 0xF8) ) {
+				/* only XABORT and XBEGIN are defined for /7 */
+				return 0;
+			}
+			if ( buf[s.pos - 1] == 0xC6 ) {
+				return decode_operands( &s, M|I8 );
+			}
+			if ( buf[s.pos] == 0xF8 ) {
+				return decode_operands( &s, M|JZ );
+			}
+			return decode_operands( &s, M|IZ );
+
+		case 0xF6: case 0xF7:
+			s.pos++;
+			if ( peek_reg( &s ) > 1 ) {
+				return decode_operands( &s, M );
+			}
+			return decode_operands( &s, ( buf[s.pos - 1] == 0xF6 ) ?
+							M|I8 : M|IZ );
+
+		case 0x8D:
+			/* LEA requires a memory operand */
+			s.pos++;
+			if ( s.pos >= s.len || (buf[s.pos] >> 6) == 3 ) {
+				return 0;
+			}
+			return decode_operands( &s, M );
+
+		case 0xFE:
+			s.pos++;
+			if ( peek_reg( &s ) > 1 ) {
+				return 0;
+			}
+			return decode_operands( &s, M );
+
+		case 0xFF:
+			s.pos++;
+			switch ( peek_reg( &s ) ) {
+				case 3: case 5:
+					/* far CALL/JMP require a memory operand */
+					if ( (buf[s.pos] >> 6) == 3 ) {
+						return 0;
+					}
+					break;
+				case 7: case -1:
+					return 0;
+			}
+			return decode_operands( &s, M );
+	}
+
+	if ( map_1byte[buf[s.pos]] == S ) {
+		/* inc/dec 40-4F outside of 64-bit mode */
+		if ( mode != opdis_x86_mode_64 && (buf[s.pos] & 0xF0) == 0x40 ) {
+			s.pos++;
+			return finish( &s );
+		}
+		return 0;
+	}
+
+	s.pos++;
+	return decode_operands( &s, map_1byte[buf[s.pos - 1]] );
+}
@@ -0,0 +1,2271 @@
+/*!
+ * \file x86_mnemonic.c
+ * \brief Table of x86 mnemonics and their classification.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#include <string.h>
+
+#include <opdis/metadata.h>
+#include <opdis/model.h>
+#include <opdis/x86_mnemonic.h>
+
+/* ---------------------------------------------------------------------- */
+/* Mnemonic table */
+
+/* The table holds every mnemonic that libopcodes (binutils 2.40) emits for
+ * x86 in AT&T and Intel syntax, in 16-, 32- and 64-bit mode, classified with
+ * the rules in decode_intel_mnemonic(). The hash tables that follow it are
+ * generated from the list of mnemonics by util/x86_hash.py: run
+ * "util/x86_hash.py mnemonic" when a mnemonic is added or removed. */
+
+#define GEN	opdis_insn_subset_gen
+#define FPU	opdis_insn_subset_fpu
+#define SIMD	opdis_insn_subset_simd
+
+#define UNK	opdis_insn_cat_unknown
+#define CFLOW	opdis_insn_cat_cflow
+#define STACK	opdis_insn_cat_stack
+#define LOST	opdis_insn_cat_lost
+#define TEST	opdis_insn_cat_test
+#define MATH	opdis_insn_cat_math
+#define BIT	opdis_insn_cat_bit
+#define IO	opdis_insn_cat_io
+#define TRAP	opdis_insn_cat_trap
+#define PRIV	opdis_insn_cat_priv
+#define NOP	opdis_insn_cat_nop
+
+#define CALL	opdis_cflow_flag_call
+#define JMP	opdis_cflow_flag_jmp
+#define JCC	opdis_cflow_flag_jmpcc
+#define RET	opdis_cflow_flag_ret
+
+#define PUSH	opdis_stack_flag_push
+#define POP	opdis_stack_flag_pop
+#define FRAME	opdis_stack_flag_frame
+#define UNFRAME	opdis_stack_flag_unframe
+
+#define AND	opdis_bit_flag_and
+#define OR	opdis_bit_flag_or
+#define XOR	opdis_bit_flag_xor
+#define NOT	opdis_bit_flag_not
+#define LSL	opdis_bit_flag_lsl
+#define LSR	opdis_bit_flag_lsr
+#define ASL	opdis_bit_flag_asl
+#define ASR	opdis_bit_flag_asr
+#define ROL	opdis_bit_flag_rol
+#define ROR	opdis_bit_flag_ror
+#define RCL	opdis_bit_flag_rcl
+#define RCR	opdis_bit_flag_rcr
+
+#define IN	opdis_io_flag_in
+#define OUT	opdis_io_flag_out
+
+static const opdis_x86_mnemonic_t mnemonics[] = {
+	{ "aaa", GEN, UNK, 0 },
+	{ "aad", GEN, UNK, 0 },
+	{ "aadd", GEN, MATH, 0 },
+	{ "aam", GEN, UNK, 0 },
+	{ "aand", GEN, UNK, 0 },
+	{ "aas", GEN, UNK, 0 },
+	{ "adc", GEN, MATH, 0 },
+	{ "adcb", GEN, MATH, 0 },
+	{ "adcl", GEN, MATH, 0 },
+	{ "adcq", GEN, MATH, 0 },
+	{ "adcw", GEN, MATH, 0 },
+	{ "adcx", GEN, MATH, 0 },
+	{ "add", GEN, MATH, 0 },
+	{ "addb", GEN, MATH, 0 },
+	{ "addl", GEN, MATH, 0 },
+	{ "addpd", SIMD, MATH, 0 },
+	{ "addps", SIMD, MATH, 0 },
+	{ "addq", GEN, MATH, 0 },
+	{ "addsd", SIMD, MATH, 0 },
+	{ "addss", SIMD, MATH, 0 },
+	{ "addsubpd", SIMD, MATH, 0 },
+	{ "addsubps", SIMD, MATH, 0 },
+	{ "addw", GEN, MATH, 0 },
+	{ "adox", GEN, UNK, 0 },
+	{ "aesdec", SIMD, UNK, 0 },
+	{ "aesdec128kl", SIMD, UNK, 0 },
+	{ "aesdec256kl", SIMD, UNK, 0 },
+	{ "aesdeclast", SIMD, UNK, 0 },
+	{ "aesdecwide128kl", SIMD, UNK, 0 },
+	{ "aesdecwide256kl", SIMD, UNK, 0 },
+	{ "aesenc", GEN, UNK, 0 },
+	{ "aesenc128kl", GEN, UNK, 0 },
+	{ "aesenc256kl", GEN, UNK, 0 },
+	{ "aesenclast", GEN, UNK, 0 },
+	{ "aesencwide128kl", GEN, UNK, 0 },
+	{ "aesencwide256kl", GEN, UNK, 0 },
+	{ "aesimc", GEN, UNK, 0 },
+	{ "aeskeygenassist", SIMD, UNK, 0 },
+	{ "and", GEN, BIT, AND },
+	{ "andb", GEN, BIT, AND },
+	{ "andl", GEN, BIT, AND },
+	{ "andn", GEN, BIT, AND },
+	{ "andnpd", SIMD, BIT, AND },
+	{ "andnps", SIMD, BIT, AND },
+	{ "andpd", SIMD, BIT, AND },
+	{ "andps", SIMD, BIT, AND },
+	{ "andq", GEN, BIT, AND },
+	{ "andw", GEN, BIT, AND },
+	{ "aor", GEN, UNK, 0 },
+	{ "arpl", GEN, UNK, 0 },
+	{ "axor", GEN, UNK, 0 },
+	{ "bextr", GEN, UNK, 0 },
+	{ "blendpd", SIMD, UNK, 0 },
+	{ "blendps", SIMD, UNK, 0 },
+	{ "blendvpd", SIMD, UNK, 0 },
+	{ "blendvps", SIMD, UNK, 0 },
+	{ "blsi", GEN, UNK, 0 },
+	{ "blsmsk", GEN, UNK, 0 },
+	{ "blsr", GEN, UNK, 0 },
+	{ "bndcl", GEN, UNK, 0 },
+	{ "bndcn", GEN, UNK, 0 },
+	{ "bndcu", GEN, UNK, 0 },
+	{ "bndldx", GEN, UNK, 0 },
+	{ "bndmk", GEN, UNK, 0 },
+	{ "bndmov", GEN, LOST, 0 },
+	{ "bndstx", GEN, UNK, 0 },
+	{ "bound", GEN, UNK, 0 },
+	{ "bsf", GEN, UNK, 0 },
+	{ "bsr", GEN, UNK, 0 },
+	{ "bswap", GEN, UNK, 0 },
+	{ "bt", GEN, TEST, 0 },
+	{ "btc", GEN, TEST, 0 },
+	{ "btcl", GEN, TEST, 0 },
+	{ "btcq", GEN, TEST, 0 },
+	{ "btcw", GEN, TEST, 0 },
+	{ "btl", GEN, TEST, 0 },
+	{ "btq", GEN, TEST, 0 },
+	{ "btr", GEN, TEST, 0 },
+	{ "btrl", GEN, TEST, 0 },
+	{ "btrq", GEN, TEST, 0 },
+	{ "btrw", GEN, TEST, 0 },
+	{ "bts", GEN, TEST, 0 },
+	{ "btsl", GEN, TEST, 0 },
+	{ "btsq", GEN, TEST, 0 },
+	{ "btsw", GEN, TEST, 0 },
+	{ "btw", GEN, TEST, 0 },
+	{ "bzhi", GEN, UNK, 0 },
+	{ "call", GEN, CFLOW, CALL },
+	{ "calld", GEN, CFLOW, CALL },
+	{ "calll", GEN, CFLOW, CALL },
+	{ "callw", GEN, CFLOW, CALL },
+	{ "cbtw", GEN, UNK, 0 },
+	{ "cbw", GEN, UNK, 0 },
+	{ "cdq", GEN, UNK, 0 },
+	{ "cdqe", GEN, UNK, 0 },
+	{ "clc", GEN, UNK, 0 },
+	{ "cld", GEN, UNK, 0 },
+	{ "cldemote", GEN, UNK, 0 },
+	{ "clflush", GEN, UNK, 0 },
+	{ "clflushopt", GEN, UNK, 0 },
+	{ "cli", GEN, TRAP, 0 },
+	{ "clrssbsy", SIMD, UNK, 0 },
+	{ "cltd", GEN, UNK, 0 },
+	{ "cltq", GEN, UNK, 0 },
+	{ "clts", GEN, PRIV, 0 },
+	{ "clui", GEN, UNK, 0 },
+	{ "clwb", GEN, UNK, 0 },
+	{ "clzero", GEN, UNK, 0 },
+	{ "cmc", GEN, UNK, 0 },
+	{ "cmova", GEN, LOST, 0 },
+	{ "cmovae", GEN, LOST, 0 },
+	{ "cmovb", GEN, LOST, 0 },
+	{ "cmovbe", GEN, LOST, 0 },
+	{ "cmove", GEN, LOST, 0 },
+	{ "cmovg", GEN, LOST, 0 },
+	{ "cmovge", GEN, LOST, 0 },
+	{ "cmovl", GEN, LOST, 0 },
+	{ "cmovle", GEN, LOST, 0 },
+	{ "cmovne", GEN, LOST, 0 },
+	{ "cmovno", GEN, LOST, 0 },
+	{ "cmovnp", GEN, LOST, 0 },
+	{ "cmovns", GEN, LOST, 0 },
+	{ "cmovo", GEN, LOST, 0 },
+	{ "cmovp", GEN, LOST, 0 },
+	{ "cmovs", GEN, LOST, 0 },
+	{ "cmp", GEN, TEST, 0 },
+	{ "cmpb", GEN, TEST, 0 },
+	{ "cmpbexadd", GEN, TEST, 0 },
+	{ "cmpbxadd", GEN, TEST, 0 },
+	{ "cmpl", GEN, TEST, 0 },
+	{ "cmplexadd", GEN, TEST, 0 },
+	{ "cmpltps", SIMD, TEST, 0 },
+	{ "cmplxadd", GEN, TEST, 0 },
+	{ "cmpnbexadd", GEN, TEST, 0 },
+	{ "cmpnbxadd", GEN, TEST, 0 },
+	{ "cmpnlexadd", GEN, TEST, 0 },
+	{ "cmpnlxadd", GEN, TEST, 0 },
+	{ "cmpnoxadd", GEN, TEST, 0 },
+	{ "cmpnpxadd", GEN, TEST, 0 },
+	{ "cmpnsxadd", GEN, TEST, 0 },
+	{ "cmpnzxadd", GEN, TEST, 0 },
+	{ "cmpoxadd", GEN, TEST, 0 },
+	{ "cmppd", SIMD, TEST, 0 },
+	{ "cmpps", SIMD, TEST, 0 },
+	{ "cmppxadd", GEN, TEST, 0 },
+	{ "cmpq", GEN, TEST, 0 },
+	{ "cmps", SIMD, TEST, 0 },
+	{ "cmpsb", SIMD, TEST, 0 },
+	{ "cmpsd", SIMD, TEST, 0 },
+	{ "cmpsl", SIMD, TEST, 0 },
+	{ "cmpsq", SIMD, TEST, 0 },
+	{ "cmpss", SIMD, TEST, 0 },
+	{ "cmpsw", SIMD, TEST, 0 },
+	{ "cmpsxadd", SIMD, TEST, 0 },
+	{ "cmpw", GEN, TEST, 0 },
+	{ "cmpxchg", GEN, LOST, 0 },
+	{ "cmpxchg16b", GEN, LOST, 0 },
+	{ "cmpxchg8b", GEN, LOST, 0 },
+	{ "cmpzxadd", GEN, TEST, 0 },
+	{ "comisd", SIMD, TEST, 0 },
+	{ "comiss", SIMD, TEST, 0 },
+	{ "cpuid", GEN, UNK, 0 },
+	{ "cqo", GEN, UNK, 0 },
+	{ "cqto", GEN, UNK, 0 },
+	{ "crc32", GEN, UNK, 0 },
+	{ "crc32b", GEN, UNK, 0 },
+	{ "crc32l", GEN, UNK, 0 },
+	{ "crc32w", GEN, UNK, 0 },
+	{ "cvtdq2pd", SIMD, UNK, 0 },
+	{ "cvtdq2ps", SIMD, UNK, 0 },
+	{ "cvtpd2dq", SIMD, UNK, 0 },
+	{ "cvtpd2pi", SIMD, UNK, 0 },
+	{ "cvtpd2ps", SIMD, UNK, 0 },
+	{ "cvtpi2pd", SIMD, UNK, 0 },
+	{ "cvtpi2ps", SIMD, UNK, 0 },
+	{ "cvtps2dq", SIMD, UNK, 0 },
+	{ "cvtps2pd", SIMD, UNK, 0 },
+	{ "cvtps2pi", SIMD, UNK, 0 },
+	{ "cvtsd2si", SIMD, UNK, 0 },
+	{ "cvtsd2ss", SIMD, UNK, 0 },
+	{ "cvtsi2sd", SIMD, UNK, 0 },
+	{ "cvtsi2sdl", SIMD, UNK, 0 },
+	{ "cvtsi2ss", SIMD, UNK, 0 },
+	{ "cvtsi2ssl", SIMD, UNK, 0 },
+	{ "cvtss2sd", SIMD, UNK, 0 },
+	{ "cvtss2si", SIMD, UNK, 0 },
+	{ "cvttpd2dq", SIMD, UNK, 0 },
+	{ "cvttpd2pi", SIMD, UNK, 0 },
+	{ "cvttps2dq", SIMD, UNK, 0 },
+	{ "cvttps2pi", SIMD, UNK, 0 },
+	{ "cvttsd2si", SIMD, UNK, 0 },
+	{ "cvttss2si", SIMD, UNK, 0 },
+	{ "cwd", GEN, UNK, 0 },
+	{ "cwde", GEN, UNK, 0 },
+	{ "cwtd", GEN, UNK, 0 },
+	{ "cwtl", GEN, UNK, 0 },
+	{ "daa", GEN, UNK, 0 },
+	{ "das", GEN, UNK, 0 },
+	{ "dec", GEN, MATH, 0 },
+	{ "decb", GEN, MATH, 0 },
+	{ "decl", GEN, MATH, 0 },
+	{ "decq", GEN, MATH, 0 },
+	{ "decw", GEN, MATH, 0 },
+	{ "div", GEN, MATH, 0 },
+	{ "divb", GEN, MATH, 0 },
+	{ "divl", GEN, MATH, 0 },
+	{ "divpd", SIMD, MATH, 0 },
+	{ "divps", SIMD, MATH, 0 },
+	{ "divq", GEN, MATH, 0 },
+	{ "divsd", SIMD, MATH, 0 },
+	{ "divss", SIMD, MATH, 0 },
+	{ "divw", GEN, MATH, 0 },
+	{ "dppd", SIMD, MATH, 0 },
+	{ "dpps", SIMD, MATH, 0 },
+	{ "emms", GEN, UNK, 0 },
+	{ "enclu", GEN, UNK, 0 },
+	{ "enclv", GEN, UNK, 0 },
+	{ "encodekey128", GEN, UNK, 0 },
+	{ "encodekey256", GEN, UNK, 0 },
+	{ "endbr32", GEN, UNK, 0 },
+	{ "endbr64", GEN, UNK, 0 },
+	{ "enqcmd", GEN, UNK, 0 },
+	{ "enqcmds", GEN, UNK, 0 },
+	{ "enter", GEN, STACK, FRAME },
+	{ "enterd", GEN, STACK, FRAME },
+	{ "enterl", GEN, STACK, FRAME },
+	{ "enterw", GEN, STACK, FRAME },
+	{ "extractps", SIMD, UNK, 0 },
+	{ "extrq", GEN, UNK, 0 },
+	{ "f2xm1", FPU, MATH, 0 },
+	{ "fabs", FPU, MATH, 0 },
+	{ "fadd", FPU, MATH, 0 },
+	{ "faddl", FPU, MATH, 0 },
+	{ "faddp", FPU, MATH, 0 },
+	{ "fadds", FPU, MATH, 0 },
+	{ "fbld", FPU, UNK, 0 },
+	{ "fbstp", FPU, UNK, 0 },
+	{ "fchs", FPU, UNK, 0 },
+	{ "fcmovb", FPU, LOST, 0 },
+	{ "fcmovbe", FPU, LOST, 0 },
+	{ "fcmove", FPU, LOST, 0 },
+	{ "fcmovnb", FPU, LOST, 0 },
+	{ "fcmovnbe", FPU, LOST, 0 },
+	{ "fcmovne", FPU, LOST, 0 },
+	{ "fcmovnu", FPU, LOST, 0 },
+	{ "fcmovu", FPU, LOST, 0 },
+	{ "fcom", FPU, TEST, 0 },
+	{ "fcomi", FPU, TEST, 0 },
+	{ "fcomip", FPU, TEST, 0 },
+	{ "fcoml", FPU, TEST, 0 },
+	{ "fcomp", FPU, TEST, 0 },
+	{ "fcompl", FPU, TEST, 0 },
+	{ "fcompp", FPU, TEST, 0 },
+	{ "fcomps", FPU, TEST, 0 },
+	{ "fcoms", FPU, TEST, 0 },
+	{ "fcos", FPU, MATH, 0 },
+	{ "fdecstp", FPU, UNK, 0 },
+	{ "fdiv", FPU, MATH, 0 },
+	{ "fdivl", FPU, MATH, 0 },
+	{ "fdivp", FPU, MATH, 0 },
+	{ "fdivr", FPU, MATH, 0 },
+	{ "fdivrl", FPU, MATH, 0 },
+	{ "fdivrp", FPU, MATH, 0 },
+	{ "fdivrs", FPU, MATH, 0 },
+	{ "fdivs", FPU, MATH, 0 },
+	{ "femms", FPU, UNK, 0 },
+	{ "ffree", FPU, UNK, 0 },
+	{ "ffreep", FPU, UNK, 0 },
+	{ "fiadd", FPU, MATH, 0 },
+	{ "fiaddl", FPU, MATH, 0 },
+	{ "fiadds", FPU, MATH, 0 },
+	{ "ficom", FPU, TEST, 0 },
+	{ "ficoml", FPU, TEST, 0 },
+	{ "ficomp", FPU, TEST, 0 },
+	{ "ficompl", FPU, TEST, 0 },
+	{ "ficomps", FPU, TEST, 0 },
+	{ "ficoms", FPU, TEST, 0 },
+	{ "fidiv", FPU, MATH, 0 },
+	{ "fidivl", FPU, MATH, 0 },
+	{ "fidivr", FPU, MATH, 0 },
+	{ "fidivrl", FPU, MATH, 0 },
+	{ "fidivrs", FPU, MATH, 0 },
+	{ "fidivs", FPU, MATH, 0 },
+	{ "fild", FPU, LOST, 0 },
+	{ "fildl", FPU, LOST, 0 },
+	{ "fildll", FPU, LOST, 0 },
+	{ "filds", FPU, LOST, 0 },
+	{ "fimul", FPU, MATH, 0 },
+	{ "fimull", FPU, MATH, 0 },
+	{ "fimuls", FPU, MATH, 0 },
+	{ "fincstp", FPU, UNK, 0 },
+	{ "fist", FPU, LOST, 0 },
+	{ "fistl", FPU, LOST, 0 },
+	{ "fistp", FPU, LOST, 0 },
+	{ "fistpl", FPU, LOST, 0 },
+	{ "fistpll", FPU, LOST, 0 },
+	{ "fistps", FPU, LOST, 0 },
+	{ "fists", FPU, LOST, 0 },
+	{ "fisttp", FPU, LOST, 0 },
+	{ "fisttpl", FPU, LOST, 0 },
+	{ "fisttpll", FPU, LOST, 0 },
+	{ "fisttps", FPU, LOST, 0 },
+	{ "fisub", FPU, MATH, 0 },
+	{ "fisubl", FPU, MATH, 0 },
+	{ "fisubr", FPU, MATH, 0 },
+	{ "fisubrl", FPU, MATH, 0 },
+	{ "fisubrs", FPU, MATH, 0 },
+	{ "fisubs", FPU, MATH, 0 },
+	{ "fld", FPU, LOST, 0 },
+	{ "fld1", FPU, LOST, 0 },
+	{ "fldcw", FPU, LOST, 0 },
+	{ "fldenv", FPU, LOST, 0 },
+	{ "fldenvd", FPU, LOST, 0 },
+	{ "fldenvl", FPU, LOST, 0 },
+	{ "fldenvs", FPU, LOST, 0 },
+	{ "fldenvw", FPU, LOST, 0 },
+	{ "fldl", FPU, LOST, 0 },
+	{ "fldl2e", FPU, LOST, 0 },
+	{ "fldl2t", FPU, LOST, 0 },
+	{ "fldlg2", FPU, LOST, 0 },
+	{ "fldln2", FPU, LOST, 0 },
+	{ "fldpi", FPU, LOST, 0 },
+	{ "flds", FPU, LOST, 0 },
+	{ "fldt", FPU, LOST, 0 },
+	{ "fldz", FPU, LOST, 0 },
+	{ "fmul", FPU, MATH, 0 },
+	{ "fmull", FPU, MATH, 0 },
+	{ "fmulp", FPU, MATH, 0 },
+	{ "fmuls", FPU, MATH, 0 },
+	{ "fnclex", FPU, UNK, 0 },
+	{ "fninit", FPU, UNK, 0 },
+	{ "fnop", FPU, NOP, 0 },
+	{ "fnsave", FPU, UNK, 0 },
+	{ "fnsaved", FPU, UNK, 0 },
+	{ "fnsavel", FPU, UNK, 0 },
+	{ "fnsaves", FPU, UNK, 0 },
+	{ "fnsavew", FPU, UNK, 0 },
+	{ "fnstcw", FPU, UNK, 0 },
+	{ "fnstenv", FPU, UNK, 0 },
+	{ "fnstenvd", FPU, UNK, 0 },
+	{ "fnstenvl", FPU, UNK, 0 },
+	{ "fnstenvs", FPU, UNK, 0 },
+	{ "fnstenvw", FPU, UNK, 0 },
+	{ "fnstsw", FPU, UNK, 0 },
+	{ "fpatan", FPU, MATH, 0 },
+	{ "fprem", FPU, MATH, 0 },
+	{ "fprem1", FPU, MATH, 0 },
+	{ "fptan", FPU, MATH, 0 },
+	{ "frndint", FPU, UNK, 0 },
+	{ "frstor", FPU, UNK, 0 },
+	{ "frstord", FPU, UNK, 0 },
+	{ "frstorl", FPU, UNK, 0 },
+	{ "frstors", FPU, UNK, 0 },
+	{ "frstorw", FPU, UNK, 0 },
+	{ "fscale", FPU, MATH, 0 },
+	{ "fsin", FPU, MATH, 0 },
+	{ "fsincos", FPU, MATH, 0 },
+	{ "fsqrt", FPU, MATH, 0 },
+	{ "fst", FPU, LOST, 0 },
+	{ "fstenv", FPU, LOST, 0 },
+	{ "fstl", FPU, LOST, 0 },
+	{ "fstp", FPU, LOST, 0 },
+	{ "fstpl", FPU, LOST, 0 },
+	{ "fstps", FPU, LOST, 0 },
+	{ "fstpt", FPU, LOST, 0 },
+	{ "fsts", FPU, LOST, 0 },
+	{ "fsub", FPU, MATH, 0 },
+	{ "fsubl", FPU, MATH, 0 },
+	{ "fsubp", FPU, MATH, 0 },
+	{ "fsubr", FPU, MATH, 0 },
+	{ "fsubrl", FPU, MATH, 0 },
+	{ "fsubrp", FPU, MATH, 0 },
+	{ "fsubrs", FPU, MATH, 0 },
+	{ "fsubs", FPU, MATH, 0 },
+	{ "ftst", FPU, TEST, 0 },
+	{ "fucom", FPU, TEST, 0 },
+	{ "fucomi", FPU, TEST, 0 },
+	{ "fucomip", FPU, TEST, 0 },
+	{ "fucomp", FPU, TEST, 0 },
+	{ "fucompp", FPU, TEST, 0 },
+	{ "fwait", FPU, UNK, 0 },
+	{ "fxam", FPU, UNK, 0 },
+	{ "fxch", FPU, LOST, 0 },
+	{ "fxrstor", FPU, UNK, 0 },
+	{ "fxrstor64", FPU, UNK, 0 },
+	{ "fxsave", FPU, UNK, 0 },
+	{ "fxsave64", FPU, UNK, 0 },
+	{ "fxtract", FPU, UNK, 0 },
+	{ "fyl2x", FPU, MATH, 0 },
+	{ "fyl2xp1", FPU, MATH, 0 },
+	{ "getsec", GEN, UNK, 0 },
+	{ "gf2p8affineinvqb", GEN, UNK, 0 },
+	{ "gf2p8affineqb", GEN, UNK, 0 },
+	{ "gf2p8mulb", GEN, MATH, 0 },
+	{ "haddpd", SIMD, MATH, 0 },
+	{ "haddps", SIMD, MATH, 0 },
+	{ "hlt", GEN, PRIV, 0 },
+	{ "hreset", GEN, UNK, 0 },
+	{ "hsubpd", SIMD, MATH, 0 },
+	{ "hsubps", SIMD, MATH, 0 },
+	{ "idiv", GEN, MATH, 0 },
+	{ "idivb", GEN, MATH, 0 },
+	{ "idivl", GEN, MATH, 0 },
+	{ "idivq", GEN, MATH, 0 },
+	{ "idivw", GEN, MATH, 0 },
+	{ "imul", GEN, MATH, 0 },
+	{ "imulb", GEN, MATH, 0 },
+	{ "imull", GEN, MATH, 0 },
+	{ "imulq", GEN, MATH, 0 },
+	{ "imulw", GEN, MATH, 0 },
+	{ "in", GEN, IO, IN },
+	{ "inc", GEN, MATH, 0 },
+	{ "incb", GEN, MATH, 0 },
+	{ "incl", GEN, MATH, 0 },
+	{ "incq", GEN, MATH, 0 },
+	{ "incsspd", SIMD, MATH, 0 },
+	{ "incw", GEN, MATH, 0 },
+	{ "ins", GEN, IO, IN },
+	{ "insb", GEN, IO, IN },
+	{ "insertps", SIMD, IO, IN },
+	{ "insertq", GEN, IO, IN },
+	{ "insl", GEN, IO, IN },
+	{ "insw", GEN, IO, IN },
+	{ "int", GEN, TRAP, 0 },
+	{ "int1", GEN, TRAP, 0 },
+	{ "int3", GEN, TRAP, 0 },
+	{ "into", GEN, TRAP, 0 },
+	{ "invd", GEN, PRIV, 0 },
+	{ "invept", GEN, PRIV, 0 },
+	{ "invlpg", GEN, PRIV, 0 },
+	{ "invpcid", GEN, PRIV, 0 },
+	{ "invvpid", GEN, PRIV, 0 },
+	{ "iret", GEN, CFLOW, RET },
+	{ "iretd", GEN, CFLOW, RET },
+	{ "iretl", GEN, CFLOW, RET },
+	{ "iretq", GEN, CFLOW, RET },
+	{ "iretw", GEN, CFLOW, RET },
+	{ "ja", GEN, CFLOW, JCC },
+	{ "jae", GEN, CFLOW, JCC },
+	{ "jb", GEN, CFLOW, JCC },
+	{ "jbe", GEN, CFLOW, JCC },
+	{ "jcxz", GEN, CFLOW, JCC },
+	{ "je", GEN, CFLOW, JCC },
+	{ "jecxz", GEN, CFLOW, JCC },
+	{ "jg", GEN, CFLOW, JCC },
+	{ "jge", GEN, CFLOW, JCC },
+	{ "jl", GEN, CFLOW, JCC },
+	{ "jle", GEN, CFLOW, JCC },
+	{ "jmp", GEN, CFLOW, JMP },
+	{ "jmpd", SIMD, CFLOW, JMP },
+	{ "jmpl", GEN, CFLOW, JMP },
+	{ "jmpw", GEN, CFLOW, JMP },
+	{ "jne", GEN, CFLOW, JCC },
+	{ "jno", GEN, CFLOW, JCC },
+	{ "jnp", GEN, CFLOW, JCC },
+	{ "jns", GEN, CFLOW, JCC },
+	{ "jo", GEN, CFLOW, JCC },
+	{ "jp", GEN, CFLOW, JCC },
+	{ "jrcxz", GEN, CFLOW, JCC },
+	{ "js", GEN, CFLOW, JCC },
+	{ "kaddb", GEN, MATH, 0 },
+	{ "kaddd", GEN, MATH, 0 },
+	{ "kaddq", GEN, MATH, 0 },
+	{ "kaddw", GEN, MATH, 0 },
+	{ "kandb", GEN, UNK, 0 },
+	{ "kandd", GEN, UNK, 0 },
+	{ "kandnb", GEN, UNK, 0 },
+	{ "kandnd", GEN, UNK, 0 },
+	{ "kandnq", GEN, UNK, 0 },
+	{ "kandnw", GEN, UNK, 0 },
+	{ "kandq", GEN, UNK, 0 },
+	{ "kandw", GEN, UNK, 0 },
+	{ "kmovb", GEN, LOST, 0 },
+	{ "kmovd", GEN, LOST, 0 },
+	{ "kmovq", GEN, LOST, 0 },
+	{ "kmovw", GEN, LOST, 0 },
+	{ "knotb", GEN, UNK, 0 },
+	{ "knotd", GEN, UNK, 0 },
+	{ "knotq", GEN, UNK, 0 },
+	{ "knotw", GEN, UNK, 0 },
+	{ "korb", GEN, UNK, 0 },
+	{ "kord", GEN, UNK, 0 },
+	{ "korq", GEN, UNK, 0 },
+	{ "kortestb", GEN, TEST, 0 },
+	{ "kortestd", GEN, TEST, 0 },
+	{ "kortestq", GEN, TEST, 0 },
+	{ "kortestw", GEN, TEST, 0 },
+	{ "korw", GEN, UNK, 0 },
+	{ "kshiftlb", GEN, UNK, 0 },
+	{ "kshiftld", GEN, UNK, 0 },
+	{ "kshiftlq", GEN, UNK, 0 },
+	{ "kshiftlw", GEN, UNK, 0 },
+	{ "kshiftrb", GEN, UNK, 0 },
+	{ "kshiftrd", GEN, UNK, 0 },
+	{ "kshiftrq", GEN, UNK, 0 },
+	{ "kshiftrw", GEN, UNK, 0 },
+	{ "ktestb", GEN, TEST, 0 },
+	{ "ktestd", GEN, TEST, 0 },
+	{ "ktestq", GEN, TEST, 0 },
+	{ "ktestw", GEN, TEST, 0 },
+	{ "kunpckbw", GEN, UNK, 0 },
+	{ "kunpckdq", GEN, UNK, 0 },
+	{ "kunpckwd", GEN, UNK, 0 },
+	{ "kxnorb", GEN, UNK, 0 },
+	{ "kxnord", GEN, UNK, 0 },
+	{ "kxnorq", GEN, UNK, 0 },
+	{ "kxnorw", GEN, UNK, 0 },
+	{ "kxorb", GEN, UNK, 0 },
+	{ "kxord", GEN, UNK, 0 },
+	{ "kxorq", GEN, UNK, 0 },
+	{ "kxorw", GEN, UNK, 0 },
+	{ "lahf", GEN, LOST, 0 },
+	{ "lar", GEN, LOST, 0 },
+	{ "lcall", GEN, CFLOW, CALL },
+	{ "lcalll", GEN, CFLOW, CALL },
+	{ "lcallw", GEN, CFLOW, CALL },
+	{ "lddqu", GEN, LOST, 0 },
+	{ "ldmxcsr", GEN, LOST, 0 },
+	{ "lds", GEN, LOST, 0 },
+	{ "ldtilecfg", GEN, LOST, 0 },
+	{ "lea", GEN, MATH, 0 },
+	{ "leave", GEN, STACK, UNFRAME },
+	{ "leaved", GEN, STACK, UNFRAME },
+	{ "leavel", GEN, STACK, UNFRAME },
+	{ "leavew", GEN, STACK, UNFRAME },
+	{ "les", GEN, UNK, 0 },
+	{ "lfence", GEN, LOST, 0 },
+	{ "lfs", GEN, LOST, 0 },
+	{ "lgdt", GEN, LOST, 0 },
+	{ "lgdtd", GEN, LOST, 0 },
+	{ "lgdtl", GEN, LOST, 0 },
+	{ "lgdtw", GEN, LOST, 0 },
+	{ "lgs", GEN, LOST, 0 },
+	{ "lidt", GEN, UNK, 0 },
+	{ "lidtd", GEN, UNK, 0 },
+	{ "lidtl", GEN, UNK, 0 },
+	{ "lidtw", GEN, UNK, 0 },
+	{ "ljmp", GEN, CFLOW, JMP },
+	{ "ljmpl", GEN, CFLOW, JMP },
+	{ "ljmpw", GEN, CFLOW, JMP },
+	{ "lldt", GEN, LOST, 0 },
+	{ "lmsw", GEN, LOST, 0 },
+	{ "loadiwkey", GEN, UNK, 0 },
+	{ "lods", GEN, LOST, 0 },
+	{ "loop", GEN, CFLOW, JCC },
+	{ "loope", GEN, CFLOW, JCC },
+	{ "loopel", GEN, CFLOW, JCC },
+	{ "loopew", GEN, CFLOW, JCC },
+	{ "loopl", GEN, CFLOW, JCC },
+	{ "loopne", GEN, CFLOW, JCC },
+	{ "loopnel", GEN, CFLOW, JCC },
+	{ "loopnew", GEN, CFLOW, JCC },
+	{ "loopw", GEN, CFLOW, JCC },
+	{ "lret", GEN, CFLOW, RET },
+	{ "lretl", GEN, CFLOW, RET },
+	{ "lretq", GEN, CFLOW, RET },
+	{ "lretw", GEN, CFLOW, RET },
+	{ "lsl", GEN, UNK, 0 },
+	{ "lss", SIMD, UNK, 0 },
+	{ "ltr", GEN, PRIV, 0 },
+	{ "lzcnt", GEN, UNK, 0 },
+	{ "maskmovdqu", GEN, LOST, 0 },
+	{ "maskmovq", GEN, LOST, 0 },
+	{ "maxpd", SIMD, TEST, 0 },
+	{ "maxps", SIMD, TEST, 0 },
+	{ "maxsd", SIMD, TEST, 0 },
+	{ "maxss", SIMD, TEST, 0 },
+	{ "mcommit", GEN, TEST, 0 },
+	{ "mfence", GEN, UNK, 0 },
+	{ "minpd", SIMD, TEST, 0 },
+	{ "minps", SIMD, TEST, 0 },
+	{ "minsd", SIMD, TEST, 0 },
+	{ "minss", SIMD, TEST, 0 },
+	{ "monitor", GEN, UNK, 0 },
+	{ "monitorx", GEN, UNK, 0 },
+	{ "montmul", GEN, MATH, 0 },
+	{ "mov", GEN, LOST, 0 },
+	{ "movabs", GEN, LOST, 0 },
+	{ "movapd", SIMD, LOST, 0 },
+	{ "movaps", SIMD, LOST, 0 },
+	{ "movb", GEN, LOST, 0 },
+	{ "movbe", GEN, LOST, 0 },
+	{ "movd", GEN, LOST, 0 },
+	{ "movddup", GEN, LOST, 0 },
+	{ "movdir64b", GEN, LOST, 0 },
+	{ "movdiri", GEN, LOST, 0 },
+	{ "movdq2q", GEN, LOST, 0 },
+	{ "movdqa", GEN, LOST, 0 },
+	{ "movdqu", GEN, LOST, 0 },
+	{ "movhlps", SIMD, LOST, 0 },
+	{ "movhpd", SIMD, LOST, 0 },
+	{ "movhps", SIMD, LOST, 0 },
+	{ "movl", GEN, LOST, 0 },
+	{ "movlhps", SIMD, LOST, 0 },
+	{ "movlpd", SIMD, LOST, 0 },
+	{ "movlps", SIMD, LOST, 0 },
+	{ "movmskpd", SIMD, LOST, 0 },
+	{ "movmskps", SIMD, LOST, 0 },
+	{ "movntdq", GEN, LOST, 0 },
+	{ "movntdqa", GEN, LOST, 0 },
+	{ "movnti", GEN, LOST, 0 },
+	{ "movntpd", SIMD, LOST, 0 },
+	{ "movntps", SIMD, LOST, 0 },
+	{ "movntq", GEN, LOST, 0 },
+	{ "movntsd", SIMD, LOST, 0 },
+	{ "movntss", SIMD, LOST, 0 },
+	{ "movq", GEN, LOST, 0 },
+	{ "movq2dq", GEN, LOST, 0 },
+	{ "movs", GEN, LOST, 0 },
+	{ "movsb", GEN, LOST, 0 },
+	{ "movsbl", GEN, LOST, 0 },
+	{ "movsbq", GEN, LOST, 0 },
+	{ "movsbw", GEN, LOST, 0 },
+	{ "movsd", SIMD, LOST, 0 },
+	{ "movshdup", GEN, LOST, 0 },
+	{ "movsl", GEN, LOST, 0 },
+	{ "movsldup", GEN, LOST, 0 },
+	{ "movslq", GEN, LOST, 0 },
+	{ "movsq", GEN, LOST, 0 },
+	{ "movss", SIMD, LOST, 0 },
+	{ "movsw", GEN, LOST, 0 },
+	{ "movswl", GEN, LOST, 0 },
+	{ "movswq", GEN, LOST, 0 },
+	{ "movsww", GEN, LOST, 0 },
+	{ "movsx", GEN, LOST, 0 },
+	{ "movsxd", GEN, LOST, 0 },
+	{ "movupd", SIMD, LOST, 0 },
+	{ "movups", SIMD, LOST, 0 },
+	{ "movw", GEN, LOST, 0 },
+	{ "movzbl", GEN, LOST, 0 },
+	{ "movzbq", GEN, LOST, 0 },
+	{ "movzbw", GEN, LOST, 0 },
+	{ "movzwl", GEN, LOST, 0 },
+	{ "movzwq", GEN, LOST, 0 },
+	{ "movzww", GEN, LOST, 0 },
+	{ "movzx", GEN, LOST, 0 },
+	{ "mpsadbw", SIMD, TEST, 0 },
+	{ "mul", GEN, MATH, 0 },
+	{ "mulb", GEN, MATH, 0 },
+	{ "mull", GEN, MATH, 0 },
+	{ "mulpd", SIMD, MATH, 0 },
+	{ "mulps", SIMD, MATH, 0 },
+	{ "mulq", GEN, MATH, 0 },
+	{ "mulsd", SIMD, MATH, 0 },
+	{ "mulss", SIMD, MATH, 0 },
+	{ "mulw", GEN, MATH, 0 },
+	{ "mulx", GEN, MATH, 0 },
+	{ "mwaitx", GEN, UNK, 0 },
+	{ "neg", GEN, BIT, NOT },
+	{ "negb", GEN, BIT, NOT },
+	{ "negl", GEN, BIT, NOT },
+	{ "negq", GEN, BIT, NOT },
+	{ "negw", GEN, BIT, NOT },
+	{ "nop", GEN, NOP, 0 },
+	{ "nopl", GEN, UNK, 0 },
+	{ "nopq", GEN, UNK, 0 },
+	{ "nopw", GEN, UNK, 0 },
+	{ "not", GEN, BIT, NOT },
+	{ "notb", GEN, BIT, NOT },
+	{ "notl", GEN, BIT, NOT },
+	{ "notq", GEN, BIT, NOT },
+	{ "notw", GEN, BIT, NOT },
+	{ "or", GEN, BIT, OR },
+	{ "orb", GEN, BIT, OR },
+	{ "orl", GEN, BIT, OR },
+	{ "orpd", SIMD, BIT, OR },
+	{ "orps", SIMD, BIT, OR },
+	{ "orq", GEN, BIT, OR },
+	{ "orw", GEN, BIT, OR },
+	{ "out", GEN, IO, OUT },
+	{ "outs", GEN, IO, OUT },
+	{ "outsb", GEN, IO, OUT },
+	{ "outsl", GEN, IO, OUT },
+	{ "outsw", GEN, IO, OUT },
+	{ "pabsb", SIMD, MATH, 0 },
+	{ "pabsd", SIMD, MATH, 0 },
+	{ "pabsw", SIMD, MATH, 0 },
+	{ "packssdw", SIMD, UNK, 0 },
+	{ "packsswb", SIMD, UNK, 0 },
+	{ "packusdw", SIMD, UNK, 0 },
+	{ "packuswb", SIMD, UNK, 0 },
+	{ "paddb", SIMD, MATH, 0 },
+	{ "paddd", SIMD, MATH, 0 },
+	{ "paddq", SIMD, MATH, 0 },
+	{ "paddsb", SIMD, MATH, 0 },
+	{ "paddsw", SIMD, MATH, 0 },
+	{ "paddusb", SIMD, MATH, 0 },
+	{ "paddusw", SIMD, MATH, 0 },
+	{ "paddw", SIMD, MATH, 0 },
+	{ "palignr", SIMD, UNK, 0 },
+	{ "pand", SIMD, BIT, AND },
+	{ "pandn", SIMD, BIT, AND },
+	{ "pause", GEN, UNK, 0 },
+	{ "pavgb", SIMD, MATH, 0 },
+	{ "pavgw", SIMD, MATH, 0 },
+	{ "pblendvb", SIMD, UNK, 0 },
+	{ "pblendw", SIMD, UNK, 0 },
+	{ "pclmulhqhqdq", SIMD, MATH, 0 },
+	{ "pclmullqhqdq", SIMD, MATH, 0 },
+	{ "pclmullqlqdq", SIMD, MATH, 0 },
+	{ "pcmpeqb", SIMD, TEST, 0 },
+	{ "pcmpeqd", SIMD, TEST, 0 },
+	{ "pcmpeqq", SIMD, TEST, 0 },
+	{ "pcmpeqw", SIMD, TEST, 0 },
+	{ "pcmpestri", SIMD, TEST, 0 },
+	{ "pcmpestrm", SIMD, TEST, 0 },
+	{ "pcmpgtb", SIMD, TEST, 0 },
+	{ "pcmpgtd", SIMD, TEST, 0 },
+	{ "pcmpgtq", SIMD, TEST, 0 },
+	{ "pcmpgtw", SIMD, TEST, 0 },
+	{ "pcmpistri", SIMD, TEST, 0 },
+	{ "pcmpistrm", SIMD, TEST, 0 },
+	{ "pdep", SIMD, UNK, 0 },
+	{ "pext", SIMD, UNK, 0 },
+	{ "pextrb", SIMD, UNK, 0 },
+	{ "pextrd", SIMD, UNK, 0 },
+	{ "pextrw", SIMD, UNK, 0 },
+	{ "phaddd", SIMD, MATH, 0 },
+	{ "phaddsw", SIMD, MATH, 0 },
+	{ "phaddw", SIMD, MATH, 0 },
+	{ "phminposuw", SIMD, TEST, 0 },
+	{ "phsubd", SIMD, MATH, 0 },
+	{ "phsubsw", SIMD, MATH, 0 },
+	{ "phsubw", SIMD, MATH, 0 },
+	{ "pinsrb", SIMD, UNK, 0 },
+	{ "pinsrd", SIMD, UNK, 0 },
+	{ "pinsrw", SIMD, UNK, 0 },
+	{ "pmaddubsw", SIMD, MATH, 0 },
+	{ "pmaddwd", SIMD, MATH, 0 },
+	{ "pmaxsb", SIMD, TEST, 0 },
+	{ "pmaxsd", SIMD, TEST, 0 },
+	{ "pmaxsw", SIMD, TEST, 0 },
+	{ "pmaxub", SIMD, TEST, 0 },
+	{ "pmaxud", SIMD, TEST, 0 },
+	{ "pmaxuw", SIMD, TEST, 0 },
+	{ "pminsb", SIMD, TEST, 0 },
+	{ "pminsd", SIMD, TEST, 0 },
+	{ "pminsw", SIMD, TEST, 0 },
+	{ "pminub", SIMD, TEST, 0 },
+	{ "pminud", SIMD, TEST, 0 },
+	{ "pminuw", SIMD, TEST, 0 },
+	{ "pmovmskb", SIMD, LOST, 0 },
+	{ "pmovsxbd", SIMD, LOST, 0 },
+	{ "pmovsxbq", SIMD, LOST, 0 },
+	{ "pmovsxbw", SIMD, LOST, 0 },
+	{ "pmovsxdq", SIMD, LOST, 0 },
+	{ "pmovsxwd", SIMD, LOST, 0 },
+	{ "pmovsxwq", SIMD, LOST, 0 },
+	{ "pmovzxbd", SIMD, LOST, 0 },
+	{ "pmovzxbq", SIMD, LOST, 0 },
+	{ "pmovzxbw", SIMD, LOST, 0 },
+	{ "pmovzxdq", SIMD, LOST, 0 },
+	{ "pmovzxwd", SIMD, LOST, 0 },
+	{ "pmovzxwq", SIMD, LOST, 0 },
+	{ "pmuldq", SIMD, MATH, 0 },
+	{ "pmulhrsw", SIMD, MATH, 0 },
+	{ "pmulhrw", SIMD, MATH, 0 },
+	{ "pmulhuw", SIMD, MATH, 0 },
+	{ "pmulhw", SIMD, MATH, 0 },
+	{ "pmulld", SIMD, MATH, 0 },
+	{ "pmullw", SIMD, MATH, 0 },
+	{ "pmuludq", SIMD, MATH, 0 },
+	{ "pop", GEN, STACK, POP },
+	{ "popa", GEN, STACK, POP },
+	{ "popad", GEN, STACK, POP },
+	{ "popal", GEN, STACK, POP },
+	{ "popaw", GEN, STACK, POP },
+	{ "popcnt", GEN, UNK, 0 },
+	{ "popd", SIMD, STACK, POP },
+	{ "popf", GEN, STACK, POP },
+	{ "popfd", GEN, STACK, POP },
+	{ "popfl", GEN, STACK, POP },
+	{ "popfw", GEN, STACK, POP },
+	{ "popl", GEN, STACK, POP },
+	{ "popw", GEN, STACK, POP },
+	{ "por", SIMD, BIT, OR },
+	{ "prefetch", GEN, UNK, 0 },
+	{ "prefetchnta", GEN, UNK, 0 },
+	{ "prefetcht0", GEN, UNK, 0 },
+	{ "prefetcht1", GEN, UNK, 0 },
+	{ "prefetcht2", GEN, UNK, 0 },
+	{ "prefetchw", GEN, UNK, 0 },
+	{ "prefetchwt1", GEN, UNK, 0 },
+	{ "psadbw", SIMD, MATH, 0 },
+	{ "pshufb", SIMD, UNK, 0 },
+	{ "pshufd", SIMD, UNK, 0 },
+	{ "pshufhw", SIMD, UNK, 0 },
+	{ "pshuflw", SIMD, UNK, 0 },
+	{ "pshufw", SIMD, UNK, 0 },
+	{ "psignb", SIMD, UNK, 0 },
+	{ "psignd", SIMD, UNK, 0 },
+	{ "psignw", SIMD, UNK, 0 },
+	{ "pslld", SIMD, BIT, LSL },
+	{ "pslldq", SIMD, BIT, LSL },
+	{ "psllq", SIMD, BIT, LSL },
+	{ "psllw", SIMD, BIT, LSL },
+	{ "psrad", SIMD, BIT, ASR },
+	{ "psraw", SIMD, BIT, ASR },
+	{ "psrld", SIMD, BIT, LSR },
+	{ "psrldq", SIMD, BIT, LSR },
+	{ "psrlq", SIMD, BIT, LSR },
+	{ "psrlw", SIMD, BIT, LSR },
+	{ "psubb", SIMD, MATH, 0 },
+	{ "psubd", SIMD, MATH, 0 },
+	{ "psubq", SIMD, MATH, 0 },
+	{ "psubsb", SIMD, MATH, 0 },
+	{ "psubsw", SIMD, MATH, 0 },
+	{ "psubusb", SIMD, MATH, 0 },
+	{ "psubusw", SIMD, MATH, 0 },
+	{ "psubw", SIMD, MATH, 0 },
+	{ "ptest", SIMD, TEST, 0 },
+	{ "ptwrite", SIMD, UNK, 0 },
+	{ "ptwritel", SIMD, UNK, 0 },
+	{ "punpckhbw", SIMD, UNK, 0 },
+	{ "punpckhdq", SIMD, UNK, 0 },
+	{ "punpckhqdq", SIMD, UNK, 0 },
+	{ "punpckhwd", SIMD, UNK, 0 },
+	{ "punpcklbw", SIMD, UNK, 0 },
+	{ "punpckldq", SIMD, UNK, 0 },
+	{ "punpcklqdq", SIMD, UNK, 0 },
+	{ "punpcklwd", SIMD, UNK, 0 },
+	{ "push", GEN, STACK, PUSH },
+	{ "pusha", GEN, STACK, PUSH },
+	{ "pushad", GEN, STACK, PUSH },
+	{ "pushal", GEN, STACK, PUSH },
+	{ "pushaw", GEN, STACK, PUSH },
+	{ "pushd", GEN, STACK, PUSH },
+	{ "pushf", GEN, STACK, PUSH },
+	{ "pushfd", GEN, STACK, PUSH },
+	{ "pushfl", GEN, STACK, PUSH },
+	{ "pushfw", GEN, STACK, PUSH },
+	{ "pushl", GEN, STACK, PUSH },
+	{ "pushw", GEN, STACK, PUSH },
+	{ "pxor", SIMD, BIT, XOR },
+	{ "rcl", GEN, BIT, RCL },
+	{ "rclb", GEN, BIT, RCL },
+	{ "rcll", GEN, BIT, RCL },
+	{ "rclq", GEN, BIT, RCL },
+	{ "rclw", GEN, BIT, RCL },
+	{ "rcpps", SIMD, MATH, 0 },
+	{ "rcpss", SIMD, MATH, 0 },
+	{ "rcr", GEN, BIT, RCR },
+	{ "rcrb", GEN, BIT, RCR },
+	{ "rcrl", GEN, BIT, RCR },
+	{ "rcrq", GEN, BIT, RCR },
+	{ "rcrw", GEN, BIT, RCR },
+	{ "rdfsbase", GEN, LOST, 0 },
+	{ "rdgsbase", GEN, LOST, 0 },
+	{ "rdmsr", GEN, LOST, 0 },
+	{ "rdpid", GEN, LOST, 0 },
+	{ "rdpkru", GEN, LOST, 0 },
+	{ "rdpmc", GEN, LOST, 0 },
+	{ "rdrand", GEN, LOST, 0 },
+	{ "rdseed", GEN, LOST, 0 },
+	{ "rdsspd", SIMD, LOST, 0 },
+	{ "rdtsc", GEN, LOST, 0 },
+	{ "rdtscp", GEN, LOST, 0 },
+	{ "ret", GEN, CFLOW, RET },
+	{ "retd", GEN, CFLOW, RET },
+	{ "retf", GEN, CFLOW, RET },
+	{ "retfd", GEN, CFLOW, RET },
+	{ "retfq", GEN, CFLOW, RET },
+	{ "retfw", GEN, CFLOW, RET },
+	{ "retl", GEN, CFLOW, RET },
+	{ "retw", GEN, CFLOW, RET },
+	{ "rol", GEN, BIT, ROL },
+	{ "rolb", GEN, BIT, ROL },
+	{ "roll", GEN, BIT, ROL },
+	{ "rolq", GEN, BIT, ROL },
+	{ "rolw", GEN, BIT, ROL },
+	{ "ror", GEN, BIT, ROR },
+	{ "rorb", GEN, BIT, ROR },
+	{ "rorl", GEN, BIT, ROR },
+	{ "rorq", GEN, BIT, ROR },
+	{ "rorw", GEN, BIT, ROR },
+	{ "rorx", GEN, BIT, ROR },
+	{ "roundpd", SIMD, MATH, 0 },
+	{ "roundps", SIMD, MATH, 0 },
+	{ "roundsd", SIMD, MATH, 0 },
+	{ "roundss", SIMD, MATH, 0 },
+	{ "rsm", GEN, PRIV, 0 },
+	{ "rsqrtps", SIMD, MATH, 0 },
+	{ "rsqrtss", SIMD, MATH, 0 },
+	{ "rstorssp", SIMD, UNK, 0 },
+	{ "sahf", GEN, LOST, 0 },
+	{ "sar", GEN, BIT, ASR },
+	{ "sarb", GEN, BIT, ASR },
+	{ "sarl", GEN, BIT, ASR },
+	{ "sarq", GEN, BIT, ASR },
+	{ "sarw", GEN, BIT, ASR },
+	{ "sarx", GEN, BIT, ASR },
+	{ "sbb", GEN, UNK, 0 },
+	{ "sbbb", GEN, UNK, 0 },
+	{ "sbbl", GEN, UNK, 0 },
+	{ "sbbq", GEN, UNK, 0 },
+	{ "sbbw", GEN, UNK, 0 },
+	{ "scas", GEN, UNK, 0 },
+	{ "senduipi", GEN, UNK, 0 },
+	{ "serialize", GEN, UNK, 0 },
+	{ "seta", GEN, UNK, 0 },
+	{ "setae", GEN, UNK, 0 },
+	{ "setb", GEN, UNK, 0 },
+	{ "setbe", GEN, UNK, 0 },
+	{ "sete", GEN, UNK, 0 },
+	{ "setg", GEN, UNK, 0 },
+	{ "setge", GEN, UNK, 0 },
+	{ "setl", GEN, UNK, 0 },
+	{ "setle", GEN, UNK, 0 },
+	{ "setne", GEN, UNK, 0 },
+	{ "setno", GEN, UNK, 0 },
+	{ "setnp", GEN, UNK, 0 },
+	{ "setns", GEN, UNK, 0 },
+	{ "seto", GEN, UNK, 0 },
+	{ "setp", GEN, UNK, 0 },
+	{ "sets", GEN, UNK, 0 },
+	{ "setssbsy", SIMD, UNK, 0 },
+	{ "sfence", GEN, UNK, 0 },
+	{ "sgdt", GEN, LOST, 0 },
+	{ "sgdtd", GEN, LOST, 0 },
+	{ "sgdtl", GEN, LOST, 0 },
+	{ "sgdtw", GEN, LOST, 0 },
+	{ "sha1msg1", GEN, UNK, 0 },
+	{ "sha1msg2", GEN, UNK, 0 },
+	{ "sha1nexte", GEN, UNK, 0 },
+	{ "sha1rnds4", GEN, UNK, 0 },
+	{ "sha256msg1", GEN, UNK, 0 },
+	{ "sha256msg2", GEN, UNK, 0 },
+	{ "sha256rnds2", GEN, UNK, 0 },
+	{ "shl", GEN, BIT, LSL },
+	{ "shlb", GEN, BIT, LSL },
+	{ "shld", GEN, BIT, LSL },
+	{ "shll", GEN, BIT, LSL },
+	{ "shlq", GEN, BIT, LSL },
+	{ "shlw", GEN, BIT, LSL },
+	{ "shlx", GEN, BIT, LSL },
+	{ "shr", GEN, BIT, LSR },
+	{ "shrb", GEN, BIT, LSR },
+	{ "shrd", GEN, BIT, LSR },
+	{ "shrl", GEN, BIT, LSR },
+	{ "shrq", GEN, BIT, LSR },
+	{ "shrw", GEN, BIT, LSR },
+	{ "shrx", GEN, BIT, LSR },
+	{ "shufpd", SIMD, UNK, 0 },
+	{ "shufps", SIMD, UNK, 0 },
+	{ "sidt", GEN, LOST, 0 },
+	{ "sidtd", GEN, LOST, 0 },
+	{ "sidtl", GEN, LOST, 0 },
+	{ "sidtw", GEN, LOST, 0 },
+	{ "sldt", GEN, LOST, 0 },
+	{ "smsw", GEN, LOST, 0 },
+	{ "sqrtpd", SIMD, MATH, 0 },
+	{ "sqrtps", SIMD, MATH, 0 },
+	{ "sqrtsd", SIMD, MATH, 0 },
+	{ "sqrtss", SIMD, MATH, 0 },
+	{ "stc", GEN, UNK, 0 },
+	{ "std", GEN, UNK, 0 },
+	{ "sti", GEN, TRAP, 0 },
+	{ "stmxcsr", GEN, LOST, 0 },
+	{ "stos", GEN, LOST, 0 },
+	{ "str", GEN, LOST, 0 },
+	{ "sttilecfg", GEN, UNK, 0 },
+	{ "stui", GEN, UNK, 0 },
+	{ "sub", GEN, MATH, 0 },
+	{ "subb", GEN, MATH, 0 },
+	{ "subl", GEN, MATH, 0 },
+	{ "subpd", SIMD, MATH, 0 },
+	{ "subps", SIMD, MATH, 0 },
+	{ "subq", GEN, MATH, 0 },
+	{ "subsd", SIMD, MATH, 0 },
+	{ "subss", SIMD, MATH, 0 },
+	{ "subw", GEN, MATH, 0 },
+	{ "swapgs", GEN, LOST, 0 },
+	{ "syscall", GEN, CFLOW, CALL },
+	{ "sysenter", GEN, CFLOW, CALL },
+	{ "sysexit", GEN, CFLOW, RET },
+	{ "sysexitd", GEN, UNK, 0 },
+	{ "sysexitl", GEN, UNK, 0 },
+	{ "sysexitq", GEN, UNK, 0 },
+	{ "sysret", GEN, CFLOW, RET },
+	{ "sysretd", GEN, UNK, 0 },
+	{ "sysretl", GEN, UNK, 0 },
+	{ "sysretq", GEN, UNK, 0 },
+	{ "tdpbf16ps", SIMD, UNK, 0 },
+	{ "tdpbssd", SIMD, UNK, 0 },
+	{ "tdpbsud", GEN, UNK, 0 },
+	{ "tdpbusd", SIMD, UNK, 0 },
+	{ "tdpbuud", GEN, UNK, 0 },
+	{ "tdpfp16ps", SIMD, UNK, 0 },
+	{ "test", GEN, TEST, 0 },
+	{ "testb", GEN, TEST, 0 },
+	{ "testl", GEN, TEST, 0 },
+	{ "testq", GEN, TEST, 0 },
+	{ "testw", GEN, TEST, 0 },
+	{ "tileloadd", GEN, MATH, 0 },
+	{ "tileloaddt1", GEN, MATH, 0 },
+	{ "tilerelease", GEN, UNK, 0 },
+	{ "tilestored", GEN, UNK, 0 },
+	{ "tilezero", GEN, UNK, 0 },
+	{ "tpause", GEN, UNK, 0 },
+	{ "tzcnt", GEN, UNK, 0 },
+	{ "ucomisd", SIMD, TEST, 0 },
+	{ "ucomiss", SIMD, TEST, 0 },
+	{ "ud0", GEN, UNK, 0 },
+	{ "ud1", GEN, UNK, 0 },
+	{ "ud2", GEN, TRAP, 0 },
+	{ "umonitor", GEN, UNK, 0 },
+	{ "umwait", GEN, UNK, 0 },
+	{ "unpckhpd", SIMD, UNK, 0 },
+	{ "unpckhps", SIMD, UNK, 0 },
+	{ "unpcklpd", SIMD, UNK, 0 },
+	{ "unpcklps", SIMD, UNK, 0 },
+	{ "v4fmaddps", SIMD, MATH, 0 },
+	{ "v4fmaddss", SIMD, MATH, 0 },
+	{ "v4fnmaddps", SIMD, MATH, 0 },
+	{ "v4fnmaddss", SIMD, MATH, 0 },
+	{ "vaddpd", SIMD, MATH, 0 },
+	{ "vaddph", GEN, MATH, 0 },
+	{ "vaddps", SIMD, MATH, 0 },
+	{ "vaddsd", SIMD, MATH, 0 },
+	{ "vaddsh", GEN, MATH, 0 },
+	{ "vaddss", SIMD, MATH, 0 },
+	{ "vaddsubpd", SIMD, MATH, 0 },
+	{ "vaddsubps", SIMD, MATH, 0 },
+	{ "vaesdec", SIMD, UNK, 0 },
+	{ "vaesdeclast", SIMD, UNK, 0 },
+	{ "vaesenc", GEN, UNK, 0 },
+	{ "vaesenclast", GEN, UNK, 0 },
+	{ "vaesimc", GEN, UNK, 0 },
+	{ "vaeskeygenassist", SIMD, UNK, 0 },
+	{ "valignd", GEN, UNK, 0 },
+	{ "valignq", GEN, UNK, 0 },
+	{ "vandnpd", SIMD, UNK, 0 },
+	{ "vandnps", SIMD, UNK, 0 },
+	{ "vandpd", SIMD, UNK, 0 },
+	{ "vandps", SIMD, UNK, 0 },
+	{ "vbcstnebf162ps", SIMD, UNK, 0 },
+	{ "vbcstnesh2ps", SIMD, UNK, 0 },
+	{ "vblendmpd", SIMD, UNK, 0 },
+	{ "vblendmps", SIMD, UNK, 0 },
+	{ "vblendpd", SIMD, UNK, 0 },
+	{ "vblendps", SIMD, UNK, 0 },
+	{ "vblendvpd", SIMD, UNK, 0 },
+	{ "vblendvps", SIMD, UNK, 0 },
+	{ "vbroadcastf128", GEN, UNK, 0 },
+	{ "vbroadcastf32x2", GEN, UNK, 0 },
+	{ "vbroadcastf32x4", GEN, UNK, 0 },
+	{ "vbroadcastf32x8", GEN, UNK, 0 },
+	{ "vbroadcastf64x2", GEN, UNK, 0 },
+	{ "vbroadcastf64x4", GEN, UNK, 0 },
+	{ "vbroadcasti128", GEN, UNK, 0 },
+	{ "vbroadcasti32x2", GEN, UNK, 0 },
+	{ "vbroadcasti32x4", GEN, UNK, 0 },
+	{ "vbroadcasti32x8", GEN, UNK, 0 },
+	{ "vbroadcasti64x2", GEN, UNK, 0 },
+	{ "vbroadcasti64x4", GEN, UNK, 0 },
+	{ "vbroadcastsd", SIMD, UNK, 0 },
+	{ "vbroadcastss", SIMD, UNK, 0 },
+	{ "vcmplt_oqpd", SIMD, TEST, 0 },
+	{ "vcmplt_oqph", GEN, TEST, 0 },
+	{ "vcmplt_oqps", SIMD, TEST, 0 },
+	{ "vcmplt_oqsd", SIMD, TEST, 0 },
+	{ "vcmplt_oqsh", GEN, TEST, 0 },
+	{ "vcmplt_oqss", SIMD, TEST, 0 },
+	{ "vcomisd", SIMD, TEST, 0 },
+	{ "vcomish", GEN, TEST, 0 },
+	{ "vcomiss", SIMD, TEST, 0 },
+	{ "vcompresspd", SIMD, TEST, 0 },
+	{ "vcompressps", SIMD, TEST, 0 },
+	{ "vcvtdq2pd", SIMD, UNK, 0 },
+	{ "vcvtdq2ph", GEN, UNK, 0 },
+	{ "vcvtdq2phx", GEN, UNK, 0 },
+	{ "vcvtdq2phy", GEN, UNK, 0 },
+	{ "vcvtdq2ps", SIMD, UNK, 0 },
+	{ "vcvtne2ps2bf16", SIMD, UNK, 0 },
+	{ "vcvtneebf162ps", SIMD, UNK, 0 },
+	{ "vcvtneeph2ps", SIMD, UNK, 0 },
+	{ "vcvtneobf162ps", SIMD, UNK, 0 },
+	{ "vcvtneoph2ps", SIMD, UNK, 0 },
+	{ "vcvtneps2bf16", SIMD, UNK, 0 },
+	{ "vcvtneps2bf16x", SIMD, UNK, 0 },
+	{ "vcvtneps2bf16y", SIMD, UNK, 0 },
+	{ "vcvtpd2dq", SIMD, UNK, 0 },
+	{ "vcvtpd2dqx", SIMD, UNK, 0 },
+	{ "vcvtpd2dqy", SIMD, UNK, 0 },
+	{ "vcvtpd2ph", SIMD, UNK, 0 },
+	{ "vcvtpd2phx", SIMD, UNK, 0 },
+	{ "vcvtpd2phy", SIMD, UNK, 0 },
+	{ "vcvtpd2phz", SIMD, UNK, 0 },
+	{ "vcvtpd2ps", SIMD, UNK, 0 },
+	{ "vcvtpd2psx", SIMD, UNK, 0 },
+	{ "vcvtpd2psy", SIMD, UNK, 0 },
+	{ "vcvtpd2qq", SIMD, UNK, 0 },
+	{ "vcvtpd2udq", SIMD, UNK, 0 },
+	{ "vcvtpd2udqx", SIMD, UNK, 0 },
+	{ "vcvtpd2udqy", SIMD, UNK, 0 },
+	{ "vcvtpd2uqq", SIMD, UNK, 0 },
+	{ "vcvtph2dq", GEN, UNK, 0 },
+	{ "vcvtph2pd", SIMD, UNK, 0 },
+	{ "vcvtph2ps", SIMD, UNK, 0 },
+	{ "vcvtph2psx", SIMD, UNK, 0 },
+	{ "vcvtph2qq", GEN, UNK, 0 },
+	{ "vcvtph2udq", GEN, UNK, 0 },
+	{ "vcvtph2uqq", GEN, UNK, 0 },
+	{ "vcvtph2uw", GEN, UNK, 0 },
+	{ "vcvtph2w", GEN, UNK, 0 },
+	{ "vcvtps2dq", SIMD, UNK, 0 },
+	{ "vcvtps2pd", SIMD, UNK, 0 },
+	{ "vcvtps2ph", SIMD, UNK, 0 },
+	{ "vcvtps2phx", SIMD, UNK, 0 },
+	{ "vcvtps2phxx", SIMD, UNK, 0 },
+	{ "vcvtps2phxy", SIMD, UNK, 0 },
+	{ "vcvtps2qq", SIMD, UNK, 0 },
+	{ "vcvtps2udq", SIMD, UNK, 0 },
+	{ "vcvtps2uqq", SIMD, UNK, 0 },
+	{ "vcvtqq2pd", SIMD, UNK, 0 },
+	{ "vcvtqq2ph", GEN, UNK, 0 },
+	{ "vcvtqq2phx", GEN, UNK, 0 },
+	{ "vcvtqq2phy", GEN, UNK, 0 },
+	{ "vcvtqq2phz", GEN, UNK, 0 },
+	{ "vcvtqq2ps", SIMD, UNK, 0 },
+	{ "vcvtqq2psx", SIMD, UNK, 0 },
+	{ "vcvtqq2psy", SIMD, UNK, 0 },
+	{ "vcvtsd2sh", SIMD, UNK, 0 },
+	{ "vcvtsd2si", SIMD, UNK, 0 },
+	{ "vcvtsd2ss", SIMD, UNK, 0 },
+	{ "vcvtsd2usi", SIMD, UNK, 0 },
+	{ "vcvtsh2sd", SIMD, UNK, 0 },
+	{ "vcvtsh2si", GEN, UNK, 0 },
+	{ "vcvtsh2ss", SIMD, UNK, 0 },
+	{ "vcvtsh2usi", GEN, UNK, 0 },
+	{ "vcvtsi2sd", SIMD, UNK, 0 },
+	{ "vcvtsi2sdl", SIMD, UNK, 0 },
+	{ "vcvtsi2sdq", SIMD, UNK, 0 },
+	{ "vcvtsi2sh", GEN, UNK, 0 },
+	{ "vcvtsi2shl", GEN, UNK, 0 },
+	{ "vcvtsi2shq", GEN, UNK, 0 },
+	{ "vcvtsi2ss", SIMD, UNK, 0 },
+	{ "vcvtsi2ssl", SIMD, UNK, 0 },
+	{ "vcvtsi2ssq", SIMD, UNK, 0 },
+	{ "vcvtss2sd", SIMD, UNK, 0 },
+	{ "vcvtss2sh", SIMD, UNK, 0 },
+	{ "vcvtss2si", SIMD, UNK, 0 },
+	{ "vcvtss2usi", SIMD, UNK, 0 },
+	{ "vcvttpd2dq", SIMD, UNK, 0 },
+	{ "vcvttpd2dqx", SIMD, UNK, 0 },
+	{ "vcvttpd2dqy", SIMD, UNK, 0 },
+	{ "vcvttpd2qq", SIMD, UNK, 0 },
+	{ "vcvttpd2udq", SIMD, UNK, 0 },
+	{ "vcvttpd2udqx", SIMD, UNK, 0 },
+	{ "vcvttpd2udqy", SIMD, UNK, 0 },
+	{ "vcvttpd2uqq", SIMD, UNK, 0 },
+	{ "vcvttph2dq", GEN, UNK, 0 },
+	{ "vcvttph2qq", GEN, UNK, 0 },
+	{ "vcvttph2udq", GEN, UNK, 0 },
+	{ "vcvttph2uqq", GEN, UNK, 0 },
+	{ "vcvttph2uw", GEN, UNK, 0 },
+	{ "vcvttph2w", GEN, UNK, 0 },
+	{ "vcvttps2dq", SIMD, UNK, 0 },
+	{ "vcvttps2qq", SIMD, UNK, 0 },
+	{ "vcvttps2udq", SIMD, UNK, 0 },
+	{ "vcvttps2uqq", SIMD, UNK, 0 },
+	{ "vcvttsd2si", SIMD, UNK, 0 },
+	{ "vcvttsd2usi", SIMD, UNK, 0 },
+	{ "vcvttsh2si", GEN, UNK, 0 },
+	{ "vcvttsh2usi", GEN, UNK, 0 },
+	{ "vcvttss2si", SIMD, UNK, 0 },
+	{ "vcvttss2usi", SIMD, UNK, 0 },
+	{ "vcvtudq2pd", SIMD, UNK, 0 },
+	{ "vcvtudq2ph", GEN, UNK, 0 },
+	{ "vcvtudq2phx", GEN, UNK, 0 },
+	{ "vcvtudq2phy", GEN, UNK, 0 },
+	{ "vcvtudq2ps", SIMD, UNK, 0 },
+	{ "vcvtuqq2pd", SIMD, UNK, 0 },
+	{ "vcvtuqq2ph", GEN, UNK, 0 },
+	{ "vcvtuqq2phx", GEN, UNK, 0 },
+	{ "vcvtuqq2phy", GEN, UNK, 0 },
+	{ "vcvtuqq2phz", GEN, UNK, 0 },
+	{ "vcvtuqq2ps", SIMD, UNK, 0 },
+	{ "vcvtuqq2psx", SIMD, UNK, 0 },
+	{ "vcvtuqq2psy", SIMD, UNK, 0 },
+	{ "vcvtusi2sd", SIMD, UNK, 0 },
+	{ "vcvtusi2sdl", SIMD, UNK, 0 },
+	{ "vcvtusi2sdq", SIMD, UNK, 0 },
+	{ "vcvtusi2sh", GEN, UNK, 0 },
+	{ "vcvtusi2shl", GEN, UNK, 0 },
+	{ "vcvtusi2shq", GEN, UNK, 0 },
+	{ "vcvtusi2ss", SIMD, UNK, 0 },
+	{ "vcvtusi2ssl", SIMD, UNK, 0 },
+	{ "vcvtusi2ssq", SIMD, UNK, 0 },
+	{ "vcvtuw2ph", GEN, UNK, 0 },
+	{ "vcvtw2ph", GEN, UNK, 0 },
+	{ "vdbpsadbw", SIMD, UNK, 0 },
+	{ "vdivpd", SIMD, MATH, 0 },
+	{ "vdivph", GEN, MATH, 0 },
+	{ "vdivps", SIMD, MATH, 0 },
+	{ "vdivsd", SIMD, MATH, 0 },
+	{ "vdivsh", GEN, MATH, 0 },
+	{ "vdivss", SIMD, MATH, 0 },
+	{ "vdpbf16ps", SIMD, UNK, 0 },
+	{ "vdppd", SIMD, UNK, 0 },
+	{ "vdpps", SIMD, UNK, 0 },
+	{ "verr", GEN, UNK, 0 },
+	{ "verw", GEN, UNK, 0 },
+	{ "vexp2pd", SIMD, UNK, 0 },
+	{ "vexp2ps", SIMD, UNK, 0 },
+	{ "vexpandpd", SIMD, UNK, 0 },
+	{ "vexpandps", SIMD, UNK, 0 },
+	{ "vextractf128", GEN, UNK, 0 },
+	{ "vextractf32x4", GEN, UNK, 0 },
+	{ "vextractf32x8", GEN, UNK, 0 },
+	{ "vextractf64x2", GEN, UNK, 0 },
+	{ "vextractf64x4", GEN, UNK, 0 },
+	{ "vextracti128", GEN, UNK, 0 },
+	{ "vextracti32x4", GEN, UNK, 0 },
+	{ "vextracti32x8", GEN, UNK, 0 },
+	{ "vextracti64x2", GEN, UNK, 0 },
+	{ "vextracti64x4", GEN, UNK, 0 },
+	{ "vextractps", SIMD, UNK, 0 },
+	{ "vfcmaddcph", GEN, MATH, 0 },
+	{ "vfcmaddcsh", GEN, MATH, 0 },
+	{ "vfcmulcph", GEN, MATH, 0 },
+	{ "vfcmulcsh", GEN, MATH, 0 },
+	{ "vfixupimmpd", SIMD, UNK, 0 },
+	{ "vfixupimmps", SIMD, UNK, 0 },
+	{ "vfixupimmsd", SIMD, UNK, 0 },
+	{ "vfixupimmss", SIMD, UNK, 0 },
+	{ "vfmadd132pd", SIMD, MATH, 0 },
+	{ "vfmadd132ph", GEN, MATH, 0 },
+	{ "vfmadd132ps", SIMD, MATH, 0 },
+	{ "vfmadd132sd", SIMD, MATH, 0 },
+	{ "vfmadd132sh", GEN, MATH, 0 },
+	{ "vfmadd132ss", SIMD, MATH, 0 },
+	{ "vfmadd213pd", SIMD, MATH, 0 },
+	{ "vfmadd213ph", GEN, MATH, 0 },
+	{ "vfmadd213ps", SIMD, MATH, 0 },
+	{ "vfmadd213sd", SIMD, MATH, 0 },
+	{ "vfmadd213sh", GEN, MATH, 0 },
+	{ "vfmadd213ss", SIMD, MATH, 0 },
+	{ "vfmadd231pd", SIMD, MATH, 0 },
+	{ "vfmadd231ph", GEN, MATH, 0 },
+	{ "vfmadd231ps", SIMD, MATH, 0 },
+	{ "vfmadd231sd", SIMD, MATH, 0 },
+	{ "vfmadd231sh", GEN, MATH, 0 },
+	{ "vfmadd231ss", SIMD, MATH, 0 },
+	{ "vfmaddcph", GEN, MATH, 0 },
+	{ "vfmaddcsh", GEN, MATH, 0 },
+	{ "vfmaddpd", SIMD, MATH, 0 },
+	{ "vfmaddps", SIMD, MATH, 0 },
+	{ "vfmaddsd", SIMD, MATH, 0 },
+	{ "vfmaddss", SIMD, MATH, 0 },
+	{ "vfmaddsub132pd", SIMD, MATH, 0 },
+	{ "vfmaddsub132ph", GEN, MATH, 0 },
+	{ "vfmaddsub132ps", SIMD, MATH, 0 },
+	{ "vfmaddsub213pd", SIMD, MATH, 0 },
+	{ "vfmaddsub213ph", GEN, MATH, 0 },
+	{ "vfmaddsub213ps", SIMD, MATH, 0 },
+	{ "vfmaddsub231pd", SIMD, MATH, 0 },
+	{ "vfmaddsub231ph", GEN, MATH, 0 },
+	{ "vfmaddsub231ps", SIMD, MATH, 0 },
+	{ "vfmaddsubpd", SIMD, MATH, 0 },
+	{ "vfmaddsubps", SIMD, MATH, 0 },
+	{ "vfmsub132pd", SIMD, MATH, 0 },
+	{ "vfmsub132ph", GEN, MATH, 0 },
+	{ "vfmsub132ps", SIMD, MATH, 0 },
+	{ "vfmsub132sd", SIMD, MATH, 0 },
+	{ "vfmsub132sh", GEN, MATH, 0 },
+	{ "vfmsub132ss", SIMD, MATH, 0 },
+	{ "vfmsub213pd", SIMD, MATH, 0 },
+	{ "vfmsub213ph", GEN, MATH, 0 },
+	{ "vfmsub213ps", SIMD, MATH, 0 },
+	{ "vfmsub213sd", SIMD, MATH, 0 },
+	{ "vfmsub213sh", GEN, MATH, 0 },
+	{ "vfmsub213ss", SIMD, MATH, 0 },
+	{ "vfmsub231pd", SIMD, MATH, 0 },
+	{ "vfmsub231ph", GEN, MATH, 0 },
+	{ "vfmsub231ps", SIMD, MATH, 0 },
+	{ "vfmsub231sd", SIMD, MATH, 0 },
+	{ "vfmsub231sh", GEN, MATH, 0 },
+	{ "vfmsub231ss", SIMD, MATH, 0 },
+	{ "vfmsubadd132pd", SIMD, MATH, 0 },
+	{ "vfmsubadd132ph", GEN, MATH, 0 },
+	{ "vfmsubadd132ps", SIMD, MATH, 0 },
+	{ "vfmsubadd213pd", SIMD, MATH, 0 },
+	{ "vfmsubadd213ph", GEN, MATH, 0 },
+	{ "vfmsubadd213ps", SIMD, MATH, 0 },
+	{ "vfmsubadd231pd", SIMD, MATH, 0 },
+	{ "vfmsubadd231ph", GEN, MATH, 0 },
+	{ "vfmsubadd231ps", SIMD, MATH, 0 },
+	{ "vfmsubaddpd", SIMD, MATH, 0 },
+	{ "vfmsubaddps", SIMD, MATH, 0 },
+	{ "vfmsubpd", SIMD, MATH, 0 },
+	{ "vfmsubps", SIMD, MATH, 0 },
+	{ "vfmsubsd", SIMD, MATH, 0 },
+	{ "vfmsubss", SIMD, MATH, 0 },
+	{ "vfmulcph", GEN, MATH, 0 },
+	{ "vfmulcsh", GEN, MATH, 0 },
+	{ "vfnmadd132pd", SIMD, MATH, 0 },
+	{ "vfnmadd132ph", GEN, MATH, 0 },
+	{ "vfnmadd132ps", SIMD, MATH, 0 },
+	{ "vfnmadd132sd", SIMD, MATH, 0 },
+	{ "vfnmadd132sh", GEN, MATH, 0 },
+	{ "vfnmadd132ss", SIMD, MATH, 0 },
+	{ "vfnmadd213pd", SIMD, MATH, 0 },
+	{ "vfnmadd213ph", GEN, MATH, 0 },
+	{ "vfnmadd213ps", SIMD, MATH, 0 },
+	{ "vfnmadd213sd", SIMD, MATH, 0 },
+	{ "vfnmadd213sh", GEN, MATH, 0 },
+	{ "vfnmadd213ss", SIMD, MATH, 0 },
+	{ "vfnmadd231pd", SIMD, MATH, 0 },
+	{ "vfnmadd231ph", GEN, MATH, 0 },
+	{ "vfnmadd231ps", SIMD, MATH, 0 },
+	{ "vfnmadd231sd", SIMD, MATH, 0 },
+	{ "vfnmadd231sh", GEN, MATH, 0 },
+	{ "vfnmadd231ss", SIMD, MATH, 0 },
+	{ "vfnmaddpd", SIMD, MATH, 0 },
+	{ "vfnmaddps", SIMD, MATH, 0 },
+	{ "vfnmaddsd", SIMD, MATH, 0 },
+	{ "vfnmaddss", SIMD, MATH, 0 },
+	{ "vfnmsub132pd", SIMD, MATH, 0 },
+	{ "vfnmsub132ph", GEN, MATH, 0 },
+	{ "vfnmsub132ps", SIMD, MATH, 0 },
+	{ "vfnmsub132sd", SIMD, MATH, 0 },
+	{ "vfnmsub132sh", GEN, MATH, 0 },
+	{ "vfnmsub132ss", SIMD, MATH, 0 },
+	{ "vfnmsub213pd", SIMD, MATH, 0 },
+	{ "vfnmsub213ph", GEN, MATH, 0 },
+	{ "vfnmsub213ps", SIMD, MATH, 0 },
+	{ "vfnmsub213sd", SIMD, MATH, 0 },
+	{ "vfnmsub213sh", GEN, MATH, 0 },
+	{ "vfnmsub213ss", SIMD, MATH, 0 },
+	{ "vfnmsub231pd", SIMD, MATH, 0 },
+	{ "vfnmsub231ph", GEN, MATH, 0 },
+	{ "vfnmsub231ps", SIMD, MATH, 0 },
+	{ "vfnmsub231sd", SIMD, MATH, 0 },
+	{ "vfnmsub231sh", GEN, MATH, 0 },
+	{ "vfnmsub231ss", SIMD, MATH, 0 },
+	{ "vfnmsubpd", SIMD, MATH, 0 },
+	{ "vfnmsubps", SIMD, MATH, 0 },
+	{ "vfnmsubsd", SIMD, MATH, 0 },
+	{ "vfnmsubss", SIMD, MATH, 0 },
+	{ "vfpclasspd", SIMD, UNK, 0 },
+	{ "vfpclasspdx", SIMD, UNK, 0 },
+	{ "vfpclasspdy", SIMD, UNK, 0 },
+	{ "vfpclasspdz", SIMD, UNK, 0 },
+	{ "vfpclassph", SIMD, UNK, 0 },
+	{ "vfpclassphx", SIMD, UNK, 0 },
+	{ "vfpclassphy", SIMD, UNK, 0 },
+	{ "vfpclassphz", SIMD, UNK, 0 },
+	{ "vfpclassps", SIMD, UNK, 0 },
+	{ "vfpclasspsx", SIMD, UNK, 0 },
+	{ "vfpclasspsy", SIMD, UNK, 0 },
+	{ "vfpclasspsz", SIMD, UNK, 0 },
+	{ "vfpclasssd", SIMD, UNK, 0 },
+	{ "vfpclasssh", SIMD, UNK, 0 },
+	{ "vfpclassss", SIMD, UNK, 0 },
+	{ "vgatherdpd", SIMD, UNK, 0 },
+	{ "vgatherdps", SIMD, UNK, 0 },
+	{ "vgatherpf0dpd", SIMD, UNK, 0 },
+	{ "vgatherpf0dps", SIMD, UNK, 0 },
+	{ "vgatherpf0qpd", SIMD, UNK, 0 },
+	{ "vgatherpf0qps", SIMD, UNK, 0 },
+	{ "vgatherpf1dpd", SIMD, UNK, 0 },
+	{ "vgatherpf1dps", SIMD, UNK, 0 },
+	{ "vgatherpf1qpd", SIMD, UNK, 0 },
+	{ "vgatherpf1qps", SIMD, UNK, 0 },
+	{ "vgatherqpd", SIMD, UNK, 0 },
+	{ "vgatherqps", SIMD, UNK, 0 },
+	{ "vgetexppd", SIMD, UNK, 0 },
+	{ "vgetexpph", GEN, UNK, 0 },
+	{ "vgetexpps", SIMD, UNK, 0 },
+	{ "vgetexpsd", SIMD, UNK, 0 },
+	{ "vgetexpsh", SIMD, UNK, 0 },
+	{ "vgetexpss", SIMD, UNK, 0 },
+	{ "vgetmantpd", SIMD, UNK, 0 },
+	{ "vgetmantph", GEN, UNK, 0 },
+	{ "vgetmantps", SIMD, UNK, 0 },
+	{ "vgetmantsd", SIMD, UNK, 0 },
+	{ "vgetmantsh", GEN, UNK, 0 },
+	{ "vgetmantss", SIMD, UNK, 0 },
+	{ "vgf2p8affineinvqb", GEN, UNK, 0 },
+	{ "vgf2p8affineqb", GEN, UNK, 0 },
+	{ "vgf2p8mulb", GEN, MATH, 0 },
+	{ "vhaddpd", SIMD, MATH, 0 },
+	{ "vhaddps", SIMD, MATH, 0 },
+	{ "vhsubpd", SIMD, MATH, 0 },
+	{ "vhsubps", SIMD, MATH, 0 },
+	{ "vinsertf128", GEN, UNK, 0 },
+	{ "vinsertf32x4", GEN, UNK, 0 },
+	{ "vinsertf32x8", GEN, UNK, 0 },
+	{ "vinsertf64x2", GEN, UNK, 0 },
+	{ "vinsertf64x4", GEN, UNK, 0 },
+	{ "vinserti128", GEN, UNK, 0 },
+	{ "vinserti32x4", GEN, UNK, 0 },
+	{ "vinserti32x8", GEN, UNK, 0 },
+	{ "vinserti64x2", GEN, UNK, 0 },
+	{ "vinserti64x4", GEN, UNK, 0 },
+	{ "vinsertps", SIMD, UNK, 0 },
+	{ "vlddqu", GEN, UNK, 0 },
+	{ "vldmxcsr", GEN, UNK, 0 },
+	{ "vmaskmovdqu", GEN, LOST, 0 },
+	{ "vmaskmovpd", SIMD, LOST, 0 },
+	{ "vmaskmovps", SIMD, LOST, 0 },
+	{ "vmaxpd", SIMD, TEST, 0 },
+	{ "vmaxph", GEN, TEST, 0 },
+	{ "vmaxps", SIMD, TEST, 0 },
+	{ "vmaxsd", SIMD, TEST, 0 },
+	{ "vmaxsh", GEN, TEST, 0 },
+	{ "vmaxss", SIMD, TEST, 0 },
+	{ "vmcall", GEN, UNK, 0 },
+	{ "vmclear", GEN, UNK, 0 },
+	{ "vminpd", SIMD, TEST, 0 },
+	{ "vminph", GEN, TEST, 0 },
+	{ "vminps", SIMD, TEST, 0 },
+	{ "vminsd", SIMD, TEST, 0 },
+	{ "vminsh", GEN, TEST, 0 },
+	{ "vminss", SIMD, TEST, 0 },
+	{ "vmlaunch", GEN, UNK, 0 },
+	{ "vmovapd", SIMD, LOST, 0 },
+	{ "vmovaps", SIMD, LOST, 0 },
+	{ "vmovd", GEN, LOST, 0 },
+	{ "vmovddup", GEN, LOST, 0 },
+	{ "vmovdqa", GEN, LOST, 0 },
+	{ "vmovdqa32", GEN, LOST, 0 },
+	{ "vmovdqa64", GEN, LOST, 0 },
+	{ "vmovdqu", GEN, LOST, 0 },
+	{ "vmovdqu16", GEN, LOST, 0 },
+	{ "vmovdqu32", GEN, LOST, 0 },
+	{ "vmovdqu64", GEN, LOST, 0 },
+	{ "vmovdqu8", GEN, LOST, 0 },
+	{ "vmovhlps", SIMD, LOST, 0 },
+	{ "vmovhpd", SIMD, LOST, 0 },
+	{ "vmovhps", SIMD, LOST, 0 },
+	{ "vmovlhps", SIMD, LOST, 0 },
+	{ "vmovlpd", SIMD, LOST, 0 },
+	{ "vmovlps", SIMD, LOST, 0 },
+	{ "vmovmskpd", SIMD, LOST, 0 },
+	{ "vmovmskps", SIMD, LOST, 0 },
+	{ "vmovntdq", GEN, LOST, 0 },
+	{ "vmovntdqa", GEN, LOST, 0 },
+	{ "vmovntpd", SIMD, LOST, 0 },
+	{ "vmovntps", SIMD, LOST, 0 },
+	{ "vmovq", GEN, LOST, 0 },
+	{ "vmovsd", SIMD, LOST, 0 },
+	{ "vmovsh", GEN, LOST, 0 },
+	{ "vmovshdup", GEN, LOST, 0 },
+	{ "vmovsldup", GEN, LOST, 0 },
+	{ "vmovss", SIMD, LOST, 0 },
+	{ "vmovupd", SIMD, LOST, 0 },
+	{ "vmovups", SIMD, LOST, 0 },
+	{ "vmovw", GEN, LOST, 0 },
+	{ "vmpsadbw", SIMD, UNK, 0 },
+	{ "vmptrld", GEN, UNK, 0 },
+	{ "vmptrst", GEN, UNK, 0 },
+	{ "vmread", GEN, UNK, 0 },
+	{ "vmresume", GEN, UNK, 0 },
+	{ "vmrun", GEN, UNK, 0 },
+	{ "vmulpd", SIMD, MATH, 0 },
+	{ "vmulph", GEN, MATH, 0 },
+	{ "vmulps", SIMD, MATH, 0 },
+	{ "vmulsd", SIMD, MATH, 0 },
+	{ "vmulsh", GEN, MATH, 0 },
+	{ "vmulss", SIMD, MATH, 0 },
+	{ "vmwrite", GEN, UNK, 0 },
+	{ "vmxon", GEN, UNK, 0 },
+	{ "vorpd", SIMD, UNK, 0 },
+	{ "vorps", SIMD, UNK, 0 },
+	{ "vp2intersectd", GEN, UNK, 0 },
+	{ "vp2intersectq", GEN, UNK, 0 },
+	{ "vp4dpwssd", SIMD, UNK, 0 },
+	{ "vp4dpwssds", SIMD, UNK, 0 },
+	{ "vpabsb", GEN, MATH, 0 },
+	{ "vpabsd", SIMD, MATH, 0 },
+	{ "vpabsq", GEN, MATH, 0 },
+	{ "vpabsw", GEN, MATH, 0 },
+	{ "vpackssdw", SIMD, UNK, 0 },
+	{ "vpacksswb", SIMD, UNK, 0 },
+	{ "vpackusdw", SIMD, UNK, 0 },
+	{ "vpackuswb", GEN, UNK, 0 },
+	{ "vpaddb", GEN, MATH, 0 },
+	{ "vpaddd", GEN, MATH, 0 },
+	{ "vpaddq", GEN, MATH, 0 },
+	{ "vpaddsb", GEN, MATH, 0 },
+	{ "vpaddsw", GEN, MATH, 0 },
+	{ "vpaddusb", GEN, MATH, 0 },
+	{ "vpaddusw", GEN, MATH, 0 },
+	{ "vpaddw", GEN, MATH, 0 },
+	{ "vpalignr", GEN, UNK, 0 },
+	{ "vpand", GEN, UNK, 0 },
+	{ "vpandd", GEN, UNK, 0 },
+	{ "vpandn", GEN, UNK, 0 },
+	{ "vpandnd", GEN, UNK, 0 },
+	{ "vpandnq", GEN, UNK, 0 },
+	{ "vpandq", GEN, UNK, 0 },
+	{ "vpavgb", GEN, MATH, 0 },
+	{ "vpavgw", GEN, MATH, 0 },
+	{ "vpblendd", GEN, UNK, 0 },
+	{ "vpblendmb", GEN, UNK, 0 },
+	{ "vpblendmd", GEN, UNK, 0 },
+	{ "vpblendmq", GEN, UNK, 0 },
+	{ "vpblendmw", GEN, UNK, 0 },
+	{ "vpblendvb", GEN, UNK, 0 },
+	{ "vpblendw", GEN, UNK, 0 },
+	{ "vpbroadcastb", GEN, UNK, 0 },
+	{ "vpbroadcastd", GEN, UNK, 0 },
+	{ "vpbroadcastmb2q", GEN, UNK, 0 },
+	{ "vpbroadcastmw2d", GEN, UNK, 0 },
+	{ "vpbroadcastq", GEN, UNK, 0 },
+	{ "vpbroadcastw", GEN, UNK, 0 },
+	{ "vpclmulhqhqdq", GEN, MATH, 0 },
+	{ "vpclmulhqlqdq", GEN, MATH, 0 },
+	{ "vpclmullqhqdq", GEN, MATH, 0 },
+	{ "vpclmullqlqdq", GEN, MATH, 0 },
+	{ "vpcmpb", GEN, TEST, 0 },
+	{ "vpcmpd", SIMD, TEST, 0 },
+	{ "vpcmpeqb", GEN, TEST, 0 },
+	{ "vpcmpeqd", GEN, TEST, 0 },
+	{ "vpcmpeqq", GEN, TEST, 0 },
+	{ "vpcmpequq", GEN, TEST, 0 },
+	{ "vpcmpeqw", GEN, TEST, 0 },
+	{ "vpcmpestri", GEN, TEST, 0 },
+	{ "vpcmpestriq", GEN, TEST, 0 },
+	{ "vpcmpestrm", GEN, TEST, 0 },
+	{ "vpcmpestrmq", GEN, TEST, 0 },
+	{ "vpcmpgtb", GEN, TEST, 0 },
+	{ "vpcmpgtd", GEN, TEST, 0 },
+	{ "vpcmpgtq", GEN, TEST, 0 },
+	{ "vpcmpgtw", GEN, TEST, 0 },
+	{ "vpcmpistri", GEN, TEST, 0 },
+	{ "vpcmpistrm", GEN, TEST, 0 },
+	{ "vpcmpltub", GEN, TEST, 0 },
+	{ "vpcmpltuq", GEN, TEST, 0 },
+	{ "vpcmpneqb", GEN, TEST, 0 },
+	{ "vpcmpneqd", GEN, TEST, 0 },
+	{ "vpcmpnequb", GEN, TEST, 0 },
+	{ "vpcmpq", GEN, TEST, 0 },
+	{ "vpcmpub", GEN, TEST, 0 },
+	{ "vpcmpud", GEN, TEST, 0 },
+	{ "vpcmpuq", GEN, TEST, 0 },
+	{ "vpcmpuw", GEN, TEST, 0 },
+	{ "vpcmpw", GEN, TEST, 0 },
+	{ "vpcompressb", SIMD, TEST, 0 },
+	{ "vpcompressd", SIMD, TEST, 0 },
+	{ "vpcompressq", SIMD, TEST, 0 },
+	{ "vpcompressw", SIMD, TEST, 0 },
+	{ "vpconflictd", GEN, UNK, 0 },
+	{ "vpconflictq", GEN, UNK, 0 },
+	{ "vpdpbssd", SIMD, UNK, 0 },
+	{ "vpdpbssds", SIMD, UNK, 0 },
+	{ "vpdpbsud", SIMD, UNK, 0 },
+	{ "vpdpbsuds", SIMD, UNK, 0 },
+	{ "vpdpbusd", SIMD, UNK, 0 },
+	{ "vpdpbusds", SIMD, UNK, 0 },
+	{ "vpdpbuud", SIMD, UNK, 0 },
+	{ "vpdpbuuds", SIMD, UNK, 0 },
+	{ "vpdpwssd", SIMD, UNK, 0 },
+	{ "vpdpwssds", SIMD, UNK, 0 },
+	{ "vperm2f128", GEN, UNK, 0 },
+	{ "vperm2i128", GEN, UNK, 0 },
+	{ "vpermb", GEN, UNK, 0 },
+	{ "vpermd", GEN, UNK, 0 },
+	{ "vpermi2b", GEN, UNK, 0 },
+	{ "vpermi2d", GEN, UNK, 0 },
+	{ "vpermi2pd", SIMD, UNK, 0 },
+	{ "vpermi2ps", SIMD, UNK, 0 },
+	{ "vpermi2q", GEN, UNK, 0 },
+	{ "vpermi2w", GEN, UNK, 0 },
+	{ "vpermil2pd", SIMD, UNK, 0 },
+	{ "vpermil2ps", SIMD, UNK, 0 },
+	{ "vpermilpd", SIMD, UNK, 0 },
+	{ "vpermilps", SIMD, UNK, 0 },
+	{ "vpermpd", SIMD, UNK, 0 },
+	{ "vpermps", SIMD, UNK, 0 },
+	{ "vpermq", GEN, UNK, 0 },
+	{ "vpermt2b", GEN, UNK, 0 },
+	{ "vpermt2d", GEN, UNK, 0 },
+	{ "vpermt2pd", SIMD, UNK, 0 },
+	{ "vpermt2ps", SIMD, UNK, 0 },
+	{ "vpermt2q", GEN, UNK, 0 },
+	{ "vpermt2w", GEN, UNK, 0 },
+	{ "vpermw", GEN, UNK, 0 },
+	{ "vpexpandb", GEN, UNK, 0 },
+	{ "vpexpandd", GEN, UNK, 0 },
+	{ "vpexpandq", GEN, UNK, 0 },
+	{ "vpexpandw", GEN, UNK, 0 },
+	{ "vpextrb", GEN, UNK, 0 },
+	{ "vpextrd", GEN, UNK, 0 },
+	{ "vpextrq", GEN, UNK, 0 },
+	{ "vpextrw", GEN, UNK, 0 },
+	{ "vpgatherdd", GEN, UNK, 0 },
+	{ "vpgatherdq", GEN, UNK, 0 },
+	{ "vpgatherqd", GEN, UNK, 0 },
+	{ "vpgatherqq", GEN, UNK, 0 },
+	{ "vphaddd", GEN, MATH, 0 },
+	{ "vphaddsw", GEN, MATH, 0 },
+	{ "vphaddw", GEN, MATH, 0 },
+	{ "vphminposuw", GEN, TEST, 0 },
+	{ "vphsubd", GEN, MATH, 0 },
+	{ "vphsubsw", GEN, MATH, 0 },
+	{ "vphsubw", GEN, MATH, 0 },
+	{ "vpinsrb", GEN, UNK, 0 },
+	{ "vpinsrd", GEN, UNK, 0 },
+	{ "vpinsrq", GEN, UNK, 0 },
+	{ "vpinsrw", GEN, UNK, 0 },
+	{ "vplzcntd", GEN, UNK, 0 },
+	{ "vplzcntq", GEN, UNK, 0 },
+	{ "vpmadd52huq", GEN, MATH, 0 },
+	{ "vpmadd52luq", GEN, MATH, 0 },
+	{ "vpmaddubsw", GEN, MATH, 0 },
+	{ "vpmaddwd", GEN, MATH, 0 },
+	{ "vpmaskmovd", GEN, LOST, 0 },
+	{ "vpmaskmovq", GEN, LOST, 0 },
+	{ "vpmaxsb", GEN, TEST, 0 },
+	{ "vpmaxsd", SIMD, TEST, 0 },
+	{ "vpmaxsq", GEN, TEST, 0 },
+	{ "vpmaxsw", GEN, TEST, 0 },
+	{ "vpmaxub", GEN, TEST, 0 },
+	{ "vpmaxud", GEN, TEST, 0 },
+	{ "vpmaxuq", GEN, TEST, 0 },
+	{ "vpmaxuw", GEN, TEST, 0 },
+	{ "vpminsb", GEN, TEST, 0 },
+	{ "vpminsd", SIMD, TEST, 0 },
+	{ "vpminsq", GEN, TEST, 0 },
+	{ "vpminsw", GEN, TEST, 0 },
+	{ "vpminub", GEN, TEST, 0 },
+	{ "vpminud", GEN, TEST, 0 },
+	{ "vpminuq", GEN, TEST, 0 },
+	{ "vpminuw", GEN, TEST, 0 },
+	{ "vpmovb2m", GEN, LOST, 0 },
+	{ "vpmovd2m", GEN, LOST, 0 },
+	{ "vpmovdb", GEN, LOST, 0 },
+	{ "vpmovdw", GEN, LOST, 0 },
+	{ "vpmovm2b", GEN, LOST, 0 },
+	{ "vpmovm2d", GEN, LOST, 0 },
+	{ "vpmovm2q", GEN, LOST, 0 },
+	{ "vpmovm2w", GEN, LOST, 0 },
+	{ "vpmovmskb", GEN, LOST, 0 },
+	{ "vpmovq2m", GEN, LOST, 0 },
+	{ "vpmovqb", GEN, LOST, 0 },
+	{ "vpmovqd", GEN, LOST, 0 },
+	{ "vpmovqw", GEN, LOST, 0 },
+	{ "vpmovsdb", SIMD, LOST, 0 },
+	{ "vpmovsdw", SIMD, LOST, 0 },
+	{ "vpmovsqb", GEN, LOST, 0 },
+	{ "vpmovsqd", GEN, LOST, 0 },
+	{ "vpmovsqw", GEN, LOST, 0 },
+	{ "vpmovswb", GEN, LOST, 0 },
+	{ "vpmovsxbd", GEN, LOST, 0 },
+	{ "vpmovsxbq", GEN, LOST, 0 },
+	{ "vpmovsxbw", GEN, LOST, 0 },
+	{ "vpmovsxdq", GEN, LOST, 0 },
+	{ "vpmovsxwd", GEN, LOST, 0 },
+	{ "vpmovsxwq", GEN, LOST, 0 },
+	{ "vpmovusdb", SIMD, LOST, 0 },
+	{ "vpmovusdw", SIMD, LOST, 0 },
+	{ "vpmovusqb", GEN, LOST, 0 },
+	{ "vpmovusqd", GEN, LOST, 0 },
+	{ "vpmovusqw", GEN, LOST, 0 },
+	{ "vpmovuswb", GEN, LOST, 0 },
+	{ "vpmovw2m", GEN, LOST, 0 },
+	{ "vpmovwb", GEN, LOST, 0 },
+	{ "vpmovzxbd", GEN, LOST, 0 },
+	{ "vpmovzxbq", GEN, LOST, 0 },
+	{ "vpmovzxbw", GEN, LOST, 0 },
+	{ "vpmovzxdq", GEN, LOST, 0 },
+	{ "vpmovzxwd", GEN, LOST, 0 },
+	{ "vpmovzxwq", GEN, LOST, 0 },
+	{ "vpmuldq", GEN, MATH, 0 },
+	{ "vpmulhrsw", GEN, MATH, 0 },
+	{ "vpmulhuw", GEN, MATH, 0 },
+	{ "vpmulhw", GEN, MATH, 0 },
+	{ "vpmulld", GEN, MATH, 0 },
+	{ "vpmullq", GEN, MATH, 0 },
+	{ "vpmullw", GEN, MATH, 0 },
+	{ "vpmultishiftqb", GEN, MATH, 0 },
+	{ "vpmuludq", GEN, MATH, 0 },
+	{ "vpopcntb", GEN, UNK, 0 },
+	{ "vpopcntd", GEN, UNK, 0 },
+	{ "vpopcntq", GEN, UNK, 0 },
+	{ "vpopcntw", GEN, UNK, 0 },
+	{ "vpor", GEN, UNK, 0 },
+	{ "vpord", GEN, UNK, 0 },
+	{ "vporq", GEN, UNK, 0 },
+	{ "vprold", GEN, UNK, 0 },
+	{ "vprolq", GEN, UNK, 0 },
+	{ "vprolvd", GEN, UNK, 0 },
+	{ "vprolvq", GEN, UNK, 0 },
+	{ "vprord", GEN, UNK, 0 },
+	{ "vprorq", GEN, UNK, 0 },
+	{ "vprorvd", GEN, UNK, 0 },
+	{ "vprorvq", GEN, UNK, 0 },
+	{ "vprotd", GEN, UNK, 0 },
+	{ "vprotq", GEN, UNK, 0 },
+	{ "vpsadbw", SIMD, UNK, 0 },
+	{ "vpscatterdd", SIMD, UNK, 0 },
+	{ "vpscatterdq", SIMD, UNK, 0 },
+	{ "vpscatterqd", SIMD, UNK, 0 },
+	{ "vpscatterqq", SIMD, UNK, 0 },
+	{ "vpshldd", SIMD, UNK, 0 },
+	{ "vpshldq", SIMD, UNK, 0 },
+	{ "vpshldvd", SIMD, UNK, 0 },
+	{ "vpshldvq", SIMD, UNK, 0 },
+	{ "vpshldvw", SIMD, UNK, 0 },
+	{ "vpshldw", SIMD, UNK, 0 },
+	{ "vpshrdd", SIMD, UNK, 0 },
+	{ "vpshrdq", SIMD, UNK, 0 },
+	{ "vpshrdvd", SIMD, UNK, 0 },
+	{ "vpshrdvq", SIMD, UNK, 0 },
+	{ "vpshrdvw", SIMD, UNK, 0 },
+	{ "vpshrdw", SIMD, UNK, 0 },
+	{ "vpshufb", SIMD, UNK, 0 },
+	{ "vpshufbitqmb", SIMD, UNK, 0 },
+	{ "vpshufd", SIMD, UNK, 0 },
+	{ "vpshufhw", SIMD, UNK, 0 },
+	{ "vpshuflw", SIMD, UNK, 0 },
+	{ "vpsignb", SIMD, UNK, 0 },
+	{ "vpsignd", SIMD, UNK, 0 },
+	{ "vpsignw", SIMD, UNK, 0 },
+	{ "vpslld", SIMD, UNK, 0 },
+	{ "vpslldq", SIMD, UNK, 0 },
+	{ "vpsllq", SIMD, UNK, 0 },
+	{ "vpsllvd", SIMD, UNK, 0 },
+	{ "vpsllvq", SIMD, UNK, 0 },
+	{ "vpsllvw", SIMD, UNK, 0 },
+	{ "vpsllw", SIMD, UNK, 0 },
+	{ "vpsrad", SIMD, UNK, 0 },
+	{ "vpsraq", SIMD, UNK, 0 },
+	{ "vpsravd", SIMD, UNK, 0 },
+	{ "vpsravq", SIMD, UNK, 0 },
+	{ "vpsravw", SIMD, UNK, 0 },
+	{ "vpsraw", SIMD, UNK, 0 },
+	{ "vpsrld", SIMD, UNK, 0 },
+	{ "vpsrldq", SIMD, UNK, 0 },
+	{ "vpsrlq", SIMD, UNK, 0 },
+	{ "vpsrlvd", SIMD, UNK, 0 },
+	{ "vpsrlvq", SIMD, UNK, 0 },
+	{ "vpsrlvw", SIMD, UNK, 0 },
+	{ "vpsrlw", SIMD, UNK, 0 },
+	{ "vpsubb", SIMD, MATH, 0 },
+	{ "vpsubd", SIMD, MATH, 0 },
+	{ "vpsubq", SIMD, MATH, 0 },
+	{ "vpsubsb", SIMD, MATH, 0 },
+	{ "vpsubsw", SIMD, MATH, 0 },
+	{ "vpsubusb", SIMD, MATH, 0 },
+	{ "vpsubusw", SIMD, MATH, 0 },
+	{ "vpsubw", SIMD, MATH, 0 },
+	{ "vpternlogd", GEN, UNK, 0 },
+	{ "vpternlogq", GEN, UNK, 0 },
+	{ "vptest", GEN, TEST, 0 },
+	{ "vptestmb", GEN, TEST, 0 },
+	{ "vptestmd", GEN, TEST, 0 },
+	{ "vptestmq", GEN, TEST, 0 },
+	{ "vptestmw", GEN, TEST, 0 },
+	{ "vptestnmb", GEN, TEST, 0 },
+	{ "vptestnmd", GEN, TEST, 0 },
+	{ "vptestnmq", GEN, TEST, 0 },
+	{ "vptestnmw", GEN, TEST, 0 },
+	{ "vpunpckhbw", GEN, UNK, 0 },
+	{ "vpunpckhdq", GEN, UNK, 0 },
+	{ "vpunpckhqdq", GEN, UNK, 0 },
+	{ "vpunpckhwd", GEN, UNK, 0 },
+	{ "vpunpcklbw", GEN, UNK, 0 },
+	{ "vpunpckldq", GEN, UNK, 0 },
+	{ "vpunpcklqdq", GEN, UNK, 0 },
+	{ "vpunpcklwd", GEN, UNK, 0 },
+	{ "vpxor", GEN, UNK, 0 },
+	{ "vpxord", GEN, UNK, 0 },
+	{ "vpxorq", GEN, UNK, 0 },
+	{ "vrangepd", SIMD, UNK, 0 },
+	{ "vrangeps", SIMD, UNK, 0 },
+	{ "vrangesd", SIMD, UNK, 0 },
+	{ "vrangess", SIMD, UNK, 0 },
+	{ "vrcp14pd", SIMD, UNK, 0 },
+	{ "vrcp14ps", SIMD, UNK, 0 },
+	{ "vrcp14sd", SIMD, UNK, 0 },
+	{ "vrcp14ss", SIMD, UNK, 0 },
+	{ "vrcp28pd", SIMD, UNK, 0 },
+	{ "vrcp28ps", SIMD, UNK, 0 },
+	{ "vrcp28sd", SIMD, UNK, 0 },
+	{ "vrcp28ss", SIMD, UNK, 0 },
+	{ "vrcpph", GEN, UNK, 0 },
+	{ "vrcpps", SIMD, UNK, 0 },
+	{ "vrcpsh", SIMD, UNK, 0 },
+	{ "vrcpss", SIMD, UNK, 0 },
+	{ "vreducepd", SIMD, UNK, 0 },
+	{ "vreduceph", GEN, UNK, 0 },
+	{ "vreduceps", SIMD, UNK, 0 },
+	{ "vreducesd", SIMD, UNK, 0 },
+	{ "vreducesh", GEN, UNK, 0 },
+	{ "vreducess", SIMD, UNK, 0 },
+	{ "vrndscalepd", SIMD, UNK, 0 },
+	{ "vrndscaleph", GEN, UNK, 0 },
+	{ "vrndscaleps", SIMD, UNK, 0 },
+	{ "vrndscalesd", SIMD, UNK, 0 },
+	{ "vrndscalesh", GEN, UNK, 0 },
+	{ "vrndscaless", SIMD, UNK, 0 },
+	{ "vroundpd", SIMD, UNK, 0 },
+	{ "vroundps", SIMD, UNK, 0 },
+	{ "vroundsd", SIMD, UNK, 0 },
+	{ "vroundss", SIMD, UNK, 0 },
+	{ "vrsqrt14pd", SIMD, MATH, 0 },
+	{ "vrsqrt14ps", SIMD, MATH, 0 },
+	{ "vrsqrt14sd", SIMD, MATH, 0 },
+	{ "vrsqrt14ss", SIMD, MATH, 0 },
+	{ "vrsqrt28pd", SIMD, MATH, 0 },
+	{ "vrsqrt28ps", SIMD, MATH, 0 },
+	{ "vrsqrt28sd", SIMD, MATH, 0 },
+	{ "vrsqrt28ss", SIMD, MATH, 0 },
+	{ "vrsqrtph", GEN, MATH, 0 },
+	{ "vrsqrtps", SIMD, MATH, 0 },
+	{ "vrsqrtsh", GEN, MATH, 0 },
+	{ "vrsqrtss", SIMD, MATH, 0 },
+	{ "vscalefpd", SIMD, UNK, 0 },
+	{ "vscalefph", GEN, UNK, 0 },
+	{ "vscalefps", SIMD, UNK, 0 },
+	{ "vscalefsd", SIMD, UNK, 0 },
+	{ "vscalefsh", GEN, UNK, 0 },
+	{ "vscalefss", SIMD, UNK, 0 },
+	{ "vscatterdpd", SIMD, UNK, 0 },
+	{ "vscatterdps", SIMD, UNK, 0 },
+	{ "vscatterpf0dpd", SIMD, UNK, 0 },
+	{ "vscatterpf0dps", SIMD, UNK, 0 },
+	{ "vscatterpf0qpd", SIMD, UNK, 0 },
+	{ "vscatterpf0qps", SIMD, UNK, 0 },
+	{ "vscatterpf1dpd", SIMD, UNK, 0 },
+	{ "vscatterpf1dps", SIMD, UNK, 0 },
+	{ "vscatterpf1qpd", SIMD, UNK, 0 },
+	{ "vscatterpf1qps", SIMD, UNK, 0 },
+	{ "vscatterqpd", SIMD, UNK, 0 },
+	{ "vscatterqps", SIMD, UNK, 0 },
+	{ "vshuff32x4", GEN, UNK, 0 },
+	{ "vshuff64x2", GEN, UNK, 0 },
+	{ "vshufi32x4", GEN, UNK, 0 },
+	{ "vshufi64x2", GEN, UNK, 0 },
+	{ "vshufpd", SIMD, UNK, 0 },
+	{ "vshufps", SIMD, UNK, 0 },
+	{ "vsqrtpd", SIMD, MATH, 0 },
+	{ "vsqrtph", GEN, MATH, 0 },
+	{ "vsqrtps", SIMD, MATH, 0 },
+	{ "vsqrtsd", SIMD, MATH, 0 },
+	{ "vsqrtsh", GEN, MATH, 0 },
+	{ "vsqrtss", SIMD, MATH, 0 },
+	{ "vstmxcsr", GEN, UNK, 0 },
+	{ "vsubpd", SIMD, MATH, 0 },
+	{ "vsubph", GEN, MATH, 0 },
+	{ "vsubps", SIMD, MATH, 0 },
+	{ "vsubsd", SIMD, MATH, 0 },
+	{ "vsubsh", GEN, MATH, 0 },
+	{ "vsubss", SIMD, MATH, 0 },
+	{ "vtestpd", SIMD, TEST, 0 },
+	{ "vtestps", SIMD, TEST, 0 },
+	{ "vucomisd", SIMD, TEST, 0 },
+	{ "vucomish", GEN, TEST, 0 },
+	{ "vucomiss", SIMD, TEST, 0 },
+	{ "vunpckhpd", SIMD, UNK, 0 },
+	{ "vunpckhps", SIMD, UNK, 0 },
+	{ "vunpcklpd", SIMD, UNK, 0 },
+	{ "vunpcklps", SIMD, UNK, 0 },
+	{ "vxorpd", SIMD, UNK, 0 },
+	{ "vxorps", SIMD, UNK, 0 },
+	{ "vzeroall", GEN, UNK, 0 },
+	{ "vzeroupper", GEN, UNK, 0 },
+	{ "wbinvd", GEN, PRIV, 0 },
+	{ "wbnoinvd", GEN, UNK, 0 },
+	{ "wrfsbase", GEN, UNK, 0 },
+	{ "wrgsbase", GEN, UNK, 0 },
+	{ "wrmsr", GEN, LOST, 0 },
+	{ "wrpkru", GEN, UNK, 0 },
+	{ "wrssd", SIMD, UNK, 0 },
+	{ "wrssq", SIMD, UNK, 0 },
+	{ "wrussd", SIMD, UNK, 0 },
+	{ "xabort", GEN, UNK, 0 },
+	{ "xadd", GEN, MATH, 0 },
+	{ "xbegin", GEN, UNK, 0 },
+	{ "xbegind", GEN, UNK, 0 },
+	{ "xbeginl", GEN, UNK, 0 },
+	{ "xbeginw", GEN, UNK, 0 },
+	{ "xchg", GEN, LOST, 0 },
+	{ "xend", GEN, UNK, 0 },
+	{ "xgetbv", GEN, LOST, 0 },
+	{ "xlat", GEN, UNK, 0 },
+	{ "xor", GEN, BIT, XOR },
+	{ "xorb", GEN, BIT, XOR },
+	{ "xorl", GEN, BIT, XOR },
+	{ "xorpd", SIMD, BIT, XOR },
+	{ "xorps", SIMD, BIT, XOR },
+	{ "xorq", GEN, BIT, XOR },
+	{ "xorw", GEN, BIT, XOR },
+	{ "xrstor", GEN, LOST, 0 },
+	{ "xrstor64", GEN, LOST, 0 },
+	{ "xrstors", GEN, LOST, 0 },
+	{ "xrstors64", GEN, LOST, 0 },
+	{ "xsave", GEN, LOST, 0 },
+	{ "xsave64", GEN, LOST, 0 },
+	{ "xsavec", GEN, LOST, 0 },
+	{ "xsavec64", GEN, LOST, 0 },
+	{ "xsaveopt", GEN, LOST, 0 },
+	{ "xsaveopt64", GEN, LOST, 0 },
+	{ "xsaves", GEN, LOST, 0 },
+	{ "xsaves64", GEN, LOST, 0 },
+	{ "xsetbv", GEN, LOST, 0 },
+	{ "xsha1", GEN, UNK, 0 },
+	{ "xsha256", GEN, UNK, 0 },
+	{ "xsusldtrk", GEN, UNK, 0 },
+	{ "xtest", GEN, TEST, 0 }
+};
+
+#define NUM_MNEMONICS 1904
+#define NUM_BUCKETS 512
+#define NUM_SLOTS 2048
+
+/* displacement for each bucket */
+static const unsigned short bucket_disp[512] = {
+	0, 16, 3, 9, 9, 3, 1, 8, 1, 2, 13, 20,
+	4, 12, 24, 70, 24, 1, 19, 3, 4, 19, 5, 1,
+	1, 3, 5, 4, 3, 0, 18, 4, 7, 11, 14, 8,
+	67, 1, 3, 11, 31, 3, 11, 5, 1, 12, 22, 2,
+	29, 5, 40, 28, 15, 26, 11, 0, 10, 19, 62, 10,
+	8, 3, 33, 1, 8, 4, 1, 10, 54, 2, 3, 2,
+	8, 59, 16, 44, 1, 5, 1, 63, 16, 6, 12, 6,
+	115, 8, 0, 2, 11, 15, 3, 11, 92, 6, 1, 22,
+	3, 43, 15, 9, 200, 6, 27, 51, 2, 14, 16, 11,
+	1, 9, 2, 6, 21, 8, 22, 1, 1, 9, 29, 21,
+	39, 9, 14, 0, 2, 24, 1, 13, 98, 7, 12, 1,
+	39, 1, 32, 25, 3, 88, 18, 45, 14, 17, 9, 4,
+	12, 24, 6, 7, 12, 38, 41, 43, 17, 39, 4, 12,
+	27, 5, 4, 4, 32, 10, 5, 11, 21, 9, 19, 4,
+	62, 9, 0, 10, 1, 13, 46, 4, 1, 57, 4, 1,
+	30, 14, 24, 4, 11, 28, 50, 10, 69, 9, 40, 8,
+	56, 28, 5, 1, 26, 12, 5, 1, 144, 75, 5, 31,
+	2, 3, 5, 31, 10, 29, 33, 9, 80, 0, 19, 28,
+	30, 12, 18, 10, 97, 37, 38, 21, 27, 1, 79, 4,
+	16, 2, 44, 4, 11, 74, 2, 3, 2, 15, 16, 287,
+	46, 35, 4, 22, 102, 138, 49, 5, 4, 15, 78, 4,
+	22, 32, 60, 71, 118, 1, 19, 5, 40, 3, 27, 49,
+	1, 2, 84, 35, 64, 5, 7, 34, 29, 44, 7, 52,
+	1, 3, 1, 3, 92, 19, 19, 41, 13, 10, 11, 6,
+	15, 3, 3, 1, 209, 27, 27, 10, 43, 6, 2, 2,
+	18, 4, 14, 1, 16, 131, 6, 14, 66, 2, 24, 102,
+	14, 89, 4, 5, 17, 77, 50, 34, 47, 14, 8, 5,
+	86, 10, 11, 10, 3, 7, 15, 3, 156, 2, 33, 50,
+	36, 1, 3, 1, 13, 21, 112, 1, 23, 6, 1, 18,
+	13, 5, 50, 77, 3, 9, 30, 31, 32, 17, 38, 15,
+	153, 17, 60, 0, 64, 3, 26, 19, 2, 24, 13, 8,
+	13, 101, 0, 1, 117, 1, 197, 51, 15, 26, 9, 12,
+	34, 26, 43, 16, 2, 235, 45, 103, 4, 40, 21, 43,
+	97, 6, 257, 152, 1, 5, 27, 253, 8, 63, 1, 39,
+	1, 38, 38, 103, 172, 4, 24, 7, 109, 28, 31, 13,
+	34, 113, 35, 50, 0, 47, 35, 1, 2, 84, 47, 22,
+	27, 2, 140, 20, 197, 75, 6, 5, 75, 3, 265, 69,
+	14, 147, 6, 13, 18, 1, 24, 12, 1, 19, 198, 115,
+	3, 280, 32, 469, 6, 24, 7, 236, 34, 23, 30, 14,
+	1, 406, 102, 10, 46, 0, 35, 101, 19, 112, 40, 31,
+	31, 0, 3, 18, 40, 79, 60, 546, 35, 4, 81, 14,
+	81, 20, 180, 8, 27, 11, 5, 46, 1, 38, 46, 1,
+	155, 9, 8, 1, 133, 136, 186, 36
+};
+
+/* index + 1 of the mnemonic in each slot; 0 if the slot is empty */
+static const unsigned short slot_mnemonic[2048] = {
+	760, 101, 1601, 323, 1151, 415, 1326, 397, 1428, 155, 919, 1628,
+	925, 278, 238, 1547, 1675, 0, 1327, 0, 1747, 877, 875, 675,
+	1069, 295, 1360, 1448, 24, 1763, 367, 96, 1681, 1005, 1165, 546,
+	956, 0, 1731, 1207, 1710, 1843, 705, 78, 518, 0, 634, 395,
+	104, 1008, 198, 918, 1527, 494, 1625, 611, 1046, 0, 558, 687,
+	16, 243, 1483, 299, 917, 754, 1573, 422, 1287, 204, 603, 1617,
+	1626, 122, 450, 1365, 127, 1383, 265, 1055, 311, 1203, 0, 1232,
+	640, 0, 1094, 685, 53, 1530, 867, 275, 456, 229, 1899, 1461,
+	403, 1818, 1153, 745, 661, 267, 482, 1177, 437, 882, 446, 293,
+	777, 351, 758, 1655, 826, 771, 1296, 1752, 0, 0, 663, 1783,
+	963, 1707, 1023, 0, 1431, 981, 976, 566, 52, 214, 1596, 1821,
+	385, 1319, 447, 1174, 144, 1525, 1610, 65, 1782, 258, 1400, 935,
+	869, 0, 695, 1254, 1619, 0, 245, 0, 1635, 5, 1690, 166,
+	1549, 1009, 1489, 982, 1495, 173, 812, 451, 1280, 1035, 584, 370,
+	929, 489, 1513, 1499, 1156, 0, 1356, 1347, 1329, 1517, 713, 190,
+	1414, 1579, 1434, 364, 861, 0, 532, 975, 706, 1624, 1556, 289,
+	1426, 341, 390, 0, 591, 1181, 9, 953, 468, 651, 1015, 1879,
+	829, 1736, 1140, 703, 553, 978, 1473, 1013, 984, 993, 1480, 1639,
+	68, 1163, 650, 66, 920, 1337, 1640, 1330, 469, 1503, 1486, 1492,
+	1413, 1227, 1188, 1598, 379, 605, 556, 1353, 85, 263, 1199, 1372,
+	307, 1588, 1300, 835, 782, 1865, 1409, 716, 821, 1041, 1683, 889,
+	1888, 464, 1161, 921, 1348, 1496, 0, 1290, 1728, 864, 1028, 862,
+	1278, 607, 0, 933, 1774, 1656, 276, 1831, 1545, 1691, 1258, 1016,
+	602, 1614, 0, 146, 1867, 177, 273, 922, 780, 1828, 180, 1295,
+	0, 0, 1757, 1288, 720, 210, 528, 1208, 735, 1869, 876, 895,
+	1102, 1603, 224, 1668, 676, 827, 1220, 1487, 1444, 1223, 1644, 1388,
+	381, 871, 1244, 361, 1113, 678, 516, 1441, 1849, 493, 1695, 576,
+	1164, 629, 1003, 478, 88, 0, 49, 1314, 1259, 1705, 434, 74,
+	438, 1309, 1684, 0, 1284, 580, 1130, 338, 1342, 844, 1721, 290,
+	1419, 219, 292, 380, 1235, 1432, 1167, 1727, 1248, 1105, 1719, 1454,
+	223, 0, 1848, 891, 0, 772, 0, 655, 791, 251, 697, 342,
+	641, 424, 100, 1507, 1726, 1559, 683, 1313, 1096, 0, 356, 1170,
+	880, 1776, 413, 747, 793, 1297, 899, 1504, 1410, 1033, 0, 888,
+	839, 410, 1469, 807, 0, 601, 548, 974, 1421, 176, 340, 1043,
+	322, 1051, 1651, 627, 220, 968, 817, 1118, 739, 630, 242, 1778,
+	1609, 1584, 1511, 597, 1098, 593, 1680, 386, 1077, 822, 1583, 112,
+	1060, 213, 1597, 1343, 388, 1895, 0, 105, 1192, 0, 1136, 0,
+	1661, 454, 794, 513, 1435, 113, 737, 1497, 1135, 1029, 996, 237,
+	1241, 201, 18, 305, 1749, 743, 1566, 666, 590, 1616, 884, 1271,
+	1231, 1039, 449, 399, 1299, 1834, 0, 615, 1723, 701, 1524, 1376,
+	1697, 1352, 941, 297, 1797, 1637, 61, 1331, 1796, 1608, 1104, 1482,
+	355, 0, 1101, 335, 1124, 0, 797, 324, 1322, 0, 823, 369,
+	1107, 1453, 0, 802, 1470, 490, 1502, 0, 1805, 893, 1283, 571,
+	389, 1769, 1742, 1735, 1739, 1679, 345, 352, 1166, 866, 1892, 778,
+	609, 282, 1350, 887, 595, 1842, 0, 314, 268, 470, 643, 1189,
+	1145, 873, 1229, 239, 1214, 1289, 923, 1873, 1711, 269, 1466, 1595,
+	1809, 1515, 998, 592, 1447, 0, 1791, 0, 402, 302, 0, 1804,
+	508, 727, 910, 983, 495, 310, 860, 870, 688, 617, 471, 486,
+	501, 120, 804, 460, 1382, 1369, 684, 1709, 467, 412, 431, 368,
+	1564, 749, 1627, 1458, 134, 264, 833, 1103, 1178, 1546, 457, 225,
+	375, 0, 582, 1768, 1738, 818, 1904, 1147, 642, 1004, 233, 1653,
+	952, 616, 1897, 1878, 92, 439, 599, 227, 41, 0, 945, 1366,
+	1781, 1048, 0, 718, 535, 260, 588, 691, 1685, 1658, 132, 842,
+	511, 334, 123, 103, 787, 463, 1766, 1446, 200, 1034, 954, 843,
+	522, 0, 1717, 175, 8, 1850, 911, 1131, 1730, 1509, 1871, 1518,
+	230, 1277, 1349, 831, 502, 350, 1158, 773, 1138, 852, 1406, 1700,
+	789, 554, 989, 971, 1686, 715, 1361, 1870, 1042, 1857, 559, 1076,
+	1321, 1808, 1812, 19, 1552, 1638, 524, 509, 973, 359, 1472, 1456,
+	1, 1565, 1061, 1389, 1234, 1467, 1753, 1501, 1191, 1240, 659, 1086,
+	1833, 1551, 121, 1590, 746, 321, 1116, 90, 946, 1305, 1012, 1751,
+	753, 531, 184, 1129, 1720, 565, 55, 441, 1756, 1142, 1898, 1811,
+	1293, 798, 881, 1484, 472, 1217, 912, 1722, 575, 551, 1893, 417,
+	567, 1430, 671, 992, 378, 0, 465, 1087, 1531, 172, 287, 550,
+	31, 1788, 1793, 914, 0, 436, 0, 60, 1315, 1407, 1201, 649,
+	0, 461, 1672, 1335, 1771, 1268, 985, 1732, 309, 1200, 1172, 1379,
+	1479, 317, 1676, 781, 1620, 1729, 247, 1449, 26, 1099, 475, 1716,
+	0, 1245, 1829, 1813, 1599, 21, 1629, 1062, 373, 610, 1159, 1687,
+	7, 1112, 232, 1270, 1408, 443, 849, 1239, 47, 1018, 1576, 1108,
+	1052, 187, 557, 0, 1089, 1040, 1760, 1512, 538, 1666, 1144, 1091,
+	274, 1604, 0, 740, 1275, 1183, 1618, 401, 1279, 1355, 1615, 226,
+	679, 1847, 185, 372, 505, 1759, 1622, 1054, 633, 1228, 785, 909,
+	937, 1301, 639, 1022, 124, 969, 1370, 383, 619, 329, 667, 784,
+	473, 235, 1154, 1317, 1092, 1216, 1071, 555, 732, 1712, 0, 951,
+	1652, 107, 1560, 149, 846, 854, 1401, 497, 1820, 199, 0, 1242,
+	547, 1030, 426, 1184, 1047, 304, 445, 1704, 712, 768, 1823, 75,
+	1057, 759, 763, 496, 596, 1247, 0, 492, 0, 767, 64, 250,
+	236, 1415, 115, 1835, 561, 1067, 1874, 1024, 262, 0, 0, 344,
+	82, 636, 1420, 0, 1206, 955, 1032, 1471, 0, 564, 1249, 988,
+	1399, 1308, 733, 1761, 815, 1800, 543, 136, 681, 1185, 143, 1281,
+	1514, 1589, 42, 0, 1539, 1839, 1403, 0, 0, 1336, 0, 795,
+	990, 1386, 1779, 15, 967, 1903, 1126, 755, 11, 1538, 847, 1377,
+	167, 809, 1593, 1251, 0, 58, 1613, 1267, 1678, 645, 962, 1646,
+	560, 1291, 98, 850, 179, 254, 1202, 391, 1243, 669, 859, 480,
+	1080, 1648, 1219, 1845, 830, 514, 986, 298, 1253, 50, 1827, 1394,
+	1082, 1477, 69, 215, 44, 878, 940, 1468, 257, 1754, 83, 656,
+	751, 958, 1642, 537, 312, 1633, 40, 904, 0, 903, 0, 979,
+	1173, 1540, 316, 568, 1367, 1346, 1276, 1450, 1323, 670, 271, 1017,
+	1044, 606, 731, 624, 256, 1600, 484, 1671, 690, 28, 625, 161,
+	894, 25, 1737, 704, 462, 119, 1673, 80, 1801, 563, 1891, 1037,
+	1197, 1890, 1900, 504, 1790, 930, 764, 0, 1767, 1586, 1274, 947,
+	279, 1152, 1378, 1889, 652, 533, 613, 331, 116, 1316, 110, 987,
+	906, 1391, 949, 957, 1836, 17, 418, 1500, 1724, 0, 147, 1396,
+	93, 1570, 1312, 0, 1395, 1607, 572, 1882, 1508, 1404, 692, 0,
+	1088, 1363, 1832, 1182, 1427, 477, 1786, 765, 805, 156, 898, 1334,
+	97, 1534, 995, 56, 0, 1198, 1362, 1491, 1522, 506, 0, 0,
+	999, 141, 1209, 308, 1650, 396, 1068, 228, 1303, 1696, 118, 1422,
+	855, 583, 0, 1475, 325, 507, 1555, 333, 170, 1128, 246, 517,
+	326, 387, 194, 824, 542, 879, 1416, 654, 1000, 1481, 1304, 1838,
+	1351, 1689, 1894, 1745, 1260, 1282, 1385, 1285, 680, 1537, 0, 589,
+	549, 382, 1019, 1384, 799, 1529, 788, 79, 927, 1097, 1746, 1567,
+	1246, 762, 1750, 728, 30, 1358, 1452, 1792, 1713, 13, 924, 1109,
+	36, 171, 1765, 1117, 0, 573, 1733, 39, 1237, 1230, 734, 259,
+	1381, 1162, 0, 959, 6, 825, 950, 1332, 756, 1463, 330, 668,
+	479, 255, 183, 169, 775, 1741, 1440, 519, 427, 1143, 1535, 0,
+	766, 1799, 0, 178, 0, 1803, 1611, 459, 1110, 240, 109, 1631,
+	1528, 0, 1176, 1591, 218, 195, 1272, 1261, 1575, 1581, 221, 1810,
+	792, 1493, 1657, 303, 1380, 585, 1662, 1830, 1133, 1075, 365, 231,
+	151, 1114, 1328, 729, 1233, 1257, 665, 874, 1485, 1457, 1498, 1139,
+	1478, 423, 796, 944, 0, 1175, 600, 696, 932, 1398, 160, 354,
+	1157, 0, 648, 689, 520, 1263, 188, 628, 1411, 1594, 301, 1510,
+	1521, 539, 0, 1612, 711, 1459, 907, 91, 1775, 1090, 1886, 393,
+	1344, 1569, 700, 0, 1862, 1049, 1213, 0, 569, 202, 1056, 1814,
+	1070, 970, 722, 1789, 1190, 319, 1445, 1193, 614, 283, 1402, 0,
+	349, 1807, 1460, 291, 622, 362, 1250, 315, 420, 1474, 1010, 318,
+	1853, 0, 1557, 0, 0, 1115, 45, 476, 0, 1665, 71, 1226,
+	1132, 1084, 148, 216, 536, 12, 1265, 621, 73, 730, 1221, 994,
+	872, 400, 965, 1520, 1885, 129, 1106, 481, 1663, 660, 578, 515,
+	939, 0, 890, 845, 150, 343, 936, 10, 404, 972, 34, 1194,
+	1186, 708, 1273, 1464, 280, 406, 498, 0, 1824, 357, 1340, 1364,
+	288, 128, 1669, 902, 694, 212, 0, 814, 618, 1095, 1674, 1568,
+	0, 0, 1433, 1694, 1205, 1605, 1373, 193, 1505, 1543, 29, 1027,
+	281, 757, 1872, 1073, 1490, 770, 1855, 1122, 0, 1397, 1794, 1455,
+	1852, 253, 1093, 1064, 1770, 752, 1815, 0, 769, 249, 0, 189,
+	915, 1187, 828, 1412, 174, 738, 377, 1532, 620, 1578, 1519, 776,
+	1238, 1100, 181, 892, 1755, 662, 1021, 810, 1002, 1887, 1703, 1773,
+	425, 1844, 587, 1692, 741, 819, 863, 133, 57, 14, 1025, 1081,
+	808, 961, 1901, 207, 1714, 552, 1141, 336, 153, 1725, 503, 1641,
+	699, 1083, 0, 168, 800, 1706, 430, 197, 1780, 1001, 1858, 816,
+	1868, 86, 51, 801, 453, 631, 0, 1602, 1125, 152, 1127, 0,
+	442, 1816, 1160, 926, 455, 1806, 865, 626, 1465, 407, 59, 526,
+	1063, 0, 744, 130, 1856, 0, 1701, 1715, 1307, 466, 347, 1074,
+	709, 192, 1837, 448, 1264, 1688, 1526, 1606, 313, 0, 1053, 748,
+	717, 1743, 674, 1718, 440, 208, 966, 848, 1667, 1387, 108, 20,
+	1072, 813, 1224, 1392, 138, 284, 394, 1506, 853, 834, 186, 488,
+	429, 1851, 1065, 414, 1542, 23, 135, 0, 1802, 67, 2, 0,
+	384, 337, 977, 0, 54, 272, 0, 409, 1171, 997, 1149, 635,
+	0, 117, 570, 0, 896, 1341, 527, 1863, 1632, 646, 1310, 594,
+	241, 1007, 710, 1762, 1292, 444, 1210, 346, 0, 1580, 435, 1698,
+	1693, 742, 858, 638, 165, 803, 521, 1902, 761, 1875, 419, 1670,
+	1876, 63, 1437, 1020, 102, 191, 300, 0, 1339, 114, 719, 790,
+	1764, 1880, 1211, 95, 408, 252, 856, 693, 1252, 332, 820, 1659,
+	1451, 205, 203, 1320, 48, 991, 980, 0, 0, 604, 0, 421,
+	1169, 942, 811, 217, 750, 1592, 360, 94, 376, 1563, 0, 1294,
+	366, 4, 1544, 908, 1623, 530, 714, 261, 1123, 1677, 139, 1150,
+	1572, 612, 608, 1784, 296, 46, 1649, 1204, 1066, 1516, 1826, 266,
+	0, 905, 433, 1255, 432, 209, 1772, 1744, 682, 320, 1841, 726,
+	1425, 99, 1014, 938, 126, 76, 545, 0, 1533, 960, 1494, 541,
+	698, 1375, 1119, 1286, 43, 779, 0, 1050, 1045, 883, 1866, 27,
+	897, 868, 1442, 1371, 81, 0, 1225, 686, 1196, 0, 1439, 886,
+	658, 1180, 0, 653, 1302, 806, 1418, 106, 339, 1338, 1883, 0,
+	0, 1634, 182, 1647, 1179, 931, 841, 1059, 491, 1795, 1523, 736,
+	1318, 1553, 234, 37, 277, 723, 363, 162, 702, 1374, 1854, 1269,
+	916, 327, 1896, 211, 1702, 783, 1390, 1817, 1536, 1393, 411, 1345,
+	1562, 1819, 158, 673, 196, 405, 1137, 1777, 529, 1488, 1860, 534,
+	244, 328, 1298, 1031, 0, 840, 157, 487, 1660, 1026, 164, 89,
+	1058, 1577, 1121, 523, 77, 598, 838, 3, 159, 1541, 637, 1215,
+	786, 1621, 206, 72, 294, 87, 0, 725, 1548, 1574, 1443, 644,
+	1155, 0, 1424, 163, 934, 353, 0, 131, 452, 0, 306, 348,
+	1682, 286, 1758, 540, 913, 964, 885, 0, 1311, 1884, 623, 1078,
+	1859, 137, 632, 1436, 1864, 0, 586, 1438, 1168, 22, 1429, 1708,
+	1195, 1587, 943, 248, 1266, 0, 1877, 62, 1846, 1561, 1325, 0,
+	474, 142, 1079, 84, 270, 371, 1636, 677, 574, 1236, 1582, 222,
+	851, 579, 1417, 837, 1571, 1798, 1748, 647, 1554, 0, 32, 512,
+	510, 0, 581, 1881, 125, 374, 1218, 1462, 544, 0, 832, 1654,
+	1664, 1359, 1006, 900, 657, 1354, 1333, 1111, 1550, 948, 1146, 1476,
+	1558, 416, 774, 0, 525, 1585, 458, 1822, 1423, 428, 1405, 1785,
+	154, 1734, 1643, 707, 836, 672, 562, 664, 1699, 485, 1840, 1085,
+	1011, 928, 1306, 857, 0, 1787, 1120, 1134, 70, 140, 392, 111,
+	1825, 145, 901, 500, 1038, 1368, 1148, 0, 1630, 33, 0, 499,
+	1262, 1645, 35, 398, 1036, 1256, 577, 0, 1861, 38, 483, 285,
+	1740, 1222, 1212, 724, 721, 1357, 1324, 358
+};
+
+/* ---------------------------------------------------------------------- */
+/* Perfect hash */
+
+/* Hash-and-displace: the first hash selects a bucket, and the displacement
+ * of the bucket combines the two hashes into a slot. The displacements were
+ * chosen so that no two mnemonics share a slot. */
+void LIBCALL opdis_x86_name_hash( const char * name, size_t len,
+				  unsigned int * h1, unsigned int * h2 ) {
+	unsigned int a = 2166136261U, b = 5381;
+	const unsigned char * c = (const unsigned char *) name;
+	size_t i;
+
+	for ( i = 0; i < len; i++ ) {
+		a = (a ^ c[i]) * 16777619U;
+		b = (b * 33) ^ c[i];
+	}
+
+	*h1 = a;
+	*h2 = b | 1;
+}
+
+const opdis_x86_mnemonic_t * LIBCALL opdis_x86_mnemonic_lookup(
+							const char * mnem ) {
+	unsigned int h1, h2, slot, idx;
+
+	if (! mnem ) {
+		return NULL;
+	}
+
+	opdis_x86_name_hash( mnem, strlen( mnem ), &h1, &h2 );
+	slot = (h1 + bucket_disp[h1 % NUM_BUCKETS] * h2) % NUM_SLOTS;
+	idx = slot_mnemonic[slot];
+
+	if (! idx || strcmp( mnemonics[idx - 1].name, mnem ) ) {
+		return NULL;
+	}
+
+	return &mnemonics[idx - 1];
+}
+
+int LIBCALL opdis_x86_mnemonic_classify( opdis_insn_t * insn,
+					 const char * mnem ) {
+	const opdis_x86_mnemonic_t * m = opdis_x86_mnemonic_lookup( mnem );
+
+	if (! m || ! insn ) {
+		return 0;
+	}
+
+	insn->isa = (enum opdis_insn_subset_t) m->isa;
+	if ( m->category == opdis_insn_cat_unknown ) {
+		return 1;
+	}
+
+	insn->category = (enum opdis_insn_cat_t) m->category;
+	switch ( insn->category ) {
+		case opdis_insn_cat_cflow:
+			insn->flags.cflow = (enum opdis_cflow_flag_t) m->flags;
+			break;
+		case opdis_insn_cat_stack:
+			insn->flags.stack = (enum opdis_stack_flag_t) m->flags;
+			break;
+		case opdis_insn_cat_bit:
+			insn->flags.bit = (enum opdis_bit_flag_t) m->flags;
+			break;
+		case opdis_insn_cat_io:
+			insn->flags.io = (enum opdis_io_flag_t) m->flags;
+			break;
+		default: break;
+	}
+
+	return 1;
+}
@@ -0,0 +1,87 @@
+/*!
+ * \file x86_mnemonic.h
+ * \brief Table of x86 mnemonics and their classification.
+ * \details This defines the table used by the x86 decoders to look up the
+ *          ISA subset, category and flags of an instruction from its
+ *          mnemonic. The table is indexed by a perfect hash of the full
+ *          mnemonic, so classification is a single lookup.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#ifndef OPDIS_X86_MNEMONIC_H
+#define OPDIS_X86_MNEMONIC_H
+
+#include <opdis/model.h>
+
+#ifdef WIN32
+        #define LIBCALL _stdcall
+#else
+        #define LIBCALL
+#endif
+
+/*! \struct opdis_x86_mnemonic_t
+ *  \ingroup internal
+ *  \brief The classification of a single mnemonic.
+ *  \details \e flags is an opdis_cflow_flag_t, opdis_stack_flag_t,
+ *           opdis_bit_flag_t or opdis_io_flag_t depending on \e category.
+ */
+typedef struct {
+	const char * name;		/*!< Mnemonic (key) */
+	unsigned char isa;		/*!< opdis_insn_subset_t */
+	unsigned char category;		/*!< opdis_insn_cat_t */
+	unsigned short flags;		/*!< Category-specific flags */
+} opdis_x86_mnemonic_t;
+
+/* ---------------------------------------------------------------------- */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*!
+ * \fn void opdis_x86_name_hash( const char *, size_t, unsigned int *,
+ * 				unsigned int * )
+ * \ingroup internal
+ * \brief Compute the two hashes of a name used by the x86 perfect hashes.
+ * \details The mnemonic table and the register table of the x86 decoder
+ *          are both indexed with these hashes; their displacement tables
+ *          are generated by util/x86_hash.py, which must use the same hash.
+ * \param name The name. It need not be NUL-terminated.
+ * \param len The number of characters in \e name.
+ * \param h1 The first hash, which selects a bucket.
+ * \param h2 The second hash, which is scaled by the bucket displacement.
+ */
+void LIBCALL opdis_x86_name_hash( const char * name, size_t len,
+				  unsigned int * h1, unsigned int * h2 );
+
+/*!
+ * \fn const opdis_x86_mnemonic_t * opdis_x86_mnemonic_lookup( const char * )
+ * \ingroup internal
+ * \brief Look up the classification of an x86 mnemonic.
+ * \details The table contains every mnemonic emitted by libopcodes in both
+ *          AT&T and Intel syntax.
+ * \param mnem The mnemonic, without prefixes or operands.
+ * \return The table entry for \e mnem, or NULL if it is not in the table.
+ */
+const opdis_x86_mnemonic_t * LIBCALL opdis_x86_mnemonic_lookup(
+							const char * mnem );
+
+/*!
+ * \fn int opdis_x86_mnemonic_classify( opdis_insn_t *, const char * )
+ * \ingroup internal
+ * \brief Set the ISA subset, category and flags of an instruction.
+ * \param insn The instruction to classify.
+ * \param mnem The mnemonic, without prefixes or operands.
+ * \return 1 if \e mnem is in the table, 0 if the instruction was not changed.
+ */
+int LIBCALL opdis_x86_mnemonic_classify( opdis_insn_t * insn,
+					 const char * mnem );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
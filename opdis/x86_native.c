@@ -0,0 +1,1159 @@
+/*!
+ * \file x86_native.c
+ * \brief x86 and x86-64 decoder which works directly from instruction bytes
+ * \details This builds an opdis_insn_t from the bytes of an instruction
+ *          without invoking libopcodes. Only the general-purpose integer
+ *          instructions that make up most compiled code are decoded:
+ *          ALU and MOV forms, LEA, PUSH/POP, shifts, MUL/DIV, Jcc, CALL,
+ *          JMP, RET, SETcc, CMOVcc, MOVZX/MOVSX and a handful of
+ *          no-operand instructions. The ASCII form of the instruction is
+ *          rendered from the decoded fields in the format used by
+ *          libopcodes (binutils 2.40). Anything else, including 16-bit
+ *          code and most prefix combinations, yields 0 so that the caller
+ *          can fall back to libopcodes.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <opdis/x86_decoder.h>
+#include <opdis/x86_mnemonic.h>
+
+#define MAX_INSN_LEN	15
+#define MAX_OPS		3
+#define MAX_OP_STR	64
+#define MAX_MNEM_STR	16
+
+/* operand kinds; operands are listed in Intel order */
+enum NATIVE_KIND {
+	K_NONE,
+	K_E,		/* ModRM r/m: register or memory */
+	K_M,		/* ModRM r/m: memory only, unsized (LEA) */
+	K_G,		/* ModRM reg */
+	K_Z,		/* register in the low 3 bits of the opcode */
+	K_ACC,		/* AL, AX, EAX or RAX */
+	K_CL,		/* CL as a shift count */
+	K_ONE,		/* implicit shift count of 1 */
+	K_I,		/* immediate: imm8 if size is 1, else imm16/32 */
+	K_IB,		/* imm8 sign-extended to the operand size */
+	K_IW,		/* imm16 (RET) */
+	K_IV,		/* immediate of the full operand size (MOV r, imm) */
+	K_J		/* relative branch target */
+};
+
+/* operand size code: 0 is the operand size of the instruction */
+#define SZ_V	0
+
+struct NATIVE_SPEC {
+	unsigned char kind;
+	unsigned char size;
+};
+
+/* instruction flags */
+#define F_SUFFIX	1	/* AT&T: size suffix unless a register sets it */
+#define F_LOCK		2	/* LOCK is allowed with a memory operand */
+#define F_INDIRECT	4	/* K_E operand is an indirect branch target */
+#define F_STACK		8	/* operand size is 64 bits in long mode */
+
+struct NATIVE_INSN {
+	char name[MAX_MNEM_STR];	/* Intel mnemonic */
+	char att_name[MAX_MNEM_STR];	/* AT&T mnemonic, if different */
+	struct NATIVE_SPEC ops[MAX_OPS];
+	unsigned int num_ops;
+	unsigned int flags;
+	int modrm;			/* ModRM byte follows the opcode */
+};
+
+struct NATIVE_STATE {
+	const opdis_byte_t * buf;
+	opdis_off_t len;
+	opdis_off_t pos;
+	enum opdis_x86_mode_t mode;
+	unsigned int opsize;		/* 2, 4 or 8 */
+	int p66, lock, rex, rex_w, rex_r, rex_x, rex_b;
+	int seg;			/* 0, or the id of FS or GS */
+	opdis_byte_t opcode;		/* low 3 bits select K_Z register */
+	/* ModRM */
+	int mod, reg, rm;
+	int base, index, scale;		/* -1 if absent */
+	int rip;			/* RIP-relative */
+	int has_disp;
+	int64_t disp;
+	uint64_t imm;
+	int imm_size;
+	/* prefix bits that affected decoding; libopcodes prints the others
+	 * (e.g. "rex.W", "data16") as separate prefixes */
+	int used_v, used_r, used_x, used_b, used_rex8;
+};
+
+/* ---------------------------------------------------------------------- */
+/* Registers */
+
+static const char * reg8_names[16] = {
+	"al", "cl", "dl", "bl", "spl", "bpl", "sil", "dil",
+	"r8b", "r9b", "r10b", "r11b", "r12b", "r13b", "r14b", "r15b"
+};
+static const char * reg8_legacy_names[8] = {
+	"al", "cl", "dl", "bl", "ah", "ch", "dh", "bh"
+};
+static const char * reg16_names[16] = {
+	"ax", "cx", "dx", "bx", "sp", "bp", "si", "di",
+	"r8w", "r9w", "r10w", "r11w", "r12w", "r13w", "r14w", "r15w"
+};
+static const char * reg32_names[16] = {
+	"eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi",
+	"r8d", "r9d", "r10d", "r11d", "r12d", "r13d", "r14d", "r15d"
+};
+static const char * reg64_names[16] = {
+	"rax", "rcx", "rdx", "rbx", "rsp", "rbp", "rsi", "rdi",
+	"r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15"
+};
+
+/* register ids match those used by the libopcodes-based decoders */
+#define REG_ID_FS	53
+#define REG_ID_GS	54
+#define REG_ID_PC	55
+
+static void set_register( opdis_reg_t * reg, const char * name,
+			  unsigned char id, unsigned char size,
+			  enum opdis_reg_flag_t flags ) {
+	strncpy( reg->ascii, name, OPDIS_REG_NAME_SZ - 1 );
+	reg->ascii[OPDIS_REG_NAME_SZ - 1] = '\0';
+	reg->id = id;
+	reg->size = size;
+	reg->flags = flags;
+}
+
+static void gp_register( opdis_reg_t * reg, int num, unsigned int size,
+			 int rex ) {
+	enum opdis_reg_flag_t flags = opdis_reg_flag_gen;
+	const char * name;
+	int id = num;
+
+	switch ( size ) {
+		case 1:
+			if (! rex && num >= 4 ) {
+				/* AH, CH, DH, BH */
+				name = reg8_legacy_names[num];
+				id = num - 4;
+			} else {
+				name = reg8_names[num];
+			}
+			break;
+		case 2: name = reg16_names[num]; break;
+		case 4: name = reg32_names[num]; break;
+		default: name = reg64_names[num]; break;
+	}
+
+	if ( id == 4 ) {
+		flags |= opdis_reg_flag_stack;
+	} else if ( id == 5 ) {
+		flags |= opdis_reg_flag_frame;
+	}
+
+	set_register( reg, name, (unsigned char) (id + 1),
+		      (unsigned char) size, flags );
+}
+
+static void seg_register( opdis_reg_t * reg, int id ) {
+	set_register( reg, ( id == REG_ID_FS ) ? "fs" : "gs",
+		      (unsigned char) id, 2,
+		      opdis_reg_flag_gen | opdis_reg_flag_seg );
+}
+
+/* ---------------------------------------------------------------------- */
+/* Bytes */
+
+static int fetch( struct NATIVE_STATE * s, unsigned int n, uint64_t * val ) {
+	unsigned int i;
+
+	if ( s->pos + n > s->len || s->pos + n > MAX_INSN_LEN ) {
+		return 0;
+	}
+
+	*val = 0;
+	for ( i = 0; i < n; i++ ) {
+		*val |= ((uint64_t) s->buf[s->pos + i]) << (8 * i);
+	}
+	s->pos += n;
+
+	return 1;
+}
+
+static int64_t sign_extend( uint64_t val, unsigned int size ) {
+	unsigned int bits = size * 8;
+
+	if ( bits >= 64 ) {
+		return (int64_t) val;
+	}
+	if ( val & ((uint64_t) 1 << (bits - 1)) ) {
+		val |= ~(uint64_t) 0 << bits;
+	}
+	return (int64_t) val;
+}
+
+static uint64_t size_mask( uint64_t val, unsigned int size ) {
+	return ( size >= 8 ) ? val : val & (((uint64_t) 1 << (size * 8)) - 1);
+}
+
+static int decode_modrm( struct NATIVE_STATE * s ) {
+	uint64_t b, v;
+
+	if (! fetch( s, 1, &b ) ) {
+		return 0;
+	}
+
+	s->mod = (int) (b >> 6);
+	s->reg = (int) ((b >> 3) & 7) | (s->rex_r << 3);
+	s->rm = (int) (b & 7);
+	s->base = s->index = -1;
+	s->scale = 1;
+
+	if ( s->mod == 3 ) {
+		s->rm |= s->rex_b << 3;
+		s->used_b = 1;
+		return 1;
+	}
+
+	if ( s->rm == 4 ) {
+		int base, index;
+
+		if (! fetch( s, 1, &b ) ) {
+			return 0;
+		}
+		s->scale = 1 << (b >> 6);
+		index = (int) ((b >> 3) & 7) | (s->rex_x << 3);
+		base = (int) (b & 7);
+
+		if ( index != 4 ) {
+			s->index = index;
+			s->used_x = 1;
+		}
+		if ( base == 5 && s->mod == 0 ) {
+			s->has_disp = 4;
+		} else {
+			s->base = base | (s->rex_b << 3);
+			s->used_b = 1;
+		}
+
+		/* libopcodes prints %eiz/%riz for other SIB bytes without
+		 * an index: only (%esp) and (%r12) forms are decoded */
+		if ( s->index < 0 &&
+		     ( s->base < 0 || (s->base & 7) != 4 || s->scale != 1 ) ) {
+			return 0;
+		}
+	} else if ( s->rm == 5 && s->mod == 0 ) {
+		s->has_disp = 4;
+		s->rip = ( s->mode == opdis_x86_mode_64 );
+	} else {
+		s->base = s->rm | (s->rex_b << 3);
+		s->used_b = 1;
+	}
+
+	if ( s->mod == 1 ) {
+		s->has_disp = 1;
+	} else if ( s->mod == 2 ) {
+		s->has_disp = 4;
+	}
+
+	if ( s->has_disp ) {
+		if (! fetch( s, s->has_disp, &v ) ) {
+			return 0;
+		}
+		s->disp = sign_extend( v, s->has_disp );
+	}
+
+	/* absolute addresses above 2GB are sign-extended in long mode */
+	if ( s->mode == opdis_x86_mode_64 && s->base < 0 && s->index < 0 &&
+	     ! s->rip && s->disp < 0 ) {
+		return 0;
+	}
+
+	return 1;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Opcodes */
+
+static const char * alu_names[8] = {
+	"add", "or", "adc", "sbb", "and", "sub", "xor", "cmp"
+};
+static const char * shift_names[8] = {
+	"rol", "ror", "rcl", "rcr", "shl", "shr", NULL, "sar"
+};
+static const char * grp3_names[8] = {
+	"test", NULL, "not", "neg", "mul", "imul", "div", "idiv"
+};
+static const char * cc_names[16] = {
+	"o", "no", "b", "ae", "e", "ne", "be", "a",
+	"s", "ns", "p", "np", "l", "ge", "le", "g"
+};
+
+static void set_ops( struct NATIVE_INSN * n, unsigned int num,
+		     unsigned char k1, unsigned char s1,
+		     unsigned char k2, unsigned char s2,
+		     unsigned char k3, unsigned char s3 ) {
+	n->num_ops = num;
+	n->ops[0].kind = k1; n->ops[0].size = s1;
+	n->ops[1].kind = k2; n->ops[1].size = s2;
+	n->ops[2].kind = k3; n->ops[2].size = s3;
+}
+
+#define OPS0(n)			set_ops( n, 0, 0, 0, 0, 0, 0, 0 )
+#define OPS1(n,k,s)		set_ops( n, 1, k, s, 0, 0, 0, 0 )
+#define OPS2(n,k1,s1,k2,s2)	set_ops( n, 2, k1, s1, k2, s2, 0, 0 )
+
+static void set_name( struct NATIVE_INSN * n, const char * prefix,
+		      const char * suffix ) {
+	snprintf( n->name, MAX_MNEM_STR, "%s%s", prefix, suffix );
+}
+
+/* peek at the reg field of the ModRM byte which follows the opcode */
+static int peek_reg( struct NATIVE_STATE * s ) {
+	if ( s->pos >= s->len ) {
+		return -1;
+	}
+	return (s->buf[s->pos] >> 3) & 7;
+}
+
+static int decode_0f( struct NATIVE_STATE * s, struct NATIVE_INSN * n ) {
+	uint64_t b;
+
+	if (! fetch( s, 1, &b ) ) {
+		return 0;
+	}
+	s->opcode = (opdis_byte_t) b;
+
+	switch ( b ) {
+		case 0x05: set_name( n, "syscall", "" ); OPS0( n ); return 1;
+		case 0x0B: set_name( n, "ud2", "" ); OPS0( n ); return 1;
+		case 0xA2: set_name( n, "cpuid", "" ); OPS0( n ); return 1;
+		case 0x1F:
+			if ( peek_reg( s ) != 0 ) {
+				return 0;
+			}
+			set_name( n, "nop", "" );
+			OPS1( n, K_E, SZ_V );
+			n->flags = F_SUFFIX;
+			n->modrm = 1;
+			return 1;
+		case 0xAF:
+			set_name( n, "imul", "" );
+			OPS2( n, K_G, SZ_V, K_E, SZ_V );
+			n->modrm = 1;
+			return 1;
+		case 0xB6: case 0xB7: case 0xBE: case 0xBF: {
+			unsigned int src = ( b & 1 ) ? 2 : 1;
+			const char * dst = ( s->opsize == 8 ) ? "q" :
+					   ( s->opsize == 4 ) ? "l" : "w";
+			int zx = ( b < 0xB8 );
+
+			if ( s->p66 && src == 2 ) {
+				return 0;
+			}
+			set_name( n, zx ? "movzx" : "movsx", "" );
+			snprintf( n->att_name, MAX_MNEM_STR, "%s%s%s",
+				  zx ? "movz" : "movs",
+				  ( src == 1 ) ? "b" : "w", dst );
+			OPS2( n, K_G, SZ_V, K_E, (unsigned char) src );
+			n->modrm = 1;
+			return 1;
+		}
+	}
+
+	if ( b >= 0x40 && b <= 0x4F ) {
+		set_name( n, "cmov", cc_names[b & 0x0F] );
+		OPS2( n, K_G, SZ_V, K_E, SZ_V );
+		n->modrm = 1;
+		return 1;
+	}
+	if ( b >= 0x80 && b <= 0x8F && ! s->p66 ) {
+		set_name( n, "j", cc_names[b & 0x0F] );
+		OPS1( n, K_J, 4 );
+		return 1;
+	}
+	if ( b >= 0x90 && b <= 0x9F ) {
+		set_name( n, "set", cc_names[b & 0x0F] );
+		OPS1( n, K_E, 1 );
+		n->modrm = 1;
+		return 1;
+	}
+
+	return 0;
+}
+
+static int decode_opcode( struct NATIVE_STATE * s, struct NATIVE_INSN * n ) {
+	uint64_t b;
+	int reg;
+
+	if (! fetch( s, 1, &b ) ) {
+		return 0;
+	}
+	s->opcode = (opdis_byte_t) b;
+
+	if ( b < 0x40 && (b & 7) < 6 ) {
+		/* ALU: add, or, adc, sbb, and, sub, xor, cmp */
+		set_name( n, alu_names[b >> 3], "" );
+		switch ( b & 7 ) {
+			case 0: OPS2( n, K_E, 1, K_G, 1 ); break;
+			case 1: OPS2( n, K_E, SZ_V, K_G, SZ_V ); break;
+			case 2: OPS2( n, K_G, 1, K_E, 1 ); break;
+			case 3: OPS2( n, K_G, SZ_V, K_E, SZ_V ); break;
+			case 4: OPS2( n, K_ACC, 1, K_I, 1 ); break;
+			case 5: OPS2( n, K_ACC, SZ_V, K_I, SZ_V ); break;
+		}
+		n->modrm = ( (b & 7) < 4 );
+		if ( (b & 7) < 2 && (b >> 3) != 7 ) {
+			n->flags = F_LOCK;
+		}
+		return 1;
+	}
+
+	if ( b >= 0x40 && b <= 0x4F ) {
+		/* REX prefixes in long mode */
+		set_name( n, ( b < 0x48 ) ? "inc" : "dec", "" );
+		OPS1( n, K_Z, SZ_V );
+		return 1;
+	}
+	if ( b >= 0x50 && b <= 0x5F ) {
+		if ( s->rex_w ) {
+			return 0;
+		}
+		set_name( n, ( b < 0x58 ) ? "push" : "pop", "" );
+		OPS1( n, K_Z, SZ_V );
+		n->flags = F_STACK;
+		return 1;
+	}
+	if ( b >= 0x70 && b <= 0x7F && ! s->p66 ) {
+		set_name( n, "j", cc_names[b & 0x0F] );
+		OPS1( n, K_J, 1 );
+		return 1;
+	}
+	if ( b >= 0xB0 && b <= 0xB7 ) {
+		set_name( n, "mov", "" );
+		OPS2( n, K_Z, 1, K_I, 1 );
+		return 1;
+	}
+	if ( b >= 0xB8 && b <= 0xBF ) {
+		set_name( n, ( s->opsize == 8 ) ? "movabs" : "mov", "" );
+		OPS2( n, K_Z, SZ_V, K_IV, SZ_V );
+		return 1;
+	}
+
+	switch ( b ) {
+		case 0x0F:
+			return decode_0f( s, n );
+		case 0x63:
+			if ( s->mode != opdis_x86_mode_64 || ! s->rex_w ) {
+				return 0;
+			}
+			set_name( n, "movsxd", "" );
+			strcpy( n->att_name, "movslq" );
+			OPS2( n, K_G, SZ_V, K_E, 4 );
+			n->modrm = 1;
+			return 1;
+		case 0x68: case 0x6A:
+			if ( s->p66 ) {
+				return 0;
+			}
+			set_name( n, "push", "" );
+			OPS1( n, ( b == 0x68 ) ? K_I : K_IB, SZ_V );
+			n->flags = F_STACK;
+			return 1;
+		case 0x69: case 0x6B:
+			set_name( n, "imul", "" );
+			set_ops( n, 3, K_G, SZ_V, K_E, SZ_V,
+				 ( b == 0x69 ) ? K_I : K_IB, SZ_V );
+			n->modrm = 1;
+			return 1;
+		case 0x80: case 0x81: case 0x83:
+			reg = peek_reg( s );
+			if ( reg < 0 ) {
+				return 0;
+			}
+			set_name( n, alu_names[reg], "" );
+			if ( b == 0x80 ) {
+				OPS2( n, K_E, 1, K_I, 1 );
+			} else {
+				OPS2( n, K_E, SZ_V, ( b == 0x81 ) ? K_I : K_IB,
+				      SZ_V );
+			}
+			n->flags = F_SUFFIX | (( reg != 7 ) ? F_LOCK : 0);
+			n->modrm = 1;
+			return 1;
+		case 0x84: case 0x85: case 0x86: case 0x87:
+			set_name( n, ( b < 0x86 ) ? "test" : "xchg", "" );
+			if ( b & 1 ) {
+				OPS2( n, K_E, SZ_V, K_G, SZ_V );
+			} else {
+				OPS2( n, K_E, 1, K_G, 1 );
+			}
+			n->flags = ( b < 0x86 ) ? 0 : F_LOCK;
+			n->modrm = 1;
+			return 1;
+		case 0x88: case 0x89: case 0x8A: case 0x8B: {
+			unsigned char size = ( b & 1 ) ? SZ_V : 1;
+			set_name( n, "mov", "" );
+			if ( b & 2 ) {
+				OPS2( n, K_G, size, K_E, size );
+			} else {
+				OPS2( n, K_E, size, K_G, size );
+			}
+			n->modrm = 1;
+			return 1;
+		}
+		case 0x8D:
+			set_name( n, "lea", "" );
+			OPS2( n, K_G, SZ_V, K_M, SZ_V );
+			n->modrm = 1;
+			return 1;
+		case 0x90:
+			/* REX.B makes this XCHG, and 66 90 is XCHG %ax,%ax */
+			if ( s->rex || s->p66 ) {
+				return 0;
+			}
+			set_name( n, "nop", "" );
+			OPS0( n );
+			return 1;
+		case 0xA8: case 0xA9:
+			set_name( n, "test", "" );
+			OPS2( n, K_ACC, ( b & 1 ) ? SZ_V : 1, K_I,
+			      ( b & 1 ) ? SZ_V : 1 );
+			return 1;
+		case 0xC0: case 0xC1: case 0xD0: case 0xD1:
+		case 0xD2: case 0xD3: {
+			unsigned char size = ( b & 1 ) ? SZ_V : 1;
+			reg = peek_reg( s );
+			if ( reg < 0 || ! shift_names[reg] ) {
+				return 0;
+			}
+			set_name( n, shift_names[reg], "" );
+			if ( b < 0xD0 ) {
+				OPS2( n, K_E, size, K_I, 1 );
+			} else if ( b < 0xD2 ) {
+				OPS2( n, K_E, size, K_ONE, 1 );
+			} else {
+				OPS2( n, K_E, size, K_CL, 1 );
+			}
+			n->flags = F_SUFFIX;
+			n->modrm = 1;
+			return 1;
+		}
+		case 0xC2: case 0xC3:
+			if ( s->p66 || s->rex ) {
+				return 0;
+			}
+			set_name( n, "ret", "" );
+			if ( b == 0xC2 ) {
+				OPS1( n, K_IW, 2 );
+			} else {
+				OPS0( n );
+			}
+			return 1;
+		case 0xC6: case 0xC7:
+			if ( peek_reg( s ) != 0 ) {
+				return 0;
+			}
+			set_name( n, "mov", "" );
+			OPS2( n, K_E, ( b & 1 ) ? SZ_V : 1, K_I,
+			      ( b & 1 ) ? SZ_V : 1 );
+			n->flags = F_SUFFIX;
+			n->modrm = 1;
+			return 1;
+		case 0xC9:
+			if ( s->p66 || s->rex ) {
+				return 0;
+			}
+			set_name( n, "leave", "" );
+			OPS0( n );
+			return 1;
+		case 0xCC: set_name( n, "int3", "" ); OPS0( n ); return 1;
+		case 0xF4: set_name( n, "hlt", "" ); OPS0( n ); return 1;
+		case 0xE8: case 0xE9: case 0xEB:
+			if ( s->p66 ) {
+				return 0;
+			}
+			set_name( n, ( b == 0xE8 ) ? "call" : "jmp", "" );
+			OPS1( n, K_J, ( b == 0xEB ) ? 1 : 4 );
+			return 1;
+		case 0xF6: case 0xF7: {
+			unsigned char size = ( b & 1 ) ? SZ_V : 1;
+			reg = peek_reg( s );
+			if ( reg < 0 || ! grp3_names[reg] ) {
+				return 0;
+			}
+			set_name( n, grp3_names[reg], "" );
+			if ( reg == 0 ) {
+				OPS2( n, K_E, size, K_I, size );
+			} else {
+				OPS1( n, K_E, size );
+			}
+			n->flags = F_SUFFIX |
+				   (( reg == 2 || reg == 3 ) ? F_LOCK : 0);
+			n->modrm = 1;
+			return 1;
+		}
+		case 0xFE: case 0xFF:
+			reg = peek_reg( s );
+			if ( reg == 0 || reg == 1 ) {
+				set_name( n, reg ? "dec" : "inc", "" );
+				OPS1( n, K_E, ( b & 1 ) ? SZ_V : 1 );
+				n->flags = F_SUFFIX | F_LOCK;
+				n->modrm = 1;
+				return 1;
+			}
+			if ( b == 0xFF && (reg == 2 || reg == 4) && ! s->p66 ) {
+				set_name( n, ( reg == 2 ) ? "call" : "jmp", "" );
+				OPS1( n, K_E, SZ_V );
+				n->flags = F_INDIRECT | F_STACK;
+				n->modrm = 1;
+				return 1;
+			}
+			return 0;
+	}
+
+	return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Operands */
+
+struct NATIVE_OPERAND {
+	opdis_op_t op;
+	char ascii[MAX_OP_STR];
+	int is_reg;		/* register which determines the insn size */
+	int is_mem;
+};
+
+/* as generic_print_address(), the default libopcodes print_address_func */
+static void format_address( char * buf, size_t len, opdis_vma_t addr ) {
+	snprintf( buf, len, "0x%08" PRIx64, (uint64_t) addr );
+}
+
+static void format_disp( char * buf, size_t len, int64_t disp, int sign ) {
+	if ( disp < 0 ) {
+		snprintf( buf, len, "-0x%llx",
+			  (unsigned long long) -(uint64_t) disp );
+	} else {
+		snprintf( buf, len, "%s0x%llx", ( sign ) ? "+" : "",
+			  (unsigned long long) disp );
+	}
+}
+
+static const char * ptr_name( unsigned int size ) {
+	switch ( size ) {
+		case 1: return "BYTE PTR ";
+		case 2: return "WORD PTR ";
+		case 4: return "DWORD PTR ";
+		default: return "QWORD PTR ";
+	}
+}
+
+static void memory_operand( struct NATIVE_STATE * s, struct NATIVE_OPERAND * o,
+			    unsigned int size, int att ) {
+	opdis_addr_expr_t * expr = &o->op.value.expr;
+	unsigned int asize = ( s->mode == opdis_x86_mode_64 ) ? 8 : 4;
+	const char ** names = ( asize == 8 ) ? reg64_names : reg32_names;
+	const char * base = NULL, * index = NULL;
+	char disp[32] = "", seg[8] = "";
+	enum opdis_addr_expr_elem_t elem = 0;
+	int has_base = ( s->base >= 0 || s->rip );
+
+	o->is_mem = 1;
+	o->op.category = opdis_op_cat_expr;
+	o->op.flags = opdis_op_flag_address;
+	o->op.data_size = (unsigned char) size;
+
+	if ( s->rip ) {
+		base = ( asize == 8 ) ? "rip" : "eip";
+		set_register( &expr->base, base, REG_ID_PC,
+			      (unsigned char) asize, opdis_reg_flag_pc );
+		elem |= opdis_addr_expr_base;
+	} else if ( s->base >= 0 ) {
+		base = names[s->base];
+		gp_register( &expr->base, s->base, asize, 1 );
+		elem |= opdis_addr_expr_base;
+	}
+	if ( s->index >= 0 ) {
+		index = names[s->index];
+		gp_register( &expr->index, s->index, asize, 1 );
+		elem |= opdis_addr_expr_index;
+	}
+	expr->scale = (char) s->scale;
+	expr->shift = opdis_addr_expr_asl;
+
+	if ( s->seg ) {
+		snprintf( seg, sizeof(seg), att ? "%%%s:" : "%s:",
+			  ( s->seg == REG_ID_FS ) ? "fs" : "gs" );
+	}
+
+	if (! has_base && s->index < 0 ) {
+		/* absolute address */
+		uint64_t addr = size_mask( (uint64_t) s->disp, asize );
+		if ( s->seg ) {
+			o->op.category = opdis_op_cat_absolute;
+			seg_register( &o->op.value.abs.segment, s->seg );
+			o->op.value.abs.offset = addr;
+		} else {
+			expr->displacement.u = addr;
+			elem |= opdis_addr_expr_disp | opdis_addr_expr_disp_u;
+			expr->elements = elem;
+		}
+		if ( att ) {
+			snprintf( o->ascii, MAX_OP_STR, "%s0x%llx", seg,
+				  (unsigned long long) addr );
+		} else {
+			snprintf( o->ascii, MAX_OP_STR, "%s%s0x%llx",
+				  ( size ) ? ptr_name( size ) : "",
+				  ( s->seg ) ? seg : "ds:",
+				  (unsigned long long) addr );
+		}
+		return;
+	}
+
+	if ( s->has_disp ) {
+		elem |= opdis_addr_expr_disp;
+		elem |= ( s->disp < 0 ) ? opdis_addr_expr_disp_s :
+					  opdis_addr_expr_disp_u;
+		if ( s->rip && ! att && s->disp < 0 ) {
+			/* libopcodes prints negative RIP offsets unsigned */
+			snprintf( disp, sizeof(disp), "+0x%llx",
+				  (unsigned long long) s->disp );
+		} else {
+			format_disp( disp, sizeof(disp), s->disp, ! att );
+		}
+	}
+	if ( s->seg ) {
+		seg_register( &expr->displacement.a.segment, s->seg );
+		expr->displacement.a.offset = (uint64_t) s->disp;
+		elem |= opdis_addr_expr_disp_abs;
+	} else {
+		expr->displacement.u = (uint64_t) s->disp;
+	}
+	expr->elements = elem;
+
+	if ( att ) {
+		char sib[40];
+		if ( index ) {
+			snprintf( sib, sizeof(sib), "(%s%s,%%%s,%d)",
+				  ( base ) ? "%" : "", ( base ) ? base : "",
+				  index, s->scale );
+		} else {
+			snprintf( sib, sizeof(sib), "(%%%s)", base );
+		}
+		snprintf( o->ascii, MAX_OP_STR, "%s%s%s", seg, disp, sib );
+	} else {
+		char sib[40];
+		if ( base && index ) {
+			snprintf( sib, sizeof(sib), "%s+%s*%d", base, index,
+				  s->scale );
+		} else if ( index ) {
+			snprintf( sib, sizeof(sib), "%s*%d", index, s->scale );
+		} else {
+			snprintf( sib, sizeof(sib), "%s", base );
+		}
+		snprintf( o->ascii, MAX_OP_STR, "%s%s[%s%s]",
+			  ( size ) ? ptr_name( size ) : "", seg, sib, disp );
+	}
+}
+
+static void register_operand( struct NATIVE_STATE * s,
+			      struct NATIVE_OPERAND * o, int num,
+			      unsigned int size, int att ) {
+	if ( size == 1 && num >= 4 && num < 8 ) {
+		/* REX selects SPL..DIL instead of AH..BH */
+		s->used_rex8 = 1;
+	}
+
+	o->op.category = opdis_op_cat_register;
+	o->op.data_size = (unsigned char) size;
+	gp_register( &o->op.value.reg, num, size, s->rex );
+	snprintf( o->ascii, MAX_OP_STR, "%s%s", att ? "%" : "",
+		  o->op.value.reg.ascii );
+}
+
+static void immediate_operand( struct NATIVE_OPERAND * o, uint64_t val,
+			       unsigned int size, int att ) {
+	o->op.category = opdis_op_cat_immediate;
+	o->op.data_size = (unsigned char) size;
+	o->op.value.immediate.u = size_mask( val, size );
+	snprintf( o->ascii, MAX_OP_STR, "%s0x%llx", att ? "$" : "",
+		  (unsigned long long) o->op.value.immediate.u );
+}
+
+/* fetch the immediate for an operand; returns 0 if it does not fit */
+static int fetch_immediate( struct NATIVE_STATE * s,
+			    const struct NATIVE_SPEC * spec,
+			    unsigned int size ) {
+	unsigned int n;
+
+	switch ( spec->kind ) {
+		case K_I: n = ( size > 4 ) ? 4 : size; break;
+		case K_IB: n = 1; break;
+		case K_IW: n = 2; break;
+		case K_IV: n = size; break;
+		case K_J: n = spec->size; break;
+		default: return 1;
+	}
+
+	s->imm_size = (int) n;
+	return fetch( s, n, &s->imm );
+}
+
+static unsigned int spec_size( struct NATIVE_STATE * s,
+			       const struct NATIVE_INSN * n,
+			       const struct NATIVE_SPEC * spec ) {
+	if ( spec->size != SZ_V ) {
+		return spec->size;
+	}
+	if ( (n->flags & F_STACK) && s->mode == opdis_x86_mode_64 ) {
+		/* REX.W is ignored here */
+		return ( s->p66 ) ? 2 : 8;
+	}
+	s->used_v = 1;
+	return s->opsize;
+}
+
+static int build_operand( struct NATIVE_STATE * s,
+			  const struct NATIVE_INSN * n,
+			  const struct NATIVE_SPEC * spec,
+			  struct NATIVE_OPERAND * o, opdis_vma_t vma, int att ) {
+	unsigned int size = spec_size( s, n, spec );
+	uint64_t val;
+
+	memset( o, 0, sizeof(*o) );
+
+	switch ( spec->kind ) {
+		case K_E:
+			if ( s->mod == 3 ) {
+				register_operand( s, o, s->rm, size, att );
+				o->is_reg = 1;
+			} else {
+				memory_operand( s, o, size, att );
+			}
+			if ( n->flags & F_INDIRECT ) {
+				o->op.flags |= opdis_op_flag_indirect;
+				if ( att ) {
+					memmove( o->ascii + 1, o->ascii,
+						 MAX_OP_STR - 1 );
+					o->ascii[0] = '*';
+					o->ascii[MAX_OP_STR - 1] = '\0';
+				}
+			}
+			return 1;
+		case K_M:
+			if ( s->mod == 3 ) {
+				return 0;
+			}
+			memory_operand( s, o, 0, att );
+			return 1;
+		case K_G:
+			register_operand( s, o, s->reg, size, att );
+			s->used_r = 1;
+			o->is_reg = 1;
+			return 1;
+		case K_Z:
+			register_operand( s, o,
+					  (s->opcode & 7) | (s->rex_b << 3),
+					  size, att );
+			s->used_b = 1;
+			o->is_reg = 1;
+			return 1;
+		case K_ACC:
+			register_operand( s, o, 0, size, att );
+			o->is_reg = 1;
+			return 1;
+		case K_CL:
+			register_operand( s, o, 1, 1, att );
+			return 1;
+		case K_ONE:
+			/* only printed in Intel syntax */
+			immediate_operand( o, 1, 1, 0 );
+			strcpy( o->ascii, "1" );
+			return 1;
+		case K_I: case K_IB: case K_IW: case K_IV:
+			immediate_operand( o, (uint64_t) sign_extend( s->imm,
+					   (unsigned int) s->imm_size ), size,
+					   att );
+			return 1;
+		case K_J:
+			val = vma + s->pos + (uint64_t) sign_extend( s->imm,
+						(unsigned int) s->imm_size );
+			if ( s->mode != opdis_x86_mode_64 ) {
+				val &= 0xFFFFFFFF;
+			}
+			o->op.category = opdis_op_cat_immediate;
+			o->op.flags = opdis_op_flag_address;
+			o->op.value.immediate.vma = val;
+			format_address( o->ascii, MAX_OP_STR, val );
+			return 1;
+	}
+
+	return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Instruction */
+
+static int decode_prefixes( struct NATIVE_STATE * s ) {
+	for ( ; s->pos < s->len && s->pos < MAX_INSN_LEN; s->pos++ ) {
+		opdis_byte_t b = s->buf[s->pos];
+
+		if ( s->mode == opdis_x86_mode_64 && (b & 0xF0) == 0x40 ) {
+			if ( s->rex ) {
+				return 0;
+			}
+			s->rex = 1;
+			s->rex_w = (b >> 3) & 1;
+			s->rex_r = (b >> 2) & 1;
+			s->rex_x = (b >> 1) & 1;
+			s->rex_b = b & 1;
+			continue;
+		}
+
+		/* REX must immediately precede the opcode */
+		if ( s->rex ) {
+			return ( b == 0x66 || b == 0xF0 || b == 0x64 ||
+				 b == 0x65 ) ? 0 : 1;
+		}
+
+		switch ( b ) {
+			case 0x66:
+				if ( s->p66 ) {
+					return 0;
+				}
+				s->p66 = 1;
+				break;
+			case 0xF0:
+				if ( s->lock ) {
+					return 0;
+				}
+				s->lock = 1;
+				break;
+			case 0x64: case 0x65:
+				if ( s->seg ) {
+					return 0;
+				}
+				s->seg = ( b == 0x64 ) ? REG_ID_FS : REG_ID_GS;
+				break;
+			case 0x26: case 0x2E: case 0x36: case 0x3E:
+			case 0x67: case 0xF2: case 0xF3:
+				/* hints, address size and REP are left to
+				 * libopcodes */
+				return 0;
+			default:
+				return 1;
+		}
+	}
+
+	return 0;
+}
+
+static void set_operand_pointers( opdis_insn_t * insn, int att ) {
+	/* same rules as the libopcodes-based x86 decoders */
+	if ( insn->category == opdis_insn_cat_cflow ) {
+		if ( insn->num_operands > 0 &&
+		     (insn->flags.cflow >= opdis_cflow_flag_call &&
+		      insn->flags.cflow <= opdis_cflow_flag_jmpcc ) ) {
+			insn->target = insn->operands[0];
+			insn->target->flags |= opdis_op_flag_r |
+					       opdis_op_flag_x;
+		}
+	} else if ( insn->num_operands > 0 ) {
+		unsigned int d = ( att && insn->num_operands > 1 ) ?
+				 insn->num_operands - 1 : 0;
+		unsigned int src = ( att ) ? 0 : 1;
+
+		insn->dest = insn->operands[d];
+		insn->dest->flags |= opdis_op_flag_w;
+		if ( insn->num_operands > 1 ) {
+			insn->src = insn->operands[src];
+			insn->src->flags |= opdis_op_flag_r;
+		}
+	}
+}
+
+static int add_operand( opdis_insn_t * insn,
+			const struct NATIVE_OPERAND * src ) {
+	opdis_op_t * op = opdis_insn_next_avail_op( insn );
+
+	if (! op ) {
+		op = opdis_op_alloc();
+		if (! op || ! opdis_insn_add_operand( insn, op ) ) {
+			opdis_op_free( op );
+			return 0;
+		}
+	}
+
+	op->category = src->op.category;
+	op->flags = src->op.flags;
+	op->value = src->op.value;
+	op->data_size = src->op.data_size;
+	opdis_op_set_ascii( op, src->ascii );
+
+	return 1;
+}
+
+int LIBCALL opdis_x86_native_decode( const opdis_byte_t * buf, opdis_off_t len,
+				     opdis_vma_t vma,
+				     enum opdis_x86_mode_t mode,
+				     enum opdis_x86_syntax_t syntax,
+				     opdis_insn_t * insn ) {
+	struct NATIVE_OPERAND ops[MAX_OPS];
+	struct NATIVE_STATE s;
+	struct NATIVE_INSN n;
+	char ascii[OPDIS_MAX_INSN_STR], head[32], comment[40] = "";
+	const char * mnem;
+	char mnem_buf[MAX_MNEM_STR + 1];	/* name plus an AT&T size suffix */
+	int att = ( syntax == opdis_x86_syntax_att );
+	int has_reg = 0, has_mem = 0, is_mem_insn = 0;
+	unsigned int i, num_printed, pos;
+
+	if (! buf || ! len || ! insn || mode == opdis_x86_mode_16 ) {
+		return 0;
+	}
+
+	memset( &s, 0, sizeof(s) );
+	memset( &n, 0, sizeof(n) );
+	s.buf = buf;
+	s.len = len;
+	s.mode = mode;
+
+	if (! decode_prefixes( &s ) ) {
+		return 0;
+	}
+	if ( s.mode == opdis_x86_mode_64 && s.rex_w ) {
+		s.opsize = 8;
+	} else {
+		s.opsize = ( s.p66 ) ? 2 : 4;
+	}
+
+	if (! decode_opcode( &s, &n ) ) {
+		return 0;
+	}
+	if ( n.modrm && ! decode_modrm( &s ) ) {
+		return 0;
+	}
+	for ( i = 0; i < n.num_ops; i++ ) {
+		if (! fetch_immediate( &s, &n.ops[i],
+				       spec_size( &s, &n, &n.ops[i] ) ) ) {
+			return 0;
+		}
+	}
+
+	/* segment overrides only apply to memory operands */
+	is_mem_insn = ( n.modrm && s.mod != 3 );
+	if ( s.seg && ! is_mem_insn ) {
+		return 0;
+	}
+	if ( s.lock && ! ( (n.flags & F_LOCK) && is_mem_insn ) ) {
+		return 0;
+	}
+
+	/* operands are built in Intel order, and printed reversed for AT&T */
+	for ( i = 0; i < n.num_ops; i++ ) {
+		if (! build_operand( &s, &n, &n.ops[i], &ops[i], vma, att ) ) {
+			return 0;
+		}
+		has_reg |= ops[i].is_reg;
+		has_mem |= ops[i].is_mem;
+	}
+
+	if ( (s.p66 && ! s.used_v) || (s.rex_w && ! s.used_v) ||
+	     (s.rex_r && ! s.used_r) || (s.rex_x && ! s.used_x) ||
+	     (s.rex_b && ! s.used_b) ) {
+		return 0;
+	}
+	if ( s.rex && ! (s.rex_w | s.rex_r | s.rex_x | s.rex_b) &&
+	     ! s.used_rex8 ) {
+		return 0;
+	}
+
+	mnem = n.name;
+	if ( att ) {
+		if ( n.att_name[0] ) {
+			mnem = n.att_name;
+		} else if ( (n.flags & F_SUFFIX) && has_mem && ! has_reg ) {
+			/* nothing else determines the operand size */
+			unsigned int size = spec_size( &s, &n, &n.ops[0] );
+			snprintf( mnem_buf, sizeof(mnem_buf), "%s%c", n.name,
+				  ( size == 1 ) ? 'b' : ( size == 2 ) ? 'w' :
+				  ( size == 4 ) ? 'l' : 'q' );
+			mnem = mnem_buf;
+		}
+	}
+
+	/* render ASCII in the libopcodes format */
+	snprintf( head, sizeof(head), "%s%s", ( s.lock ) ? "lock " : "",
+		  mnem );
+	num_printed = n.num_ops;
+	if ( att && num_printed == 2 && n.ops[1].kind == K_ONE ) {
+		/* AT&T omits the shift count of 1 */
+		num_printed = 1;
+	}
+	if ( num_printed ) {
+		pos = (unsigned int) snprintf( ascii, sizeof(ascii), "%-6s ",
+					       head );
+	} else {
+		pos = (unsigned int) snprintf( ascii, sizeof(ascii), "%s",
+					       head );
+	}
+	for ( i = 0; i < num_printed && pos < sizeof(ascii); i++ ) {
+		unsigned int idx = ( att ) ? num_printed - 1 - i : i;
+		pos += (unsigned int) snprintf( &ascii[pos],
+						sizeof(ascii) - pos, "%s%s",
+						( i ) ? "," : "",
+						ops[idx].ascii );
+	}
+	if ( s.rip ) {
+		format_address( comment, sizeof(comment),
+				vma + s.pos + (uint64_t) s.disp );
+		if ( pos < sizeof(ascii) ) {
+			snprintf( &ascii[pos], sizeof(ascii) - pos,
+				  "        # %s", comment );
+		}
+	}
+
+	/* fill instruction */
+	opdis_insn_clear( insn );
+	opdis_insn_set_ascii( insn, ascii );
+	if (! insn->fixed_size ) {
+		/* fixed-size insns have a 128-byte bytes field */
+		void * ptr = realloc( insn->bytes, s.pos );
+		if (! ptr ) {
+			return 0;
+		}
+		insn->bytes = (opdis_byte_t *) ptr;
+	}
+	memcpy( insn->bytes, buf, s.pos );
+	insn->size = s.pos;
+	insn->vma = vma;
+	insn->status |= opdis_decode_basic;
+
+	if ( s.lock ) {
+		opdis_insn_add_prefix( insn, "lock" );
+	}
+	opdis_insn_set_mnemonic( insn, mnem );
+	opdis_x86_mnemonic_classify( insn, n.name );
+	if ( s.rip ) {
+		opdis_insn_add_comment( insn, comment );
+	}
+	insn->status |= opdis_decode_mnem | opdis_decode_mnem_flags;
+
+	for ( i = 0; i < num_printed; i++ ) {
+		unsigned int idx = ( att ) ? num_printed - 1 - i : i;
+		if (! add_operand( insn, &ops[idx] ) ) {
+			return 0;
+		}
+	}
+	set_operand_pointers( insn, att );
+	insn->status |= opdis_decode_ops | opdis_decode_op_flags;
+
+	return (int) s.pos;
+}
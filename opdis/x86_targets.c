@@ -0,0 +1,116 @@
+/*!
+ * \file x86_targets.c
+ * \brief Scan of x86 code for likely function addresses
+ * \details This searches the raw bytes of a code buffer for direct calls
+ *          (E8 rel32) and, in 64-bit mode, RIP-relative LEA instructions,
+ *          which load function pointers in position-independent code.
+ *          The scan does not disassemble the buffer, so every occurrence
+ *          of these byte patterns is a candidate; a candidate is only
+ *          reported if its target lies within the buffer and starts with
+ *          a valid instruction.
+ * \author TG Community Developers <community@thoughtgang.org>
+ * \note Copyright (c) 2010 ThoughtGang.
+ * Released under the GNU Lesser Public License (LGPL), version 2.1.
+ * See http://www.gnu.org/licenses/gpl.txt for details.
+ */
+
+#include <string.h>
+
+#include <opdis/x86_decoder.h>
+
+#define OP_CALL_REL	0xE8
+#define OP_LEA		0x8D
+#define REX_W		0x48
+#define REX_WR		0x4C
+
+static int32_t rel32( const opdis_byte_t * buf ) {
+	return (int32_t) ( (uint32_t) buf[0] | ((uint32_t) buf[1] << 8) |
+			   ((uint32_t) buf[2] << 16) |
+			   ((uint32_t) buf[3] << 24) );
+}
+
+/* Report target if it is in the buffer and starts with a valid insn */
+static int report_target( const opdis_byte_t * buf, opdis_off_t len,
+			  opdis_vma_t vma, enum opdis_x86_mode_t mode,
+			  opdis_vma_t target, OPDIS_X86_TARGET fn,
+			  void * arg ) {
+	opdis_off_t offset;
+
+	if ( mode != opdis_x86_mode_64 ) {
+		target &= 0xFFFFFFFF;
+	}
+
+	if ( target < vma || target - vma >= len ) {
+		return 0;
+	}
+
+	offset = target - vma;
+	if (! opdis_x86_insn_size( &buf[offset], len - offset, mode ) ) {
+		return 0;
+	}
+
+	fn( target, arg );
+	return 1;
+}
+
+static unsigned int scan_calls( const opdis_byte_t * buf, opdis_off_t len,
+				opdis_vma_t vma, enum opdis_x86_mode_t mode,
+				OPDIS_X86_TARGET fn, void * arg ) {
+	const opdis_byte_t * end = buf + len, * c = buf;
+	unsigned int count = 0;
+
+	/* memchr is vectorized by the C library */
+	while ( c + 5 <= end &&
+		(c = memchr( c, OP_CALL_REL, (end - c) - 4 )) != NULL ) {
+		opdis_off_t next = (c - buf) + 5;
+		opdis_vma_t target = vma + next + (int64_t) rel32( &c[1] );
+
+		count += report_target( buf, len, vma, mode, target, fn, arg );
+		c++;
+	}
+
+	return count;
+}
+
+static unsigned int scan_rip_lea( const opdis_byte_t * buf, opdis_off_t len,
+				  opdis_vma_t vma, OPDIS_X86_TARGET fn,
+				  void * arg ) {
+	const opdis_byte_t * end = buf + len, * c = buf + 1;
+	unsigned int count = 0;
+
+	/* REX.W 8D /r with mod 00, r/m 101: lea reg, [rip + disp32] */
+	while ( c + 6 <= end &&
+		(c = memchr( c, OP_LEA, (end - c) - 5 )) != NULL ) {
+		if ( (c[-1] == REX_W || c[-1] == REX_WR) &&
+		     (c[1] & 0xC7) == 0x05 ) {
+			opdis_off_t next = (c - buf) + 6;
+			opdis_vma_t target = vma + next +
+					     (int64_t) rel32( &c[2] );
+
+			count += report_target( buf, len, vma,
+						opdis_x86_mode_64, target,
+						fn, arg );
+		}
+		c++;
+	}
+
+	return count;
+}
+
+unsigned int LIBCALL opdis_x86_call_targets( const opdis_byte_t * buf,
+					     opdis_off_t len, opdis_vma_t vma,
+					     enum opdis_x86_mode_t mode,
+					     OPDIS_X86_TARGET fn, void * arg ) {
+	unsigned int count;
+
+	if (! buf || ! fn || mode == opdis_x86_mode_16 ) {
+		return 0;
+	}
+
+	count = scan_calls( buf, len, vma, mode, fn, arg );
+	if ( mode == opdis_x86_mode_64 ) {
+		count += scan_rip_lea( buf, len, vma, fn, arg );
+	}
+
+	return count;
+}
@@ -164,6 +164,9 @@ static opdis_t opdis_for_bfd( bfd * abfd, opdis_t orig ) {
 	o->debug = orig->debug;
 	o->visited_addr = orig->visited_addr;
 
+	/* BFD targets are files: map sections rather than copying them */
+	opdis_set_mmap_sections( o, 1 );
+
 	/* if user has overridden syntax or decoder, defer to it */
 	if ( orig->config.arch == o->config.arch ) {
 		if ( orig->disassembler != o->disassembler ) {
@@ -311,10 +314,13 @@ static int cflow_job( job_list_item_t * job, tgt_list_item_t * tgt,
 	return opdis_disasm_cflow( o->opdis, tgt->data, vma );
 }
 
+/* the generic decoders only classify branches from libopcodes insn info */
 static void decoder_check( opdis_t o ) {
-	if ( o->decoder == opdis_default_decoder ) {
+	if ( o->decoder == opdis_default_decoder ||
+	     o->decoder == opdis_styled_decoder ) {
 		fprintf( stderr, 
-			 "WARNING: cflow will not work on this architecture\n");
+			 "WARNING: cflow requires branch info from libopcodes "
+			 "on this architecture\n");
 	}
 }
 
@@ -13,6 +13,8 @@
 #include <string.h>
 
 #include <opdis/opdis.h>
+#include <opdis/arena.h>
+#include <opdis/strpool.h>
 
 #include "asm_format.h"
 #include "job_list.h"
@@ -125,6 +127,8 @@ struct opdis_options {
 
 	FILE *			output_file;
 	opdis_insn_tree_t	insn_tree;
+	opdis_arena_t		insn_arena;
+	opdis_strpool_t		insn_strings;
 };
 
 static void set_defaults( struct opdis_options * opts ) {
@@ -132,7 +136,14 @@ static void set_defaults( struct opdis_options * opts ) {
 	opts->map = mem_map_alloc();
 	opts->targets = tgt_list_alloc();
 	opts->opdis = opdis_init();
-	opts->insn_tree = opdis_insn_tree_init( 1 );
+	/* collected insns are owned by the arena, not the tree */
+	opts->insn_tree = opdis_insn_tree_init( 0 );
+	opts->insn_arena = opdis_arena_init( 0 );
+	/* collected insns share mnemonic and operand strings */
+	opts->insn_strings = opdis_strpool_init();
+	if ( opts->insn_arena ) {
+		opts->insn_arena->strings = opts->insn_strings;
+	}
 	opts->output_file = stdout;
 
 	// TODO get first available arch
@@ -465,13 +476,19 @@ static struct argp argp_cfg = {
 
 void opdis_display_cb ( const opdis_insn_t * insn, void * arg ) {
 	opdis_insn_t * i;
-	opdis_insn_tree_t tree = (opdis_insn_tree_t) arg;
-	if (! tree ) {
+	struct opdis_options * opts = (struct opdis_options *) arg;
+	if (! opts || ! opts->insn_tree ) {
 		return;
 	}
 
-	i = opdis_insn_dupe( insn );
-	opdis_insn_tree_add( tree, i );
+	if ( opdis_insn_tree_contains( opts->insn_tree, insn->vma ) ) {
+		return;
+	}
+
+	i = opdis_insn_arena_dupe( opts->insn_arena, insn );
+	if ( i ) {
+		opdis_insn_tree_add( opts->insn_tree, i );
+	}
 }
 
 opdis_vma_t opdis_resolver_cb( const opdis_insn_t * i, void * arg ) {
@@ -570,7 +587,7 @@ static void configure_opdis( struct opdis_options * opts ) {
 
 	opdis_set_x86_syntax( o, opts->syntax );
 
-	opdis_set_display( o, opdis_display_cb, opts->insn_tree );
+	opdis_set_display( o, opdis_display_cb, opts );
 	opdis_set_resolver( o, opdis_resolver_cb, opts->map );
 
 	o->debug = opts->debug;
@@ -728,6 +745,10 @@ int main( int argc, char ** argv ) {
 
 	output_disassembly( & opts );
 
+	opdis_insn_tree_free( opts.insn_tree );
+	opdis_arena_free( opts.insn_arena );
+	opdis_strpool_free( opts.insn_strings );
+
 	return 0;
 }
 
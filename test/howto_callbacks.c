@@ -80,9 +80,10 @@ static void handle_target( opdis_insn_t * out, const char * item ) {
 	out->target = out->operands[0];
 }
 
-static int decode_mnemonic( char ** items, int idx, opdis_insn_t * out ) {
+static int decode_mnemonic( const opdis_insn_buf_t in, int idx,
+			    opdis_insn_t * out ) {
 	int i, num;
-	const char *item = items[idx];
+	const char *item = OPDIS_INSN_BUF_ITEM(in, idx);
 
 	/* detect JMP */
 	num = (int) sizeof(jmp_insns) / sizeof(char *);
@@ -90,7 +91,7 @@ static int decode_mnemonic( char ** items, int idx, opdis_insn_t * out ) {
 		if (! strcmp(jmp_insns[i], item) ) {
 			out->category = opdis_insn_cat_cflow;
 			out->flags.cflow = opdis_cflow_flag_jmp;
-			handle_target( out, items[idx+1] );
+			handle_target( out, OPDIS_INSN_BUF_ITEM(in, idx+1) );
 			return 1;
 		}
 	}
@@ -111,7 +112,7 @@ static int decode_mnemonic( char ** items, int idx, opdis_insn_t * out ) {
 		if (! strcmp(call_insns[i], item) ) {
 			out->category = opdis_insn_cat_cflow;
 			out->flags.cflow = opdis_cflow_flag_call;
-			handle_target( out, items[idx+1] );
+			handle_target( out, OPDIS_INSN_BUF_ITEM(in, idx+1) );
 			return 1;
 		}
 	}
@@ -120,7 +121,7 @@ static int decode_mnemonic( char ** items, int idx, opdis_insn_t * out ) {
 		if (! strcmp(jcc_insns[i], item) ) {
 			out->category = opdis_insn_cat_cflow;
 			out->flags.cflow = opdis_cflow_flag_jmpcc;
-			handle_target( out, items[idx+1] );
+			handle_target( out, OPDIS_INSN_BUF_ITEM(in, idx+1) );
 			return 1;
 		}
 	}
@@ -142,7 +143,7 @@ static int my_decoder( const opdis_insn_buf_t in, opdis_insn_t * out,
 	}
 
 	for ( i=0; i < in->item_count; i++ ) {
-		if ( decode_mnemonic( in->items, i, out ) ) {
+		if ( decode_mnemonic( in, i, out ) ) {
 			out->status |= (opdis_decode_mnem | opdis_decode_ops | 
 					opdis_decode_mnem_flags);
 			break;
@@ -0,0 +1,121 @@
+/* insn_dupe_test.c
+ * Test that instructions created by opdis_insn_dupe can be modified after
+ * they are duplicated.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <opdis/model.h>
+
+#define LONG_OP "0x12345678(%rax,%rbx,8)"
+#define MAX_OPS 5
+
+static const char * names[MAX_OPS] = { "%eax", "%ebx", "%ecx", "%edx",
+				       "%esi" };
+
+static opdis_insn_t * make_insn( unsigned int num_ops ) {
+	opdis_insn_t * insn = opdis_insn_alloc_fixed( 128, 32, 8, 64 );
+	unsigned int i;
+
+	opdis_insn_set_ascii( insn, "mov    %eax,%ebx" );
+	opdis_insn_set_mnemonic( insn, "mov" );
+	for ( i = 0; i < num_ops && i < MAX_OPS; i++ ) {
+		opdis_op_t * op = opdis_insn_next_avail_op( insn );
+		if (! op ) {
+			op = opdis_op_alloc();
+			opdis_insn_add_operand( insn, op );
+		}
+		opdis_op_set_ascii( op, names[i] );
+	}
+	insn->target = insn->operands[0];
+
+	return insn;
+}
+
+static int check( const char * test, const char * field, const char * value,
+		  const char * expected ) {
+	if (! value || strcmp( value, expected ) ) {
+		printf( "FAIL %s: %s is '%s', expected '%s'\n", test, field,
+			( value ) ? value : "(null)", expected );
+		return 0;
+	}
+	return 1;
+}
+
+/* set a longer operand string than the one that was packed */
+static int test_set_op( unsigned int num_ops ) {
+	opdis_insn_t * insn = make_insn( num_ops );
+	opdis_insn_t * dupe = opdis_insn_dupe( insn );
+	unsigned int last = num_ops - 1;
+	int ok;
+
+	opdis_op_set_ascii( dupe->operands[last], LONG_OP );
+	opdis_op_set_ascii( dupe->operands[last], LONG_OP " " LONG_OP );
+
+	ok = check( "set operand", "operand",
+		    dupe->operands[last]->ascii, LONG_OP " " LONG_OP );
+	ok &= check( "set operand", "original operand",
+		     insn->operands[last]->ascii, names[last] );
+	ok &= check( "set operand", "mnemonic", dupe->mnemonic, "mov" );
+
+	opdis_insn_free( dupe );
+	opdis_insn_free( insn );
+	return ok;
+}
+
+/* modify the insn after setting an operand string */
+static int test_unpack( void ) {
+	opdis_insn_t * insn = make_insn( 2 );
+	opdis_insn_t * dupe = opdis_insn_dupe( insn );
+	int ok;
+
+	opdis_op_set_ascii( dupe->operands[0], LONG_OP );
+	opdis_insn_set_mnemonic( dupe, "movl" );
+	opdis_op_set_ascii( dupe->operands[1], LONG_OP );
+
+	ok = check( "unpack", "mnemonic", dupe->mnemonic, "movl" );
+	ok &= check( "unpack", "operand 0", dupe->operands[0]->ascii, LONG_OP );
+	ok &= check( "unpack", "operand 1", dupe->operands[1]->ascii, LONG_OP );
+	ok &= check( "unpack", "target", dupe->target->ascii, LONG_OP );
+
+	opdis_insn_free( dupe );
+	opdis_insn_free( insn );
+	return ok;
+}
+
+/* clear and refill a duplicate */
+static int test_clear( void ) {
+	opdis_insn_t * insn = make_insn( 2 );
+	opdis_insn_t * dupe = opdis_insn_dupe( insn );
+	opdis_op_t * op;
+	int ok;
+
+	opdis_op_set_ascii( dupe->operands[1], LONG_OP );
+	opdis_insn_clear( dupe );
+	op = opdis_insn_next_avail_op( dupe );
+	opdis_op_set_ascii( op, LONG_OP );
+	opdis_insn_set_mnemonic( dupe, "lea" );
+
+	ok = check( "clear", "mnemonic", dupe->mnemonic, "lea" );
+	ok &= check( "clear", "operand", dupe->operands[0]->ascii, LONG_OP );
+	ok &= check( "clear", "original mnemonic", insn->mnemonic, "mov" );
+
+	opdis_insn_free( dupe );
+	opdis_insn_free( insn );
+	return ok;
+}
+
+int main( void ) {
+	int i = 0, failed = 0;
+
+	failed += ! test_set_op( 1 ); i++;
+	failed += ! test_set_op( 2 ); i++;
+	failed += ! test_set_op( MAX_OPS ); i++;	/* not inline */
+	failed += ! test_unpack(); i++;
+	failed += ! test_clear(); i++;
+
+	printf( "%d of %d duplicate tests passed\n", i - failed, i );
+
+	return ( failed ) ? 1 : 0;
+}
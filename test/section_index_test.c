@@ -0,0 +1,193 @@
+/* section_index_test.c
+ * Test the BFD section index against sections which overlap, nest, are
+ * adjacent or are empty. An address in more than one section must be found
+ * in the section that appears last in the BFD section list, as it was
+ * before the index was added.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <opdis/section_index.h>
+
+#define MAX_TEST_SECTIONS 4
+#define MAX_TEST_PROBES 12
+
+struct TEST_SECTION {
+	const char * name;
+	opdis_vma_t vma;
+	opdis_off_t size;
+};
+
+struct TEST_PROBE {
+	opdis_vma_t vma;
+	const char * section;		/* expected section or NULL */
+};
+
+struct INDEX_TEST {
+	const char * desc;
+	struct TEST_SECTION sections[MAX_TEST_SECTIONS];	/* in BFD order */
+	struct TEST_PROBE probes[MAX_TEST_PROBES];
+};
+
+#define END_PROBES { OPDIS_INVALID_ADDR, NULL }
+
+static struct INDEX_TEST corpus[] = {
+	{ "adjacent",
+	  { { ".a", 0x1000, 0x100 }, { ".b", 0x1100, 0x100 } },
+	  { { 0xFFF, NULL }, { 0x1000, ".a" }, { 0x10FF, ".a" },
+	    { 0x1100, ".b" }, { 0x11FF, ".b" }, { 0x1200, NULL },
+	    END_PROBES } },
+	{ "overlapping",
+	  { { ".a", 0x1000, 0x200 }, { ".b", 0x1100, 0x200 } },
+	  { { 0x1000, ".a" }, { 0x10FF, ".a" }, { 0x1100, ".b" },
+	    { 0x11FF, ".b" }, { 0x1200, ".b" }, { 0x12FF, ".b" },
+	    { 0x1300, NULL }, END_PROBES } },
+	{ "overlapping, earlier section later in list",
+	  { { ".b", 0x1100, 0x200 }, { ".a", 0x1000, 0x200 } },
+	  { { 0x1000, ".a" }, { 0x1100, ".a" }, { 0x11FF, ".a" },
+	    { 0x1200, ".b" }, { 0x12FF, ".b" }, { 0x1300, NULL },
+	    END_PROBES } },
+	{ "nested",
+	  { { ".outer", 0x1000, 0x1000 }, { ".inner", 0x1400, 0x400 } },
+	  { { 0x1000, ".outer" }, { 0x13FF, ".outer" }, { 0x1400, ".inner" },
+	    { 0x17FF, ".inner" }, { 0x1800, ".outer" }, { 0x1FFF, ".outer" },
+	    { 0x2000, NULL }, END_PROBES } },
+	{ "nested, inner section first in list",
+	  { { ".inner", 0x1400, 0x400 }, { ".outer", 0x1000, 0x1000 } },
+	  { { 0x1000, ".outer" }, { 0x1400, ".outer" }, { 0x17FF, ".outer" },
+	    { 0x1800, ".outer" }, { 0x2000, NULL }, END_PROBES } },
+	{ "empty",
+	  { { ".empty", 0x1000, 0 }, { ".a", 0x1000, 0x100 },
+	    { ".empty2", 0x1080, 0 }, { ".empty3", 0x3000, 0 } },
+	  { { 0x1000, ".a" }, { 0x1080, ".a" }, { 0x10FF, ".a" },
+	    { 0x1100, NULL }, { 0x3000, NULL }, END_PROBES } },
+	{ "relocatable object",
+	  { { ".text", 0, 0x100 }, { ".data", 0, 0x40 }, { ".bss", 0, 0x10 },
+	    { ".rodata", 0, 0x40 } },
+	  { { 0x0, ".rodata" }, { 0x10, ".rodata" }, { 0x3F, ".rodata" },
+	    { 0x40, ".text" }, { 0xFF, ".text" }, { 0x100, NULL },
+	    END_PROBES } },
+	{ "no sections",
+	  { { NULL, 0, 0 } },
+	  { { 0x0, NULL }, { 0x1000, NULL }, END_PROBES } },
+
+	{ NULL, { { NULL, 0, 0 } }, { END_PROBES } }
+};
+
+struct VMA_SECTION {
+	opdis_vma_t vma;
+	asection * sec;
+};
+
+/* the section lookup that the index replaced */
+static void vma_in_section( bfd * abfd, asection * s, PTR data ) {
+	struct VMA_SECTION * req = (struct VMA_SECTION *) data;
+
+	if ( req->vma >= bfd_section_vma( abfd, s ) &&
+	     req->vma < bfd_section_vma( abfd, s ) +
+			bfd_section_size( abfd, s ) ) {
+		req->sec = s;
+	}
+}
+
+static const char * section_name( asection * s ) {
+	return ( s ) ? s->name : "(none)";
+}
+
+static int check_vma( const struct INDEX_TEST * t, bfd * abfd,
+		      opdis_section_index_t idx, opdis_vma_t vma ) {
+	struct VMA_SECTION req = { vma, NULL };
+	asection * s = opdis_section_index_find( idx, vma );
+
+	bfd_map_over_sections( abfd, vma_in_section, &req );
+	if ( s != req.sec ) {
+		printf( "FAIL '%s': 0x%llx is in %s, expected %s\n", t->desc,
+			(unsigned long long) vma, section_name( s ),
+			section_name( req.sec ) );
+		return 0;
+	}
+
+	return 1;
+}
+
+static int test_index( const struct INDEX_TEST * t ) {
+	bfd * abfd = bfd_create( t->desc, NULL );
+	opdis_section_index_t idx;
+	unsigned int i;
+	int ok = 1;
+
+	if (! abfd ) {
+		printf( "FAIL '%s': unable to create BFD\n", t->desc );
+		return 0;
+	}
+
+	for ( i = 0; i < MAX_TEST_SECTIONS && t->sections[i].name; i++ ) {
+		asection * s = bfd_make_section_anyway( abfd,
+							t->sections[i].name );
+		if (! s ) {
+			printf( "FAIL '%s': unable to create section %s\n",
+				t->desc, t->sections[i].name );
+			bfd_close_all_done( abfd );
+			return 0;
+		}
+		(void) bfd_set_section_vma( abfd, s, t->sections[i].vma );
+		bfd_set_section_size( abfd, s, t->sections[i].size );
+	}
+
+	idx = opdis_section_index_init( abfd );
+	if (! idx ) {
+		printf( "FAIL '%s': unable to build index\n", t->desc );
+		bfd_close_all_done( abfd );
+		return 0;
+	}
+
+	for ( i = 0; i < MAX_TEST_PROBES &&
+		     t->probes[i].vma != OPDIS_INVALID_ADDR; i++ ) {
+		const struct TEST_PROBE * p = &t->probes[i];
+		asection * s = opdis_section_index_find( idx, p->vma );
+		const char * name = ( s ) ? s->name : NULL;
+
+		if ( ( name || p->section ) &&
+		     ( ! name || ! p->section || strcmp( name, p->section ) ) ) {
+			printf( "FAIL '%s': 0x%llx is in %s, expected %s\n",
+				t->desc, (unsigned long long) p->vma,
+				section_name( s ),
+				( p->section ) ? p->section : "(none)" );
+			ok = 0;
+		}
+	}
+
+	/* every range endpoint, and the addresses on either side of it */
+	for ( i = 0; i < MAX_TEST_SECTIONS && t->sections[i].name; i++ ) {
+		opdis_vma_t start = t->sections[i].vma;
+		opdis_vma_t end = start + t->sections[i].size;
+
+		ok &= check_vma( t, abfd, idx, start - 1 );
+		ok &= check_vma( t, abfd, idx, start );
+		ok &= check_vma( t, abfd, idx, start + 1 );
+		ok &= check_vma( t, abfd, idx, end - 1 );
+		ok &= check_vma( t, abfd, idx, end );
+	}
+
+	opdis_section_index_free( idx );
+	bfd_close_all_done( abfd );
+	return ok;
+}
+
+int main( void ) {
+	int i, failed = 0;
+
+	bfd_init();
+
+	for ( i = 0; corpus[i].desc; i++ ) {
+		if (! test_index( &corpus[i] ) ) {
+			failed++;
+		}
+	}
+
+	printf( "%d of %d section indexes searched correctly\n", i - failed,
+		i );
+
+	return ( failed ) ? 1 : 0;
+}
@@ -0,0 +1,239 @@
+/* styled_decoder_test.c
+ * Test the styled instruction layout and decoder against hand-built item
+ * sequences of the form produced by libopcodes fprintf_styled_func.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <opdis/opdis.h>
+
+#define MAX_TEST_ITEMS 16
+#define MAX_TEST_OPS 4
+
+struct STYLED_ITEM {
+	enum opdis_token_style_t style;
+	const char * text;
+};
+
+struct STYLED_OP {
+	const char * ascii;			/* expected operand string */
+	enum opdis_op_cat_t cat;		/* expected category */
+	uint64_t value;				/* immediate value */
+	unsigned int flags;			/* masked by FLAG_MASK */
+};
+
+struct STYLED_TEST {
+	const char * desc;
+	struct STYLED_ITEM items[MAX_TEST_ITEMS];
+	const char * prefixes;			/* expected prefixes or NULL */
+	const char * mnemonic;			/* expected mnemonic */
+	const char * comment;			/* expected comment or NULL */
+	unsigned int num_ops;
+	struct STYLED_OP ops[MAX_TEST_OPS];
+};
+
+#define FLAG_MASK ( opdis_op_flag_signed | opdis_op_flag_address )
+
+#define TXT	opdis_token_style_text
+#define MNEM	opdis_token_style_mnemonic
+#define SUB	opdis_token_style_sub_mnemonic
+#define REGS	opdis_token_style_register
+#define IMMS	opdis_token_style_immediate
+#define ADRS	opdis_token_style_address
+#define OFFS	opdis_token_style_address_offset
+#define CMTS	opdis_token_style_comment
+
+#define REG	opdis_op_cat_register
+#define IMM	opdis_op_cat_immediate
+#define EXPR	opdis_op_cat_expr
+#define ADDR	opdis_op_flag_address
+#define SIGNED	opdis_op_flag_signed
+
+static struct STYLED_TEST corpus[] = {
+	/* AT&T */
+	{ "mov %rsp,%rbp",
+	  { { MNEM, "mov" }, { TXT, "    " }, { REGS, "%rsp" }, { TXT, "," },
+	    { REGS, "%rbp" } },
+	  NULL, "mov", NULL, 2,
+	  { { "%rsp", REG, 0, 0 }, { "%rbp", REG, 0, 0 } } },
+	{ "add $0x8,%rsp",
+	  { { MNEM, "add" }, { TXT, "    " }, { IMMS, "$0x8" }, { TXT, "," },
+	    { REGS, "%rsp" } },
+	  NULL, "add", NULL, 2,
+	  { { "$0x8", IMM, 8, 0 }, { "%rsp", REG, 0, 0 } } },
+	{ "lock cmpxchg %rcx,(%rdi)",
+	  { { MNEM, "lock" }, { TXT, " " }, { MNEM, "cmpxchg" },
+	    { TXT, " " }, { REGS, "%rcx" }, { TXT, "," }, { TXT, "(" },
+	    { REGS, "%rdi" }, { TXT, ")" } },
+	  "lock", "cmpxchg", NULL, 2,
+	  { { "%rcx", REG, 0, 0 }, { "(%rdi)", EXPR, 0, ADDR } } },
+	{ "lea 0x10(%rip),%rax # 0x1017",
+	  { { MNEM, "lea" }, { TXT, "    " }, { OFFS, "0x10" }, { TXT, "(" },
+	    { REGS, "%rip" }, { TXT, ")" }, { TXT, "," }, { REGS, "%rax" },
+	    { TXT, "        " }, { CMTS, "# " }, { ADRS, "0x1017" } },
+	  NULL, "lea", "0x1017", 2,
+	  { { "0x10(%rip)", EXPR, 0, ADDR }, { "%rax", REG, 0, 0 } } },
+	{ "call 0x00401000",
+	  { { MNEM, "call" }, { TXT, "   " }, { ADRS, "0x00401000" } },
+	  NULL, "call", NULL, 1,
+	  { { "0x00401000", IMM, 0x401000, ADDR } } },
+
+	/* Intel */
+	{ "mov eax,0x1",
+	  { { MNEM, "mov" }, { TXT, "    " }, { REGS, "eax" }, { TXT, "," },
+	    { IMMS, "0x1" } },
+	  NULL, "mov", NULL, 2,
+	  { { "eax", REG, 0, 0 }, { "0x1", IMM, 1, 0 } } },
+	{ "mov rax,QWORD PTR [rsp+0x8]",
+	  { { MNEM, "mov" }, { TXT, "    " }, { REGS, "rax" }, { TXT, "," },
+	    { TXT, "QWORD PTR " }, { TXT, "[" }, { REGS, "rsp" },
+	    { TXT, "+" }, { OFFS, "0x8" }, { TXT, "]" } },
+	  NULL, "mov", NULL, 2,
+	  { { "rax", REG, 0, 0 },
+	    { "QWORD PTR [rsp+0x8]", EXPR, 0, ADDR } } },
+	{ "rep stos QWORD PTR es:[rdi],rax",
+	  { { MNEM, "rep" }, { TXT, " " }, { MNEM, "stos" }, { TXT, " " },
+	    { TXT, "QWORD PTR " }, { REGS, "es" }, { TXT, ":" },
+	    { TXT, "[" }, { REGS, "rdi" }, { TXT, "]" }, { TXT, "," },
+	    { REGS, "rax" } },
+	  "rep", "stos", NULL, 2,
+	  { { "QWORD PTR es:[rdi]", EXPR, 0, ADDR }, { "rax", REG, 0, 0 } } },
+
+	/* ARM */
+	{ "ldr r0, [r1, #4]",
+	  { { MNEM, "ldr" }, { TXT, "\t" }, { REGS, "r0" }, { TXT, ", " },
+	    { TXT, "[" }, { REGS, "r1" }, { TXT, ", " }, { IMMS, "#4" },
+	    { TXT, "]" } },
+	  NULL, "ldr", NULL, 2,
+	  { { "r0", REG, 0, 0 }, { "[r1, #4]", EXPR, 0, ADDR } } },
+	{ "addne r0, r1, #-1",
+	  { { MNEM, "add" }, { SUB, "ne" }, { TXT, "\t" }, { REGS, "r0" },
+	    { TXT, ", " }, { REGS, "r1" }, { TXT, ", " }, { IMMS, "#-1" } },
+	  NULL, "addne", NULL, 3,
+	  { { "r0", REG, 0, 0 }, { "r1", REG, 0, 0 },
+	    { "#-1", IMM, (uint64_t) -1, SIGNED } } },
+	{ "bl 0x00008000",
+	  { { MNEM, "bl" }, { TXT, "\t" }, { ADRS, "0x00008000" } },
+	  NULL, "bl", NULL, 1,
+	  { { "0x00008000", IMM, 0x8000, ADDR } } },
+	{ "push {r4, lr}",
+	  { { MNEM, "push" }, { TXT, "\t" }, { TXT, "{" }, { REGS, "r4" },
+	    { TXT, ", " }, { REGS, "lr" }, { TXT, "}" } },
+	  NULL, "push", NULL, 1,
+	  { { "{r4, lr}", opdis_op_cat_unknown, 0, 0 } } },
+
+	{ NULL, { { 0, NULL } }, NULL, NULL, NULL, 0, { { NULL, 0, 0, 0 } } }
+};
+
+static void add_item( opdis_insn_buf_t buf, enum opdis_token_style_t style,
+		      const char * format, ... ) {
+	va_list args;
+
+	va_start( args, format );
+	opdis_insn_buf_vappend( buf, style, format, args );
+	va_end( args );
+}
+
+static int check_str( const struct STYLED_TEST * t, const char * field,
+		      const char * value, const char * expected ) {
+	if (! value ) {
+		value = "";
+	}
+	if (! expected ) {
+		expected = "";
+	}
+
+	if ( strcmp( value, expected ) ) {
+		printf( "FAIL '%s': %s is '%s', expected '%s'\n", t->desc,
+			field, value, expected );
+		return 0;
+	}
+
+	return 1;
+}
+
+static int check_operand( const struct STYLED_TEST * t, unsigned int i,
+			  const opdis_op_t * op ) {
+	const struct STYLED_OP * e = &t->ops[i];
+	int ok = check_str( t, "operand", op->ascii, e->ascii );
+
+	if ( op->category != e->cat ) {
+		printf( "FAIL '%s': operand %d category is %d, expected %d\n",
+			t->desc, i, op->category, e->cat );
+		return 0;
+	}
+
+	if ( (op->flags & FLAG_MASK) != e->flags ) {
+		printf( "FAIL '%s': operand %d flags are 0x%X, expected 0x%X\n",
+			t->desc, i, op->flags & FLAG_MASK, e->flags );
+		ok = 0;
+	}
+
+	if ( op->category == opdis_op_cat_immediate &&
+	     op->value.immediate.u != e->value ) {
+		printf( "FAIL '%s': operand %d is 0x%llx, expected 0x%llx\n",
+			t->desc, i, (unsigned long long) op->value.immediate.u,
+			(unsigned long long) e->value );
+		ok = 0;
+	}
+
+	return ok;
+}
+
+static int test_insn( opdis_insn_buf_t buf, const struct STYLED_TEST * t ) {
+	opdis_byte_t bytes[1] = { 0x90 };
+	opdis_insn_t * insn = opdis_insn_alloc_fixed( 128, 32, 8, 64 );
+	opdis_insn_layout_t layout;
+	unsigned int i;
+	int ok;
+
+	opdis_insn_buf_clear( buf );
+	for ( i = 0; i < MAX_TEST_ITEMS && t->items[i].text; i++ ) {
+		add_item( buf, t->items[i].style, "%s", t->items[i].text );
+	}
+
+	if (! opdis_insn_buf_layout( buf, &layout ) ||
+	     layout.num_operands != t->num_ops ) {
+		printf( "FAIL '%s': layout has %d operands, expected %d\n",
+			t->desc, (int) layout.num_operands, t->num_ops );
+		opdis_insn_free( insn );
+		return 0;
+	}
+
+	opdis_styled_decoder( buf, insn, bytes, 0, 0, 1, NULL );
+
+	ok = check_str( t, "mnemonic", insn->mnemonic, t->mnemonic );
+	ok &= check_str( t, "prefixes", insn->prefixes, t->prefixes );
+	ok &= check_str( t, "comment", insn->comment, t->comment );
+
+	if ( insn->num_operands != t->num_ops ) {
+		printf( "FAIL '%s': %d operands, expected %d\n", t->desc,
+			(int) insn->num_operands, t->num_ops );
+		ok = 0;
+	} else {
+		for ( i = 0; i < t->num_ops; i++ ) {
+			ok &= check_operand( t, i, insn->operands[i] );
+		}
+	}
+
+	opdis_insn_free( insn );
+	return ok;
+}
+
+int main( void ) {
+	opdis_insn_buf_t buf = opdis_insn_buf_alloc( 0, 0, 0 );
+	int i, failed = 0;
+
+	for ( i = 0; corpus[i].desc; i++ ) {
+		if (! test_insn( buf, &corpus[i] ) ) {
+			failed++;
+		}
+	}
+
+	printf( "%d of %d instructions decoded correctly\n", i - failed, i );
+	opdis_insn_buf_free( buf );
+
+	return ( failed ) ? 1 : 0;
+}
@@ -0,0 +1,197 @@
+/* x86_decoder_test.c
+ * Test the operand decoding of the built-in x86 decoders against a corpus
+ * of libopcodes operand strings.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <opdis/opdis.h>
+#include <opdis/x86_decoder.h>
+
+#define FLAG_MASK ( opdis_op_flag_signed | opdis_op_flag_address | \
+		    opdis_op_flag_indirect )
+
+struct OP_TEST {
+	int att;				/* syntax of the operand */
+	const char * item;			/* operand string */
+	enum opdis_op_cat_t cat;		/* expected category */
+	const char * reg;			/* register or base */
+	const char * index;
+	int scale;
+	uint64_t value;				/* imm, disp or offset */
+	const char * seg;
+	unsigned int flags;			/* masked by FLAG_MASK */
+};
+
+#define REG	opdis_op_cat_register
+#define IMM	opdis_op_cat_immediate
+#define ABS	opdis_op_cat_absolute
+#define EXPR	opdis_op_cat_expr
+#define ADDR	opdis_op_flag_address
+#define IND	opdis_op_flag_indirect
+
+static struct OP_TEST corpus[] = {
+	/* AT&T */
+	{ 1, "%eax", REG, "eax", NULL, 0, 0, NULL, 0 },
+	{ 1, "%r10d", REG, "r10d", NULL, 0, 0, NULL, 0 },
+	{ 1, "%st(1)", REG, "st(1)", NULL, 0, 0, NULL, 0 },
+	{ 1, "$0x10", IMM, NULL, NULL, 0, 0x10, NULL, 0 },
+	{ 1, "$0xffffffffffffffff", IMM, NULL, NULL, 0, (uint64_t) -1, NULL,
+	  0 },
+	{ 1, "0x401000", IMM, NULL, NULL, 0, 0x401000, NULL, ADDR },
+	{ 1, "-0x8(%ebp)", EXPR, "ebp", NULL, 1, (uint64_t) -8, NULL, ADDR },
+	{ 1, "0x10(%rax,%rbx,4)", EXPR, "rax", "rbx", 4, 0x10, NULL, ADDR },
+	{ 1, "(%rsp)", EXPR, "rsp", NULL, 1, 0, NULL, ADDR },
+	{ 1, "0x0(,%rax,8)", EXPR, NULL, "rax", 8, 0, NULL, ADDR },
+	{ 1, "0x20(%rip)", EXPR, "rip", NULL, 1, 0x20, NULL, ADDR },
+	{ 1, "%fs:0x28", ABS, NULL, NULL, 0, 0x28, "fs", ADDR },
+	{ 1, "%es:(%rdi)", EXPR, "rdi", NULL, 1, 0, "es", ADDR },
+	{ 1, "%gs:0x8(%eax,%ecx,2)", EXPR, "eax", "ecx", 2, 8, "gs", ADDR },
+	{ 1, "*%rax", REG, "rax", NULL, 0, 0, NULL, IND },
+	{ 1, "*0x8(%rax)", EXPR, "rax", NULL, 1, 8, NULL, ADDR | IND },
+	/* Intel */
+	{ 0, "eax", REG, "eax", NULL, 0, 0, NULL, 0 },
+	{ 0, "st(1)", REG, "st(1)", NULL, 0, 0, NULL, 0 },
+	{ 0, "0x10", IMM, NULL, NULL, 0, 0x10, NULL, 0 },
+	{ 0, "DWORD PTR [rbp-0x8]", EXPR, "rbp", NULL, 1, (uint64_t) -8,
+	  NULL, ADDR | IND },
+	{ 0, "QWORD PTR [rax+rbx*4+0x10]", EXPR, "rax", "rbx", 4, 0x10, NULL,
+	  ADDR | IND },
+	{ 0, "BYTE PTR [rbx*8-0x8]", EXPR, NULL, "rbx", 8, (uint64_t) -8, NULL,
+	  ADDR | IND },
+	{ 0, "[rip+0xffffffffffffcd48]", EXPR, "rip", NULL, 1,
+	  0xffffffffffffcd48ULL, NULL, ADDR },
+	{ 0, "QWORD PTR fs:0x28", ABS, NULL, NULL, 0, 0x28, "fs", ADDR | IND },
+	{ 0, "DWORD PTR ds:0x601040", ABS, NULL, NULL, 0, 0x601040, "ds",
+	  ADDR | IND },
+	{ 0, "DWORD PTR fs:[eax*4-0x8]", EXPR, NULL, "eax", 4, (uint64_t) -8,
+	  "fs", ADDR | IND },
+	{ 0, NULL, 0, NULL, NULL, 0, 0, NULL, 0 }
+};
+
+static int check_reg( const struct OP_TEST * t, const char * field,
+		      const char * expected, const opdis_reg_t * reg,
+		      int present ) {
+	if (! expected ) {
+		if ( present ) {
+			printf( "FAIL '%s': unexpected %s %s\n", t->item,
+				field, reg->ascii );
+			return 0;
+		}
+		return 1;
+	}
+
+	if (! present || strcmp( reg->ascii, expected ) ) {
+		printf( "FAIL '%s': %s is '%s', expected '%s'\n", t->item,
+			field, ( present ) ? reg->ascii : "", expected );
+		return 0;
+	}
+
+	return 1;
+}
+
+static int check_value( const struct OP_TEST * t, uint64_t value ) {
+	if ( value != t->value ) {
+		printf( "FAIL '%s': value is 0x%llx, expected 0x%llx\n",
+			t->item, (unsigned long long) value,
+			(unsigned long long) t->value );
+		return 0;
+	}
+	return 1;
+}
+
+static int check_operand( const struct OP_TEST * t, const opdis_op_t * op ) {
+	const opdis_addr_expr_t * expr = &op->value.expr;
+	int ok = 1, has_seg;
+
+	if ( op->category != t->cat ) {
+		printf( "FAIL '%s': category is %d, expected %d\n", t->item,
+			op->category, t->cat );
+		return 0;
+	}
+
+	if ( (op->flags & FLAG_MASK) != t->flags ) {
+		printf( "FAIL '%s': flags are 0x%X, expected 0x%X\n", t->item,
+			op->flags & FLAG_MASK, t->flags );
+		ok = 0;
+	}
+
+	switch ( op->category ) {
+		case opdis_op_cat_register:
+			ok &= check_reg( t, "register", t->reg, &op->value.reg,
+					 1 );
+			break;
+		case opdis_op_cat_immediate:
+			ok &= check_value( t, op->value.immediate.u );
+			break;
+		case opdis_op_cat_absolute:
+			ok &= check_reg( t, "segment", t->seg,
+					 &op->value.abs.segment, 1 );
+			ok &= check_value( t, op->value.abs.offset );
+			break;
+		case opdis_op_cat_expr:
+			has_seg = expr->elements & opdis_addr_expr_disp_abs;
+			ok &= check_reg( t, "base", t->reg, &expr->base,
+				expr->elements & opdis_addr_expr_base );
+			ok &= check_reg( t, "index", t->index, &expr->index,
+				expr->elements & opdis_addr_expr_index );
+			ok &= check_reg( t, "segment", t->seg,
+				&expr->displacement.a.segment, has_seg );
+			ok &= check_value( t, ( has_seg ) ?
+						expr->displacement.a.offset :
+						expr->displacement.u );
+			if ( expr->scale != t->scale ) {
+				printf( "FAIL '%s': scale is %d, expected %d\n",
+					t->item, expr->scale, t->scale );
+				ok = 0;
+			}
+			break;
+		default:
+			break;
+	}
+
+	return ok;
+}
+
+static int test_operand( opdis_insn_buf_t buf, const struct OP_TEST * t ) {
+	opdis_byte_t bytes[1] = { 0x90 };
+	opdis_insn_t * insn = opdis_insn_alloc_fixed( 128, 32, 8, 64 );
+	int ok = 0;
+
+	opdis_insn_buf_clear( buf );
+	opdis_insn_buf_append( buf, "nop    " );
+	opdis_insn_buf_append( buf, t->item );
+
+	if ( t->att ) {
+		opdis_x86_att_decoder( buf, insn, bytes, 0, 0, 1, NULL );
+	} else {
+		opdis_x86_intel_decoder( buf, insn, bytes, 0, 0, 1, NULL );
+	}
+
+	if ( insn->num_operands != 1 ) {
+		printf( "FAIL '%s': %d operands\n", t->item,
+			(int) insn->num_operands );
+	} else {
+		ok = check_operand( t, insn->operands[0] );
+	}
+
+	opdis_insn_free( insn );
+	return ok;
+}
+
+int main( void ) {
+	opdis_insn_buf_t buf = opdis_insn_buf_alloc( 0, 0, 0 );
+	int i, failed = 0;
+
+	for ( i = 0; corpus[i].item; i++ ) {
+		if (! test_operand( buf, &corpus[i] ) ) {
+			failed++;
+		}
+	}
+
+	printf( "%d of %d operands decoded correctly\n", i - failed, i );
+	opdis_insn_buf_free( buf );
+
+	return ( failed ) ? 1 : 0;
+}
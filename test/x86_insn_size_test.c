@@ -0,0 +1,141 @@
+/* x86_insn_size_test.c
+ * Test the x86 instruction length decoder against a table of instruction
+ * bytes and the lengths that libopcodes reports for them.
+ */
+
+#include <stdio.h>
+
+#include <opdis/x86_decoder.h>
+
+struct SIZE_TEST {
+	enum opdis_x86_mode_t mode;
+	const char * desc;
+	int size;			/* expected size; 0 if not decodable */
+	unsigned int len;		/* number of bytes available */
+	opdis_byte_t bytes[15];
+};
+
+#define M16 opdis_x86_mode_16
+#define M32 opdis_x86_mode_32
+#define M64 opdis_x86_mode_64
+
+static struct SIZE_TEST corpus[] = {
+	/* one-byte opcodes, ModRM, SIB and displacement */
+	{ M64, "nop", 1, 1, { 0x90 } },
+	{ M64, "mov %rsp,%rbp", 3, 3, { 0x48, 0x89, 0xE5 } },
+	{ M64, "mov 0x1000,%eax", 7, 7,
+	  { 0x8B, 0x04, 0x25, 0x00, 0x10, 0x00, 0x00 } },
+	{ M64, "mov 0x8(%rsp),%eax", 4, 4, { 0x8B, 0x44, 0x24, 0x08 } },
+	{ M64, "mov 0x100(%rax),%eax", 6, 6,
+	  { 0x8B, 0x80, 0x00, 0x01, 0x00, 0x00 } },
+	{ M64, "mov 0x100(%rip),%eax", 6, 6,
+	  { 0x8B, 0x05, 0x00, 0x01, 0x00, 0x00 } },
+
+	/* immediates */
+	{ M64, "movabs $imm64,%rax", 10, 10,
+	  { 0x48, 0xB8, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11 } },
+	{ M64, "mov $0x1,%rax", 7, 7,
+	  { 0x48, 0xC7, 0xC0, 0x01, 0x00, 0x00, 0x00 } },
+	{ M64, "add $0x100,%esp", 6, 6,
+	  { 0x81, 0xC4, 0x00, 0x01, 0x00, 0x00 } },
+	{ M64, "add $0x8,%esp", 3, 3, { 0x83, 0xC4, 0x08 } },
+	{ M64, "ret $0x8", 3, 3, { 0xC2, 0x08, 0x00 } },
+	{ M64, "enter $0x10,$0x0", 4, 4, { 0xC8, 0x10, 0x00, 0x00 } },
+	{ M64, "test $0x1,%al", 3, 3, { 0xF6, 0xC0, 0x01 } },
+	{ M64, "not %al", 2, 2, { 0xF6, 0xD0 } },
+	{ M64, "test $0x100,%eax", 6, 6,
+	  { 0xF7, 0xC0, 0x00, 0x01, 0x00, 0x00 } },
+	{ M64, "movabs 0x1122334455667788,%eax", 9, 9,
+	  { 0xA1, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11 } },
+
+	/* branches */
+	{ M64, "call rel32", 5, 5, { 0xE8, 0x00, 0x01, 0x00, 0x00 } },
+	{ M64, "je rel32", 6, 6, { 0x0F, 0x84, 0x00, 0x01, 0x00, 0x00 } },
+	{ M64, "je rel8", 2, 2, { 0x74, 0x10 } },
+	{ M64, "notrack jmp *%rax", 3, 3, { 0x3E, 0xFF, 0xE0 } },
+
+	/* prefixes */
+	{ M64, "xchg %ax,%ax", 2, 2, { 0x66, 0x90 } },
+	{ M64, "rep movsq", 3, 3, { 0xF3, 0x48, 0xA5 } },
+	{ M64, "cs nopw 0x0(%rax,%rax,1)", 10, 10,
+	  { 0x66, 0x2E, 0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+	{ M64, "add $0x100,%sp", 5, 5, { 0x66, 0x81, 0xC4, 0x00, 0x01 } },
+	{ M64, "test $0x100,%ax", 5, 5, { 0x66, 0xF7, 0xC0, 0x00, 0x01 } },
+	{ M64, "mov (%eax),%eax", 3, 3, { 0x67, 0x8B, 0x00 } },
+	{ M64, "addr32 mov 0x11223344,%eax", 6, 6,
+	  { 0x67, 0xA1, 0x44, 0x33, 0x22, 0x11 } },
+	{ M64, "lock cmpxchg %rcx,(%rdi)", 5, 5,
+	  { 0xF0, 0x48, 0x0F, 0xB1, 0x0F } },
+
+	/* two- and three-byte opcodes */
+	{ M64, "syscall", 2, 2, { 0x0F, 0x05 } },
+	{ M64, "pshufb %mm1,%mm0", 4, 4, { 0x0F, 0x38, 0x00, 0xC1 } },
+	{ M64, "palignr $0x8,%xmm1,%xmm0", 6, 6,
+	  { 0x66, 0x0F, 0x3A, 0x0F, 0xC1, 0x08 } },
+
+	/* VEX and EVEX */
+	{ M64, "vzeroupper", 3, 3, { 0xC5, 0xF8, 0x77 } },
+	{ M64, "vmovdqa (%rsp),%ymm0", 5, 5, { 0xC5, 0xFD, 0x6F, 0x04, 0x24 } },
+	{ M64, "vpbroadcastd %xmm0,%ymm0", 5, 5,
+	  { 0xC4, 0xE2, 0x7D, 0x58, 0xC0 } },
+	{ M64, "vinsertf128 $0x1,%xmm1,%ymm0,%ymm0", 6, 6,
+	  { 0xC4, 0xE3, 0x7D, 0x18, 0xC1, 0x01 } },
+	{ M64, "vmovdqa32 (%rsp),%zmm0", 7, 7,
+	  { 0x62, 0xF1, 0x7D, 0x48, 0x6F, 0x04, 0x24 } },
+	{ M64, "vmovdqa32 0x40(%rsp),%zmm0", 8, 8,
+	  { 0x62, 0xF1, 0x7D, 0x48, 0x6F, 0x44, 0x24, 0x01 } },
+	{ M64, "vpcmpequd %zmm1,%zmm0,%k0", 7, 7,
+	  { 0x62, 0xF3, 0x7D, 0x48, 0x1E, 0xC1, 0x00 } },
+
+	/* 3DNow! */
+	{ M64, "pfmul %mm1,%mm0", 4, 4, { 0x0F, 0x0F, 0xC1, 0xB4 } },
+	{ M64, "pfadd 0x8(%rsp),%mm0", 6, 6,
+	  { 0x0F, 0x0F, 0x44, 0x24, 0x08, 0x9E } },
+	{ M64, "3DNow! with undefined suffix", 0, 4,
+	  { 0x0F, 0x0F, 0xC1, 0x00 } },
+
+	/* 32-bit mode */
+	{ M32, "lds (%esi),%eax", 2, 2, { 0xC5, 0x06 } },
+	{ M32, "bound %eax,(%eax)", 2, 2, { 0x62, 0x00 } },
+	{ M32, "inc %eax", 1, 1, { 0x40 } },
+	{ M32, "mov 0x11223344,%eax", 5, 5,
+	  { 0xA1, 0x44, 0x33, 0x22, 0x11 } },
+	{ M32, "mov $0x100,%ax", 4, 4, { 0x66, 0xB8, 0x00, 0x01 } },
+
+	/* 16-bit mode */
+	{ M16, "mov $0x100,%ax", 3, 3, { 0xB8, 0x00, 0x01 } },
+	{ M16, "mov 0x8(%bp),%ax", 3, 3, { 0x8B, 0x46, 0x08 } },
+	{ M16, "mov $0x100,%eax", 6, 6,
+	  { 0x66, 0xB8, 0x00, 0x01, 0x00, 0x00 } },
+
+	/* truncated input */
+	{ M64, "truncated call", 0, 3, { 0xE8, 0x00, 0x01 } },
+	{ M64, "truncated REX prefix", 0, 1, { 0x48 } },
+	{ M64, "truncated 0F escape", 0, 1, { 0x0F } },
+	{ M64, "truncated SIB", 0, 2, { 0x8B, 0x04 } },
+	{ M64, "truncated VEX", 0, 2, { 0xC4, 0xE2 } },
+	{ M64, "truncated EVEX", 0, 3, { 0x62, 0xF1, 0x7D } },
+	{ M64, "truncated 3DNow! suffix", 0, 3, { 0x0F, 0x0F, 0xC1 } },
+	{ M64, "empty buffer", 0, 0, { 0x90 } },
+
+	{ M64, NULL, 0, 0, { 0 } }
+};
+
+int main( void ) {
+	int i, size, failed = 0;
+
+	for ( i = 0; corpus[i].desc; i++ ) {
+		const struct SIZE_TEST * t = &corpus[i];
+
+		size = opdis_x86_insn_size( t->bytes, t->len, t->mode );
+		if ( size != t->size ) {
+			printf( "FAIL '%s' (%d-bit): size is %d, expected %d\n",
+				t->desc, t->mode, size, t->size );
+			failed++;
+		}
+	}
+
+	printf( "%d of %d instructions sized correctly\n", i - failed, i );
+
+	return ( failed ) ? 1 : 0;
+}
@@ -0,0 +1,215 @@
+/* x86_native_test.c
+ * Test the native x86 decoder against a corpus of instruction bytes and the
+ * AT&T and Intel text that libopcodes (binutils 2.40) prints for them.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <opdis/x86_decoder.h>
+
+#define TEST_VMA 0x1000
+
+struct NATIVE_TEST {
+	enum opdis_x86_mode_t mode;
+	unsigned int size;
+	opdis_byte_t bytes[15];
+	const char * att;			/* expected AT&T text */
+	const char * intel;			/* expected Intel text */
+};
+
+#define M32 opdis_x86_mode_32
+#define M64 opdis_x86_mode_64
+
+/* branch targets and RIP-relative comments are printed as by the default
+ * libopcodes print_address_func, relative to TEST_VMA */
+static struct NATIVE_TEST corpus[] = {
+	/* 64-bit mode */
+	{ M64, 1, { 0x55 },
+	  "push   %rbp",
+	  "push   rbp" },
+	{ M64, 3, { 0x48, 0x89, 0xE5 },
+	  "mov    %rsp,%rbp",
+	  "mov    rbp,rsp" },
+	{ M64, 1, { 0xC3 },
+	  "ret",
+	  "ret" },
+	{ M64, 1, { 0x90 },
+	  "nop",
+	  "nop" },
+	{ M64, 2, { 0x31, 0xC0 },
+	  "xor    %eax,%eax",
+	  "xor    eax,eax" },
+	{ M64, 4, { 0x48, 0x83, 0xEC, 0x10 },
+	  "sub    $0x10,%rsp",
+	  "sub    rsp,0x10" },
+	{ M64, 5, { 0x48, 0x8B, 0x44, 0x24, 0x08 },
+	  "mov    0x8(%rsp),%rax",
+	  "mov    rax,QWORD PTR [rsp+0x8]" },
+	{ M64, 3, { 0x89, 0x7D, 0xFC },
+	  "mov    %edi,-0x4(%rbp)",
+	  "mov    DWORD PTR [rbp-0x4],edi" },
+	{ M64, 7, { 0x48, 0x8D, 0x05, 0x00, 0x01, 0x00, 0x00 },
+	  "lea    0x100(%rip),%rax        # 0x00001107",
+	  "lea    rax,[rip+0x100]        # 0x00001107" },
+	{ M64, 5, { 0xE8, 0xFB, 0x0F, 0x00, 0x00 },
+	  "call   0x00002000",
+	  "call   0x00002000" },
+	{ M64, 2, { 0xEB, 0x10 },
+	  "jmp    0x00001012",
+	  "jmp    0x00001012" },
+	{ M64, 2, { 0x74, 0x05 },
+	  "je     0x00001007",
+	  "je     0x00001007" },
+	{ M64, 6, { 0x0F, 0x84, 0x00, 0x01, 0x00, 0x00 },
+	  "je     0x00001106",
+	  "je     0x00001106" },
+	{ M64, 6, { 0xFF, 0x25, 0x00, 0x01, 0x00, 0x00 },
+	  "jmp    *0x100(%rip)        # 0x00001106",
+	  "jmp    QWORD PTR [rip+0x100]        # 0x00001106" },
+	{ M64, 2, { 0xFF, 0xD0 },
+	  "call   *%rax",
+	  "call   rax" },
+	{ M64, 3, { 0xFF, 0x50, 0x08 },
+	  "call   *0x8(%rax)",
+	  "call   QWORD PTR [rax+0x8]" },
+	{ M64, 7, { 0xC7, 0x45, 0x08, 0x00, 0x00, 0x00, 0x00 },
+	  "movl   $0x0,0x8(%rbp)",
+	  "mov    DWORD PTR [rbp+0x8],0x0" },
+	{ M64, 3, { 0xC6, 0x00, 0x01 },
+	  "movb   $0x1,(%rax)",
+	  "mov    BYTE PTR [rax],0x1" },
+	{ M64, 7, { 0x48, 0xC7, 0xC0, 0x01, 0x00, 0x00, 0x00 },
+	  "mov    $0x1,%rax",
+	  "mov    rax,0x1" },
+	{ M64, 10,
+	  { 0x48, 0xB8, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11 },
+	  "movabs $0x1122334455667788,%rax",
+	  "movabs rax,0x1122334455667788" },
+	{ M64, 3, { 0x48, 0x01, 0xD8 },
+	  "add    %rbx,%rax",
+	  "add    rax,rbx" },
+	{ M64, 4, { 0x4C, 0x8B, 0x45, 0x08 },
+	  "mov    0x8(%rbp),%r8",
+	  "mov    r8,QWORD PTR [rbp+0x8]" },
+	{ M64, 4, { 0x4A, 0x8B, 0x04, 0xC0 },
+	  "mov    (%rax,%r8,8),%rax",
+	  "mov    rax,QWORD PTR [rax+r8*8]" },
+	{ M64, 2, { 0xF7, 0xD8 },
+	  "neg    %eax",
+	  "neg    eax" },
+	{ M64, 2, { 0xD1, 0xE0 },
+	  "shl    %eax",
+	  "shl    eax,1" },
+	{ M64, 3, { 0xC1, 0xE0, 0x03 },
+	  "shl    $0x3,%eax",
+	  "shl    eax,0x3" },
+	{ M64, 2, { 0xD3, 0xE8 },
+	  "shr    %cl,%eax",
+	  "shr    eax,cl" },
+	{ M64, 3, { 0x0F, 0xB6, 0xC0 },
+	  "movzbl %al,%eax",
+	  "movzx  eax,al" },
+	{ M64, 4, { 0x48, 0x0F, 0xBE, 0xC0 },
+	  "movsbq %al,%rax",
+	  "movsx  rax,al" },
+	{ M64, 3, { 0x0F, 0xAF, 0xC3 },
+	  "imul   %ebx,%eax",
+	  "imul   eax,ebx" },
+	{ M64, 3, { 0xF0, 0xFF, 0x00 },
+	  "lock incl (%rax)",
+	  "lock inc DWORD PTR [rax]" },
+	{ M64, 4, { 0x66, 0x8B, 0x45, 0x08 },
+	  "mov    0x8(%rbp),%ax",
+	  "mov    ax,WORD PTR [rbp+0x8]" },
+	{ M64, 3, { 0x48, 0x63, 0xC7 },
+	  "movslq %edi,%rax",
+	  "movsxd rax,edi" },
+	{ M64, 5, { 0xE9, 0xFC, 0x0F, 0x00, 0x00 },
+	  "jmp    0x00002001",
+	  "jmp    0x00002001" },
+	{ M64, 2, { 0xA8, 0x01 },
+	  "test   $0x1,%al",
+	  "test   al,0x1" },
+	{ M64, 2, { 0x84, 0xC0 },
+	  "test   %al,%al",
+	  "test   al,al" },
+	{ M64, 3, { 0x48, 0x85, 0xFF },
+	  "test   %rdi,%rdi",
+	  "test   rdi,rdi" },
+	{ M64, 3, { 0x0F, 0x94, 0xC0 },
+	  "sete   %al",
+	  "sete   al" },
+	{ M64, 3, { 0x0F, 0x4F, 0xC1 },
+	  "cmovg  %ecx,%eax",
+	  "cmovg  eax,ecx" },
+	{ M64, 3, { 0x8D, 0x0C, 0x89 },
+	  "lea    (%rcx,%rcx,4),%ecx",
+	  "lea    ecx,[rcx+rcx*4]" },
+	{ M64, 1, { 0x50 },
+	  "push   %rax",
+	  "push   rax" },
+	{ M64, 2, { 0x41, 0x5F },
+	  "pop    %r15",
+	  "pop    r15" },
+	{ M64, 1, { 0xC9 },
+	  "leave",
+	  "leave" },
+
+	/* 32-bit mode */
+	{ M32, 1, { 0x55 },
+	  "push   %ebp",
+	  "push   ebp" },
+	{ M32, 2, { 0x89, 0xE5 },
+	  "mov    %esp,%ebp",
+	  "mov    ebp,esp" },
+	{ M32, 3, { 0x8B, 0x45, 0x0C },
+	  "mov    0xc(%ebp),%eax",
+	  "mov    eax,DWORD PTR [ebp+0xc]" },
+	{ M32, 6, { 0xFF, 0x15, 0x44, 0x33, 0x22, 0x11 },
+	  "call   *0x11223344",
+	  "call   DWORD PTR ds:0x11223344" },
+
+	{ M64, 0, { 0 }, NULL, NULL }
+};
+
+static int test_syntax( opdis_insn_t * insn, const struct NATIVE_TEST * t,
+			enum opdis_x86_syntax_t syntax,
+			const char * expected ) {
+	int size;
+
+	size = opdis_x86_native_decode( t->bytes, t->size, TEST_VMA, t->mode,
+					syntax, insn );
+	if ( size != (int) t->size ) {
+		printf( "FAIL '%s': size is %d, expected %d\n", expected,
+			size, t->size );
+		return 0;
+	}
+
+	if ( strcmp( insn->ascii, expected ) ) {
+		printf( "FAIL '%s': decoded as '%s'\n", expected,
+			insn->ascii );
+		return 0;
+	}
+
+	return 1;
+}
+
+int main( void ) {
+	opdis_insn_t * insn = opdis_insn_alloc_fixed( 128, 32, 8, 64 );
+	int i, failed = 0;
+
+	for ( i = 0; corpus[i].att; i++ ) {
+		if (! test_syntax( insn, &corpus[i], opdis_x86_syntax_att,
+				   corpus[i].att ) ||
+		    ! test_syntax( insn, &corpus[i], opdis_x86_syntax_intel,
+				   corpus[i].intel ) ) {
+			failed++;
+		}
+	}
+
+	printf( "%d of %d instructions decoded correctly\n", i - failed, i );
+	opdis_insn_free( insn );
+
+	return ( failed ) ? 1 : 0;
+}
@@ -0,0 +1,131 @@
+/* x86_targets_test.c
+ * Test the x86 call target scan against small buffers containing direct
+ * calls and RIP-relative LEA instructions.
+ */
+
+#include <stdio.h>
+
+#include <opdis/x86_decoder.h>
+
+#define MAX_TARGETS 4
+
+struct TARGET_TEST {
+	enum opdis_x86_mode_t mode;
+	const char * desc;
+	opdis_vma_t vma;
+	unsigned int len;		/* number of bytes in buffer */
+	opdis_byte_t bytes[16];
+	unsigned int num_targets;	/* expected number of targets */
+	opdis_vma_t targets[MAX_TARGETS];	/* in the order reported */
+};
+
+struct FOUND_TARGETS {
+	unsigned int count;
+	opdis_vma_t targets[MAX_TARGETS];
+};
+
+#define M32 opdis_x86_mode_32
+#define M64 opdis_x86_mode_64
+
+static struct TARGET_TEST corpus[] = {
+	/* direct calls */
+	{ M64, "call in range", 0x1000, 6,
+	  { 0xE8, 0x00, 0x00, 0x00, 0x00, 0x90 }, 1, { 0x1005 } },
+	{ M64, "call out of range", 0x1000, 6,
+	  { 0xE8, 0x00, 0x01, 0x00, 0x00, 0x90 }, 0, { 0 } },
+	{ M64, "call before buffer", 0x1000, 6,
+	  { 0xE8, 0xF0, 0xFF, 0xFF, 0xFF, 0x90 }, 0, { 0 } },
+	{ M64, "call to invalid insn", 0x1000, 6,
+	  { 0xE8, 0x00, 0x00, 0x00, 0x00, 0x0F }, 0, { 0 } },
+	{ M32, "call in range", 0x1000, 6,
+	  { 0xE8, 0x00, 0x00, 0x00, 0x00, 0x90 }, 1, { 0x1005 } },
+
+	/* RIP-relative LEA */
+	{ M64, "lea 0x1(%rip),%rax", 0x1000, 9,
+	  { 0x48, 0x8D, 0x05, 0x01, 0x00, 0x00, 0x00, 0x90, 0x90 },
+	  1, { 0x1008 } },
+	{ M64, "lea 0x0(%rip),%r9", 0x1000, 8,
+	  { 0x4C, 0x8D, 0x0D, 0x00, 0x00, 0x00, 0x00, 0x90 },
+	  1, { 0x1007 } },
+	{ M64, "lea without REX.W", 0x1000, 8,
+	  { 0x90, 0x8D, 0x05, 0x00, 0x00, 0x00, 0x00, 0x90 }, 0, { 0 } },
+	{ M64, "lea 0x8(%rax),%rax", 0x1000, 8,
+	  { 0x48, 0x8D, 0x40, 0x08, 0x90, 0x90, 0x90, 0x90 }, 0, { 0 } },
+	{ M32, "lea is 64-bit only", 0x1000, 9,
+	  { 0x48, 0x8D, 0x05, 0x01, 0x00, 0x00, 0x00, 0x90, 0x90 },
+	  0, { 0 } },
+
+	/* candidates at the end of the buffer */
+	{ M64, "call in last 5 bytes", 0x1000, 6,
+	  { 0x90, 0xE8, 0xFA, 0xFF, 0xFF, 0xFF }, 1, { 0x1000 } },
+	{ M64, "call in last 4 bytes", 0x1000, 6,
+	  { 0x90, 0x90, 0xE8, 0xFA, 0xFF, 0xFF }, 0, { 0 } },
+	{ M64, "lea in last 5 bytes", 0x1000, 6,
+	  { 0x48, 0x8D, 0x05, 0xFF, 0xFF, 0xFF }, 0, { 0 } },
+
+	/* 32-bit targets wrap at 4 GB */
+	{ M64, "call past 4 GB", 0xFFFFFFF8, 12,
+	  { 0xE8, 0x05, 0x00, 0x00, 0x00, 0x90, 0x90, 0x90, 0x90, 0x90,
+	    0x90, 0x90 }, 1, { 0x100000002ULL } },
+	{ M32, "call wraps past 4 GB", 0xFFFFFFF8, 12,
+	  { 0xE8, 0x05, 0x00, 0x00, 0x00, 0x90, 0x90, 0x90, 0x90, 0x90,
+	    0x90, 0x90 }, 0, { 0 } },
+	{ M32, "call wraps below 0", 0x0, 6,
+	  { 0xE8, 0xF0, 0xFF, 0xFF, 0xFF, 0x90 }, 0, { 0 } },
+
+	/* several targets */
+	{ M64, "calls and lea", 0x2000, 16,
+	  { 0xE8, 0x07, 0x00, 0x00, 0x00, 0x48, 0x8D, 0x05, 0xF4, 0xFF,
+	    0xFF, 0xFF, 0x90, 0xE8, 0xFF, 0xFF }, 2, { 0x200C, 0x2000 } },
+
+	{ M64, NULL, 0, 0, { 0 }, 0, { 0 } }
+};
+
+static void found_target( opdis_vma_t target, void * arg ) {
+	struct FOUND_TARGETS * found = (struct FOUND_TARGETS *) arg;
+
+	if ( found->count < MAX_TARGETS ) {
+		found->targets[found->count] = target;
+	}
+	found->count++;
+}
+
+static int test_targets( const struct TARGET_TEST * t ) {
+	struct FOUND_TARGETS found = { 0, { 0 } };
+	unsigned int i, count;
+
+	count = opdis_x86_call_targets( t->bytes, t->len, t->vma, t->mode,
+					found_target, &found );
+	if ( count != found.count || found.count != t->num_targets ) {
+		printf( "FAIL '%s' (%d-bit): %d targets (returned %d), "
+			"expected %d\n", t->desc, t->mode, found.count, count,
+			t->num_targets );
+		return 0;
+	}
+
+	for ( i = 0; i < t->num_targets; i++ ) {
+		if ( found.targets[i] != t->targets[i] ) {
+			printf( "FAIL '%s' (%d-bit): target %d is 0x%llx, "
+				"expected 0x%llx\n", t->desc, t->mode, i,
+				(unsigned long long) found.targets[i],
+				(unsigned long long) t->targets[i] );
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+int main( void ) {
+	int i, failed = 0;
+
+	for ( i = 0; corpus[i].desc; i++ ) {
+		if (! test_targets( &corpus[i] ) ) {
+			failed++;
+		}
+	}
+
+	printf( "%d of %d buffers scanned correctly\n", i - failed, i );
+
+	return ( failed ) ? 1 : 0;
+}
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+# x86_hash.py
+# Regenerate the perfect hash tables which index the x86 mnemonic table in
+# opdis/x86_mnemonic.c and the register table in opdis/x86_decoder.c. Run
+# this from the top of the source tree after a name has been added to or
+# removed from either table:
+#
+#	util/x86_hash.py mnemonic
+#	util/x86_hash.py register
+#
+# The tables in the source file are replaced in place. With --check, the
+# file is left unchanged and the exit status is 1 if its tables are stale.
+#
+# The hash must be identical to opdis_x86_name_hash() in
+# opdis/x86_mnemonic.c.
+
+import re
+import sys
+
+MASK = 0xFFFFFFFF
+
+# name : (source file, array of names, count define or None, bucket table,
+#	  slot table, number of buckets, number of slots, values per line,
+#	  largest value the tables can hold)
+TABLES = {
+	'mnemonic': ('opdis/x86_mnemonic.c', 'mnemonics', 'NUM_MNEMONICS',
+		     'bucket_disp', 'slot_mnemonic', 512, 2048, 12, 0xFFFF),
+	'register': ('opdis/x86_decoder.c', 'intel_registers', None,
+		     'reg_bucket_disp', 'reg_slot', 48, 256, 16, 0xFF),
+}
+
+def name_hash(name):
+	a, b = 2166136261, 5381
+	for c in name.encode('ascii'):
+		a = ((a ^ c) * 16777619) & MASK
+		b = ((b * 33) & MASK) ^ c
+	return a, b | 1
+
+def read_names(src, array):
+	m = re.search(r'\b%s\[\] = \{\n(.*?)\n\};' % array, src, re.S)
+	if not m:
+		sys.exit('cannot find array %s' % array)
+	return re.findall(r'\{ "([^"]+)",', m.group(1))
+
+# Hash-and-displace: buckets are placed largest first, each with the
+# smallest displacement that puts all of its names in empty slots.
+def displace(names, num_buckets, num_slots):
+	buckets = [[] for i in range(num_buckets)]
+	for idx, name in enumerate(names):
+		h1, h2 = name_hash(name)
+		buckets[h1 % num_buckets].append((idx, h1, h2))
+
+	disp = [0] * num_buckets
+	slots = [0] * num_slots
+	order = sorted(range(num_buckets), key=lambda b: (-len(buckets[b]), b))
+	for b in order:
+		if not buckets[b]:
+			continue
+		for d in range(1 << 16):
+			want = [(h1 + d * h2) % num_slots
+				for idx, h1, h2 in buckets[b]]
+			if len(set(want)) == len(want) and \
+			   not any(slots[s] for s in want):
+				break
+		else:
+			sys.exit('no displacement for bucket %d' % b)
+		disp[b] = d
+		for s, (idx, h1, h2) in zip(want, buckets[b]):
+			slots[s] = idx + 1
+	return disp, slots
+
+def format_values(values, per_line):
+	lines = []
+	for i in range(0, len(values), per_line):
+		lines.append('\t' + ', '.join(str(v)
+				for v in values[i:i + per_line]))
+	return ',\n'.join(lines)
+
+def replace_table(src, table, values, per_line):
+	pat = r'(\b%s\[\d+\] = \{\n)(.*?)(\n\};)' % table
+	if not re.search(pat, src, re.S):
+		sys.exit('cannot find table %s' % table)
+	return re.sub(pat, lambda m: m.group(1) +
+		      format_values(values, per_line) + m.group(3),
+		      src, count=1, flags=re.S)
+
+def main(argv):
+	check = '--check' in argv
+	args = [a for a in argv if a != '--check']
+	if len(args) != 1 or args[0] not in TABLES:
+		sys.exit('usage: x86_hash.py [--check] %s' %
+			 '|'.join(sorted(TABLES)))
+
+	path, array, count, bucket_tbl, slot_tbl, num_buckets, num_slots, \
+		per_line, max_value = TABLES[args[0]]
+	src = open(path).read()
+	names = read_names(src, array)
+	if len(set(names)) != len(names):
+		sys.exit('duplicate names in %s' % array)
+
+	disp, slots = displace(names, num_buckets, num_slots)
+	if max(disp + slots) > max_value:
+		sys.exit('%s: table value exceeds %d' % (path, max_value))
+
+	out = src
+	if count:
+		out = re.sub(r'(#define %s )\d+' % count,
+			     lambda m: m.group(1) + str(len(names)), out)
+	out = replace_table(out, bucket_tbl, disp, per_line)
+	out = replace_table(out, slot_tbl, slots, per_line)
+
+	if check:
+		if out != src:
+			print('%s: hash tables are out of date' % path)
+			return 1
+		return 0
+
+	if out != src:
+		open(path, 'w').write(out)
+	return 0
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv[1:]))